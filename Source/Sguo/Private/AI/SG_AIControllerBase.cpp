@@ -6,14 +6,21 @@
 #include "AbilitySystem/SG_AttributeSet.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "Units/SG_UnitsBase.h"
 #include "Kismet/GameplayStatics.h"
 #include "Buildings/SG_MainCityBase.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
+#include "Debug/SG_Stats.h"
+#include "Debug/SG_Trace.h"
 #include "NavigationSystem.h"
 #include "AI/SG_CombatTargetManager.h"
 #include "AI/SG_TargetingSubsystem.h"
+#include "AI/SG_ReachabilityCache.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Units/SG_DeathEventHub.h"
 #include "Components/BoxComponent.h"
 
 
@@ -44,26 +51,15 @@ void ASG_AIControllerBase::BeginPlay()
  * @param DeltaTime 帧间隔
  * @details
  * 功能说明：
- * - 更新移动计时器
- * - 周期性清理不可达列表
  * - 移动中检测更好目标
  * - ✨ 新增：攻击主城时检测敌方单位
  */
 void ASG_AIControllerBase::Tick(float DeltaTime)
 {
+    SG_SCOPE_CYCLE_COUNTER(AIControllerTick);
+
     Super::Tick(DeltaTime);
     
-    // 更新移动计时器
-    UpdateMovementTimer(DeltaTime);
-    
-    // 周期性清理不可达列表
-    UnreachableClearTimer += DeltaTime;
-    if (UnreachableClearTimer >= UnreachableClearInterval)
-    {
-        UnreachableClearTimer = 0.0f;
-        ClearUnreachableTargets();
-    }
-
     // ✨ 新增 - 攻击主城时检测敌方单位
     TargetSwitchCheckTimer += DeltaTime;
     if (TargetSwitchCheckTimer >= TargetSwitchCheckInterval)
@@ -86,11 +82,9 @@ void ASG_AIControllerBase::Tick(float DeltaTime)
 // ========== OnPossess ==========
 void ASG_AIControllerBase::OnPossess(APawn* InPawn)
 {
+    SG_LLM_SCOPE(AI); // ✨ 新增 - LLM 标签
     Super::OnPossess(InPawn);
     
-    // 初始化位置记录
-    LastPosition = InPawn->GetActorLocation();
-    
     // 步骤1：确定要使用的行为树
     UBehaviorTree* BehaviorTreeToUse = nullptr;
     
@@ -214,8 +208,7 @@ void ASG_AIControllerBase::OnUnPossess()
     }
     
     CurrentBehaviorTree = nullptr;
-    UnreachableTargets.Empty();
-    TargetEngagementState = ESGTargetEngagementState::Searching;
+    SetTargetEngagementState(ESGTargetEngagementState::Searching);
     
     Super::OnUnPossess();
 }
@@ -240,12 +233,38 @@ void ASG_AIControllerBase::FreezeAI()
     SetCurrentTarget(nullptr);
     SetActorTickEnabled(false);
     
-    TargetEngagementState = ESGTargetEngagementState::Searching;
+    SetTargetEngagementState(ESGTargetEngagementState::Searching);
+}
+
+// ✨ 新增 - 对象池复用
+/**
+ * @brief 重置控制器状态
+ */
+void ASG_AIControllerBase::ResetForReuse()
+{
+    if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+    {
+        // 包括父黑板中的键
+        for (const UBlackboardData* BlackboardAsset = BlackboardComp->GetBlackboardAsset(); BlackboardAsset; BlackboardAsset = BlackboardAsset->Parent)
+        {
+            for (const FBlackboardEntry& Entry : BlackboardAsset->Keys)
+            {
+                BlackboardComp->ClearValue(Entry.EntryName);
+            }
+        }
+    }
+
+    bStuckDetected = false;
+    StuckEventCount = 0;
+    TargetSwitchCheckTimer = 0.0f;
+    SetTargetEngagementState(ESGTargetEngagementState::Searching);
+    SetActorTickEnabled(true);
 }
 
 /**
  * @brief 设置目标锁定状态
  * @param NewState 新状态
+ * @details 进入或离开 Moving 状态时，同步登记到卡住检测
  */
 void ASG_AIControllerBase::SetTargetEngagementState(ESGTargetEngagementState NewState)
 {
@@ -255,6 +274,18 @@ void ASG_AIControllerBase::SetTargetEngagementState(ESGTargetEngagementState New
     }
     
     TargetEngagementState = NewState;
+
+    ASG_UnitsBase* ControlledUnit = Cast<ASG_UnitsBase>(GetPawn());
+    UWorld* World = GetWorld();
+    if (ControlledUnit && World)
+    {
+        if (USG_UnitRegistrySubsystem* Registry = World->GetSubsystem<USG_UnitRegistrySubsystem>())
+        {
+            // 判定时间内移动不足阈值距离即为卡住：换算为平均速度阈值
+            const float StuckSpeedThreshold = MinMovementDistance / FMath::Max(StuckThresholdTime, KINDA_SMALL_NUMBER);
+            Registry->SetMoving(ControlledUnit->RegistryHandle, NewState == ESGTargetEngagementState::Moving, StuckSpeedThreshold, StuckThresholdTime);
+        }
+    }
 }
 
 /**
@@ -337,9 +368,9 @@ void ASG_AIControllerBase::CheckForEnemyUnitsWhileAttackingMainCity()
         return;
     }
     
-    // 查找敌方单位（不包括主城）
+    // 查找敌方单位（不包括主城），不可达目标由寻敌系统查询可达性缓存过滤
     TArray<FSGTargetCandidate> Candidates;
-    TSet<TWeakObjectPtr<AActor>> IgnoreList = UnreachableTargets;
+    TSet<TWeakObjectPtr<AActor>> IgnoreList;
     
     AActor* EnemyUnit = TargetingSys->FindEnemyUnitsOnly(
         ControlledUnit,
@@ -404,7 +435,7 @@ void ASG_AIControllerBase::CheckForBetterTargetWhileMoving()
     float CurrentDistance = FVector::Dist(MyLocation, CurrentTarget->GetActorLocation());
 
     TArray<FSGTargetCandidate> Candidates;
-    TSet<TWeakObjectPtr<AActor>> IgnoreList = UnreachableTargets;
+    TSet<TWeakObjectPtr<AActor>> IgnoreList;
     
     AActor* BetterTarget = TargetingSys->FindEnemyUnitsOnly(
         ControlledUnit,
@@ -454,7 +485,14 @@ void ASG_AIControllerBase::MarkCurrentTargetUnreachable()
         return;
     }
     
-    UnreachableTargets.Add(CurrentTarget);
+    if (UWorld* World = GetWorld())
+    {
+        if (USG_ReachabilityCache* ReachabilityCache = World->GetSubsystem<USG_ReachabilityCache>())
+        {
+            const FVector FromLocation = GetPawn() ? GetPawn()->GetActorLocation() : GetActorLocation();
+            ReachabilityCache->MarkUnreachable(FromLocation, CurrentTarget);
+        }
+    }
     SetTargetEngagementState(ESGTargetEngagementState::Blocked);
 }
 
@@ -463,17 +501,16 @@ void ASG_AIControllerBase::MarkCurrentTargetUnreachable()
  */
 void ASG_AIControllerBase::ClearUnreachableTargets()
 {
-    for (auto It = UnreachableTargets.CreateIterator(); It; ++It)
+    APawn* ControlledPawn = GetPawn();
+    UWorld* World = GetWorld();
+    if (!ControlledPawn || !World)
     {
-        if (!It->IsValid())
-        {
-            It.RemoveCurrent();
-        }
+        return;
     }
-    
-    if (UnreachableTargets.Num() > 0)
+
+    if (USG_ReachabilityCache* ReachabilityCache = World->GetSubsystem<USG_ReachabilityCache>())
     {
-        UnreachableTargets.Empty();
+        ReachabilityCache->ClearRegion(ControlledPawn->GetActorLocation());
     }
 }
 
@@ -482,12 +519,15 @@ void ASG_AIControllerBase::ClearUnreachableTargets()
  */
 bool ASG_AIControllerBase::IsTargetUnreachable(AActor* Target) const
 {
-    if (!Target)
+    APawn* ControlledPawn = GetPawn();
+    UWorld* World = GetWorld();
+    if (!Target || !ControlledPawn || !World)
     {
         return false;
     }
-    
-    return UnreachableTargets.Contains(Target);
+
+    const USG_ReachabilityCache* ReachabilityCache = World->GetSubsystem<USG_ReachabilityCache>();
+    return ReachabilityCache && ReachabilityCache->IsUnreachable(ControlledPawn->GetActorLocation(), Target);
 }
 
 /**
@@ -495,7 +535,7 @@ bool ASG_AIControllerBase::IsTargetUnreachable(AActor* Target) const
  */
 bool ASG_AIControllerBase::IsStuck() const
 {
-    return MovementTimer >= StuckThresholdTime;
+    return bStuckDetected;
 }
 
 /**
@@ -503,45 +543,74 @@ bool ASG_AIControllerBase::IsStuck() const
  */
 void ASG_AIControllerBase::ResetMovementTimer()
 {
-    MovementTimer = 0.0f;
-    if (APawn* ControlledPawn = GetPawn())
+    bStuckDetected = false;
+    StuckEventCount = 0;
+
+    ASG_UnitsBase* ControlledUnit = Cast<ASG_UnitsBase>(GetPawn());
+    UWorld* World = GetWorld();
+    if (ControlledUnit && World && ControlledUnit->RegistryHandle.IsValid())
     {
-        LastPosition = ControlledPawn->GetActorLocation();
+        if (USG_UnitRegistrySubsystem* Registry = World->GetSubsystem<USG_UnitRegistrySubsystem>())
+        {
+            Registry->ResetSpeedHistory(ControlledUnit->RegistryHandle.Index);
+        }
     }
 }
 
 /**
- * @brief 更新移动计时器
+ * @brief 卡住检测回调
+ * @details
+ * 详细流程：
+ * 1. 第一次卡住：尝试侧面绕行（主城目标、远程单位不绕行）
+ * 2. 再次卡住：标记当前目标不可达，查找可达目标
+ * 3. 没有可达目标时，清除本区域的不可达记录后再查找一次
  */
-void ASG_AIControllerBase::UpdateMovementTimer(float DeltaTime)
+void ASG_AIControllerBase::OnStuckDetected()
 {
     if (TargetEngagementState != ESGTargetEngagementState::Moving)
     {
-        MovementTimer = 0.0f;
         return;
     }
-    
-    APawn* ControlledPawn = GetPawn();
-    if (!ControlledPawn)
+
+    ASG_UnitsBase* ControlledUnit = Cast<ASG_UnitsBase>(GetPawn());
+    AActor* CurrentTarget = GetCurrentTarget();
+    if (!ControlledUnit || !CurrentTarget)
     {
         return;
     }
 
-    float Speed = ControlledPawn->GetVelocity().Size();
-    
-    if (Speed < 10.0f)
+    StuckEventCount++;
+
+    // 主城不会被标记为不可达，交给行为树重新寻路
+    if (CurrentTarget->IsA(ASG_MainCityBase::StaticClass()))
     {
-        MovementTimer += DeltaTime;
+        return;
     }
-    else
+
+    // 第一次卡住：尝试绕行
+    if (StuckEventCount == 1 && ShouldOccupyAttackSlot())
     {
-        MovementTimer = 0.0f; 
+        TryFlankingMove();
+        return;
+    }
+
+    UE_LOG(LogSGGameplay, Log, TEXT("🚧 %s 检测到卡住，切换目标"), *ControlledUnit->GetName());
+
+    bStuckDetected = true;
+    MarkCurrentTargetUnreachable();
+    StopMovement();
+
+    AActor* NewTarget = FindNearestReachableTarget();
+    if (!NewTarget)
+    {
+        ClearUnreachableTargets();
+        NewTarget = FindNearestTarget();
     }
 
-    if (MovementTimer > 0.5f)
+    if (NewTarget && NewTarget != CurrentTarget)
     {
-        MovementTimer = 0.0f;
-        TryFlankingMove();
+        SetCurrentTarget(NewTarget);
+        UE_LOG(LogSGGameplay, Log, TEXT("  ✓ 切换到新目标：%s"), *NewTarget->GetName());
     }
 }
 
@@ -612,12 +681,13 @@ AActor* ASG_AIControllerBase::FindNearestReachableTarget()
     if (USG_TargetingSubsystem* TargetingSys = World->GetSubsystem<USG_TargetingSubsystem>())
     {
         TArray<FSGTargetCandidate> Candidates;
+        TSet<TWeakObjectPtr<AActor>> IgnoreList;
 
         AActor* BestTarget = TargetingSys->FindBestTarget(
             ControlledUnit,
             ControlledUnit->GetDetectionRange(),
             Candidates,
-            UnreachableTargets
+            IgnoreList
         );
 
         return BestTarget;
@@ -646,12 +716,13 @@ AActor* ASG_AIControllerBase::FindNearestTarget()
     if (USG_TargetingSubsystem* TargetingSys = World->GetSubsystem<USG_TargetingSubsystem>())
     {
         TArray<FSGTargetCandidate> Candidates;
+        TSet<TWeakObjectPtr<AActor>> IgnoreList;
         
         AActor* BestTarget = TargetingSys->FindBestTarget(
             ControlledUnit,
             ControlledUnit->GetDetectionRange(),
             Candidates,
-            UnreachableTargets
+            IgnoreList
         );
 
         if (BestTarget)
@@ -775,6 +846,8 @@ void ASG_AIControllerBase::SetCurrentTarget(AActor* NewTarget)
         return;
     }
 
+    SG_TRACE_EVENT(TargetChanged, GetPawn(), OldTarget, NewTarget);
+
     UWorld* World = GetWorld();
     USG_TargetingSubsystem* TargetingSys = World ? World->GetSubsystem<USG_TargetingSubsystem>() : nullptr;
     USG_CombatTargetManager* CombatManager = World ? World->GetSubsystem<USG_CombatTargetManager>() : nullptr;
@@ -899,7 +972,13 @@ void ASG_AIControllerBase::SetCurrentTarget(AActor* NewTarget)
         ResetMovementTimer();
         
         // 立即开始移动
-        MoveToLocation(MoveDestination, AcceptanceRadius, true, true, true);
+        const EPathFollowingRequestResult::Type MoveResult = MoveToLocation(MoveDestination, AcceptanceRadius, true, true, true);
+
+        // ✨ 新增 - 寻路失败时写入可达性缓存，同区域单位不再重复尝试
+        if (MoveResult == EPathFollowingRequestResult::Failed && !bTargetIsMainCity)
+        {
+            MarkCurrentTargetUnreachable();
+        }
     }
     else
     {
@@ -1064,8 +1143,6 @@ void ASG_AIControllerBase::OnTargetDeath(ASG_UnitsBase* DeadUnit)
         AControlledUnit->SetTarget(nullptr);
     }
     
-    UnreachableTargets.Remove(DeadUnit);
-    
     AActor* NewTarget = FindNearestTarget();
     if (NewTarget)
     {
@@ -1081,7 +1158,11 @@ void ASG_AIControllerBase::BindTargetDeathEvent(ASG_UnitsBase* Target)
         return;
     }
     
-    Target->OnUnitDeathEvent.AddDynamic(this, &ASG_AIControllerBase::OnTargetDeath);
+    // 🔧 修改 - 通过死亡事件中心监听，不再向目标绑定动态委托
+    if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
+    {
+        DeathHub->AddWatcher(Target, this, FSGDeathWatchCallback::CreateUObject(this, &ASG_AIControllerBase::OnTargetDeath));
+    }
 }
 
 // ========== UnbindTargetDeathEvent ==========
@@ -1092,5 +1173,9 @@ void ASG_AIControllerBase::UnbindTargetDeathEvent(ASG_UnitsBase* Target)
         return;
     }
     
-    Target->OnUnitDeathEvent.RemoveDynamic(this, &ASG_AIControllerBase::OnTargetDeath);
+    // 🔧 修改 - 通过死亡事件中心取消监听
+    if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
+    {
+        DeathHub->RemoveWatcher(Target, this);
+    }
 }
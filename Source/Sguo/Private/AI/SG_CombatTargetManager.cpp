@@ -6,6 +6,9 @@
 #include "Units/SG_UnitsBase.h"
 #include "Buildings/SG_MainCityBase.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Debug/SG_Trace.h"
+#include "Debug/SG_MemoryTracking.h"
 #include "Kismet/GameplayStatics.h"
 #include "NavigationSystem.h"
 #include "Engine/OverlapResult.h"
@@ -706,6 +709,8 @@ float USG_CombatTargetManager::GetTargetCollisionRadius(AActor* Target) const
  */
 AActor* USG_CombatTargetManager::FindBestTargetWithSlot(ASG_UnitsBase* Querier)
 {
+    SG_SCOPE_CYCLE_COUNTER(FindBestTargetWithSlot);
+
     if (!Querier)
     {
         return nullptr;
@@ -728,6 +733,9 @@ AActor* USG_CombatTargetManager::FindBestTargetWithSlot(ASG_UnitsBase* Querier)
     TArray<AActor*> NearbyEnemies;
     QueryEnemiesInRange(Querier, SearchRadius, NearbyEnemies);
 
+    SG_INC_COUNTER(TargetQueries);
+    SG_INC_COUNTER_BY(TargetCandidates, NearbyEnemies.Num());
+
     // ========== 步骤2：如果有敌方单位，进行评分和槽位检查 ==========
     if (NearbyEnemies.Num() > 0)
     {
@@ -893,6 +901,9 @@ AActor* USG_CombatTargetManager::FindBestTargetWithSlot(ASG_UnitsBase* Querier)
  */
 bool USG_CombatTargetManager::TryReserveAttackSlot(ASG_UnitsBase* Attacker, AActor* Target, FVector& OutSlotPosition)
 {
+    SG_SCOPE_CYCLE_COUNTER(ReserveAttackSlot);
+    SG_INC_COUNTER(SlotReservations);
+
      if (!Attacker || !Target)
     {
         return false;
@@ -959,6 +970,7 @@ bool USG_CombatTargetManager::TryReserveAttackSlot(ASG_UnitsBase* Attacker, AAct
     {
         UE_LOG(LogSGGameplay, Warning, TEXT("❌ %s 无法预约 %s 的槽位：已满"),
             *Attacker->GetName(), *Target->GetName());
+        SG_TRACE_EVENT(SlotReserved, Attacker, Target, INDEX_NONE);
         return false;
     }
 
@@ -968,6 +980,7 @@ bool USG_CombatTargetManager::TryReserveAttackSlot(ASG_UnitsBase* Attacker, AAct
 
     UE_LOG(LogSGGameplay, Verbose, TEXT("✅ %s 预约了 %s 的槽位 #%d"),
         *Attacker->GetName(), *Target->GetName(), SlotIndex);
+    SG_TRACE_EVENT(SlotReserved, Attacker, Target, SlotIndex);
 
     return true;
 }
@@ -979,6 +992,8 @@ bool USG_CombatTargetManager::TryReserveAttackSlot(ASG_UnitsBase* Attacker, AAct
  */
 void USG_CombatTargetManager::ReleaseAttackSlot(ASG_UnitsBase* Attacker, AActor* Target)
 {
+    SG_SCOPE_CYCLE_COUNTER(ReleaseAttackSlot);
+
     if (!Attacker || !Target)
     {
         return;
@@ -1010,6 +1025,7 @@ void USG_CombatTargetManager::ReleaseAttackSlot(ASG_UnitsBase* Attacker, AActor*
             Slot.OccupyingUnit = nullptr;
             UE_LOG(LogSGGameplay, Verbose, TEXT("🔓 %s 释放了 %s 的槽位"),
                 *Attacker->GetName(), *Target->GetName());
+            SG_TRACE_EVENT(SlotReleased, Attacker, Target);
             return;
         }
     }
@@ -1051,6 +1067,76 @@ void USG_CombatTargetManager::ReleaseAllSlots(ASG_UnitsBase* Attacker)
     }
 }
 
+// ✨ 新增 - 批量死亡处理
+/**
+ * @brief 批量处理本帧死亡的单位
+ * @param DeadUnits 死亡单位列表
+ * @details
+ * 详细流程：
+ * 1. 把死亡单位分为「目标」和「占用槽位的攻击者」两个集合
+ * 2. 一次遍历槽位表：死亡目标的记录整条移除，其余记录中释放死亡攻击者的槽位
+ */
+void USG_CombatTargetManager::HandleUnitsDied(const TArray<ASG_UnitsBase*>& DeadUnits)
+{
+    if (DeadUnits.Num() == 0 || TargetCombatInfoMap.Num() == 0)
+    {
+        return;
+    }
+
+    TSet<const AActor*> DeadTargets;
+    TSet<const ASG_UnitsBase*> DeadAttackers;
+    DeadTargets.Reserve(DeadUnits.Num());
+    DeadAttackers.Reserve(DeadUnits.Num());
+
+    for (ASG_UnitsBase* Unit : DeadUnits)
+    {
+        if (!Unit)
+        {
+            continue;
+        }
+
+        DeadTargets.Add(Unit);
+
+        // 远程单位没有占用槽位
+        if (ShouldUnitOccupySlot(Unit))
+        {
+            DeadAttackers.Add(Unit);
+        }
+    }
+
+    int32 RemovedTargets = 0;
+    int32 ReleasedSlots = 0;
+
+    for (auto It = TargetCombatInfoMap.CreateIterator(); It; ++It)
+    {
+        const AActor* TargetActor = It.Key().Get();
+        if (TargetActor && DeadTargets.Contains(TargetActor))
+        {
+            It.RemoveCurrent();
+            RemovedTargets++;
+            continue;
+        }
+
+        if (DeadAttackers.Num() == 0)
+        {
+            continue;
+        }
+
+        for (FSGAttackSlot& Slot : It.Value().AttackSlots)
+        {
+            if (Slot.OccupyingUnit.IsValid() && DeadAttackers.Contains(Slot.OccupyingUnit.Get()))
+            {
+                Slot.OccupyingUnit = nullptr;
+                ReleasedSlots++;
+            }
+        }
+    }
+    TrackedTargetCount.Set(TargetCombatInfoMap.Num());
+
+    UE_LOG(LogSGGameplay, Verbose, TEXT("🔓 批量死亡处理：移除 %d 个目标记录，释放 %d 个槽位"),
+        RemovedTargets, ReleasedSlots);
+}
+
 /**
  * @brief 检查目标是否有可用槽位
  * @param Target 目标 Actor
@@ -1170,7 +1256,11 @@ void USG_CombatTargetManager::InitializeSlotsForTarget(AActor* Target)
     // 主城不使用槽位系统
     if (Target->IsA(ASG_MainCityBase::StaticClass())) return;
 
+    // ✨ 新增 - 槽位表记入 Sguo/AI
+    SG_LLM_SCOPE(AI);
+
     FSGTargetCombatInfo& CombatInfo = TargetCombatInfoMap.FindOrAdd(Target);
+    TrackedTargetCount.Set(TargetCombatInfoMap.Num());
     if (CombatInfo.AttackSlots.Num() > 0) return;  // 已初始化
 
     // 缓存目标半径
@@ -1209,6 +1299,42 @@ FSGTargetCombatInfo& USG_CombatTargetManager::GetOrCreateCombatInfo(AActor* Targ
     return TargetCombatInfoMap.FindOrAdd(Target);
 }
 
+/**
+ * @brief ✨ 新增 - 统计目标已失效的条目
+ * @return 失效条目数
+ * @details
+ * - CleanupInvalidData 定期清理，这里只读，不修改表
+ */
+int32 USG_CombatTargetManager::CountStaleTargetEntries() const
+{
+    int32 StaleCount = 0;
+    for (const auto& Pair : TargetCombatInfoMap)
+    {
+        if (!Pair.Key.IsValid())
+        {
+            ++StaleCount;
+        }
+    }
+    return StaleCount;
+}
+
+// ✨ 新增 - 性能面板
+void USG_CombatTargetManager::GetSlotTotals(int32& OutUsed, int32& OutTotal) const
+{
+    OutUsed = 0;
+    OutTotal = 0;
+    for (const auto& Pair : TargetCombatInfoMap)
+    {
+        if (!Pair.Key.IsValid())
+        {
+            continue;
+        }
+
+        OutTotal += Pair.Value.AttackSlots.Num();
+        OutUsed += Pair.Value.AttackSlots.Num() - Pair.Value.GetAvailableSlotCount();
+    }
+}
+
 /**
  * @brief 查找最近的可用槽位
  * @param Target 目标 Actor
@@ -1366,4 +1492,5 @@ void USG_CombatTargetManager::CleanupInvalidData()
             }
         }
     }
+    TrackedTargetCount.Set(TargetCombatInfoMap.Num());
 }
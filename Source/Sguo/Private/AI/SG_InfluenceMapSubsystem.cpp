@@ -0,0 +1,428 @@
+// 📄 文件：Source/Sguo/Private/AI/SG_InfluenceMapSubsystem.cpp
+// ✨ 新增 - 阵营势力/威胁图实现
+// ✅ 这是完整文件
+
+#include "AI/SG_InfluenceMapSubsystem.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
+#include "Engine/World.h"
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_InfluenceMapSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    // 确保单位注册表先于势力图初始化
+    Collection.InitializeDependency<USG_UnitRegistrySubsystem>();
+
+    Super::Initialize(Collection);
+
+    AllocateGrids();
+
+    UE_LOG(LogSGGameplay, Log, TEXT("✓ 势力图初始化完成（%d x %d，格子 %.0f）"), GridWidth, GridHeight, CellSize);
+}
+
+/**
+ * @brief 子系统销毁
+ * @details 必须等待工作线程结束，工作线程会访问本对象的成员
+ */
+void USG_InfluenceMapSubsystem::Deinitialize()
+{
+    if (PendingTask.IsValid())
+    {
+        PendingTask.Wait();
+    }
+    PendingTask = UE::Tasks::FTask();
+
+    PublishedGrid.Empty();
+    WorkingGrid.Empty();
+    PreviousContributions.Empty();
+    VisitedSlots.Empty();
+    bResultPending = false;
+
+    Super::Deinitialize();
+}
+
+/**
+ * @brief 按当前配置分配网格
+ */
+void USG_InfluenceMapSubsystem::AllocateGrids()
+{
+    SG_LLM_SCOPE(AI); // ✨ 新增 - LLM 标签
+    GridWidth = FMath::Max(GridWidth, 1);
+    GridHeight = FMath::Max(GridHeight, 1);
+    CellCount = GridWidth * GridHeight;
+
+    PublishedGrid.SetNumZeroed(CellCount * MaxFactionLayers);
+    WorkingGrid.SetNumZeroed(CellCount * MaxFactionLayers);
+    PreviousContributions.Reset();
+    VisitedSlots.Reset();
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧 Tick
+ * @param DeltaTime 帧间隔时间
+ * @details
+ * 详细流程：
+ * 1. 上一次任务完成后，发布工作网格
+ * 2. 到达更新间隔且没有进行中的任务时，启动新一轮更新
+ */
+void USG_InfluenceMapSubsystem::Tick(float DeltaTime)
+{
+    const bool bTaskBusy = PendingTask.IsValid() && !PendingTask.IsCompleted();
+
+    if (bResultPending && !bTaskBusy)
+    {
+        PublishWorkingGrid();
+    }
+
+    UpdateTimer += DeltaTime;
+    if (UpdateTimer < UpdateInterval || bTaskBusy)
+    {
+        return;
+    }
+
+    UpdateTimer = 0.0f;
+    LaunchUpdate();
+}
+
+// ========== 更新 ==========
+
+/**
+ * @brief 从单位注册表拷贝快照，并在工作线程启动增量更新
+ * @details
+ * 功能说明：
+ * - 游戏线程只做一次线性拷贝（位置 -> 格子索引、生命值 × 攻击力）
+ * - 增量计算和格子修改全部在工作线程执行
+ */
+void USG_InfluenceMapSubsystem::LaunchUpdate()
+{
+    SG_LLM_SCOPE(AI); // ✨ 新增 - LLM 标签
+    UWorld* World = GetWorld();
+    USG_UnitRegistrySubsystem* Registry = World ? World->GetSubsystem<USG_UnitRegistrySubsystem>() : nullptr;
+    if (!Registry)
+    {
+        return;
+    }
+
+    const TArray<FVector>& Positions = Registry->GetPositions();
+    const TArray<float>& Healths = Registry->GetHealths();
+    const TArray<float>& AttackDamages = Registry->GetAttackDamages();
+    const TArray<uint8>& FactionIndices = Registry->GetFactionIndices();
+    const TArray<int32>& Generations = Registry->GetGenerations();
+
+    TArray<FSGInfluenceSample> Samples;
+    Samples.Reserve(Registry->GetActiveCount());
+
+    for (TConstSetBitIterator<> It(Registry->GetActiveMask()); It; ++It)
+    {
+        const int32 SlotIndex = It.GetIndex();
+        if (FactionIndices[SlotIndex] >= MaxFactionLayers)
+        {
+            continue;
+        }
+
+        FSGInfluenceSample& Sample = Samples.AddDefaulted_GetRef();
+        Sample.SlotIndex = SlotIndex;
+        Sample.Generation = Generations[SlotIndex];
+        Sample.CellIndex = GetCellIndex(Positions[SlotIndex]);
+        Sample.FactionIndex = FactionIndices[SlotIndex];
+        Sample.Strength = FMath::Max(Healths[SlotIndex], 0.0f) * FMath::Max(AttackDamages[SlotIndex], 0.0f);
+    }
+
+    const int32 SlotCount = Registry->GetSlotCount();
+    bResultPending = true;
+
+    PendingTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [this, SlotCount, Samples = MoveTemp(Samples)]()
+        {
+            // 槽位数量只增不减，工作线程按需扩容
+            if (PreviousContributions.Num() < SlotCount)
+            {
+                PreviousContributions.SetNum(SlotCount);
+            }
+            ApplySamples(Samples);
+        });
+}
+
+/**
+ * @brief 工作线程：把快照增量应用到工作网格
+ * @param Samples 本次快照
+ * @details
+ * 详细流程：
+ * 1. 对每个采样，与该槽位上一次的贡献比较，相同则跳过
+ * 2. 不同则先减去旧贡献，再加上新贡献
+ * 3. 本次未出现的槽位（死亡或注销）减去旧贡献
+ */
+void USG_InfluenceMapSubsystem::ApplySamples(const TArray<FSGInfluenceSample>& Samples)
+{
+    auto RemoveContribution = [this](const FSGInfluenceSample& Contribution)
+    {
+        if (Contribution.CellIndex != INDEX_NONE)
+        {
+            float& Value = WorkingGrid[Contribution.FactionIndex * CellCount + Contribution.CellIndex];
+            Value = FMath::Max(Value - Contribution.Strength, 0.0f);
+        }
+    };
+
+    auto AddContribution = [this](const FSGInfluenceSample& Contribution)
+    {
+        if (Contribution.CellIndex != INDEX_NONE)
+        {
+            WorkingGrid[Contribution.FactionIndex * CellCount + Contribution.CellIndex] += Contribution.Strength;
+        }
+    };
+
+    VisitedSlots.Init(false, PreviousContributions.Num());
+
+    int32 ChangedCount = 0;
+
+    for (const FSGInfluenceSample& Sample : Samples)
+    {
+        VisitedSlots[Sample.SlotIndex] = true;
+
+        FSGInfluenceSample& Previous = PreviousContributions[Sample.SlotIndex];
+        if (Previous.Generation == Sample.Generation
+            && Previous.CellIndex == Sample.CellIndex
+            && Previous.FactionIndex == Sample.FactionIndex
+            && FMath::IsNearlyEqual(Previous.Strength, Sample.Strength))
+        {
+            continue;
+        }
+
+        // 槽位为空（SlotIndex 为 INDEX_NONE）时没有旧贡献
+        if (Previous.SlotIndex != INDEX_NONE)
+        {
+            RemoveContribution(Previous);
+        }
+        AddContribution(Sample);
+        Previous = Sample;
+        ChangedCount++;
+    }
+
+    for (int32 SlotIndex = 0; SlotIndex < PreviousContributions.Num(); ++SlotIndex)
+    {
+        FSGInfluenceSample& Previous = PreviousContributions[SlotIndex];
+        if (!VisitedSlots[SlotIndex] && Previous.SlotIndex != INDEX_NONE)
+        {
+            RemoveContribution(Previous);
+            Previous = FSGInfluenceSample();
+            ChangedCount++;
+        }
+    }
+
+    UE_LOG(LogSGGameplay, VeryVerbose, TEXT("[势力图] 采样 %d，变化 %d"), Samples.Num(), ChangedCount);
+}
+
+/**
+ * @brief 游戏线程：把工作网格发布到只读网格
+ * @details 同时统计每个阵营的最大威胁值，供归一化查询使用
+ */
+void USG_InfluenceMapSubsystem::PublishWorkingGrid()
+{
+    bResultPending = false;
+
+    FMemory::Memcpy(PublishedGrid.GetData(), WorkingGrid.GetData(), WorkingGrid.Num() * sizeof(float));
+
+    for (int32 Layer = 0; Layer < MaxFactionLayers; ++Layer)
+    {
+        PublishedMaxThreat[Layer] = 0.0f;
+    }
+
+    for (int32 CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+    {
+        float Total = 0.0f;
+        for (int32 Layer = 0; Layer < MaxFactionLayers; ++Layer)
+        {
+            Total += GetPublishedValue(Layer, CellIndex);
+        }
+
+        for (int32 Layer = 0; Layer < MaxFactionLayers; ++Layer)
+        {
+            const float Threat = Total - GetPublishedValue(Layer, CellIndex);
+            PublishedMaxThreat[Layer] = FMath::Max(PublishedMaxThreat[Layer], Threat);
+        }
+    }
+
+    PublishedVersion++;
+}
+
+// ========== 坐标转换 ==========
+
+/**
+ * @brief 世界坐标转格子索引
+ * @return 网格外返回 INDEX_NONE
+ */
+int32 USG_InfluenceMapSubsystem::GetCellIndex(const FVector& Location) const
+{
+    const int32 X = FMath::FloorToInt32((Location.X - GridOrigin.X) / CellSize);
+    const int32 Y = FMath::FloorToInt32((Location.Y - GridOrigin.Y) / CellSize);
+
+    if (X < 0 || Y < 0 || X >= GridWidth || Y >= GridHeight)
+    {
+        return INDEX_NONE;
+    }
+    return Y * GridWidth + X;
+}
+
+/**
+ * @brief 格子中心的世界坐标（Z 为 0）
+ */
+FVector USG_InfluenceMapSubsystem::GetCellCenter(int32 CellIndex) const
+{
+    const int32 X = CellIndex % GridWidth;
+    const int32 Y = CellIndex / GridWidth;
+    return FVector(
+        GridOrigin.X + (X + 0.5f) * CellSize,
+        GridOrigin.Y + (Y + 0.5f) * CellSize,
+        0.0f
+    );
+}
+
+// ========== 查询接口 ==========
+
+/**
+ * @brief 获取指定阵营在某位置的势力值
+ */
+float USG_InfluenceMapSubsystem::GetFactionInfluenceAt(FGameplayTag FactionTag, FVector Location) const
+{
+    const USG_UnitRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>() : nullptr;
+    const int32 Layer = Registry ? Registry->FindFactionIndex(FactionTag) : INDEX_NONE;
+    const int32 CellIndex = GetCellIndex(Location);
+
+    if (Layer == INDEX_NONE || Layer >= MaxFactionLayers || CellIndex == INDEX_NONE)
+    {
+        return 0.0f;
+    }
+    return GetPublishedValue(Layer, CellIndex);
+}
+
+/**
+ * @brief 获取某位置对指定阵营的威胁值
+ */
+float USG_InfluenceMapSubsystem::GetThreatAt(FGameplayTag ForFaction, FVector Location) const
+{
+    const int32 CellIndex = GetCellIndex(Location);
+    if (CellIndex == INDEX_NONE)
+    {
+        return 0.0f;
+    }
+
+    const USG_UnitRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>() : nullptr;
+    const int32 OwnLayer = Registry ? Registry->FindFactionIndex(ForFaction) : INDEX_NONE;
+
+    float Threat = 0.0f;
+    for (int32 Layer = 0; Layer < MaxFactionLayers; ++Layer)
+    {
+        if (Layer != OwnLayer)
+        {
+            Threat += GetPublishedValue(Layer, CellIndex);
+        }
+    }
+    return Threat;
+}
+
+/**
+ * @brief 获取归一化威胁值
+ */
+float USG_InfluenceMapSubsystem::GetNormalizedThreatAt(FGameplayTag ForFaction, FVector Location) const
+{
+    const USG_UnitRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>() : nullptr;
+    const int32 OwnLayer = Registry ? Registry->FindFactionIndex(ForFaction) : INDEX_NONE;
+
+    // 未注册的阵营：以所有阵营中的最大值归一化
+    float MaxThreat = 0.0f;
+    if (OwnLayer != INDEX_NONE && OwnLayer < MaxFactionLayers)
+    {
+        MaxThreat = PublishedMaxThreat[OwnLayer];
+    }
+    else
+    {
+        for (int32 Layer = 0; Layer < MaxFactionLayers; ++Layer)
+        {
+            MaxThreat = FMath::Max(MaxThreat, PublishedMaxThreat[Layer]);
+        }
+    }
+
+    if (MaxThreat <= KINDA_SMALL_NUMBER)
+    {
+        return 0.0f;
+    }
+    return FMath::Clamp(GetThreatAt(ForFaction, Location) / MaxThreat, 0.0f, 1.0f);
+}
+
+/**
+ * @brief 在区域内查找指定阵营最薄弱的位置
+ * @details
+ * 功能说明：
+ * - 薄弱度 = 敌方威胁 - 己方势力
+ * - 薄弱度相同时保留先遍历到的格子
+ */
+bool USG_InfluenceMapSubsystem::FindWeakestLocationInBox(FGameplayTag FactionTag, const FBox& Area, FVector& OutLocation) const
+{
+    if (!Area.IsValid || CellCount == 0)
+    {
+        return false;
+    }
+
+    const USG_UnitRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>() : nullptr;
+    const int32 OwnLayer = Registry ? Registry->FindFactionIndex(FactionTag) : INDEX_NONE;
+
+    const int32 MinX = FMath::Clamp(FMath::FloorToInt32((Area.Min.X - GridOrigin.X) / CellSize), 0, GridWidth - 1);
+    const int32 MinY = FMath::Clamp(FMath::FloorToInt32((Area.Min.Y - GridOrigin.Y) / CellSize), 0, GridHeight - 1);
+    const int32 MaxX = FMath::Clamp(FMath::FloorToInt32((Area.Max.X - GridOrigin.X) / CellSize), 0, GridWidth - 1);
+    const int32 MaxY = FMath::Clamp(FMath::FloorToInt32((Area.Max.Y - GridOrigin.Y) / CellSize), 0, GridHeight - 1);
+
+    int32 BestCell = INDEX_NONE;
+    float BestWeakness = -FLT_MAX;
+
+    for (int32 Y = MinY; Y <= MaxY; ++Y)
+    {
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            const int32 CellIndex = Y * GridWidth + X;
+
+            float Threat = 0.0f;
+            float Own = 0.0f;
+            for (int32 Layer = 0; Layer < MaxFactionLayers; ++Layer)
+            {
+                const float Value = GetPublishedValue(Layer, CellIndex);
+                if (Layer == OwnLayer)
+                {
+                    Own += Value;
+                }
+                else
+                {
+                    Threat += Value;
+                }
+            }
+
+            const float Weakness = Threat - Own;
+            if (Weakness > BestWeakness)
+            {
+                BestWeakness = Weakness;
+                BestCell = CellIndex;
+            }
+        }
+    }
+
+    if (BestCell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // 格子中心可能落在区域外，夹回区域内
+    FVector Center = GetCellCenter(BestCell);
+    Center.X = FMath::Clamp(Center.X, Area.Min.X, Area.Max.X);
+    Center.Y = FMath::Clamp(Center.Y, Area.Min.Y, Area.Max.Y);
+    Center.Z = Area.GetCenter().Z;
+
+    OutLocation = Center;
+    return true;
+}
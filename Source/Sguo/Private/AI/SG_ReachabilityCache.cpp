@@ -0,0 +1,257 @@
+// 📄 文件：Source/Sguo/Private/AI/SG_ReachabilityCache.cpp
+// ✨ 新增 - 全局可达性缓存实现
+// ✅ 这是完整文件
+
+#include "AI/SG_ReachabilityCache.h"
+#include "Buildings/SG_MainCityBase.h"
+#include "Units/SG_UnitsBase.h"
+#include "Debug/SG_LogCategories.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ * @details 设置定期清理计时器
+ */
+void USG_ReachabilityCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().SetTimer(
+            CleanupTimerHandle,
+            this,
+            &USG_ReachabilityCache::CleanupExpiredEntries,
+            2.0f,
+            true
+        );
+    }
+
+    UE_LOG(LogSGGameplay, Log, TEXT("✓ 可达性缓存初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_ReachabilityCache::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(CleanupTimerHandle);
+
+        if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+        {
+            NavSys->OnNavigationGenerationFinishedDelegate.Remove(NavGenerationFinishedHandle);
+        }
+    }
+
+    Entries.Empty();
+    CachedNavMesh = nullptr;
+
+    Super::Deinitialize();
+}
+
+/**
+ * @brief 世界开始运行
+ * @details 导航系统此时已创建，绑定重建完成事件并缓存导航网格
+ */
+void USG_ReachabilityCache::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+    {
+        NavGenerationFinishedHandle = NavSys->OnNavigationGenerationFinishedDelegate.AddUObject(
+            this, &USG_ReachabilityCache::OnNavigationGenerationFinished);
+
+        CachedNavMesh = Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate));
+    }
+
+    if (!CachedNavMesh.IsValid())
+    {
+        UE_LOG(LogSGGameplay, Log, TEXT("可达性缓存：未找到 Recast 导航网格，按 %.0f 划分区域"), RegionSize);
+    }
+}
+
+// ========== 查询接口 ==========
+
+/**
+ * @brief 位置转导航区域坐标
+ */
+FIntPoint USG_ReachabilityCache::GetRegion(const FVector& Location) const
+{
+    if (const ARecastNavMesh* NavMesh = CachedNavMesh.Get())
+    {
+        int32 TileX = 0;
+        int32 TileY = 0;
+        if (NavMesh->GetNavMeshTileXY(Location, TileX, TileY))
+        {
+            return FIntPoint(TileX, TileY);
+        }
+    }
+
+    return FIntPoint(
+        FMath::FloorToInt32(Location.X / RegionSize),
+        FMath::FloorToInt32(Location.Y / RegionSize)
+    );
+}
+
+/**
+ * @brief 标记目标从某位置不可达
+ * @param FromLocation 查询者位置
+ * @param Target 目标
+ */
+void USG_ReachabilityCache::MarkUnreachable(const FVector& FromLocation, AActor* Target)
+{
+    UWorld* World = GetWorld();
+    if (!World || !Target)
+    {
+        return;
+    }
+
+    // 主城不标记为不可达
+    if (Target->IsA(ASG_MainCityBase::StaticClass()))
+    {
+        return;
+    }
+
+    FSGReachabilityKey Key;
+    Key.Region = GetRegion(FromLocation);
+    Key.Target = Target;
+
+    Entries.Add(Key, World->GetTimeSeconds() + EntryLifetime);
+
+    UE_LOG(LogSGGameplay, Verbose, TEXT("可达性缓存：区域 %s -> %s 不可达（共 %d 条）"),
+        *Key.Region.ToString(), *Target->GetName(), Entries.Num());
+}
+
+/**
+ * @brief 检查目标从某位置是否已知不可达
+ */
+bool USG_ReachabilityCache::IsUnreachable(const FVector& FromLocation, const AActor* Target) const
+{
+    if (!Target || Entries.Num() == 0)
+    {
+        return false;
+    }
+
+    FSGReachabilityKey Key;
+    Key.Region = GetRegion(FromLocation);
+    Key.Target = const_cast<AActor*>(Target);
+
+    const double* ExpireTime = Entries.Find(Key);
+    return ExpireTime && GetWorld() && *ExpireTime > GetWorld()->GetTimeSeconds();
+}
+
+/**
+ * @brief 清除某导航区域内的所有记录
+ */
+void USG_ReachabilityCache::ClearRegion(const FVector& FromLocation)
+{
+    const FIntPoint Region = GetRegion(FromLocation);
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (It->Key.Region == Region)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/**
+ * @brief 清除某目标的所有记录
+ */
+void USG_ReachabilityCache::ClearTarget(const AActor* Target)
+{
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (It->Key.Target.Get() == Target)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/**
+ * @brief 批量清除本帧死亡单位的记录
+ * @param DeadUnits 死亡单位列表
+ */
+void USG_ReachabilityCache::HandleUnitsDied(const TArray<ASG_UnitsBase*>& DeadUnits)
+{
+    if (DeadUnits.Num() == 0 || Entries.Num() == 0)
+    {
+        return;
+    }
+
+    TSet<const AActor*> DeadSet;
+    DeadSet.Reserve(DeadUnits.Num());
+    for (const ASG_UnitsBase* Unit : DeadUnits)
+    {
+        if (Unit)
+        {
+            DeadSet.Add(Unit);
+        }
+    }
+
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        const AActor* TargetActor = It->Key.Target.Get();
+        if (!TargetActor || DeadSet.Contains(TargetActor))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/**
+ * @brief 清空缓存
+ */
+void USG_ReachabilityCache::InvalidateAll()
+{
+    Entries.Reset();
+}
+
+/**
+ * @brief 清理过期和失效的记录
+ */
+void USG_ReachabilityCache::CleanupExpiredEntries()
+{
+    UWorld* World = GetWorld();
+    if (!World || Entries.Num() == 0)
+    {
+        return;
+    }
+
+    const double Now = World->GetTimeSeconds();
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.Target.IsValid() || It->Value <= Now)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/**
+ * @brief 导航数据生成完成回调
+ * @details 导航网格变化后，之前的不可达结论不再可信
+ */
+void USG_ReachabilityCache::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+    if (ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavData))
+    {
+        CachedNavMesh = NavMesh;
+    }
+
+    if (Entries.Num() > 0)
+    {
+        UE_LOG(LogSGGameplay, Verbose, TEXT("可达性缓存：导航网格重建完成，清除 %d 条记录"), Entries.Num());
+        InvalidateAll();
+    }
+}
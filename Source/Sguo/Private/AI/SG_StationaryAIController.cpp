@@ -1,10 +1,12 @@
 ﻿// 📄 文件：Source/Sguo/Private/AI/SG_StationaryAIController.cpp
-// ✨ 新增 - 站桩单位专用 AI 控制器实现
+// 🔧 修改 - 支持由炮台组管理器统一驱动
 // ✅ 这是完整文件
 
 #include "AI/SG_StationaryAIController.h"
+#include "AI/SG_StationaryBatterySubsystem.h"
 #include "Units/SG_StationaryUnit.h"
 #include "Units/SG_UnitsBase.h"
+#include "Units/SG_DeathEventHub.h"
 #include "AbilitySystem/SG_AttributeSet.h"
 #include "Debug/SG_LogCategories.h"
 #include "Kismet/GameplayStatics.h"
@@ -40,12 +42,42 @@ void ASG_StationaryAIController::OnPossess(APawn* InPawn)
     else
     {
         UE_LOG(LogSGGameplay, Warning, TEXT("[站桩AI] %s 不是站桩单位类型"), *InPawn->GetName());
+        return;
+    }
+
+    // ✨ 新增 - 注册到炮台组，由炮台组统一寻敌和攻击
+    if (UWorld* World = GetWorld())
+    {
+        if (USG_StationaryBatterySubsystem* Battery = World->GetSubsystem<USG_StationaryBatterySubsystem>())
+        {
+            bManagedByBattery = Battery->RegisterTurret(this);
+            if (bManagedByBattery)
+            {
+                SetActorTickEnabled(false);
+            }
+        }
     }
 }
 
 // ========== OnUnPossess ==========
 void ASG_StationaryAIController::OnUnPossess()
 {
+    // ✨ 新增 - 从炮台组注销
+    if (bManagedByBattery)
+    {
+        if (UWorld* World = GetWorld())
+        {
+            if (USG_StationaryBatterySubsystem* Battery = World->GetSubsystem<USG_StationaryBatterySubsystem>())
+            {
+                Battery->UnregisterTurret(this);
+            }
+        }
+        bManagedByBattery = false;
+
+        // 🔧 修改 - 恢复接管时关闭的 Tick，控制器复用或重新附身时回到逐单位逻辑
+        SetActorTickEnabled(true);
+    }
+
     // 解绑目标死亡事件
     if (CurrentListenedTarget.IsValid())
     {
@@ -417,6 +449,17 @@ void ASG_StationaryAIController::OnTargetDeath(ASG_UnitsBase* DeadUnit)
         ControlledStationaryUnit->SetTarget(nullptr);
     }
 
+    // ✨ 新增 - 炮台组管理时不单独检测，由炮台组在下一帧统一分配
+    // 同一帧内多个目标死亡只会触发一次检测
+    if (bManagedByBattery)
+    {
+        if (USG_StationaryBatterySubsystem* Battery = GetWorld() ? GetWorld()->GetSubsystem<USG_StationaryBatterySubsystem>() : nullptr)
+        {
+            Battery->RequestImmediateSweep();
+        }
+        return;
+    }
+
     // 立即查找新目标
     AActor* NewTarget = FindTargetInAttackRange();
     if (NewTarget)
@@ -436,7 +479,11 @@ void ASG_StationaryAIController::BindTargetDeathEvent(ASG_UnitsBase* Target)
         return;
     }
 
-    Target->OnUnitDeathEvent.AddDynamic(this, &ASG_StationaryAIController::OnTargetDeath);
+    // 🔧 修改 - 通过死亡事件中心监听，不再向目标绑定动态委托
+    if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
+    {
+        DeathHub->AddWatcher(Target, this, FSGDeathWatchCallback::CreateUObject(this, &ASG_StationaryAIController::OnTargetDeath));
+    }
 }
 
 /**
@@ -450,5 +497,9 @@ void ASG_StationaryAIController::UnbindTargetDeathEvent(ASG_UnitsBase* Target)
         return;
     }
 
-    Target->OnUnitDeathEvent.RemoveDynamic(this, &ASG_StationaryAIController::OnTargetDeath);
+    // 🔧 修改 - 通过死亡事件中心取消监听
+    if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
+    {
+        DeathHub->RemoveWatcher(Target, this);
+    }
 }
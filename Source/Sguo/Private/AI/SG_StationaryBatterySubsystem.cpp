@@ -0,0 +1,395 @@
+// 📄 文件：Source/Sguo/Private/AI/SG_StationaryBatterySubsystem.cpp
+// ✨ 新增 - 站桩单位炮台组管理器实现
+// ✅ 这是完整文件
+
+#include "AI/SG_StationaryBatterySubsystem.h"
+#include "AI/SG_StationaryAIController.h"
+#include "Units/SG_StationaryUnit.h"
+#include "Units/SG_UnitsBase.h"
+#include "Debug/SG_LogCategories.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_StationaryBatterySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGGameplay, Log, TEXT("✓ 站桩炮台组管理器初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_StationaryBatterySubsystem::Deinitialize()
+{
+    Turrets.Empty();
+    FactionBuckets.Empty();
+
+    Super::Deinitialize();
+}
+
+// ========== 注册接口 ==========
+
+/**
+ * @brief 注册站桩单位
+ * @param Controller 站桩单位的控制器
+ * @return 是否由炮台组接管
+ * @details
+ * 功能说明：
+ * - 记录炮台，并让下一帧立即执行一次寻敌
+ * - 接管后由控制器自行关闭 Tick
+ */
+bool USG_StationaryBatterySubsystem::RegisterTurret(ASG_StationaryAIController* Controller)
+{
+    if (!bEnableBatteryManager || !Controller)
+    {
+        return false;
+    }
+
+    ASG_StationaryUnit* Unit = Cast<ASG_StationaryUnit>(Controller->GetPawn());
+    if (!Unit)
+    {
+        return false;
+    }
+
+    // 避免重复注册
+    for (const FSGBatteryTurret& Turret : Turrets)
+    {
+        if (Turret.Controller.Get() == Controller)
+        {
+            return true;
+        }
+    }
+
+    FSGBatteryTurret& NewTurret = Turrets.AddDefaulted_GetRef();
+    NewTurret.Unit = Unit;
+    NewTurret.Controller = Controller;
+
+    // 新炮台加入后尽快分配目标
+    bSweepRequested = true;
+
+    UE_LOG(LogSGGameplay, Verbose, TEXT("[炮台组] 注册 %s（当前炮台数：%d）"), *Unit->GetName(), Turrets.Num());
+
+    return true;
+}
+
+/**
+ * @brief 注销站桩单位
+ * @param Controller 站桩单位的控制器
+ * @details
+ * 注意事项：
+ * - 注销可能发生在攻击触发过程中（单位在本帧死亡），因此只清空引用，下一帧 Tick 时统一移除
+ */
+void USG_StationaryBatterySubsystem::UnregisterTurret(ASG_StationaryAIController* Controller)
+{
+    if (!Controller)
+    {
+        return;
+    }
+
+    for (FSGBatteryTurret& Turret : Turrets)
+    {
+        if (Turret.Controller.Get() == Controller)
+        {
+            Turret.Controller = nullptr;
+        }
+    }
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧 Tick
+ * @param DeltaTime 帧间隔时间
+ * @details
+ * 详细流程：
+ * 1. 清理失效炮台
+ * 2. 到达间隔或有立即请求时执行批量寻敌
+ * 3. 校验目标并触发攻击
+ */
+void USG_StationaryBatterySubsystem::Tick(float DeltaTime)
+{
+    // 清理失效炮台（单位销毁或已死亡）
+    Turrets.RemoveAllSwap([](const FSGBatteryTurret& Turret)
+    {
+        return !Turret.Unit.IsValid() || !Turret.Controller.IsValid() || Turret.Unit->bIsDead;
+    });
+
+    if (Turrets.Num() == 0)
+    {
+        return;
+    }
+
+    SweepTimer += DeltaTime;
+    if (bSweepRequested || SweepTimer >= SweepInterval)
+    {
+        SweepTimer = 0.0f;
+        bSweepRequested = false;
+        SweepAllBatteries();
+    }
+
+    UpdateTurretAttacks();
+}
+
+// ========== 批量寻敌 ==========
+
+/**
+ * @brief 对所有阵营执行一次批量寻敌
+ * @details 按阵营分组炮台，每个阵营按空间分簇后每簇做一次球形检测
+ */
+void USG_StationaryBatterySubsystem::SweepAllBatteries()
+{
+    // 复用分组数组，只清空内容
+    for (TPair<FGameplayTag, TArray<int32>>& Bucket : FactionBuckets)
+    {
+        Bucket.Value.Reset();
+    }
+
+    for (int32 Index = 0; Index < Turrets.Num(); ++Index)
+    {
+        const FSGBatteryTurret& Turret = Turrets[Index];
+        ASG_StationaryAIController* Controller = Turret.Controller.Get();
+        if (!Controller || !Controller->bAIEnabled)
+        {
+            continue;
+        }
+
+        // 阵营在单位 BeginPlay 时才确定，因此每次寻敌时读取
+        FactionBuckets.FindOrAdd(Turret.Unit->FactionTag).Add(Index);
+    }
+
+    for (const TPair<FGameplayTag, TArray<int32>>& Bucket : FactionBuckets)
+    {
+        if (Bucket.Value.Num() > 0)
+        {
+            SweepBattery(Bucket.Key, Bucket.Value);
+        }
+    }
+}
+
+/**
+ * @brief 对单个阵营的炮台按簇执行球形检测并分配目标
+ * @param FactionTag 阵营标签
+ * @param TurretIndices 该阵营炮台在 Turrets 中的索引
+ * @details
+ * 详细流程：
+ * 1. 计算最大攻击范围，并把需要目标的炮台按边长为最大攻击范围的网格分簇
+ * 2. 每簇以簇包围盒加最大攻击范围为半径做一次球形重叠检测，合并去重后得到敌方候选单位
+ * 3. 统计已有目标的攻击者数量
+ * 4. 为没有目标的炮台选择评分最优的目标（距离 ×（1 + 攻击者数 × 分散系数））
+ * 注意事项：
+ * - 🔧 修改 - 不再用一个球覆盖整个阵营：炮台分散在地图两端时，单个球会把中间的所有单位都检测进来
+ * - 网格边长等于最大攻击范围，每簇检测半径不超过约 2 倍攻击范围
+ */
+void USG_StationaryBatterySubsystem::SweepBattery(const FGameplayTag& FactionTag, const TArray<int32>& TurretIndices)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // ========== 步骤1：计算检测范围 ==========
+    float MaxAttackRange = 0.0f;
+    bool bAnyTurretNeedsTarget = false;
+
+    for (int32 Index : TurretIndices)
+    {
+        const FSGBatteryTurret& Turret = Turrets[Index];
+        ASG_StationaryAIController* Controller = Turret.Controller.Get();
+
+        MaxAttackRange = FMath::Max(MaxAttackRange, Turret.Unit->GetAttackRangeForAI() * Controller->AttackRangeMultiplier);
+
+        if (!Controller->GetCurrentTarget())
+        {
+            bAnyTurretNeedsTarget = true;
+        }
+    }
+
+    // 所有炮台都有目标时不需要检测
+    if (!bAnyTurretNeedsTarget || MaxAttackRange <= 0.0f)
+    {
+        return;
+    }
+
+    // ✨ 新增 - 只有需要目标的炮台参与分簇，按网格坐标合并包围盒
+    TMap<FIntPoint, FBox> ClusterBounds;
+    for (int32 Index : TurretIndices)
+    {
+        if (Turrets[Index].Controller->GetCurrentTarget())
+        {
+            continue;
+        }
+
+        const FVector TurretLocation = Turrets[Index].Unit->GetActorLocation();
+        const FIntPoint Cell(
+            FMath::FloorToInt(TurretLocation.X / MaxAttackRange),
+            FMath::FloorToInt(TurretLocation.Y / MaxAttackRange));
+
+        FBox& Bounds = ClusterBounds.FindOrAdd(Cell, FBox(ForceInit));
+        Bounds += TurretLocation;
+    }
+
+    // ========== 步骤2：每簇一次球形检测 ==========
+    FCollisionQueryParams QueryParams;
+    QueryParams.bTraceComplex = false;
+    QueryParams.bReturnPhysicalMaterial = false;
+
+    FCollisionObjectQueryParams ObjectParams;
+    ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+
+    // 候选目标
+    struct FBatteryCandidate
+    {
+        ASG_UnitsBase* Unit;
+        FVector Location;
+        int32 AttackerCount;
+    };
+    TArray<FBatteryCandidate> Candidates;
+    TMap<AActor*, int32> CandidateIndexMap;
+    TArray<FOverlapResult> Overlaps;
+
+    for (const TPair<FIntPoint, FBox>& Cluster : ClusterBounds)
+    {
+        const FVector SweepCenter = Cluster.Value.GetCenter();
+        const float SweepRadius = Cluster.Value.GetExtent().Size() + MaxAttackRange;
+
+        Overlaps.Reset();
+        World->OverlapMultiByObjectType(
+            Overlaps,
+            SweepCenter,
+            FQuat::Identity,
+            ObjectParams,
+            FCollisionShape::MakeSphere(SweepRadius),
+            QueryParams
+        );
+
+        // 相邻簇的检测范围会重叠，候选目标按 Actor 去重
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            ASG_UnitsBase* TargetUnit = Cast<ASG_UnitsBase>(Overlap.GetActor());
+            if (!TargetUnit || CandidateIndexMap.Contains(TargetUnit))
+            {
+                continue;
+            }
+
+            // 跳过同阵营、死亡和不可选中的单位
+            if (TargetUnit->FactionTag == FactionTag || TargetUnit->bIsDead || !TargetUnit->CanBeTargeted())
+            {
+                continue;
+            }
+
+            CandidateIndexMap.Add(TargetUnit, Candidates.Num());
+            Candidates.Add({ TargetUnit, TargetUnit->GetActorLocation(), 0 });
+        }
+    }
+
+    if (Candidates.Num() == 0)
+    {
+        return;
+    }
+
+    // ========== 步骤3：统计已有目标的攻击者数量 ==========
+    for (int32 Index : TurretIndices)
+    {
+        if (AActor* ExistingTarget = Turrets[Index].Controller->GetCurrentTarget())
+        {
+            if (const int32* CandidateIndex = CandidateIndexMap.Find(ExistingTarget))
+            {
+                Candidates[*CandidateIndex].AttackerCount++;
+            }
+        }
+    }
+
+    // ========== 步骤4：为没有目标的炮台分配目标 ==========
+    int32 AssignedCount = 0;
+
+    for (int32 Index : TurretIndices)
+    {
+        ASG_StationaryAIController* Controller = Turrets[Index].Controller.Get();
+        if (Controller->GetCurrentTarget())
+        {
+            continue;
+        }
+
+        const FVector TurretLocation = Turrets[Index].Unit->GetActorLocation();
+        const float AttackRange = Turrets[Index].Unit->GetAttackRangeForAI() * Controller->AttackRangeMultiplier;
+        const float AttackRangeSq = AttackRange * AttackRange;
+
+        int32 BestIndex = INDEX_NONE;
+        float BestScore = FLT_MAX;
+
+        for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+        {
+            const FBatteryCandidate& Candidate = Candidates[CandidateIndex];
+            const float DistanceSq = FVector::DistSquared(TurretLocation, Candidate.Location);
+            if (DistanceSq > AttackRangeSq)
+            {
+                continue;
+            }
+
+            const float Score = FMath::Sqrt(DistanceSq) * (1.0f + Candidate.AttackerCount * FireSpreadPenalty);
+            if (Score < BestScore)
+            {
+                BestScore = Score;
+                BestIndex = CandidateIndex;
+            }
+        }
+
+        if (BestIndex != INDEX_NONE)
+        {
+            Candidates[BestIndex].AttackerCount++;
+            Controller->SetCurrentTarget(Candidates[BestIndex].Unit);
+            AssignedCount++;
+        }
+    }
+
+    UE_LOG(LogSGGameplay, Verbose, TEXT("[炮台组] 阵营 %s：炮台 %d，检测簇 %d，候选 %d，新分配 %d"),
+        *FactionTag.ToString(), TurretIndices.Num(), ClusterBounds.Num(), Candidates.Num(), AssignedCount);
+}
+
+// ========== 攻击触发 ==========
+
+/**
+ * @brief 每帧更新炮台：校验目标并触发攻击
+ * @details
+ * 功能说明：
+ * - 目标失效或超出范围时清除目标（下次寻敌时重新分配）
+ * - 有目标且启用自动攻击时执行攻击
+ */
+void USG_StationaryBatterySubsystem::UpdateTurretAttacks()
+{
+    for (int32 Index = 0; Index < Turrets.Num(); ++Index)
+    {
+        // 攻击过程中可能有炮台被注销，每次都重新读取
+        ASG_StationaryAIController* Controller = Turrets[Index].Controller.Get();
+        if (!Controller || !Controller->bAIEnabled || !Turrets[Index].Unit.IsValid())
+        {
+            continue;
+        }
+
+        AActor* CurrentTarget = Controller->GetCurrentTarget();
+        if (!CurrentTarget)
+        {
+            continue;
+        }
+
+        if (!Controller->IsTargetValid() || !Controller->IsTargetInAttackRange(CurrentTarget))
+        {
+            Controller->SetCurrentTarget(nullptr);
+            bSweepRequested = true;
+            continue;
+        }
+
+        if (Controller->bAutoAttack)
+        {
+            Controller->PerformAttack();
+        }
+    }
+}
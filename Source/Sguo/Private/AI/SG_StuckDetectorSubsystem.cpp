@@ -0,0 +1,120 @@
+// 📄 文件：Source/Sguo/Private/AI/SG_StuckDetectorSubsystem.cpp
+// ✨ 新增 - 集中式卡住检测实现
+// ✅ 这是完整文件
+
+#include "AI/SG_StuckDetectorSubsystem.h"
+#include "AI/SG_AIControllerBase.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Units/SG_UnitsBase.h"
+#include "Debug/SG_LogCategories.h"
+#include "Engine/World.h"
+
+// 环形缓冲按两个 4 宽向量处理
+static_assert(USG_UnitRegistrySubsystem::SpeedHistoryLength == 8, "卡住检测按 8 个采样向量化，修改长度时需同步修改 EvaluateMovingUnits");
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_StuckDetectorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<USG_UnitRegistrySubsystem>();
+
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGGameplay, Log, TEXT("✓ 卡住检测子系统初始化完成"));
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧 Tick
+ * @param DeltaTime 帧间隔时间
+ */
+void USG_StuckDetectorSubsystem::Tick(float DeltaTime)
+{
+    SampleTimer += DeltaTime;
+    if (SampleTimer < SampleInterval)
+    {
+        return;
+    }
+    SampleTimer = 0.0f;
+
+    EvaluateMovingUnits();
+}
+
+/**
+ * @brief 评估所有移动中的单位，通知卡住的单位
+ * @details
+ * 详细流程：
+ * 1. 为所有移动中的单位写入一次速度采样
+ * 2. 一次遍历：对采样已满的槽位，用向量指令求窗口内最大速度
+ * 3. 最大速度低于该槽位阈值时累加连续低速次数，持续时间达到该槽位的判定时间即判定为卡住
+ * 4. 遍历结束后清空这些槽位的历史并通知控制器（通知可能修改移动掩码，因此不在遍历中进行）
+ */
+void USG_StuckDetectorSubsystem::EvaluateMovingUnits()
+{
+    USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>();
+    if (!Registry)
+    {
+        return;
+    }
+
+    Registry->RecordSpeedSamples();
+
+    const TArray<float>& SpeedHistory = Registry->GetSpeedHistory();
+    const TArray<uint8>& SampleCounts = Registry->GetSpeedSampleCounts();
+    const TArray<float>& SpeedThresholds = Registry->GetStuckSpeedThresholds();
+    const TArray<float>& StuckTimes = Registry->GetStuckTimes();
+    TArray<uint16>& LowSpeedEvaluations = Registry->GetLowSpeedEvaluations();
+
+    // 一个完整窗口覆盖的时长
+    const float WindowDuration = SampleInterval * USG_UnitRegistrySubsystem::SpeedHistoryLength;
+
+    StuckSlots.Reset();
+
+    for (TConstSetBitIterator<> It(Registry->GetMovingMask()); It; ++It)
+    {
+        const int32 SlotIndex = It.GetIndex();
+        if (SampleCounts[SlotIndex] < USG_UnitRegistrySubsystem::SpeedHistoryLength)
+        {
+            continue;
+        }
+
+        const float SlotThreshold = SpeedThresholds[SlotIndex] > 0.0f ? SpeedThresholds[SlotIndex] : StuckSpeedThreshold;
+        const VectorRegister4Float Threshold = VectorSetFloat1(SlotThreshold);
+
+        const float* Row = &SpeedHistory[SlotIndex * USG_UnitRegistrySubsystem::SpeedHistoryLength];
+        const VectorRegister4Float MaxSpeed = VectorMax(VectorLoad(Row), VectorLoad(Row + 4));
+
+        // 四个分量都低于阈值时，窗口内没有任何一次有效移动
+        if (VectorMaskBits(VectorCompareGE(MaxSpeed, Threshold)) != 0)
+        {
+            LowSpeedEvaluations[SlotIndex] = 0;
+            continue;
+        }
+
+        // 窗口每向前滑动一次，低速持续时间增加一个采样间隔
+        const uint16 LowCount = ++LowSpeedEvaluations[SlotIndex];
+        const float LowDuration = WindowDuration + (LowCount - 1) * SampleInterval;
+        if (LowDuration >= StuckTimes[SlotIndex])
+        {
+            StuckSlots.Add(SlotIndex);
+        }
+    }
+
+    for (int32 SlotIndex : StuckSlots)
+    {
+        Registry->ResetSpeedHistory(SlotIndex);
+
+        ASG_UnitsBase* Unit = Registry->GetUnitAt(SlotIndex);
+        ASG_AIControllerBase* Controller = Unit ? Cast<ASG_AIControllerBase>(Unit->GetController()) : nullptr;
+        if (Controller)
+        {
+            UE_LOG(LogSGGameplay, Verbose, TEXT("🚧 卡住检测：%s"), *Unit->GetName());
+            Controller->OnStuckDetected();
+        }
+    }
+}
@@ -6,6 +6,12 @@
 #include "Units/SG_UnitsBase.h"
 #include "Buildings/SG_MainCityBase.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
+#include "Debug/SG_Stats.h"
+// ✨ 新增 - 结构化日志
+#include "Debug/SG_StructuredLog.h"
+#include "AI/SG_InfluenceMapSubsystem.h"
+#include "AI/SG_ReachabilityCache.h"
 #include "Engine/OverlapResult.h"
 #include "Components/BoxComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -233,6 +239,9 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
     TArray<FSGTargetCandidate>& OutCandidates,
     const TSet<TWeakObjectPtr<AActor>>& IgnoredActors)
 {
+    SG_LLM_SCOPE(AI); // ✨ 新增 - LLM 标签
+    SG_SCOPE_CYCLE_COUNTER(FindBestTarget);
+
     OutCandidates.Empty();
 
     if (!Querier)
@@ -247,6 +256,12 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
     TArray<AActor*> NearbyActors;
     PerformSphereQuery(QuerierLocation, SearchRadius, NearbyActors);
 
+    SG_INC_COUNTER(TargetQueries);
+    SG_INC_COUNTER_BY(TargetCandidates, NearbyActors.Num());
+
+    // ✨ 新增 - 全局可达性缓存（已知不可达的目标不再评估）
+    const USG_ReachabilityCache* ReachabilityCache = GetWorld()->GetSubsystem<USG_ReachabilityCache>();
+
     // ========== 步骤2：过滤并评估敌方单位 ==========
     for (AActor* Actor : NearbyActors)
     {
@@ -262,6 +277,12 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
             continue;
         }
 
+        // 检查是否已知不可达
+        if (ReachabilityCache && ReachabilityCache->IsUnreachable(QuerierLocation, Actor))
+        {
+            continue;
+        }
+
         // 检查是否是单位
         ASG_UnitsBase* Unit = Cast<ASG_UnitsBase>(Actor);
         if (!Unit)
@@ -319,9 +340,10 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
 
         AActor* BestTarget = OutCandidates[0].Target.Get();
 
-        UE_LOG(LogSGGameplay, Log, TEXT("🎯 %s 选择敌方单位：%s (距离: %.0f, 攻击者: %d, 评分: %.2f)"),
-            *Querier->GetName(),
-            BestTarget ? *BestTarget->GetName() : TEXT("None"),
+        // 🔧 修改 - 每次查询都会执行，改为结构化日志（写入环形缓冲区，文本只在 Verbose 下输出）
+        SG_LOG_EVENT(LogSGGameplay, Verbose, TargetSelected,
+            Querier,
+            BestTarget,
             OutCandidates[0].Distance,
             OutCandidates[0].AttackerCount,
             OutCandidates[0].Score);
@@ -330,7 +352,8 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
     }
 
     // ========== 步骤4：没有敌方单位，回退到敌方主城 ==========
-    UE_LOG(LogSGGameplay, Log, TEXT("📍 %s 视野内无敌方单位，查找敌方主城..."), *Querier->GetName());
+    // 🔧 修改 - 结构化日志
+    SG_LOG_EVENT(LogSGGameplay, Verbose, TargetSearchCity, Querier);
 
     // 确保主城缓存有效
     if (!bMainCityCacheValid)
@@ -400,9 +423,10 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
 
         OutCandidates.Add(Candidate);
 
-        UE_LOG(LogSGGameplay, Log, TEXT("🏰 %s 回退到敌方主城：%s (距离: %.0f, 攻击者: %d)"),
-            *Querier->GetName(),
-            *NearestEnemyCity->GetName(),
+        // 🔧 修改 - 结构化日志
+        SG_LOG_EVENT(LogSGGameplay, Verbose, TargetFallbackCity,
+            Querier,
+            NearestEnemyCity,
             NearestCityDistance,
             AttackerCount);
 
@@ -410,7 +434,8 @@ AActor* USG_TargetingSubsystem::FindBestTarget(
     }
 
     // 完全没有目标
-    UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ %s 未找到任何敌方目标（单位和主城都没有）"), *Querier->GetName());
+    // 🔧 修改 - 结构化日志
+    SG_LOG_EVENT(LogSGGameplay, Warning, TargetNone, Querier);
     return nullptr;
 }
 
@@ -454,6 +479,9 @@ AActor* USG_TargetingSubsystem::FindEnemyUnitsOnly(
     TArray<FSGTargetCandidate>& OutCandidates,
     const TSet<TWeakObjectPtr<AActor>>& IgnoredActors)
 {
+    SG_LLM_SCOPE(AI); // ✨ 新增 - LLM 标签
+    SG_SCOPE_CYCLE_COUNTER(FindEnemyUnitsOnly);
+
     OutCandidates.Empty();
 
     if (!Querier)
@@ -468,6 +496,11 @@ AActor* USG_TargetingSubsystem::FindEnemyUnitsOnly(
     TArray<AActor*> NearbyActors;
     PerformSphereQuery(QuerierLocation, SearchRadius, NearbyActors);
 
+    SG_INC_COUNTER(TargetQueries);
+    SG_INC_COUNTER_BY(TargetCandidates, NearbyActors.Num());
+
+    const USG_ReachabilityCache* ReachabilityCache = GetWorld()->GetSubsystem<USG_ReachabilityCache>();
+
     // 过滤并评估敌方单位
     for (AActor* Actor : NearbyActors)
     {
@@ -481,6 +514,11 @@ AActor* USG_TargetingSubsystem::FindEnemyUnitsOnly(
             continue;
         }
 
+        if (ReachabilityCache && ReachabilityCache->IsUnreachable(QuerierLocation, Actor))
+        {
+            continue;
+        }
+
         ASG_UnitsBase* Unit = Cast<ASG_UnitsBase>(Actor);
         if (!Unit)
         {
@@ -678,6 +716,15 @@ float USG_TargetingSubsystem::CalculateTargetScore(
     // 最终分
     float FinalScore = BaseScore / PenaltyFactor;
 
+    // ✨ 新增 - 偏好高威胁区域的目标（查询势力图，O(1)）
+    if (ThreatPreferenceWeight > 0.0f)
+    {
+        if (const USG_InfluenceMapSubsystem* InfluenceMap = GetWorld()->GetSubsystem<USG_InfluenceMapSubsystem>())
+        {
+            FinalScore *= 1.0f + ThreatPreferenceWeight * InfluenceMap->GetNormalizedThreatAt(Querier->FactionTag, Target->GetActorLocation());
+        }
+    }
+
     UE_LOG(LogSGGameplay, Verbose, TEXT("  评分计算 [%s]: 距离分=%.2f, 攻击者=%d, 惩罚因子=%.2f, 最终=%.2f"),
         *Target->GetName(), DistanceScore, AttackerCount, PenaltyFactor, FinalScore);
 
@@ -769,6 +816,51 @@ int32 USG_TargetingSubsystem::GetAttackerCount(AActor* Target) const
     return 0;
 }
 
+// ✨ 新增 - 批量死亡处理
+/**
+ * @brief 批量处理本帧死亡的单位
+ * @param DeadUnits 死亡单位列表
+ */
+void USG_TargetingSubsystem::HandleUnitsDied(const TArray<ASG_UnitsBase*>& DeadUnits)
+{
+    if (DeadUnits.Num() == 0 || TargetAttackerMap.Num() == 0)
+    {
+        return;
+    }
+
+    TSet<const AActor*> DeadSet;
+    DeadSet.Reserve(DeadUnits.Num());
+    for (ASG_UnitsBase* Unit : DeadUnits)
+    {
+        if (Unit)
+        {
+            DeadSet.Add(Unit);
+        }
+    }
+
+    for (auto It = TargetAttackerMap.CreateIterator(); It; ++It)
+    {
+        // 目标死亡，移除整个记录
+        const AActor* TargetActor = It.Key().Get();
+        if (!TargetActor || DeadSet.Contains(TargetActor))
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        // 移除死亡的攻击者
+        It.Value().Attackers.RemoveAllSwap([&DeadSet](const TWeakObjectPtr<ASG_UnitsBase>& Ptr)
+        {
+            return !Ptr.IsValid() || DeadSet.Contains(Ptr.Get());
+        });
+
+        if (It.Value().Attackers.Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
 /**
  * @brief 检查目标是否已满
  */
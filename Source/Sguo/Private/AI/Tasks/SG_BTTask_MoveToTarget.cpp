@@ -361,28 +361,11 @@ void USG_BTTask_MoveToTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uint8*
 
     
 
-    // 检测是否卡住
+    // 🔧 修改 - 卡住由 USG_StuckDetectorSubsystem 统一处理（绕行、标记不可达、切换目标）
+    // 这里只在控制器确认卡住后结束任务，让行为树重新寻路
     if (SGAIController && SGAIController->IsStuck())
     {
-        AActor* CurrentTarget = SGAIController->GetCurrentTarget();
-        
-        if (CurrentTarget && CurrentTarget->IsA(ASG_MainCityBase::StaticClass()))
-        {
-            SGAIController->ResetMovementTimer();
-            FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
-            return;
-        }
-        
-        SGAIController->MarkCurrentTargetUnreachable();
-        AIController->StopMovement();
-        
-        AActor* NewTarget = SGAIController->FindNearestReachableTarget();
-        
-        if (NewTarget && NewTarget != CurrentTarget)
-        {
-            SGAIController->SetCurrentTarget(NewTarget);
-        }
-        
+        SGAIController->ResetMovementTimer();
         FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
         return;
     }
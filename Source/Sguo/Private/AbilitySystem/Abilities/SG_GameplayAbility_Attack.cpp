@@ -11,6 +11,8 @@
 #include "AbilitySystem/SG_AttributeSet.h"
 #include "Units/SG_UnitsBase.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_StructuredLog.h" // ✨ 新增 - 结构化日志
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimInstance.h"
 #include "GameplayEffect.h"
@@ -287,6 +289,7 @@ void USG_GameplayAbility_Attack::SpawnProjectileToTarget(AActor* Target, const F
 	SpawnParams.Instigator = Cast<APawn>(AvatarActor);
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	
+	SG_LLM_SCOPE(Projectiles); // ✨ 新增 - LLM 标签
 	ASG_Projectile* NewProjectile = World->SpawnActor<ASG_Projectile>(
 		ProjectileClass,
 		SpawnLocation,
@@ -449,6 +452,7 @@ void USG_GameplayAbility_Attack::OnSpawnProjectileEvent(FGameplayEventData Paylo
     UE_LOG(LogSGGameplay, Warning, TEXT("  生成位置：%s"), *SpawnLocation.ToString());
     UE_LOG(LogSGGameplay, Warning, TEXT("  生成旋转：%s"), *SpawnRotation.ToString());
 
+    SG_LLM_SCOPE(Projectiles); // ✨ 新增 - LLM 标签
     ASG_Projectile* NewProjectile = World->SpawnActor<ASG_Projectile>(
         ProjectileClass,
         SpawnLocation,
@@ -576,6 +580,7 @@ UE_LOG(LogSGGameplay, Log, TEXT("========== 生成投射物（带参数）======
 	SpawnParams.Instigator = Cast<APawn>(AvatarActor);
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	
+	SG_LLM_SCOPE(Projectiles); // ✨ 新增 - LLM 标签
 	ASG_Projectile* NewProjectile = World->SpawnActor<ASG_Projectile>(
 		ProjectileClass,
 		SpawnLocation,
@@ -982,7 +987,7 @@ int32 USG_GameplayAbility_Attack::FindTargetsInRange(TArray<AActor*>& OutTargets
 					if (TargetUnit && TargetUnit->FactionTag != MyFaction)
 					{
 						OutTargets.AddUnique(HitActor);
-						UE_LOG(LogSGGameplay, Verbose, TEXT("    找到敌方单位：%s"), *HitActor->GetName());
+						SG_LOG_EVENT(LogSGGameplay, Verbose, AttackUnitFound, AvatarActor, HitActor); // 🔧 修改 - 结构化日志
 						continue;
 					}
 
@@ -1011,15 +1016,13 @@ int32 USG_GameplayAbility_Attack::FindTargetsInRange(TArray<AActor*>& OutTargets
 								if (DistanceToSurface <= AttackRange)
 								{
 									OutTargets.AddUnique(MainCity);
-									UE_LOG(LogSGGameplay, Log, TEXT("    找到敌方主城（通过攻击检测盒）：%s"), 
-										*MainCity->GetName());
-									UE_LOG(LogSGGameplay, Log, TEXT("      到表面距离：%.2f / 攻击范围：%.2f"), 
-										DistanceToSurface, AttackRange);
+									// 🔧 修改 - 结构化日志
+									SG_LOG_EVENT(LogSGGameplay, Verbose, AttackCityHit, AvatarActor, MainCity, DistanceToSurface, AttackRange);
 								}
 								else
 								{
-									UE_LOG(LogSGGameplay, Warning, TEXT("    检测到主城但距离不足：%.2f > %.2f"), 
-										DistanceToSurface, AttackRange);
+									// 🔧 修改 - 结构化日志
+									SG_LOG_EVENT(LogSGGameplay, Verbose, AttackCityOutOfRange, AvatarActor, MainCity, DistanceToSurface, AttackRange);
 								}
 								
 								continue;
@@ -1061,7 +1064,7 @@ int32 USG_GameplayAbility_Attack::FindTargetsInRange(TArray<AActor*>& OutTargets
 					if (TargetUnit && TargetUnit->FactionTag != MyFaction)
 					{
 						OutTargets.AddUnique(HitActor);
-						UE_LOG(LogSGGameplay, Verbose, TEXT("    找到敌方单位：%s"), *HitActor->GetName());
+						SG_LOG_EVENT(LogSGGameplay, Verbose, AttackUnitFound, AvatarActor, HitActor); // 🔧 修改 - 结构化日志
 					}
 					
 					// ========== 🔧 修复 - 检查是否是主城的攻击检测盒 ==========
@@ -1089,15 +1092,13 @@ int32 USG_GameplayAbility_Attack::FindTargetsInRange(TArray<AActor*>& OutTargets
 								if (DistanceToSurface <= AttackRange)
 								{
 									OutTargets.AddUnique(MainCity);
-									UE_LOG(LogSGGameplay, Log, TEXT("    找到敌方主城（通过攻击检测盒）：%s"), 
-										*MainCity->GetName());
-									UE_LOG(LogSGGameplay, Log, TEXT("      到表面距离：%.2f / 攻击范围：%.2f"), 
-										DistanceToSurface, AttackRange);
+									// 🔧 修改 - 结构化日志
+									SG_LOG_EVENT(LogSGGameplay, Verbose, AttackCityHit, AvatarActor, MainCity, DistanceToSurface, AttackRange);
 								}
 								else
 								{
-									UE_LOG(LogSGGameplay, Warning, TEXT("    检测到主城但距离不足：%.2f > %.2f"), 
-										DistanceToSurface, AttackRange);
+									// 🔧 修改 - 结构化日志
+									SG_LOG_EVENT(LogSGGameplay, Verbose, AttackCityOutOfRange, AvatarActor, MainCity, DistanceToSurface, AttackRange);
 								}
 							}
 						}
@@ -1327,6 +1328,7 @@ void USG_GameplayAbility_Attack::SpawnProjectileWithArc(AActor* Target, const FV
 	SpawnParams.Instigator = Cast<APawn>(AvatarActor);
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	
+	SG_LLM_SCOPE(Projectiles); // ✨ 新增 - LLM 标签
 	ASG_Projectile* NewProjectile = World->SpawnActor<ASG_Projectile>(
 		ProjectileClass,
 		SpawnLocation,
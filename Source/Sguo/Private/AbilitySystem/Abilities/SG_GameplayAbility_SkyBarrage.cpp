@@ -10,6 +10,8 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "Data/Type/SG_UnitDataTable.h"
+#include "Game/SG_HeightfieldSubsystem.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
 
 USG_GameplayAbility_SkyBarrage::USG_GameplayAbility_SkyBarrage()
 {
@@ -231,12 +233,14 @@ void USG_GameplayAbility_SkyBarrage::StartBarrageLoop()
     // ... (目标位置计算保持不变) ...
     CachedTargetCenter = OwnerLoc + (Forward * TargetDistance);
     
-    FHitResult HitResult;
-    FVector TraceStart = CachedTargetCenter + FVector(0, 0, 1000);
-    FVector TraceEnd = CachedTargetCenter - FVector(0, 0, 1000);
-    if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic))
+    // 🔧 修改 - 落点地面高度查询高度图缓存
+    if (USG_HeightfieldSubsystem* Heightfield = GetWorld()->GetSubsystem<USG_HeightfieldSubsystem>())
     {
-        CachedTargetCenter = HitResult.Location;
+        FVector GroundLocation;
+        if (Heightfield->FindGroundLocation(CachedTargetCenter, 1000.0f, 1000.0f, GroundLocation, ECC_WorldStatic))
+        {
+            CachedTargetCenter = GroundLocation;
+        }
     }
 
     // ========== 🔧 修复开始 ==========
@@ -345,6 +349,7 @@ void USG_GameplayAbility_SkyBarrage::SpawnProjectileLoop()
     // 🔧 修改 - 显式设置 Owner，确保 Projectile 的 GetOwner() 有值（虽已修复 Projectile 使用 GetInstigator，但这仍是好习惯）
     SpawnParams.Owner = GetAvatarActorFromActorInfo();
 
+    SG_LLM_SCOPE(Projectiles); // ✨ 新增 - LLM 标签
     ASG_Projectile* NewProjectile = GetWorld()->SpawnActor<ASG_Projectile>(
         ProjectileClass,
         SpawnLoc,
@@ -3,6 +3,7 @@
 
 #include "AbilitySystem/Abilities/SG_GameplayAbility_SummonGroup.h"
 #include "Units/SG_UnitsBase.h"
+#include "Units/SG_SpawnSchedulerSubsystem.h"
 #include "GameFramework/Character.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
@@ -32,6 +33,9 @@ void USG_GameplayAbility_SummonGroup::ActivateAbility(
 {
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
+    bSpawnPending = false;
+    bEndAfterSpawn = false;
+
     if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
     {
         EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
@@ -61,9 +65,9 @@ void USG_GameplayAbility_SummonGroup::ActivateAbility(
         // 延迟结束能力
         FTimerHandle TimerHandle;
         FTimerDelegate TimerDelegate;
-        TimerDelegate.BindLambda([this, Handle, ActorInfo, ActivationInfo]()
+        TimerDelegate.BindWeakLambda(this, [this]()
         {
-            EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+            FinishSummon(false);
         });
         ActorInfo->AvatarActor->GetWorldTimerManager().SetTimer(TimerHandle, TimerDelegate, 0.5f, false);
         return;
@@ -144,7 +148,7 @@ void USG_GameplayAbility_SummonGroup::OnMontageCompleted()
         }
     }
     
-    EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+    FinishSummon(false);
 }
 
 // ✨ 新增 - 处理动画被取消/打断
@@ -159,7 +163,51 @@ void USG_GameplayAbility_SummonGroup::OnMontageCancelled()
         }
     }
     
-    EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, true);
+    FinishSummon(true);
+}
+
+/**
+ * @brief 结束召唤能力
+ * @param bWasCancelled 是否被打断
+ * @details 被打断时立即结束（已提交的单位照常生成）；正常结束时等待分帧生成完成
+ */
+void USG_GameplayAbility_SummonGroup::FinishSummon(bool bWasCancelled)
+{
+    if (!IsActive())
+    {
+        return;
+    }
+
+    if (bSpawnPending && !bWasCancelled)
+    {
+        bEndAfterSpawn = true;
+        return;
+    }
+
+    EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, bWasCancelled);
+}
+
+/**
+ * @brief 召唤单位生成完成
+ * @param SpawnedUnits 本次召唤生成的单位
+ * @param SpawnSerial 提交时的序号
+ */
+void USG_GameplayAbility_SummonGroup::OnSummonSpawnCompleted(const TArray<ASG_UnitsBase*>& SpawnedUnits, int32 SpawnSerial)
+{
+    UE_LOG(LogTemp, Log, TEXT("SummonGroup: 召唤完成，生成 %d 个单位"), SpawnedUnits.Num());
+    K2_OnUnitsSummoned(SpawnedUnits);
+
+    if (SpawnSerial != CurrentSpawnSerial)
+    {
+        return;
+    }
+
+    bSpawnPending = false;
+    if (bEndAfterSpawn)
+    {
+        bEndAfterSpawn = false;
+        FinishSummon(false);
+    }
 }
 
 void USG_GameplayAbility_SummonGroup::OnSpawnEventReceived(FGameplayEventData Payload)
@@ -254,6 +302,17 @@ void USG_GameplayAbility_SummonGroup::ExecuteSpawn()
         break;
     }
 
+    // 🔧 修改 - 召唤单位交给分帧生成调度器，地面吸附在真正生成时进行
+    FSGFormationSpawnRequest Request;
+    Request.FactionTag = OwnerUnit ? OwnerUnit->FactionTag : FGameplayTag();
+    Request.SpawnOwner = OwnerCharacter;
+    Request.SpawnInstigator = OwnerCharacter;
+    Request.bSnapToGround = true;
+    Request.GroundTraceUp = 500.0f;
+    Request.GroundTraceDown = 500.0f;
+    Request.GroundZOffset = 10.0f;
+    Request.Slots.Reserve(SpawnCount);
+
     for (int32 i = 0; i < SpawnCount; i++)
     {
         TSubclassOf<ASG_UnitsBase> SpawnClass = GetRandomUnitClass();
@@ -267,31 +326,21 @@ void USG_GameplayAbility_SummonGroup::ExecuteSpawn()
             SpawnLoc.Y += FMath::FRandRange(-SpawnRandomRange, SpawnRandomRange);
         }
 
-        FHitResult HitResult;
-        FVector TraceStart = SpawnLoc + FVector(0, 0, 500);
-        FVector TraceEnd = SpawnLoc - FVector(0, 0, 500);
-        if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic))
-        {
-            SpawnLoc.Z = HitResult.Location.Z + 10.0f;
-        }
-
         FRotator SpawnRot = CalculateSpawnRotation(SpawnLoc, FormationCenter, OwnerRotation);
 
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-        
-        ASG_UnitsBase* NewUnit = GetWorld()->SpawnActor<ASG_UnitsBase>(
-            SpawnClass, 
-            SpawnLoc, 
-            SpawnRot, 
-            SpawnParams
-        );
-
-        if (NewUnit && OwnerUnit)
-        {
-            NewUnit->InitializeCharacter(OwnerUnit->FactionTag);
-            NewUnit->SpawnDefaultController();
-        }
+        FSGFormationSpawnSlot& Slot = Request.Slots.AddDefaulted_GetRef();
+        Slot.UnitClass = SpawnClass;
+        Slot.Transform = FTransform(SpawnRot, SpawnLoc);
+    }
+
+    if (Request.Slots.Num() == 0) return;
+
+    if (USG_SpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<USG_SpawnSchedulerSubsystem>())
+    {
+        // 生成完成时通知蓝图，并在动画已结束时结束能力
+        bSpawnPending = true;
+        Scheduler->EnqueueFormation(Request, FSGSpawnRequestCallback::CreateUObject(
+            this, &USG_GameplayAbility_SummonGroup::OnSummonSpawnCompleted, ++CurrentSpawnSerial));
     }
 }
 
@@ -6,6 +6,8 @@
 #include "AbilitySystem/SG_AbilitySystemComponent.h"
 #include "Buildings/SG_BuildingAttributeSet.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Trace.h"
+#include "Debug/SG_StructuredLog.h" // ✨ 新增 - 结构化日志
 
 // ========== 属性捕获结构体 ==========
 // 用于声明需要捕获哪些属性
@@ -50,9 +52,6 @@ void USG_DamageExecutionCalc::Execute_Implementation(
 	OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput
 ) const
 {
-	// 输出日志：开始伤害计算
-	UE_LOG(LogSGGameplay, Verbose, TEXT("========== 伤害计算开始 =========="));
-
 	// 获取 Source（攻击者）和 Target（被攻击者）的 ASC
 	UAbilitySystemComponent* SourceASC = ExecutionParams.GetSourceAbilitySystemComponent();
 	UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
@@ -79,10 +78,6 @@ void USG_DamageExecutionCalc::Execute_Implementation(
 		AttackDamage
 	);
 
-	// 输出日志：攻击者信息
-	UE_LOG(LogSGGameplay, Verbose, TEXT("  攻击者：%s"), SourceActor ? *SourceActor->GetName() : TEXT("None"));
-	UE_LOG(LogSGGameplay, Verbose, TEXT("  攻击力：%.1f"), AttackDamage);
-
 	// ========== 步骤2：读取伤害倍率 ==========
 	
 	// 从 SetByCaller 读取伤害倍率
@@ -91,17 +86,15 @@ void USG_DamageExecutionCalc::Execute_Implementation(
 	const FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
 	float DamageMultiplier = Spec.GetSetByCallerMagnitude(DamageTag, false, 1.0f);
 
-	// 输出日志：伤害倍率
-	UE_LOG(LogSGGameplay, Verbose, TEXT("  伤害倍率：%.2f"), DamageMultiplier);
-
 	// ========== 步骤3：计算最终伤害 ==========
 	
 	// 计算公式：最终伤害 = 攻击力 * 伤害倍率
 	float FinalDamage = AttackDamage * DamageMultiplier;
 
-	// 输出日志：被攻击者和最终伤害
-	UE_LOG(LogSGGameplay, Verbose, TEXT("  被攻击者：%s"), TargetActor ? *TargetActor->GetName() : TEXT("None"));
-	UE_LOG(LogSGGameplay, Verbose, TEXT("  最终伤害：%.1f"), FinalDamage);
+	// 🔧 修改 - 原先 6 条 Verbose 文本合并为一条结构化日志（每次命中都会执行）
+	SG_LOG_EVENT(LogSGGameplay, Verbose, DamageComputed, SourceActor, TargetActor, AttackDamage, DamageMultiplier, FinalDamage);
+
+	SG_TRACE_EVENT(Damage, SourceActor, TargetActor, FinalDamage);
 
 	// ========== 步骤4：应用伤害到 Target ==========
 	
@@ -139,15 +132,12 @@ void USG_DamageExecutionCalc::Execute_Implementation(
 			)
 		);
 
-		// 输出日志：伤害已应用
-		UE_LOG(LogSGGameplay, Log, TEXT("  ✓ 伤害已应用到 IncomingDamage"));
+		// 🔧 修改 - 每次命中都会执行，降为 Verbose
+		UE_LOG(LogSGGameplay, Verbose, TEXT("  ✓ 伤害已应用到 IncomingDamage"));
 	}
 	else
 	{
 		// 输出日志：无伤害
 		UE_LOG(LogSGGameplay, Warning, TEXT("  ⚠️ 最终伤害为0，未应用"));
 	}
-
-	// 输出日志：伤害计算结束
-	UE_LOG(LogSGGameplay, Verbose, TEXT("========================================"));	
 }
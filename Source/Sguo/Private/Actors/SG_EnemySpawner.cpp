@@ -8,12 +8,31 @@
 #include "Data/SG_CharacterCardData.h"
 #include "Data/SG_CardDataBase.h" // 确保包含基类
 #include "Units/SG_UnitsBase.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Units/SG_SpawnSchedulerSubsystem.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
 #include "Kismet/GameplayStatics.h"
+#include "AI/SG_InfluenceMapSubsystem.h"
+#include "Debug/SG_ReplaySubsystem.h" // ✨ 新增 - 对局录像
+#include "AssetManger/SG_AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+namespace
+{
+    // ✨ 新增 - 使用生成器自己的随机流取点（对局录像需要可复现）
+    FVector RandomPointInBox(const FRandomStream& Stream, const FVector& Center, const FVector& Extent)
+    {
+        return Center + FVector(
+            Stream.FRandRange(-Extent.X, Extent.X),
+            Stream.FRandRange(-Extent.Y, Extent.Y),
+            Stream.FRandRange(-Extent.Z, Extent.Z));
+    }
+}
 
 ASG_EnemySpawner::ASG_EnemySpawner()
 {
@@ -47,10 +66,19 @@ void ASG_EnemySpawner::BeginPlay()
 
     // 初始化随机种子 (使用时间戳)
     RandomStream.GenerateNewSeed();
+
+    // ✨ 新增 - 对局录制 / 回放时使用从对局种子派生的种子
+    const USG_ReplaySubsystem* Replay = GetWorld()->GetSubsystem<USG_ReplaySubsystem>();
+    int32 ReplaySeed = 0;
+    if (Replay && Replay->ResolveStreamSeed(GetFName(), ReplaySeed))
+    {
+        RandomStream.Initialize(ReplaySeed);
+    }
     
     // ✨ 查找关联主城
     FindRelatedMainCity();
-    if (bAutoStart)
+    // 🔧 修改 - 回放时波次由录像驱动，不自行计时生成
+    if (bAutoStart && !(Replay && Replay->IsPlaying()))
     {
         StartSpawning();
     }
@@ -59,6 +87,14 @@ void ASG_EnemySpawner::BeginPlay()
 void ASG_EnemySpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     StopSpawning();
+
+    // ✨ 新增 - 释放生成池的资产包
+    if (SpawnPoolAssetHandle.IsValid())
+    {
+        SpawnPoolAssetHandle->CancelHandle();
+        SpawnPoolAssetHandle.Reset();
+    }
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -118,6 +154,7 @@ void ASG_EnemySpawner::StopSpawning()
 void ASG_EnemySpawner::InitializeSpawnPool()
 {
     SpawnPool.Empty();
+    SpawnPoolCards.Empty();
     ConsumedUniqueCards.Empty();
 
     if (!DeckConfig) return;
@@ -143,6 +180,22 @@ void ASG_EnemySpawner::InitializeSpawnPool()
         Slot.MaxOccurrences = ConfigSlot.MaxOccurrences; 
         
         SpawnPool.Add(Slot);
+        SpawnPoolCards.Add(CardAsset);
+    }
+
+    // ✨ 新增 - 构建权重采样器
+    SpawnPoolSampler.Build(SpawnPool, ConsumedUniqueCards);
+
+    // ✨ 新增 - 异步加载生成池卡牌的 Gameplay 资产包（角色类），首次生成前通常已完成
+    if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
+    {
+        TArray<FPrimaryAssetId> CardIds;
+        CardIds.Reserve(SpawnPool.Num());
+        for (const FSGCardDrawSlot& Slot : SpawnPool)
+        {
+            CardIds.Add(Slot.CardId);
+        }
+        SpawnPoolAssetHandle = AssetManager->LoadCardGameplayBundles(CardIds);
     }
 }
 
@@ -238,88 +291,52 @@ bool ASG_EnemySpawner::SpawnNextWave()
     
     UE_LOG(LogSGGameplay, Log, TEXT("  SpawnNextWave: 生成位置 %s"), *SpawnLocation.ToString());
 
+    // ✨ 新增 - 对局录像
+    if (USG_ReplaySubsystem* Replay = GetWorld()->GetSubsystem<USG_ReplaySubsystem>())
+    {
+        Replay->RecordSpawnerWave(this, SelectedCard->GetPrimaryAssetId(), SpawnLocation);
+    }
+
     // 生成单位（处理兵团逻辑）
     SpawnUnit(SelectedCard, SpawnLocation);
 
     return true;
 }
 
-USG_CardDataBase* ASG_EnemySpawner::DrawCardFromPool()
+// ✨ 新增 - 指定卡牌和位置生成
+bool ASG_EnemySpawner::SpawnCardAt(USG_CardDataBase* CardData, const FVector& Location)
 {
-    // 1. 过滤有效槽位
-    TArray<FSGCardDrawSlot*> ValidSlots;
-    float TotalWeight = 0.0f;
-
-    for (FSGCardDrawSlot& Slot : SpawnPool)
+    if (!Cast<USG_CharacterCardData>(CardData))
     {
-        // 检查唯一卡是否已消耗
-        if (ConsumedUniqueCards.Contains(Slot.CardId)) continue;
-        
-        // 检查单卡最大生成次数
-        if (Slot.MaxOccurrences > 0 && Slot.OccurrenceCount >= Slot.MaxOccurrences) continue;
-
-        // 检查权重
-        if (Slot.DrawWeight <= 0.0f) continue;
-
-        ValidSlots.Add(&Slot);
-        TotalWeight += Slot.GetEffectiveWeight();
+        UE_LOG(LogSGGameplay, Warning, TEXT("  SpawnCardAt: %s 不是角色卡"), CardData ? *CardData->GetName() : TEXT("None"));
+        return false;
     }
 
-    if (ValidSlots.Num() == 0) return nullptr;
-
-    // 2. 轮盘赌选择
-    float RandomValue = RandomStream.FRandRange(0.0f, TotalWeight);
-    float CurrentWeight = 0.0f;
-    FSGCardDrawSlot* SelectedSlot = nullptr;
+    SpawnUnit(CardData, Location);
+    return true;
+}
 
-    for (FSGCardDrawSlot* Slot : ValidSlots)
+USG_CardDataBase* ASG_EnemySpawner::DrawCardFromPool()
+{
+    // 🔧 修改 - 通过权重采样器抽取（已消耗唯一卡、达到最大次数、权重为 0 的槽位不参与）
+    if (!SpawnPoolSampler.IsBuiltFor(SpawnPool))
     {
-        CurrentWeight += Slot->GetEffectiveWeight();
-        if (RandomValue <= CurrentWeight)
-        {
-            SelectedSlot = Slot;
-            break;
-        }
+        SpawnPoolSampler.Build(SpawnPool, ConsumedUniqueCards);
     }
 
-    if (!SelectedSlot) SelectedSlot = ValidSlots.Last();
+    const int32 SelectedIndex = SpawnPoolSampler.Draw(RandomStream);
+    if (SelectedIndex == INDEX_NONE || !SpawnPoolCards.IsValidIndex(SelectedIndex)) return nullptr;
 
-    // 3. 更新保底和计数
-    for (FSGCardDrawSlot* Slot : ValidSlots)
-    {
-        if (Slot == SelectedSlot)
-        {
-            Slot->MissCount = 0;
-            Slot->OccurrenceCount++;
-        }
-        else
-        {
-            Slot->MissCount++;
-        }
-    }
+    // 卡牌数据在构建生成池时已加载
+    USG_CardDataBase* Card = SpawnPoolCards[SelectedIndex];
 
-    // 4. 获取资源 (修复部分)
-    // 我们需要从 DeckConfig 中找到对应的 SoftPtr 并加载
-    for (const FSGCardConfigSlot& ConfigSlot : DeckConfig->AllowedCards)
+    // 处理唯一卡逻辑
+    if (Card && Card->bIsUnique)
     {
-        // 🔧 修改 - 使用资产名称进行匹配
-        // TSoftObjectPtr::GetAssetName() 返回资产名称字符串 (FString)
-        // FPrimaryAssetId::PrimaryAssetName 是 FName
-        if (FName(*ConfigSlot.CardData.GetAssetName()) == SelectedSlot->CardId.PrimaryAssetName)
-        {
-            // 同步加载卡牌数据
-            USG_CardDataBase* Card = ConfigSlot.CardData.LoadSynchronous();
-             
-            // 处理唯一卡逻辑
-            if (Card && Card->bIsUnique)
-            {
-                ConsumedUniqueCards.Add(SelectedSlot->CardId);
-            }
-            return Card;
-        }
+        ConsumedUniqueCards.Add(SpawnPool[SelectedIndex].CardId);
+        SpawnPoolSampler.ExcludeCard(SpawnPool[SelectedIndex].CardId);
     }
-
-    return nullptr;
+    return Card;
 }
 
 float ASG_EnemySpawner::GetNextSpawnInterval() const
@@ -333,7 +350,8 @@ float ASG_EnemySpawner::GetNextSpawnInterval() const
         return FixedSpawnInterval;
         
     case ESGSpawnIntervalMethod::RandomInterval:
-        return FMath::RandRange(MinSpawnInterval, MaxSpawnInterval);
+        // 🔧 修改 - 使用生成器的随机流，便于对局录像复现
+        return RandomStream.FRandRange(MinSpawnInterval, MaxSpawnInterval);
         
     default:
         return 2.0f;
@@ -342,18 +360,43 @@ float ASG_EnemySpawner::GetNextSpawnInterval() const
 
 void ASG_EnemySpawner::SpawnUnit(USG_CardDataBase* CardData, const FVector& CenterLocation)
 {
+    SG_SCOPE_CYCLE_COUNTER(EnemySpawnUnit);
+
   USG_CharacterCardData* CharCard = Cast<USG_CharacterCardData>(CardData);
-    if (!CharCard || !CharCard->CharacterClass) return;
+    if (!CharCard) return;
+
+    // 🔧 修改 - 角色类为软引用，生成池初始化时已请求异步加载，这里通常直接返回已加载的类
+    UClass* CharacterClass = CharCard->CharacterClass.LoadSynchronous();
+    if (!CharacterClass) return;
 
     // 🔧 关键修改：获取胶囊体半高
     float CapsuleHalfHeight = 88.0f;
-    ACharacter* CharCDO = Cast<ACharacter>(CharCard->CharacterClass->GetDefaultObject());
+    ACharacter* CharCDO = Cast<ACharacter>(CharacterClass->GetDefaultObject());
     if (CharCDO && CharCDO->GetCapsuleComponent())
     {
         CapsuleHalfHeight = CharCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
     }
     float SpawnZOffset = CapsuleHalfHeight + 2.0f;
 
+    // ✨ 新增 - 单位对象池
+    const TSubclassOf<ASG_UnitsBase> UnitClass(CharacterClass);
+    USG_UnitPoolSubsystem* UnitPool = GetWorld()->GetSubsystem<USG_UnitPoolSubsystem>();
+    if (!UnitClass)
+    {
+        UE_LOG(LogSGGameplay, Warning, TEXT("❌ 敌人生成器：%s 的角色类不是 ASG_UnitsBase"), *CharCard->GetName());
+        return;
+    }
+
+    // 🔧 修改 - 生成位置交给分帧生成调度器，地面吸附在真正生成时进行
+    FSGFormationSpawnRequest Request;
+    Request.CardData = CharCard;
+    Request.FactionTag = FactionTag;
+    Request.SpawnOwner = this;
+    Request.bSnapToGround = true;
+    Request.GroundTraceUp = 500.0f;
+    Request.GroundTraceDown = 1000.0f;
+    Request.GroundZOffset = SpawnZOffset;
+
     // 检查是否是兵团
     if (CharCard->bIsTroopCard)
     {
@@ -367,6 +410,7 @@ void ASG_EnemySpawner::SpawnUnit(USG_CardDataBase* CardData, const FVector& Cent
             0.0f
         );
 
+        Request.Slots.Reserve(Rows * Cols);
         for (int32 Row = 0; Row < Rows; ++Row)
         {
             for (int32 Col = 0; Col < Cols; ++Col)
@@ -375,70 +419,32 @@ void ASG_EnemySpawner::SpawnUnit(USG_CardDataBase* CardData, const FVector& Cent
                 FVector RotatedOffset = SpawnRotation.RotateVector(StartOffset + UnitOffset);
                 FVector FinalLoc = CenterLocation + RotatedOffset;
 
-                // 地面吸附逻辑
-                FHitResult HitResult;
-                FVector TraceStart = FinalLoc + FVector(0, 0, 500.0f);
-                FVector TraceEnd = FinalLoc - FVector(0, 0, 1000.0f);
-                FCollisionQueryParams QueryParams;
-                QueryParams.AddIgnoredActor(this);
-
-                if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
-                {
-                    // 🔧 使用动态计算的高度
-                    FinalLoc = HitResult.Location + FVector(0.0f, 0.0f, SpawnZOffset);
-                }
-
-                FTransform SpawnTransform(SpawnRotation, FinalLoc);
-                ASG_UnitsBase* NewUnit = GetWorld()->SpawnActorDeferred<ASG_UnitsBase>(
-                    CharCard->CharacterClass,
-                    SpawnTransform,
-                    this,
-                    nullptr,
-                    ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn
-                );
-
-                if (NewUnit)
-                {
-                    NewUnit->SetSourceCardData(CharCard);
-                    NewUnit->FactionTag = FactionTag;
-                    NewUnit->FinishSpawning(SpawnTransform);
-                    CurrentSpawnCount++;
-                }
+                FSGFormationSpawnSlot& Slot = Request.Slots.AddDefaulted_GetRef();
+                Slot.UnitClass = UnitClass;
+                Slot.Transform = FTransform(SpawnRotation, FinalLoc);
             }
         }
     }
     else
     {
         // 生成单个英雄
-        FVector FinalLoc = CenterLocation;
-
-        FHitResult HitResult;
-        FVector TraceStart = FinalLoc + FVector(0, 0, 500.0f);
-        FVector TraceEnd = FinalLoc - FVector(0, 0, 1000.0f);
-        FCollisionQueryParams QueryParams;
-        QueryParams.AddIgnoredActor(this);
-
-        if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
-        {
-            // 🔧 使用动态计算的高度
-            FinalLoc = HitResult.Location + FVector(0.0f, 0.0f, SpawnZOffset);
-        }
+        FSGFormationSpawnSlot& Slot = Request.Slots.AddDefaulted_GetRef();
+        Slot.UnitClass = UnitClass;
+        Slot.Transform = FTransform(SpawnRotation, CenterLocation);
+    }
 
-        FTransform SpawnTransform(SpawnRotation, FinalLoc);
-        ASG_UnitsBase* NewUnit = GetWorld()->SpawnActorDeferred<ASG_UnitsBase>(
-            CharCard->CharacterClass,
-            SpawnTransform,
-            this,
-            nullptr,
-            ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn
-        );
+    // 提交时即计入生成数量，避免队列中的单位让生成器超出上限
+    CurrentSpawnCount += Request.Slots.Num();
 
-        if (NewUnit)
+    if (USG_SpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<USG_SpawnSchedulerSubsystem>())
+    {
+        Scheduler->EnqueueFormation(Request);
+    }
+    else if (UnitPool)
+    {
+        for (const FSGFormationSpawnSlot& Slot : Request.Slots)
         {
-            NewUnit->SetSourceCardData(CharCard);
-            NewUnit->FactionTag = FactionTag;
-            NewUnit->FinishSpawning(SpawnTransform);
-            CurrentSpawnCount++;
+            UnitPool->AcquireUnit(Slot.UnitClass, Slot.Transform, CharCard, FactionTag, this);
         }
     }
 }
@@ -447,7 +453,23 @@ FVector ASG_EnemySpawner::GetRandomSpawnLocation() const
 {
     FVector Origin = SpawnAreaBox->GetComponentLocation();
     FVector BoxExtent = SpawnAreaBox->GetScaledBoxExtent();
-    return UKismetMathLibrary::RandomPointInBoundingBox(Origin, BoxExtent);
+
+    // ✨ 新增 - 查询势力图，在最薄弱的格子内随机生成
+    if (bReinforceWeakSections)
+    {
+        const USG_InfluenceMapSubsystem* InfluenceMap = GetWorld()->GetSubsystem<USG_InfluenceMapSubsystem>();
+        FVector WeakestLocation;
+        if (InfluenceMap && InfluenceMap->GetPublishedVersion() > 0
+            && InfluenceMap->FindWeakestLocationInBox(FactionTag, FBox(Origin - BoxExtent, Origin + BoxExtent), WeakestLocation))
+        {
+            const FVector CellExtent(InfluenceMap->CellSize * 0.5f, InfluenceMap->CellSize * 0.5f, 0.0f);
+            const FVector Candidate = RandomPointInBox(RandomStream, WeakestLocation, CellExtent);
+            return Candidate.BoundToBox(Origin - BoxExtent, Origin + BoxExtent);
+        }
+    }
+
+    // 🔧 修改 - 使用生成器的随机流，便于对局录像复现
+    return RandomPointInBox(RandomStream, Origin, BoxExtent);
 }
 
 void ASG_EnemySpawner::FindRelatedMainCity()
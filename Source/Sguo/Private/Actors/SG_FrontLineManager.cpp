@@ -6,10 +6,12 @@
 // ✨ 新增 - 静态网格体组件头文件
 #include "Components/StaticMeshComponent.h"
 #include "Units/SG_UnitsBase.h"
+#include "Units/SG_DeathEventHub.h"
 #include "Buildings/SG_MainCityBase.h"
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
 
 /**
  * @brief 构造函数
@@ -191,6 +193,8 @@ void ASG_FrontLineManager::Tick(float DeltaTime)
  */
 void ASG_FrontLineManager::UpdateFrontLinePositionRealtime()
 {
+    SG_SCOPE_CYCLE_COUNTER(FrontLineUpdate);
+
     // 记录是否有变化
     bool bChanged = false;
     
@@ -801,7 +805,7 @@ void ASG_FrontLineManager::OnUnitDeath(ASG_UnitsBase* DeadUnit)
 /**
  * @brief 绑定单位死亡事件
  * @param Unit 要绑定的单位
- * @details 将 OnUnitDeath 函数绑定到单位的死亡委托
+ * @details 通过 USG_DeathEventHub 监听单位死亡，回调 OnUnitDeath
  */
 void ASG_FrontLineManager::BindUnitDeathEvent(ASG_UnitsBase* Unit)
 {
@@ -809,12 +813,10 @@ void ASG_FrontLineManager::BindUnitDeathEvent(ASG_UnitsBase* Unit)
     // IsValid 会同时检查：1. 指针是否为空 2. 对象是否标记为 PendingKill (即将销毁) 3. 对象是否是垃圾内存
     if (IsValid(Unit))
     {
-        // ✨ 新增 - 防止重复绑定
-        // 动态委托如果重复绑定同一个函数，可能会导致多次调用或警告
-        if (!Unit->OnUnitDeathEvent.IsAlreadyBound(this, &ASG_FrontLineManager::OnUnitDeath))
+        // 🔧 修改 - 通过死亡事件中心监听（同一监听者重复添加只会替换回调）
+        if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
         {
-            // 将 OnUnitDeath 函数添加到单位的死亡事件委托
-            Unit->OnUnitDeathEvent.AddDynamic(this, &ASG_FrontLineManager::OnUnitDeath);
+            DeathHub->AddWatcher(Unit, this, FSGDeathWatchCallback::CreateUObject(this, &ASG_FrontLineManager::OnUnitDeath));
         }
     }
     else
@@ -827,15 +829,18 @@ void ASG_FrontLineManager::BindUnitDeathEvent(ASG_UnitsBase* Unit)
 /**
  * @brief 解绑单位死亡事件
  * @param Unit 要解绑的单位
- * @details 从单位的死亡委托中移除 OnUnitDeath 函数
+ * @details 从 USG_DeathEventHub 取消监听
  */
 void ASG_FrontLineManager::UnbindUnitDeathEvent(ASG_UnitsBase* Unit)
 {
     // 🔧 修改 - 同样使用 IsValid 进行安全检查
     if (IsValid(Unit))
     {
-        // 从单位的死亡事件委托中移除 OnUnitDeath 函数
-        Unit->OnUnitDeathEvent.RemoveDynamic(this, &ASG_FrontLineManager::OnUnitDeath);
+        // 🔧 修改 - 从死亡事件中心取消监听
+        if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
+        {
+            DeathHub->RemoveWatcher(Unit, this);
+        }
     }
 }
 
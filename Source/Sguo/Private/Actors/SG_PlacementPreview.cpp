@@ -14,6 +14,7 @@
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/Pawn.h"
+#include "Game/SG_HeightfieldSubsystem.h"
 
 ASG_PlacementPreview::ASG_PlacementPreview()
 {
@@ -168,6 +169,30 @@ void ASG_PlacementPreview::UpdatePreviewLocation()
     FVector Start = WorldLocation;
     FVector End = Start + WorldDirection * RaycastDistance;
 
+    // ✨ 新增 - 静态地面优先与高度图求交，不做射线检测
+    if (bOnlyTraceWorldStatic && bUseHeightfieldCache)
+    {
+        if (USG_HeightfieldSubsystem* Heightfield = GetWorld()->GetSubsystem<USG_HeightfieldSubsystem>())
+        {
+            FVector GroundLocation;
+            if (Heightfield->RaycastHeightfield(Start, WorldDirection, RaycastDistance, GroundLocation))
+            {
+                FVector GroundNormal = FVector::UpVector;
+                Heightfield->GetGroundNormal(GroundLocation, GroundNormal);
+
+                PreviewLocation = GroundLocation + GroundNormal * GroundOffset;
+                SetActorLocation(PreviewLocation);
+
+                if (bDebugGroundTrace)
+                {
+                    DrawDebugLine(GetWorld(), Start, GroundLocation, FColor::Blue, false, 0.0f, 0, 1.0f);
+                    DrawDebugSphere(GetWorld(), GroundLocation, 10.0f, 8, FColor::Cyan, false, 0.0f);
+                }
+                return;
+            }
+        }
+    }
+
     // ✨ 优化 - 基础查询参数（移除 build ignore list）
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(this);
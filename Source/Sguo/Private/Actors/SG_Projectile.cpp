@@ -8,6 +8,7 @@
 #include "Units/SG_UnitsBase.h"
 #include "Buildings/SG_MainCityBase.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
 #include "GameplayEffect.h"
 #include "GameplayCueManager.h"
 #include "DrawDebugHelpers.h"
@@ -27,6 +28,9 @@ namespace ProjectileDefaults
     constexpr float CapsuleHalfHeight = 30.0f;
 }
 
+// ✨ 新增 - 当前存活的投射物数量
+int32 ASG_Projectile::ActiveProjectileCount = 0;
+
 /**
  * @brief 构造函数
  * 
@@ -119,6 +123,9 @@ void ASG_Projectile::BeginPlay()
     // 调用父类实现
     Super::BeginPlay();
 
+    INC_DWORD_STAT(STAT_SGActiveProjectiles);
+    ++ActiveProjectileCount; // ✨ 新增
+
     // 设置生存时间
     SetLifeSpan(LifeSpan);
 
@@ -187,6 +194,9 @@ void ASG_Projectile::BeginPlay()
  */
 void ASG_Projectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    DEC_DWORD_STAT(STAT_SGActiveProjectiles);
+    --ActiveProjectileCount; // ✨ 新增
+
     // 清理碰撞启用定时器
     if (GetWorldTimerManager().IsTimerActive(CollisionEnableTimerHandle))
     {
@@ -237,6 +247,9 @@ void ASG_Projectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
  */
 void ASG_Projectile::Tick(float DeltaTime)
 {
+    SG_SCOPE_CYCLE_COUNTER(ProjectileTick);
+    SG_INC_COUNTER(ProjectileTicks);
+
     // 调用父类实现
     Super::Tick(DeltaTime);
 
@@ -10,6 +10,7 @@
 #include "Components/StaticMeshComponent.h"  // ✨ 新增
 #include "AbilitySystemComponent.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Materials/MaterialInstanceDynamic.h"  // ✨ 新增
@@ -487,9 +488,10 @@ void ASG_RollingLogSpawner::SpawnRollingLogs()
     // 确定滚木类
     TSubclassOf<ASG_RollingLog> RollingLogClassToSpawn = nullptr;
     
-    if (ActiveCardData->RollingLogClass)
+    // 🔧 修改 - 滚木类为软引用（Gameplay 资产包，卡牌在手牌中时已预加载）
+    if (UClass* CardRollingLogClass = ActiveCardData->RollingLogClass.LoadSynchronous())
     {
-        RollingLogClassToSpawn = TSubclassOf<ASG_RollingLog>(ActiveCardData->RollingLogClass);
+        RollingLogClassToSpawn = TSubclassOf<ASG_RollingLog>(CardRollingLogClass);
     }
     else if (DefaultRollingLogClass)
     {
@@ -530,6 +532,7 @@ void ASG_RollingLogSpawner::SpawnRollingLogs()
         SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
         // 生成滚木（使用默认旋转，稍后强制设置）
+        SG_LLM_SCOPE(Strategies); // ✨ 新增 - LLM 标签
         ASG_RollingLog* NewLog = World->SpawnActor<ASG_RollingLog>(
             RollingLogClassToSpawn,
             SpawnLocation,
@@ -9,6 +9,7 @@
 #include "Engine/World.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
 
 // ========== 构造函数 ==========
 
@@ -65,6 +66,8 @@ void USG_ANS_MeleeDetection::NotifyTick(
 	float FrameDeltaTime, 
 	const FAnimNotifyEventReference& EventReference)
 {
+	SG_SCOPE_CYCLE_COUNTER(MeleeDetection);
+
 	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
 
 	// ========== 步骤1：检查有效性 ==========
@@ -140,6 +143,8 @@ void USG_ANS_MeleeDetection::NotifyTick(
 	// ========== 步骤6：处理命中结果 ==========
 	if (bHit)
 	{
+		SG_INC_COUNTER_BY(MeleeSweepHits, HitResults.Num());
+		
 		UE_LOG(LogSGGameplay, Verbose, TEXT("  检测到 %d 个碰撞"), HitResults.Num());
 		
 		for (const FHitResult& Hit : HitResults)
@@ -4,12 +4,45 @@
 #include "AssetManger/SG_AssetManager.h"
 // 引入 GameplayTags 定义头文件，便于初始化原生标签
 #include "Public/AbilitySystem/SG_GameplayTags.h"
+// ✨ 新增 - 同步加载检测
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+// ✨ 新增 - 手牌预加载
+#include "Data/SG_CardDataBase.h"
+
+// ✨ 新增 - 禁止同步加载作用域的嵌套深度（每个线程独立）
+static thread_local int32 GSGNoSyncLoadDepth = 0;
+
+// ✨ 新增 - 是否检测禁止作用域内的同步加载
+static TAutoConsoleVariable<bool> CVarSGFlagSyncLoads(
+	TEXT("SG.Asset.FlagSyncLoads"),
+	true,
+	TEXT("抽卡等热路径发生同步加载时触发 ensure"));
+
+FSGScopedNoSyncLoad::FSGScopedNoSyncLoad()
+{
+	++GSGNoSyncLoadDepth;
+}
+
+FSGScopedNoSyncLoad::~FSGScopedNoSyncLoad()
+{
+	--GSGNoSyncLoadDepth;
+}
+
+bool FSGScopedNoSyncLoad::IsActive()
+{
+	return GSGNoSyncLoadDepth > 0;
+}
 
 // 定义卡牌主资产类型常量
 // 定义卡牌主资产类型的实际值
 const FPrimaryAssetType USG_AssetManager::CardAssetType = FPrimaryAssetType(TEXT("Card"));
 // 定义卡组主资产类型常量
 const FPrimaryAssetType USG_AssetManager::DeckAssetType = FPrimaryAssetType(TEXT("Deck"));
+// ✨ 新增 - 卡牌 Gameplay 资产包
+const FName USG_AssetManager::GameplayBundle = FName(TEXT("Gameplay"));
 // 蓝图版本：异步加载卡组配置
 void USG_AssetManager::LoadDeckConfigAsync(const FString& DeckAssetId)
 {
@@ -418,6 +451,11 @@ void USG_AssetManager::StartInitialLoading()
 	// 注册原生 GameplayTags
 	FSG_GameplayTags::InitializeNativeTags();
 
+#if !UE_BUILD_SHIPPING
+	// ✨ 新增 - 检测热路径上的同步加载
+	FCoreDelegates::OnSyncLoadPackage.AddStatic(&USG_AssetManager::HandleSyncLoadPackage);
+#endif
+
 	UE_LOG(LogTemp, Log, TEXT("========================================"));
 	UE_LOG(LogTemp, Log, TEXT("  SG 资产管理器已启动"));
 	UE_LOG(LogTemp, Log, TEXT("========================================"));
@@ -425,4 +463,237 @@ void USG_AssetManager::StartInitialLoading()
 	// 预加载常用资产（可选）
 	// 注意：如果资产很多，可能会增加启动时间
 	// PreloadEssentialAssets();
-}
\ No newline at end of file
+}
+
+// ✨ 新增 - 同步加载回调
+void USG_AssetManager::HandleSyncLoadPackage(const FString& PackageName)
+{
+	if (!FSGScopedNoSyncLoad::IsActive() || !CVarSGFlagSyncLoads.GetValueOnAnyThread())
+	{
+		return;
+	}
+
+	UE_LOG(LogSGAsset, Error, TEXT("❌ 游戏过程中发生同步加载：%s（所需资产应在卡组初始化时异步加载）"), *PackageName);
+	ensureMsgf(false, TEXT("禁止同步加载的作用域内发生同步加载：%s"), *PackageName);
+}
+
+// ========== ✨ 新增 - 手牌预加载 ==========
+
+// 根据当前手牌更新预加载
+void USG_AssetManager::UpdateHandPreloads(const TArray<USG_CardDataBase*>& HandCards)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// 先把所有卡牌标记为不在手牌中
+	for (TPair<FPrimaryAssetId, FSGCardPreloadEntry>& Pair : CardPreloads)
+	{
+		Pair.Value.bInHand = false;
+	}
+
+	for (USG_CardDataBase* CardData : HandCards)
+	{
+		if (!CardData)
+		{
+			continue;
+		}
+
+		const FPrimaryAssetId CardId = CardData->GetPrimaryAssetId();
+		FSGCardPreloadEntry* Entry = CardPreloads.Find(CardId);
+		if (!Entry)
+		{
+			// 新进入手牌的卡牌：开始预加载
+			Entry = &CardPreloads.Add(CardId);
+			PreloadCard(CardData, *Entry);
+		}
+
+		Entry->bInHand = true;
+		Entry->LastUsedTime = Now;
+	}
+
+	EnforceCardPreloadBudget();
+}
+
+// ✨ 新增 - 异步加载一组卡牌的 Gameplay 资产包
+TSharedPtr<FStreamableHandle> USG_AssetManager::LoadCardGameplayBundles(const TArray<FPrimaryAssetId>& CardIds)
+{
+	if (CardIds.Num() == 0)
+	{
+		return nullptr;
+	}
+	return ChangeBundleStateForPrimaryAssets(CardIds, { GameplayBundle }, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+}
+
+// 开始预加载一张卡牌
+void USG_AssetManager::PreloadCard(USG_CardDataBase* CardData, FSGCardPreloadEntry& Entry)
+{
+	const FPrimaryAssetId CardId = CardData->GetPrimaryAssetId();
+
+	// 🔧 修改 - 加载卡牌的 Gameplay 资产包；没有资产包时不创建句柄，该卡牌不参与命中统计
+	Entry.AssetHandle = LoadCardGameplayBundles({ CardId });
+	if (!Entry.AssetHandle.IsValid())
+	{
+		UE_LOG(LogSGAsset, Verbose, TEXT("📦 卡牌没有 Gameplay 资产包，跳过预加载：%s"), *CardId.ToString());
+		return;
+	}
+
+	CardPreloadStats.PreloadRequests++;
+	UE_LOG(LogSGAsset, Verbose, TEXT("📦 预加载卡牌资产包：%s"), *CardId.ToString());
+}
+
+// 释放卡牌的预加载资产
+void USG_AssetManager::ReleaseCardPreload(const FPrimaryAssetId& CardId)
+{
+	if (FSGCardPreloadEntry* Entry = CardPreloads.Find(CardId))
+	{
+		ReleaseCardPreloadEntry(CardId, *Entry);
+		CardPreloads.Remove(CardId);
+	}
+}
+
+// 释放一张卡牌的预加载资产
+void USG_AssetManager::ReleaseCardPreloadEntry(const FPrimaryAssetId& CardId, FSGCardPreloadEntry& Entry)
+{
+	if (Entry.AssetHandle.IsValid())
+	{
+		if (Entry.AssetHandle->HasLoadCompleted())
+		{
+			Entry.AssetHandle->ReleaseHandle();
+		}
+		else
+		{
+			Entry.AssetHandle->CancelHandle();
+		}
+		Entry.AssetHandle.Reset();
+
+		// 🔧 修改 - 同时移除资产管理器记录的资产包状态，否则资产包仍被主资产句柄持有
+		ChangeBundleStateForPrimaryAssets({ CardId }, {}, { GameplayBundle });
+	}
+
+	CardPreloadStats.ResidentBytes -= Entry.EstimatedBytes;
+	CardPreloadStats.Releases++;
+
+	UE_LOG(LogSGAsset, Verbose, TEXT("📦 释放卡牌预加载资产：%s（%.1f KB）"), *CardId.ToString(), Entry.EstimatedBytes / 1024.0);
+}
+
+// 释放所有预加载资产
+void USG_AssetManager::ReleaseAllCardPreloads()
+{
+	for (TPair<FPrimaryAssetId, FSGCardPreloadEntry>& Pair : CardPreloads)
+	{
+		ReleaseCardPreloadEntry(Pair.Key, Pair.Value);
+	}
+	CardPreloads.Empty();
+	CardPreloadStats.ResidentBytes = 0;
+	PublishCardPreloadStats();
+}
+
+// 使用卡牌时记录预加载命中情况
+void USG_AssetManager::NotifyCardUsed(const FPrimaryAssetId& CardId)
+{
+	const FSGCardPreloadEntry* Entry = CardPreloads.Find(CardId);
+	if (Entry && !Entry->IsPreloadable())
+	{
+		// 🔧 修改 - 没有可预加载的资产，不计入命中率
+		CardPreloadStats.NotPreloadable++;
+		return;
+	}
+
+	if (Entry && Entry->HasLoadCompleted())
+	{
+		CardPreloadStats.CacheHits++;
+	}
+	else
+	{
+		CardPreloadStats.CacheMisses++;
+		UE_LOG(LogSGAsset, Log, TEXT("📦 预加载未命中：%s"), *CardId.ToString());
+	}
+
+	UE_LOG(LogSGAsset, Verbose, TEXT("📦 预加载命中率：%.1f%%（命中 %d / 未命中 %d）"),
+		CardPreloadStats.GetHitRate() * 100.0f, CardPreloadStats.CacheHits, CardPreloadStats.CacheMisses);
+
+	PublishCardPreloadStats();
+}
+
+// 内存预算
+void USG_AssetManager::EnforceCardPreloadBudget()
+{
+	// 加载完成的卡牌计算一次内存（类资产按默认对象估算）
+	for (TPair<FPrimaryAssetId, FSGCardPreloadEntry>& Pair : CardPreloads)
+	{
+		FSGCardPreloadEntry& Entry = Pair.Value;
+		if (Entry.bSizeMeasured || !Entry.HasLoadCompleted())
+		{
+			continue;
+		}
+
+		TArray<UObject*> LoadedAssets;
+		if (Entry.AssetHandle.IsValid())
+		{
+			Entry.AssetHandle->GetLoadedAssets(LoadedAssets);
+		}
+
+		for (UObject* Asset : LoadedAssets)
+		{
+			if (UClass* AssetClass = Cast<UClass>(Asset))
+			{
+				Asset = AssetClass->GetDefaultObject();
+			}
+			if (Asset)
+			{
+				Entry.EstimatedBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+		}
+
+		Entry.bSizeMeasured = true;
+		CardPreloadStats.ResidentBytes += Entry.EstimatedBytes;
+	}
+
+	const int64 BudgetBytes = static_cast<int64>(FMath::Max(0, CardPreloadBudgetMB)) * 1024 * 1024;
+	if (CardPreloadStats.ResidentBytes <= BudgetBytes)
+	{
+		PublishCardPreloadStats();
+		return;
+	}
+
+	// 超出预算：按最久未使用的顺序释放不在手牌中的卡牌
+	TArray<FPrimaryAssetId> Candidates;
+	for (const TPair<FPrimaryAssetId, FSGCardPreloadEntry>& Pair : CardPreloads)
+	{
+		if (!Pair.Value.bInHand && Pair.Value.IsPreloadable())
+		{
+			Candidates.Add(Pair.Key);
+		}
+	}
+	Candidates.Sort([this](const FPrimaryAssetId& A, const FPrimaryAssetId& B)
+	{
+		return CardPreloads[A].LastUsedTime < CardPreloads[B].LastUsedTime;
+	});
+
+	for (const FPrimaryAssetId& CardId : Candidates)
+	{
+		if (CardPreloadStats.ResidentBytes <= BudgetBytes)
+		{
+			break;
+		}
+		ReleaseCardPreload(CardId);
+	}
+
+	UE_LOG(LogSGAsset, Log, TEXT("📦 预加载超出预算，释放后占用 %.1f MB / %d MB"),
+		CardPreloadStats.ResidentBytes / (1024.0 * 1024.0), CardPreloadBudgetMB);
+
+	PublishCardPreloadStats();
+}
+
+// 把预加载统计写入 stat Sguo 和 CSV
+void USG_AssetManager::PublishCardPreloadStats() const
+{
+	const int32 HitRatePercent = FMath::RoundToInt32(CardPreloadStats.GetHitRate() * 100.0f);
+
+	SET_DWORD_STAT(STAT_SGCardPreloadHits, CardPreloadStats.CacheHits);
+	SET_DWORD_STAT(STAT_SGCardPreloadMisses, CardPreloadStats.CacheMisses);
+	SET_DWORD_STAT(STAT_SGCardPreloadHitRate, HitRatePercent);
+	SET_MEMORY_STAT(STAT_SGCardPreloadResident, CardPreloadStats.ResidentBytes);
+
+	CSV_CUSTOM_STAT(Sguo, CardPreloadHitRate, HitRatePercent, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Sguo, CardPreloadResidentMB, static_cast<float>(CardPreloadStats.ResidentBytes / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+}
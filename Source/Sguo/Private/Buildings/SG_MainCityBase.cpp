@@ -13,8 +13,10 @@
 #include "Components/BoxComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MatchTelemetrySubsystem.h" // ✨ 新增 - 对局遥测
 #include "Units/SG_UnitsBase.h"
 #include "Units/SG_StationaryUnit.h"  // ✨ 新增
+#include "Units/SG_DeathEventHub.h"
 #include "Actors/SG_EnemySpawner.h"
 #include "AI/SG_AIControllerBase.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -314,6 +316,13 @@ void ASG_MainCityBase::OnMainCityDestroyed_Implementation()
 	UWorld* World = GetWorld();
 	if (World)
 	{
+		// ✨ 新增 - 对局结束，异步写出性能遥测（在冻结单位之前，避免把结算帧计入）
+		if (USG_MatchTelemetrySubsystem* Telemetry = World->GetSubsystem<USG_MatchTelemetrySubsystem>())
+		{
+			const bool bPlayerLost = FactionTag.MatchesTag(FGameplayTag::RequestGameplayTag(TEXT("Unit.Faction.Player")));
+			Telemetry->FinishMatch(bPlayerLost ? TEXT("Defeat") : TEXT("Victory"));
+		}
+
 		// A. 停止所有敌方生成器
 		TArray<AActor*> AllSpawners;
 		UGameplayStatics::GetAllActorsOfClass(World, ASG_EnemySpawner::StaticClass(), AllSpawners);
@@ -603,9 +612,16 @@ void ASG_MainCityBase::BlastSingleUnit(ASG_StationaryUnit* Unit, const FVector&
 	
 	// ========== 步骤7：广播死亡事件 ==========
 	Unit->OnUnitDeathEvent.Broadcast(Unit);
+
+	// 🔧 修改 - 同时上报死亡事件中心（释放槽位、通知监听者）
+	if (USG_DeathEventHub* DeathHub = GetWorld()->GetSubsystem<USG_DeathEventHub>())
+	{
+		DeathHub->NotifyUnitDied(Unit);
+	}
 	
 	// ========== 步骤8：设置延迟销毁 ==========
-	Unit->SetLifeSpan(BlastDestroyDelay);
+	// 🔧 修改 - 对象池生成的单位到时回收
+	Unit->ScheduleRemoval(BlastDestroyDelay);
 	
 	UE_LOG(LogSGGameplay, Log, TEXT("    ✓ 将在 %.1f 秒后销毁"), BlastDestroyDelay);
 }
@@ -18,12 +18,16 @@
 #include "TimerManager.h"
 // ✨ NEW - 引入日志系统
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Debug/SG_Trace.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
+#include "Debug/SG_ReplaySubsystem.h" // ✨ 新增 - 对局录像
 
 // 构造函数
 USG_CardDeckComponent::USG_CardDeckComponent()
 {
-	// 启用 Tick 以便更新冷却时间
-	PrimaryComponentTick.bCanEverTick = true;
+	// 🔧 修改 - 冷却由计时器驱动并以时间戳发布，组件不需要 Tick
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 // 生命周期开始
@@ -31,6 +35,10 @@ void USG_CardDeckComponent::BeginPlay()
 {
 	// 调用父类 BeginPlay
 	Super::BeginPlay();
+	
+	// ✨ 新增 - 手牌变化时预加载卡牌资产
+	OnHandChanged.AddDynamic(this, &USG_CardDeckComponent::HandleHandChangedForPreload);
+	
 	// 若设置自动初始化且所属 Owner 不是 PlayerController 则执行
 	// PlayerController 会手动控制初始化时机
 	if (bAutoInitialize && !Cast<APlayerController>(GetOwner()))
@@ -40,67 +48,35 @@ void USG_CardDeckComponent::BeginPlay()
 	}
 }
 
-/**
- * @brief 每帧更新
- * @param DeltaTime 帧间隔时间
- * @param TickType Tick 类型
- * @param ThisTickFunction Tick 函数指针
- * @details
- * 功能说明：
- * - 更新冷却剩余时间
- * - 🔧 MODIFIED - 检测冷却卡死问题
- * 详细流程：
- * 1. 检查是否在冷却中
- * 2. 更新冷却剩余时间
- * 3. 🔧 MODIFIED - 如果剩余时间接近 0，强制完成冷却
- * 4. 广播行动状态
- * 注意事项：
- * - 防止计时器精度问题导致冷却卡死
- */
-void USG_CardDeckComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+// ✨ 新增 - 生命周期结束
+void USG_CardDeckComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// 调用父类 Tick
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-    
-	// 若冷却进行中则更新剩余时间
-	if (!bActionAvailable)
+	// 释放手牌预加载资产
+	if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
 	{
-		// 读取剩余时间
-		CooldownRemaining = GetWorld()->GetTimerManager().GetTimerRemaining(CooldownTimerHandle);
-        
-		// 🔧 MODIFIED - 检测冷却卡死问题
-		// 如果剩余时间小于 0.01 秒，强制完成冷却
-		if (CooldownRemaining > 0.0f && CooldownRemaining < 0.01f)
-		{
-			// 输出警告日志
-			UE_LOG(LogSGCard, Warning, TEXT("⚠️ 检测到冷却卡死（剩余 %.4f 秒），强制完成冷却"), CooldownRemaining);
-            
-			// 清除计时器
-			GetWorld()->GetTimerManager().ClearTimer(CooldownTimerHandle);
-            
-			// 强制完成冷却
-			CompleteCooldown();
-            
-			// 直接返回，避免后续逻辑
-			return;
-		}
-        
-		// 🔧 MODIFIED - 如果计时器无效但还在冷却状态，强制完成
-		if (!GetWorld()->GetTimerManager().IsTimerActive(CooldownTimerHandle) && CooldownRemaining <= 0.0f)
-		{
-			// 输出警告日志
-			UE_LOG(LogSGCard, Warning, TEXT("⚠️ 检测到计时器失效，强制完成冷却"));
-            
-			// 强制完成冷却
-			CompleteCooldown();
-            
-			// 直接返回
-			return;
-		}
-        
-		// 广播当前冷却状态
-		BroadcastActionState();
+		AssetManager->ReleaseAllCardPreloads();
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+// ✨ 新增 - 手牌变化时更新预加载
+void USG_CardDeckComponent::HandleHandChangedForPreload(const TArray<FSGCardInstance>& NewHand)
+{
+	USG_AssetManager* AssetManager = USG_AssetManager::Get();
+	if (!AssetManager)
+	{
+		return;
+	}
+	
+	TArray<USG_CardDataBase*> HandCardData;
+	HandCardData.Reserve(NewHand.Num());
+	for (const FSGCardInstance& Card : NewHand)
+	{
+		HandCardData.Add(Card.CardData);
 	}
+	
+	AssetManager->UpdateHandPreloads(HandCardData);
 }
 
 // 初始化卡组
@@ -129,8 +105,37 @@ void USG_CardDeckComponent::InitializeDeck()
 		return;
 	}
 	
+	// 🔧 修改 - 卡组配置未在内存中时异步加载，不再 LoadSynchronous
+	if (!DeckConfigAsset.IsValid())
+	{
+		if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
+		{
+			UE_LOG(LogSGAsset, Log, TEXT("开始异步加载卡组配置：%s"), *DeckConfigAsset.ToString());
+			bAssetsLoading = true;
+			CurrentLoadHandle = AssetManager->GetStreamableManager().RequestAsyncLoad(
+				DeckConfigAsset.ToSoftObjectPath(),
+				FStreamableDelegate::CreateUObject(this, &USG_CardDeckComponent::HandleDeckConfigLoaded));
+			if (CurrentLoadHandle.IsValid())
+			{
+				return;
+			}
+			bAssetsLoading = false;
+		}
+	}
+	
+	HandleDeckConfigLoaded();
+}
+
+// ✨ 新增 - 卡组配置加载完成回调
+void USG_CardDeckComponent::HandleDeckConfigLoaded()
+{
+	SG_LLM_SCOPE(CardsUI); // ✨ 新增 - LLM 标签
+	// 重置加载状态
+	bAssetsLoading = false;
+	CurrentLoadHandle.Reset();
+	
 	// 解析卡组配置
-	ResolvedDeckConfig = DeckConfigAsset.IsValid() ? DeckConfigAsset.Get() : DeckConfigAsset.LoadSynchronous();
+	ResolvedDeckConfig = DeckConfigAsset.Get();
 	
 	// 若配置为空则退出
 	if (!ResolvedDeckConfig)
@@ -144,6 +149,12 @@ void USG_CardDeckComponent::InitializeDeck()
 	// 🔧 MODIFIED - 使用 GetEffectiveRNGSeed() 获取种子
 	// 根据配置自动选择固定种子或随机种子
 	int32 EffectiveSeed = ResolvedDeckConfig->GetEffectiveRNGSeed();
+
+	// ✨ 新增 - 对局录制 / 回放时使用从对局种子派生的种子
+	if (const USG_ReplaySubsystem* Replay = GetWorld() ? GetWorld()->GetSubsystem<USG_ReplaySubsystem>() : nullptr)
+	{
+		Replay->ResolveStreamSeed(TEXT("Deck"), EffectiveSeed);
+	}
 	
 	// ✨ NEW - 记录种子信息到日志（重要：用于问题复现）
 	if (ResolvedDeckConfig->bUseFixedSeed)
@@ -242,7 +253,7 @@ bool USG_CardDeckComponent::UseCard(const FGuid& InstanceId)
     if (!bActionAvailable)
     {
         // 输出警告
-        UE_LOG(LogSGCard, Warning, TEXT("UseCard 失败：处于冷却中（剩余 %.2f 秒）"), CooldownRemaining);
+        UE_LOG(LogSGCard, Warning, TEXT("UseCard 失败：处于冷却中（剩余 %.2f 秒）"), GetCooldownRemaining());
         // 返回失败
         return false;
     }
@@ -279,31 +290,14 @@ bool USG_CardDeckComponent::UseCard(const FGuid& InstanceId)
         *UsedCard.CardData->CardName.ToString(), 
         *UsedCard.InstanceId.ToString());
     
+    SG_TRACE_EVENT(CardUsed, GetOwner(), UsedCard.CardData->CardName, UsedCard.InstanceId);
+    
     // 从手牌中移除
     HandCards.RemoveAt(FoundIndex);
     UE_LOG(LogSGCard, Log, TEXT("  ✓ 已从手牌移除，当前手牌数：%d"), HandCards.Num());
     
-    // 非唯一卡加入弃牌堆
-    if (!UsedCard.bIsUnique)
-    {
-        // 构建弃牌槽位
-        FSGCardDrawSlot Slot;
-        // 记录卡牌 ID
-        Slot.CardId = UsedCard.CardId;
-        // 推入弃牌堆
-        DiscardPile.Add(Slot);
-        
-        // 输出日志
-        UE_LOG(LogSGCard, Log, TEXT("  ✓ 非唯一卡牌已加入弃牌堆"));
-    }
-    else
-    {
-        // 唯一卡记录为已使用
-        ConsumedUniqueCards.Add(UsedCard.CardId);
-        
-        // 输出日志
-        UE_LOG(LogSGCard, Log, TEXT("  ✓ 唯一卡牌已加入消耗列表，不会再次出现"));
-    }
+    // 🔧 修改 - 弃牌/消耗逻辑提取到 DiscardUsedCard（离线模拟共用）
+    DiscardUsedCard(UsedCard);
     
     // 清空选中 ID
     SelectedCardId.Invalidate();
@@ -315,6 +309,12 @@ bool USG_CardDeckComponent::UseCard(const FGuid& InstanceId)
     // 广播卡牌使用
     OnCardUsed.Broadcast(UsedCard);
     
+    // ✨ 新增 - 记录预加载命中情况
+    if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
+    {
+        AssetManager->NotifyCardUsed(UsedCard.CardId);
+    }
+    
     // 输出日志
     UE_LOG(LogSGCard, Log, TEXT("✓ 卡牌使用成功"));
     UE_LOG(LogSGCard, Log, TEXT("========================================"));
@@ -350,7 +350,7 @@ bool USG_CardDeckComponent::SkipAction()
 	if (!bActionAvailable)
 	{
 		// 输出警告
-		UE_LOG(LogSGCard, Warning, TEXT("SkipAction 失败：处于冷却中（剩余 %.2f 秒）"), CooldownRemaining);
+		UE_LOG(LogSGCard, Warning, TEXT("SkipAction 失败：处于冷却中（剩余 %.2f 秒）"), GetCooldownRemaining());
 		// 返回失败
 		return false;
 	}
@@ -375,6 +375,12 @@ bool USG_CardDeckComponent::SkipAction()
 	UE_LOG(LogSGCard, Log, TEXT("✓ 跳过行动成功"));
 	UE_LOG(LogSGCard, Log, TEXT("========================================"));
     
+	// ✨ 新增 - 对局录像
+	if (USG_ReplaySubsystem* Replay = GetWorld() ? GetWorld()->GetSubsystem<USG_ReplaySubsystem>() : nullptr)
+	{
+		Replay->RecordSkip();
+	}
+
 	// 🔧 MODIFIED - 启动冷却（冷却结束后会自动抽卡）
 	UE_LOG(LogSGCard, Log, TEXT("启动冷却计时器..."));
 	StartCooldown();
@@ -393,8 +399,13 @@ bool USG_CardDeckComponent::CanAct() const
 // 获取冷却剩余时间
 float USG_CardDeckComponent::GetCooldownRemaining() const
 {
-	// 返回冷却剩余
-	return CooldownRemaining;
+	// 🔧 修改 - 根据冷却结束时间戳计算
+	const UWorld* World = GetWorld();
+	if (bActionAvailable || !World)
+	{
+		return 0.0f;
+	}
+	return FMath::Max(0.0f, CooldownEndTime - World->GetTimeSeconds());
 }
 
 // 获取卡组配置
@@ -407,6 +418,7 @@ USG_DeckConfig* USG_CardDeckComponent::GetDeckConfig() const
 // 构建抽牌池
 void USG_CardDeckComponent::BuildDrawPile()
 {
+	SG_LLM_SCOPE(CardsUI); // ✨ 新增 - LLM 标签
 	// 记录开始构建
 	UE_LOG(LogSGCard, Log, TEXT("开始构建抽牌池..."));
 	
@@ -414,6 +426,8 @@ void USG_CardDeckComponent::BuildDrawPile()
 	DrawPile.Reset();
 	// 清空已使用的唯一卡集合
 	ConsumedUniqueCards.Reset();
+	// ✨ 新增 - 清空卡牌数据缓存
+	LoadedCardData.Reset();
 	
 	// 检测配置有效性
 	if (!ResolvedDeckConfig)
@@ -422,20 +436,25 @@ void USG_CardDeckComponent::BuildDrawPile()
 		return;
 	}
 	
+	// ✨ 新增 - 卡牌数据应已由 InitializeDeck 异步加载完成
+	FSGScopedNoSyncLoad NoSyncLoad;
+	
 	// 🔧 MODIFIED - 遍历配置槽位（而不是简单的卡牌数组）
 	for (const FSGCardConfigSlot& ConfigSlot : ResolvedDeckConfig->AllowedCards)
 	{
-		// 解析卡牌数据（处理软引用）
-		USG_CardDataBase* CardAsset = ConfigSlot.CardData.IsValid() ? 
-			ConfigSlot.CardData.Get() : ConfigSlot.CardData.LoadSynchronous();
+		// 🔧 修改 - 只使用已加载的卡牌数据，不再 LoadSynchronous
+		USG_CardDataBase* CardAsset = ConfigSlot.CardData.Get();
 		
-		// 跳过无效引用
+		// 跳过无效引用或未加载的卡牌
 		if (!CardAsset)
 		{
-			UE_LOG(LogSGCard, Warning, TEXT("  ⚠️ 配置槽位的卡牌数据无效，跳过"));
+			UE_LOG(LogSGCard, Warning, TEXT("  ⚠️ 配置槽位的卡牌数据无效或未加载，跳过：%s"), *ConfigSlot.CardData.ToString());
 			continue;
 		}
 		
+		// ✨ 新增 - 缓存卡牌数据，抽卡时直接查表
+		LoadedCardData.Add(CardAsset->GetPrimaryAssetId(), CardAsset);
+		
 		// 构建抽牌槽位
 		FSGCardDrawSlot Slot;
 		
@@ -473,6 +492,9 @@ void USG_CardDeckComponent::BuildDrawPile()
 		DrawPile.Swap(i, SwapIndex);
 	}
 	
+	// ✨ 新增 - 构建权重采样器
+	DrawSampler.Build(DrawPile, ConsumedUniqueCards);
+	
 	// 记录构建完成
 	UE_LOG(LogSGCard, Log, TEXT("✓ 抽牌池构建完成，共 %d 个槽位"), DrawPile.Num());
 }
@@ -535,118 +557,47 @@ void USG_CardDeckComponent::DrawCards(int32 Count)
  */
 bool USG_CardDeckComponent::DrawSingleCard(FSGCardInstance& OutInstance)
 {
-	// 收集所有可抽取的槽位
-	TArray<FSGCardDrawSlot*> ValidSlots;
-	float TotalWeight = 0.0f;
+	SG_SCOPE_CYCLE_COUNTER(CardDraw);
+	SG_INC_COUNTER(CardsDrawn);
+
+	// ✨ 新增 - 卡牌资产加载完成前不允许抽卡
+	if (!bInitialized)
+	{
+		UE_LOG(LogSGCard, Warning, TEXT("抽牌失败：卡组尚未初始化（卡牌资产加载中）"));
+		return false;
+	}
 	
-	// 遍历抽牌池，收集有效槽位并计算总权重
-	for (FSGCardDrawSlot& Slot : DrawPile)
+	// ✨ 新增 - 抽卡路径禁止同步加载
+	FSGScopedNoSyncLoad NoSyncLoad;
+	
+	// 🔧 修改 - 通过权重采样器抽取（不再每次收集有效槽位 + 线性轮盘赌）
+	if (!DrawSampler.IsBuiltFor(DrawPile))
 	{
-		// 检查是否为已消耗的唯一卡牌
-		if (ConsumedUniqueCards.Contains(Slot.CardId))
-		{
-			continue;
-		}
-		
-		// 检查槽位是否可以抽取（权重、出现次数等）
-		if (!Slot.CanDraw())
-		{
-			continue;
-		}
-		
-		// 获取实际权重 (DrawWeight * 保底系数)
-		float EffectiveWeight = Slot.GetEffectiveWeight();
-		
-		// 累加总权重
-		TotalWeight += EffectiveWeight;
-		
-		// 添加到有效槽位列表
-		ValidSlots.Add(&Slot);
+		DrawSampler.Build(DrawPile, ConsumedUniqueCards);
 	}
 	
+	int32 SelectedIndex = DrawSampler.Draw(RandomStream, &LastDrawInfo);
+	
 	// 如果没有有效槽位，尝试重新填充抽牌池
-	if (ValidSlots.Num() == 0)
+	if (SelectedIndex == INDEX_NONE)
 	{
 		UE_LOG(LogSGCard, Warning, TEXT("抽牌池为空，尝试重新填充..."));
 		
-		// 重新填充抽牌池
+		// 重新填充抽牌池（会重建采样器）
 		RefillDrawPile();
 		
-		// 再次收集有效槽位
-		ValidSlots.Reset();
-		TotalWeight = 0.0f;
-		
-		for (FSGCardDrawSlot& Slot : DrawPile)
-		{
-			if (ConsumedUniqueCards.Contains(Slot.CardId))
-			{
-				continue;
-			}
-			
-			if (!Slot.CanDraw())
-			{
-				continue;
-			}
-			
-			float EffectiveWeight = Slot.GetEffectiveWeight();
-			TotalWeight += EffectiveWeight;
-			ValidSlots.Add(&Slot);
-		}
+		SelectedIndex = DrawSampler.Draw(RandomStream, &LastDrawInfo);
 		
 		// 如果仍然没有有效槽位，返回失败
-		if (ValidSlots.Num() == 0)
+		if (SelectedIndex == INDEX_NONE)
 		{
 			UE_LOG(LogSGCard, Error, TEXT("❌ 抽牌失败：抽牌池为空且无法重新填充"));
 			return false;
 		}
 	}
 	
-	// 使用轮盘赌算法随机选择一个槽位
-	float RandomValue = RandomStream.FRandRange(0.0f, TotalWeight);
-	float CurrentWeight = 0.0f;
-	
-	FSGCardDrawSlot* SelectedSlot = nullptr;
-	for (FSGCardDrawSlot* Slot : ValidSlots)
-	{
-		float EffectiveWeight = Slot->GetEffectiveWeight();
-		CurrentWeight += EffectiveWeight;
-		
-		if (RandomValue <= CurrentWeight)
-		{
-			SelectedSlot = Slot;
-			break;
-		}
-	}
-	
-	// 如果未选中任何槽位，选择最后一个（兜底防止浮点误差）
-	if (!SelectedSlot && ValidSlots.Num() > 0)
-	{
-		SelectedSlot = ValidSlots.Last();
-		UE_LOG(LogSGCard, Warning, TEXT("⚠️ 轮盘赌算法未选中槽位，使用最后一个槽位"));
-	}
-	
-	if (!SelectedSlot)
-	{
-		UE_LOG(LogSGCard, Error, TEXT("❌ 抽牌失败：未能选中任何槽位"));
-		return false;
-	}
-	
-	// 更新所有槽位的 MissCount 和 OccurrenceCount
-	for (FSGCardDrawSlot* Slot : ValidSlots)
-	{
-		if (Slot == SelectedSlot)
-		{
-			// 抽到的槽位重置 MissCount
-			Slot->MissCount = 0;
-			// 增加出现次数
-			Slot->OccurrenceCount++;
-		}
-		else
-		{
-			// 未抽到的槽位增加 MissCount (增加下次抽中的概率)
-			Slot->MissCount++;
-		}
-	}
+	// 采样器已更新 MissCount 和 OccurrenceCount
+	FSGCardDrawSlot* SelectedSlot = &DrawPile[SelectedIndex];
 	
 	// 解析卡牌数据
 	USG_CardDataBase* CardData = ResolveCardData(SelectedSlot->CardId);
@@ -663,18 +614,17 @@ bool USG_CardDeckComponent::DrawSingleCard(FSGCardInstance& OutInstance)
 	OutInstance.bIsUnique = CardData->bIsUnique;
 	
 	// 记录详细的抽卡日志 (包含概率)
-	UE_LOG(LogSGCard, Log, TEXT("    🎲 抽中: %s (权重: %.1f/%.1f, 概率: %.1f%%, Miss: %d, Count: %d)"), 
+	UE_LOG(LogSGCard, Log, TEXT("    🎲 抽中: %s (概率: %.1f%%, 剩余总权重: %.1f, Count: %d)"), 
 		*CardData->CardName.ToString(), 
-		SelectedSlot->GetEffectiveWeight(),
-		TotalWeight,
-		(TotalWeight > 0.0f) ? (SelectedSlot->GetEffectiveWeight() / TotalWeight * 100.0f) : 0.0f,
-		SelectedSlot->MissCount,
+		LastDrawInfo.Probability * 100.0,
+		DrawSampler.GetTotalWeight(),
 		SelectedSlot->OccurrenceCount);
 	
 	// 如果是唯一卡牌，加入消耗列表
 	if (OutInstance.bIsUnique)
 	{
 		ConsumedUniqueCards.Add(SelectedSlot->CardId);
+		DrawSampler.ExcludeCard(SelectedSlot->CardId);
 		UE_LOG(LogSGCard, Log, TEXT("    唯一卡牌 [%s] 已加入消耗列表"), *CardData->CardName.ToString());
 	}
 	
@@ -687,6 +637,12 @@ void USG_CardDeckComponent::RefillDrawPile()
 	// 🔧 MODIFIED - 使用新的日志类别
 	UE_LOG(LogSGCard, Log, TEXT("开始重新填充抽牌池..."));
 	
+	// ✨ 新增 - 先把采样器维护的 MissCount 写回，保留保底进度
+	if (DrawSampler.IsBuiltFor(DrawPile))
+	{
+		DrawSampler.SyncMissCounts();
+	}
+	
 	// 将弃牌堆的所有槽位加入抽牌池
 	for (const FSGCardDrawSlot& Slot : DiscardPile)
 	{
@@ -720,6 +676,9 @@ void USG_CardDeckComponent::RefillDrawPile()
 		DrawPile.Swap(i, SwapIndex);
 	}
 	
+	// ✨ 新增 - 槽位结构已变化，重建权重采样器
+	DrawSampler.Build(DrawPile, ConsumedUniqueCards);
+	
 	// 🔧 MODIFIED - 使用新的日志类别
 	UE_LOG(LogSGCard, Log, TEXT("✓ 抽牌池重新填充完成，当前槽位数：%d"), DrawPile.Num());
 }
@@ -745,14 +704,14 @@ void USG_CardDeckComponent::StartCooldown()
     bActionAvailable = false;
     
     // 读取冷却时长
-    CooldownRemaining = ResolvedDeckConfig ? ResolvedDeckConfig->DrawCDSeconds : 0.0f;
+    const float CooldownDuration = ResolvedDeckConfig ? ResolvedDeckConfig->DrawCDSeconds : 0.0f;
     
     // 输出日志
     UE_LOG(LogSGCard, Log, TEXT("========== 开始冷却 =========="));
-    UE_LOG(LogSGCard, Log, TEXT("  冷却时长：%.2f 秒"), CooldownRemaining);
+    UE_LOG(LogSGCard, Log, TEXT("  冷却时长：%.2f 秒"), CooldownDuration);
     
     // 🔧 MODIFIED - 如果冷却时长小于 0.01 秒，视为 0
-    if (CooldownRemaining < 0.01f)
+    if (CooldownDuration < 0.01f)
     {
         // 输出日志
         UE_LOG(LogSGCard, Log, TEXT("  冷却时长接近 0，立即完成并抽卡"));
@@ -775,12 +734,16 @@ void USG_CardDeckComponent::StartCooldown()
             World->GetTimerManager().ClearTimer(CooldownTimerHandle);
         }
         
+        // ✨ 新增 - 记录冷却时间戳（计时器同样使用世界时间，暂停和时间膨胀下保持一致）
+        CooldownStartTime = World->GetTimeSeconds();
+        CooldownEndTime = CooldownStartTime + CooldownDuration;
+        
         // 设置冷却计时器
         World->GetTimerManager().SetTimer(
             CooldownTimerHandle, 
             this, 
             &USG_CardDeckComponent::CompleteCooldown, 
-            CooldownRemaining, 
+            CooldownDuration, 
             false  // 不循环
         );
         
@@ -809,8 +772,9 @@ void USG_CardDeckComponent::StartCooldown()
         return;
     }
     
-    // 广播状态
+    // 🔧 修改 - 状态切换时广播一次，UI 根据时间戳本地插值倒计时
     BroadcastActionState();
+    OnCooldownStarted.Broadcast(CooldownStartTime, CooldownEndTime);
     
     // 输出日志
     UE_LOG(LogSGCard, Log, TEXT("========================================"));
@@ -854,7 +818,8 @@ void USG_CardDeckComponent::CompleteCooldown()
     
 	// 恢复行动可用状态
 	bActionAvailable = true;
-	CooldownRemaining = 0.0f;
+	CooldownStartTime = 0.0f;
+	CooldownEndTime = 0.0f;
     
 	// 广播行动状态变化
 	BroadcastActionState();
@@ -863,30 +828,110 @@ void USG_CardDeckComponent::CompleteCooldown()
 // 广播行动状态
 void USG_CardDeckComponent::BroadcastActionState()
 {
+	// 🔧 修改 - 已废弃的 CooldownRemaining 在状态变化时同步一次
+	CooldownRemaining = GetCooldownRemaining();
 	
 	// 广播可用状态与冷却时间
 	OnActionStateChanged.Broadcast(bActionAvailable, CooldownRemaining);
 }
 
+// ✨ 新增 - 处理已使用的卡牌
+void USG_CardDeckComponent::DiscardUsedCard(const FSGCardInstance& UsedCard)
+{
+    // 非唯一卡加入弃牌堆
+    if (!UsedCard.bIsUnique)
+    {
+        // 构建弃牌槽位
+        FSGCardDrawSlot Slot;
+        // 记录卡牌 ID
+        Slot.CardId = UsedCard.CardId;
+        // 推入弃牌堆
+        DiscardPile.Add(Slot);
+        
+        // 输出日志
+        UE_LOG(LogSGCard, Log, TEXT("  ✓ 非唯一卡牌已加入弃牌堆"));
+    }
+    else
+    {
+        // 唯一卡记录为已使用
+        ConsumedUniqueCards.Add(UsedCard.CardId);
+        
+        // ✨ 新增 - 唯一卡牌离开卡池，释放预加载资产
+        if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
+        {
+            AssetManager->ReleaseCardPreload(UsedCard.CardId);
+        }
+        
+        // 输出日志
+        UE_LOG(LogSGCard, Log, TEXT("  ✓ 唯一卡牌已加入消耗列表，不会再次出现"));
+    }
+}
+
+// ✨ 新增 - 离线模拟：同步初始化
+void USG_CardDeckComponent::InitializeForSimulation(USG_DeckConfig* InDeckConfig, int32 Seed)
+{
+	ResolvedDeckConfig = InDeckConfig;
+	
+	HandCards.Empty();
+	DrawPile.Empty();
+	DiscardPile.Empty();
+	ConsumedUniqueCards.Empty();
+	
+	RandomStream.Initialize(Seed);
+	
+	if (!ResolvedDeckConfig)
+	{
+		return;
+	}
+	
+	BuildDrawPile();
+	bInitialized = true;
+	
+	// 与 HandleCardAssetsLoaded 相同：先抽保证卡牌，再补满初始手牌
+	TArray<FSGCardInstance> GuaranteedCards;
+	DrawGuaranteedCards(GuaranteedCards);
+	HandCards.Append(GuaranteedCards);
+	
+	DrawCards(FMath::Max(0, ResolvedDeckConfig->InitialHand - HandCards.Num()));
+}
+
+// ✨ 新增 - 离线模拟：打出一张手牌
+bool USG_CardDeckComponent::PlayCardForSimulation(int32 HandIndex)
+{
+	if (!HandCards.IsValidIndex(HandIndex))
+	{
+		return false;
+	}
+	
+	const FSGCardInstance UsedCard = HandCards[HandIndex];
+	HandCards.RemoveAt(HandIndex);
+	DiscardUsedCard(UsedCard);
+	return true;
+}
+
+// ✨ 新增 - 离线模拟：抽一张牌加入手牌
+bool USG_CardDeckComponent::DrawCardForSimulation()
+{
+	FSGCardInstance NewCard;
+	if (!DrawSingleCard(NewCard))
+	{
+		return false;
+	}
+	
+	HandCards.Add(NewCard);
+	return true;
+}
+
 // 加载卡牌数据
 USG_CardDataBase* USG_CardDeckComponent::ResolveCardData(const FPrimaryAssetId& CardId)
 {
-	// 优先从配置中查找
-	if (ResolvedDeckConfig)
+	// 🔧 修改 - 优先从构建抽牌池时缓存的卡牌数据中查找（不再每次调用 GetAllCardData）
+	if (const TObjectPtr<USG_CardDataBase>* CachedCard = LoadedCardData.Find(CardId))
 	{
-		// 🔧 MODIFIED - 使用 GetAllCardData() 获取所有卡牌数据
-		TArray<USG_CardDataBase*> AllCards = ResolvedDeckConfig->GetAllCardData();
-		
-		for (USG_CardDataBase* CardAsset : AllCards)
-		{
-			if (CardAsset && CardAsset->GetPrimaryAssetId() == CardId)
-			{
-				return CardAsset;
-			}
-		}
+		return *CachedCard;
 	}
 	
-	// 从 AssetManager 加载
+	// 从 AssetManager 查询已加载的对象（不触发加载）
 	if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
 	{
 		return Cast<USG_CardDataBase>(AssetManager->GetPrimaryAssetObject(CardId));
@@ -919,6 +964,11 @@ void USG_CardDeckComponent::HandleCardAssetsLoaded()
 
     // 初始化随机流
     int32 Seed = ResolvedDeckConfig->GetEffectiveRNGSeed();
+    // ✨ 新增 - 对局录制 / 回放时使用从对局种子派生的种子
+    if (const USG_ReplaySubsystem* Replay = GetWorld() ? GetWorld()->GetSubsystem<USG_ReplaySubsystem>() : nullptr)
+    {
+        Replay->ResolveStreamSeed(TEXT("Deck"), Seed);
+    }
     RandomStream.Initialize(Seed);
     UE_LOG(LogSGCard, Log, TEXT("随机种子：%d"), Seed);
 
@@ -1002,7 +1052,7 @@ void USG_CardDeckComponent::ForceSyncState()
 	OnSelectionChanged.Broadcast(SelectedCardId);
 	
 	// 广播当前行动状态
-	UE_LOG(LogSGCard, Log, TEXT("  广播行动状态（可用: %d, 冷却: %.2f）"), bActionAvailable, CooldownRemaining);
+	UE_LOG(LogSGCard, Log, TEXT("  广播行动状态（可用: %d, 冷却: %.2f）"), bActionAvailable, GetCooldownRemaining());
 	BroadcastActionState();
 	
 	// 记录同步完成
@@ -1021,26 +1071,35 @@ TArray<FPrimaryAssetId> USG_CardDeckComponent::GatherCardAssetIds() const
 		return Result;
 	}
 	
+	// 🔧 修改 - 通过软引用路径查询资产 ID，不加载卡牌（原 GetAllCardData 会同步加载）
+	USG_AssetManager* AssetManager = USG_AssetManager::Get();
+	if (!AssetManager)
+	{
+		return Result;
+	}
+	
 	// 使用 TSet 去重
 	TSet<FPrimaryAssetId> UniqueIds;
 	
-	// 🔧 MODIFIED - 使用 GetAllCardData() 获取所有卡牌数据
-	TArray<USG_CardDataBase*> AllCards = ResolvedDeckConfig->GetAllCardData();
-	
-	// 遍历所有卡牌数据
-	for (USG_CardDataBase* CardAsset : AllCards)
+	// 遍历所有配置槽位
+	for (const FSGCardConfigSlot& ConfigSlot : ResolvedDeckConfig->AllowedCards)
 	{
 		// 跳过空引用
-		if (!CardAsset)
+		if (ConfigSlot.CardData.IsNull())
 		{
 			continue;
 		}
 		
 		// 获取资产 ID
-		FPrimaryAssetId CardId = CardAsset->GetPrimaryAssetId();
+		FPrimaryAssetId CardId = AssetManager->GetPrimaryAssetIdForPath(ConfigSlot.CardData.ToSoftObjectPath());
+		if (!CardId.IsValid())
+		{
+			UE_LOG(LogSGAsset, Warning, TEXT("  ⚠️ 卡牌未注册为主资产，无法异步加载：%s（检查 DefaultGame.ini 的 PrimaryAssetTypesToScan）"), *ConfigSlot.CardData.ToString());
+			continue;
+		}
 		
-		// 检查 ID 有效性和是否已存在
-		if (!CardId.IsValid() || UniqueIds.Contains(CardId))
+		// 检查是否已存在
+		if (UniqueIds.Contains(CardId))
 		{
 			continue;
 		}
@@ -1070,6 +1129,15 @@ int32 USG_CardDeckComponent::DrawGuaranteedCards(TArray<FSGCardInstance>& OutIns
     
 	// 获取初始手牌数量限制
 	int32 MaxGuaranteed = ResolvedDeckConfig->InitialHand;
+	
+	// ✨ 新增 - 抽卡路径禁止同步加载
+	FSGScopedNoSyncLoad NoSyncLoad;
+	
+	// ✨ 新增 - 保证卡牌通过采样器更新槽位计数
+	if (!DrawSampler.IsBuiltFor(DrawPile))
+	{
+		DrawSampler.Build(DrawPile, ConsumedUniqueCards);
+	}
     
 	UE_LOG(LogSGCard, Log, TEXT("========== 抽取保证卡牌 =========="));
     
@@ -1091,14 +1159,12 @@ int32 USG_CardDeckComponent::DrawGuaranteedCards(TArray<FSGCardInstance>& OutIns
 			break;
 		}
         
-		// 加载卡牌数据
-		USG_CardDataBase* CardData = ConfigSlot.CardData.IsValid() 
-			? ConfigSlot.CardData.Get() 
-			: ConfigSlot.CardData.LoadSynchronous();
+		// 🔧 修改 - 只使用已加载的卡牌数据，不再 LoadSynchronous
+		USG_CardDataBase* CardData = ConfigSlot.CardData.Get();
         
 		if (!CardData)
 		{
-			UE_LOG(LogSGCard, Warning, TEXT("  ⚠️ 槽位 %d 的卡牌数据加载失败"), i);
+			UE_LOG(LogSGCard, Warning, TEXT("  ⚠️ 槽位 %d 的卡牌数据无效或未加载"), i);
 			continue;
 		}
         
@@ -1130,29 +1196,22 @@ int32 USG_CardDeckComponent::DrawGuaranteedCards(TArray<FSGCardInstance>& OutIns
 			ConsumedUniqueCards.Add(CardId);
 		}
         
-		// 🔧 修改核心逻辑：处理抽牌池中的槽位
-		// 查找对应的抽牌槽位
-		for (int32 j = DrawPile.Num() - 1; j >= 0; --j)
+		// 🔧 修改核心逻辑：处理抽牌池中的槽位（通过采样器更新，槽位数组结构保持不变）
+		if (CardData->bIsUnique)
+		{
+			// 分支 A：唯一卡牌不再参与抽取（槽位在下次重新填充时移除）
+			DrawSampler.ExcludeCard(CardId);
+			UE_LOG(LogSGCard, Verbose, TEXT("    [唯一] 槽位不再参与抽取"));
+		}
+		else
 		{
-			if (DrawPile[j].CardId == CardId)
+			// 分支 B：普通卡牌保留槽位，但增加出现计数并重置 MissCount
+			// 这样后续的 DrawCards 仍然可以从这个槽位抽卡，从而填满手牌
+			const int32 SlotIndex = DrawPile.FindLastByPredicate([&CardId](const FSGCardDrawSlot& Slot) { return Slot.CardId == CardId; });
+			if (SlotIndex != INDEX_NONE)
 			{
-				// 分支 A：如果是唯一卡牌，直接从抽牌池移除槽位（防止后续 DrawCards 再次抽到）
-				if (CardData->bIsUnique)
-				{
-					DrawPile.RemoveAt(j);
-					UE_LOG(LogSGCard, Verbose, TEXT("    [唯一] 从抽牌池移除槽位"));
-				}
-				// 分支 B：如果是普通卡牌（非唯一），保留槽位，但增加出现计数
-				// 这样后续的 DrawCards 仍然可以从这个槽位抽卡，从而填满手牌
-				else
-				{
-					DrawPile[j].OccurrenceCount++;
-					DrawPile[j].MissCount = 0; // 重置 MissCount，因为它被“选中”了
-					UE_LOG(LogSGCard, Verbose, TEXT("    [普通] 保留槽位，计数+1"));
-					
-					// 假设每个 ID 在 DrawPile 中只有一个槽位，找到后即可退出内层循环
-					break; 
-				}
+				DrawSampler.MarkDrawn(SlotIndex);
+				UE_LOG(LogSGCard, Verbose, TEXT("    [普通] 保留槽位，计数+1"));
 			}
 		}
 	}
@@ -0,0 +1,369 @@
+// 📄 文件：Source/Sguo/Private/CardsAndUnits/SG_WeightedCardSampler.cpp
+// ✨ 新增 - 权重抽卡采样器实现
+// ✅ 这是完整文件
+
+#include "CardsAndUnits/SG_WeightedCardSampler.h"
+#include "Math/RandomStream.h"
+
+// ========== 构建 ==========
+
+/**
+ * @brief 根据槽位数组构建采样器
+ * @details 槽位已有的 MissCount 会被保留（换算为"上次抽中序号"）
+ */
+void FSGWeightedCardSampler::Build(TArray<FSGCardDrawSlot>& InSlots, const TSet<FPrimaryAssetId>& ExcludedCards)
+{
+	Slots = &InSlots;
+
+	const int32 SlotCount = InSlots.Num();
+	SlotStates.Reset();
+	SlotStates.SetNum(SlotCount);
+	TreeA.Init(0.0, SlotCount + 1);
+	TreeB.Init(0.0, SlotCount + 1);
+	CapEvents.Reset();
+	DrawCounter = 0;
+	EligibleCount = 0;
+
+	TreeHighBit = 1;
+	while (TreeHighBit * 2 <= SlotCount)
+	{
+		TreeHighBit *= 2;
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < SlotCount; ++SlotIndex)
+	{
+		const FSGCardDrawSlot& Slot = InSlots[SlotIndex];
+		FSlotState& State = SlotStates[SlotIndex];
+
+		State.LastHitDraw = -static_cast<int64>(Slot.MissCount);
+		State.bEligible = !ExcludedCards.Contains(Slot.CardId) && Slot.CanDraw();
+
+		if (State.bEligible)
+		{
+			EligibleCount++;
+			RefreshSlot(SlotIndex);
+		}
+	}
+}
+
+/**
+ * @brief 清空采样器
+ */
+void FSGWeightedCardSampler::Reset()
+{
+	Slots = nullptr;
+	SlotStates.Reset();
+	TreeA.Reset();
+	TreeB.Reset();
+	CapEvents.Reset();
+	DrawCounter = 0;
+	EligibleCount = 0;
+}
+
+// ========== 抽卡 ==========
+
+/**
+ * @brief 抽取一个槽位
+ * @details
+ * 详细流程：
+ * 1. 把已到封顶时刻的槽位改为常数权重
+ * 2. 随机值 = RandomStream.FRand() × 总权重（与原 FRandRange(0, Total) 相同，只消耗一次随机数）
+ * 3. 树状数组下降查找第一个前缀和 ≥ 随机值的槽位
+ * 4. 更新被抽中槽位的计数，抽卡序号 +1（其余槽位的 MissCount 随之 +1）
+ */
+int32 FSGWeightedCardSampler::Draw(FRandomStream& RandomStream, FSGWeightedDrawInfo* OutInfo)
+{
+	if (!Slots)
+	{
+		return INDEX_NONE;
+	}
+
+	ApplyCapEvents();
+
+	if (EligibleCount == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const double TotalWeight = GetTotalWeight();
+	const double RandomValue = RandomStream.FRand() * TotalWeight;
+
+	int32 SelectedIndex = FindSlotByWeight(RandomValue);
+
+	// 随机值为 0 或浮点误差落到不可抽取槽位时，向后、再向前找最近的可抽取槽位
+	if (!SlotStates.IsValidIndex(SelectedIndex) || !SlotStates[SelectedIndex].bEligible)
+	{
+		const int32 StartIndex = FMath::Clamp(SelectedIndex, 0, SlotStates.Num() - 1);
+		SelectedIndex = INDEX_NONE;
+		for (int32 Index = StartIndex; Index < SlotStates.Num() && SelectedIndex == INDEX_NONE; ++Index)
+		{
+			SelectedIndex = SlotStates[Index].bEligible ? Index : INDEX_NONE;
+		}
+		for (int32 Index = StartIndex; Index >= 0 && SelectedIndex == INDEX_NONE; --Index)
+		{
+			SelectedIndex = SlotStates[Index].bEligible ? Index : INDEX_NONE;
+		}
+	}
+
+	if (SelectedIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	if (OutInfo)
+	{
+		const FSGCardDrawSlot& Slot = (*Slots)[SelectedIndex];
+		const int32 MissCount = GetMissCount(SelectedIndex);
+		const double UncappedBonus = 1.0 + MissCount * static_cast<double>(Slot.PityMultiplier);
+
+		OutInfo->Probability = TotalWeight > 0.0 ? GetEffectiveWeight(SelectedIndex) / TotalWeight : 0.0;
+		OutInfo->MissCount = MissCount;
+		OutInfo->PityBonus = FMath::Min<double>(UncappedBonus, Slot.PityMaxMultiplier);
+		OutInfo->bPityCapped = Slot.PityMultiplier > 0.0f && UncappedBonus >= Slot.PityMaxMultiplier;
+	}
+
+	DrawCounter++;
+	MarkDrawn(SelectedIndex);
+
+	return SelectedIndex;
+}
+
+/**
+ * @brief 标记槽位被选中
+ */
+void FSGWeightedCardSampler::MarkDrawn(int32 SlotIndex)
+{
+	if (!Slots || !SlotStates.IsValidIndex(SlotIndex))
+	{
+		return;
+	}
+
+	FSGCardDrawSlot& Slot = (*Slots)[SlotIndex];
+	FSlotState& State = SlotStates[SlotIndex];
+
+	State.LastHitDraw = DrawCounter;
+	Slot.MissCount = 0;
+	Slot.OccurrenceCount++;
+
+	if (!State.bEligible)
+	{
+		return;
+	}
+
+	if (Slot.CanDraw())
+	{
+		RefreshSlot(SlotIndex);
+	}
+	else
+	{
+		RemoveSlot(SlotIndex);
+	}
+}
+
+/**
+ * @brief 排除某卡牌的所有槽位
+ */
+void FSGWeightedCardSampler::ExcludeCard(const FPrimaryAssetId& CardId)
+{
+	if (!Slots)
+	{
+		return;
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < SlotStates.Num(); ++SlotIndex)
+	{
+		if (SlotStates[SlotIndex].bEligible && (*Slots)[SlotIndex].CardId == CardId)
+		{
+			RemoveSlot(SlotIndex);
+		}
+	}
+}
+
+// ========== 查询 ==========
+
+/**
+ * @brief 获取槽位当前的实际权重
+ */
+double FSGWeightedCardSampler::GetEffectiveWeight(int32 SlotIndex) const
+{
+	if (!SlotStates.IsValidIndex(SlotIndex))
+	{
+		return 0.0;
+	}
+
+	const FSlotState& State = SlotStates[SlotIndex];
+	return State.WeightA + static_cast<double>(DrawCounter) * State.WeightB;
+}
+
+/**
+ * @brief 获取所有可抽取槽位的总权重
+ */
+double FSGWeightedCardSampler::GetTotalWeight() const
+{
+	const double Counter = static_cast<double>(DrawCounter);
+
+	double SumA = 0.0;
+	double SumB = 0.0;
+	for (int32 TreeIndex = SlotStates.Num(); TreeIndex > 0; TreeIndex -= TreeIndex & -TreeIndex)
+	{
+		SumA += TreeA[TreeIndex];
+		SumB += TreeB[TreeIndex];
+	}
+	return SumA + Counter * SumB;
+}
+
+/**
+ * @brief 获取槽位当前的 MissCount
+ */
+int32 FSGWeightedCardSampler::GetMissCount(int32 SlotIndex) const
+{
+	if (!Slots || !SlotStates.IsValidIndex(SlotIndex))
+	{
+		return 0;
+	}
+
+	const FSlotState& State = SlotStates[SlotIndex];
+	if (!State.bEligible)
+	{
+		return (*Slots)[SlotIndex].MissCount;
+	}
+	return static_cast<int32>(FMath::Min<int64>(DrawCounter - State.LastHitDraw, MAX_int32));
+}
+
+/**
+ * @brief 把所有槽位的 MissCount 写回槽位数组
+ */
+void FSGWeightedCardSampler::SyncMissCounts() const
+{
+	if (!Slots)
+	{
+		return;
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < SlotStates.Num(); ++SlotIndex)
+	{
+		(*Slots)[SlotIndex].MissCount = GetMissCount(SlotIndex);
+	}
+}
+
+// ========== 内部 ==========
+
+/**
+ * @brief 重新计算权重系数，并登记封顶事件
+ * @details
+ * - 未封顶：权重 = DrawWeight × (1 + (T - LastHit) × Pity) = A + T × B
+ *   A = DrawWeight × (1 - LastHit × Pity)，B = DrawWeight × Pity
+ * - 已封顶或保底系数为 0：常数权重
+ */
+void FSGWeightedCardSampler::RefreshSlot(int32 SlotIndex)
+{
+	const FSGCardDrawSlot& Slot = (*Slots)[SlotIndex];
+	const FSlotState& State = SlotStates[SlotIndex];
+
+	const double BaseWeight = Slot.DrawWeight;
+	const double Pity = Slot.PityMultiplier;
+	const double PityMax = Slot.PityMaxMultiplier;
+	const int64 MissCount = DrawCounter - State.LastHitDraw;
+
+	const double PityBonus = 1.0 + static_cast<double>(MissCount) * Pity;
+	if (Pity <= 0.0 || PityBonus >= PityMax)
+	{
+		SetSlotWeight(SlotIndex, BaseWeight * FMath::Min(PityBonus, PityMax), 0.0);
+		return;
+	}
+
+	SetSlotWeight(
+		SlotIndex,
+		BaseWeight * (1.0 - static_cast<double>(State.LastHitDraw) * Pity),
+		BaseWeight * Pity);
+
+	// 第一个满足 1 + (T - LastHit) × Pity ≥ PityMax 的抽卡序号（至少为下一次抽卡，避免浮点误差导致重复登记）
+	FCapEvent CapEvent;
+	CapEvent.CapDraw = FMath::Max(
+		State.LastHitDraw + static_cast<int64>(FMath::CeilToDouble((PityMax - 1.0) / Pity)),
+		DrawCounter + 1);
+	CapEvent.SlotIndex = SlotIndex;
+	CapEvent.LastHitDraw = State.LastHitDraw;
+	CapEvents.HeapPush(CapEvent);
+}
+
+/**
+ * @brief 把槽位设为不可抽取
+ */
+void FSGWeightedCardSampler::RemoveSlot(int32 SlotIndex)
+{
+	FSlotState& State = SlotStates[SlotIndex];
+	if (!State.bEligible)
+	{
+		return;
+	}
+
+	(*Slots)[SlotIndex].MissCount = GetMissCount(SlotIndex);
+	State.bEligible = false;
+	EligibleCount--;
+	SetSlotWeight(SlotIndex, 0.0, 0.0);
+}
+
+/**
+ * @brief 处理已到达的封顶事件
+ * @details 槽位在登记后又被抽中时，事件中的 LastHitDraw 不再匹配，直接丢弃
+ */
+void FSGWeightedCardSampler::ApplyCapEvents()
+{
+	while (CapEvents.Num() > 0 && CapEvents.HeapTop().CapDraw <= DrawCounter)
+	{
+		FCapEvent CapEvent;
+		CapEvents.HeapPop(CapEvent, EAllowShrinking::No);
+
+		const FSlotState& State = SlotStates[CapEvent.SlotIndex];
+		if (State.bEligible && State.LastHitDraw == CapEvent.LastHitDraw)
+		{
+			RefreshSlot(CapEvent.SlotIndex);
+		}
+	}
+}
+
+/**
+ * @brief 修改槽位的权重系数
+ */
+void FSGWeightedCardSampler::SetSlotWeight(int32 SlotIndex, double NewA, double NewB)
+{
+	FSlotState& State = SlotStates[SlotIndex];
+	const double DeltaA = NewA - State.WeightA;
+	const double DeltaB = NewB - State.WeightB;
+	State.WeightA = NewA;
+	State.WeightB = NewB;
+
+	for (int32 TreeIndex = SlotIndex + 1; TreeIndex < TreeA.Num(); TreeIndex += TreeIndex & -TreeIndex)
+	{
+		TreeA[TreeIndex] += DeltaA;
+		TreeB[TreeIndex] += DeltaB;
+	}
+}
+
+/**
+ * @brief 查找第一个前缀和 ≥ Target 的槽位
+ * @return 槽位索引（Target 超过总权重时返回槽位数量）
+ */
+int32 FSGWeightedCardSampler::FindSlotByWeight(double Target) const
+{
+	const double Counter = static_cast<double>(DrawCounter);
+	const int32 SlotCount = SlotStates.Num();
+
+	int32 Position = 0;
+	double Accumulated = 0.0;
+	for (int32 Step = TreeHighBit; Step > 0; Step >>= 1)
+	{
+		const int32 Next = Position + Step;
+		if (Next <= SlotCount)
+		{
+			const double NodeWeight = TreeA[Next] + Counter * TreeB[Next];
+			if (Accumulated + NodeWeight < Target)
+			{
+				Position = Next;
+				Accumulated += NodeWeight;
+			}
+		}
+	}
+	return Position;
+}
@@ -0,0 +1,487 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_BattleBenchmarkSubsystem.cpp
+// ✨ 新增 - 大规模战斗性能基准实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_BattleBenchmarkSubsystem.h"
+#include "Debug/SG_DebugSettings.h"
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Actors/SG_EnemySpawner.h"
+#include "Data/SG_CharacterCardData.h"
+#include "Units/SG_SpawnSchedulerSubsystem.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+
+namespace SGBattleBenchmark
+{
+    // 双方阵营
+    const TCHAR* const FactionTags[2] = { TEXT("Unit.Faction.Player"), TEXT("Unit.Faction.Enemy") };
+
+    // 兵种出现权重：近战、远程、立定弓手
+    const float CardWeights[3] = { 0.5f, 0.3f, 0.2f };
+
+    // 等待生成的最长时间（秒），超时视为配置错误
+    constexpr double MaxSpawnSeconds = 60.0;
+
+    /**
+     * @brief 单张卡牌生成的单位数
+     */
+    int32 GetUnitsPerCard(const USG_CharacterCardData* Card)
+    {
+        return Card->bIsTroopCard ? FMath::Max(1, Card->TroopFormation.X * Card->TroopFormation.Y) : 1;
+    }
+
+    /**
+     * @brief 控制台命令：SG.Benchmark.Run <每方单位数> <秒数> <种子>
+     */
+    void RunFromConsole(const TArray<FString>& Args, UWorld* World)
+    {
+        USG_BattleBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<USG_BattleBenchmarkSubsystem>() : nullptr;
+        if (!Benchmark)
+        {
+            UE_LOG(LogSGGameplay, Warning, TEXT("SG.Benchmark.Run：当前世界没有性能基准子系统"));
+            return;
+        }
+
+        const int32 Units = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 500;
+        const float Seconds = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 30.0f;
+        const int32 RunSeed = Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 1337;
+        Benchmark->StartBenchmark(Units, Seconds, RunSeed);
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs RunCommand(
+        TEXT("SG.Benchmark.Run"),
+        TEXT("运行大规模战斗性能基准。用法：SG.Benchmark.Run <每方单位数=500> <秒数=30> <种子=1337>"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunFromConsole));
+}
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 只在非 Shipping 的游戏世界创建
+ */
+bool USG_BattleBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    const UWorld* World = Outer ? Outer->GetWorld() : nullptr;
+    return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+/**
+ * @brief 世界开始时检查命令行，-SGBenchmark 时自动开始
+ */
+void USG_BattleBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+    if (!FParse::Param(CommandLine, TEXT("SGBenchmark")))
+    {
+        return;
+    }
+
+    int32 Units = 500;
+    float Seconds = 30.0f;
+    int32 RunSeed = 1337;
+    FParse::Value(CommandLine, TEXT("SGBenchmarkUnits="), Units);
+    FParse::Value(CommandLine, TEXT("SGBenchmarkSeconds="), Seconds);
+    FParse::Value(CommandLine, TEXT("SGBenchmarkSeed="), RunSeed);
+    FParse::Value(CommandLine, TEXT("SGBenchmarkTag="), RunTag);
+    FParse::Value(CommandLine, TEXT("SGBenchmarkOut="), OutputDir);
+
+    bExitWhenDone = true;
+    if (!StartBenchmark(Units, Seconds, RunSeed))
+    {
+        ExitIfRequested(2);
+    }
+}
+
+void USG_BattleBenchmarkSubsystem::Deinitialize()
+{
+    if (Phase == EPhase::Capture)
+    {
+        FSGScopeTimer::SetCaptureEnabled(false);
+    }
+    Phase = EPhase::Idle;
+    Spawners.Empty();
+    Samples.Empty();
+
+    Super::Deinitialize();
+}
+
+// ========== 基准接口 ==========
+
+/**
+ * @brief 开始一次基准
+ * @details
+ * 详细流程：
+ * 1. 加载配置中的三种卡牌（未配置的兵种跳过）
+ * 2. 固定基准自身和双方生成器的随机流（不改动全局 FMath::Rand 状态）
+ * 3. 双方各放置一个生成器，按权重随机兵种、随机横向位置提交兵团，直到达到单位数
+ */
+bool USG_BattleBenchmarkSubsystem::StartBenchmark(int32 InUnitsPerSide, float InDurationSeconds, int32 InSeed)
+{
+    if (Phase != EPhase::Idle)
+    {
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 性能基准已在运行"));
+        return false;
+    }
+
+    const USG_DebugSettings* Settings = USG_DebugSettings::Get();
+
+    TArray<USG_CharacterCardData*> Cards;
+    TArray<float> CardWeights;
+    const TSoftObjectPtr<USG_CharacterCardData>* CardPaths[3] = {
+        &Settings->BenchmarkMeleeCard, &Settings->BenchmarkRangedCard, &Settings->BenchmarkStationaryCard };
+    for (int32 Index = 0; Index < static_cast<int32>(UE_ARRAY_COUNT(CardPaths)); ++Index)
+    {
+        USG_CharacterCardData* Card = CardPaths[Index]->LoadSynchronous();
+        // 🔧 修改 - 角色类为软引用，基准准备阶段同步加载
+        if (Card && Card->CharacterClass.LoadSynchronous())
+        {
+            Cards.Add(Card);
+            CardWeights.Add(SGBattleBenchmark::CardWeights[Index]);
+        }
+    }
+
+    if (Cards.Num() == 0)
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 性能基准：项目设置 → 调试系统 → 性能基准 中没有可用的卡牌"));
+        return false;
+    }
+
+    UnitsPerSide = FMath::Max(1, InUnitsPerSide);
+    DurationSeconds = FMath::Max(1.0f, InDurationSeconds);
+    Seed = InSeed;
+
+    // 🔧 修改 - 只固定基准自己的随机流，全局 FMath::Rand 属于游戏逻辑，不在这里重置
+    RandomStream.Initialize(Seed);
+
+    Samples.Reset();
+    Samples.Reserve(FMath::CeilToInt(DurationSeconds * 120.0f));
+    LastSummary = FSGBenchmarkSummary();
+
+    SpawnedUnitCount = 0;
+    for (int32 SideIndex = 0; SideIndex < 2; ++SideIndex)
+    {
+        SpawnedUnitCount += SpawnArmy(SideIndex, Cards, CardWeights);
+    }
+
+    UE_LOG(LogSGGameplay, Log, TEXT("========== 战斗性能基准开始 =========="));
+    UE_LOG(LogSGGameplay, Log, TEXT("  每方单位：%d  实际提交：%d  时长：%.1f 秒  种子：%d"),
+        UnitsPerSide, SpawnedUnitCount, DurationSeconds, Seed);
+
+    Phase = EPhase::Spawning;
+    PhaseStartTime = FPlatformTime::Seconds();
+    return true;
+}
+
+/**
+ * @brief 放置一方的生成器并提交该方全部兵团
+ * @details 第 0 方在 -X 侧朝 +X，第 1 方在 +X 侧朝 -X；每支兵团在军队区域内随机横向位置和纵深
+ */
+int32 USG_BattleBenchmarkSubsystem::SpawnArmy(int32 SideIndex, const TArray<USG_CharacterCardData*>& Cards, const TArray<float>& CardWeights)
+{
+    const USG_DebugSettings* Settings = USG_DebugSettings::Get();
+    const float Direction = SideIndex == 0 ? -1.0f : 1.0f;
+    const FVector ArmyCenter(Direction * Settings->BenchmarkArmySpacing * 0.5f, 0.0f, 0.0f);
+    const FRotator Facing(0.0f, SideIndex == 0 ? 0.0f : 180.0f, 0.0f);
+
+    ASG_EnemySpawner* Spawner = GetWorld()->SpawnActorDeferred<ASG_EnemySpawner>(
+        ASG_EnemySpawner::StaticClass(), FTransform(Facing, ArmyCenter));
+    if (!Spawner)
+    {
+        return 0;
+    }
+    Spawner->bAutoStart = false;
+    Spawner->FactionTag = FGameplayTag::RequestGameplayTag(SGBattleBenchmark::FactionTags[SideIndex]);
+    Spawner->SpawnRotation = Facing;
+    Spawner->FinishSpawning(FTransform(Facing, ArmyCenter));
+    // 🔧 修改 - BeginPlay 已用时间戳播种，这里按基准种子和阵营重新播种（双方流互不相同）
+    Spawner->SetRandomSeed(static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(SideIndex))));
+    Spawners.Add(Spawner);
+
+    float TotalWeight = 0.0f;
+    for (const float Weight : CardWeights)
+    {
+        TotalWeight += Weight;
+    }
+
+    // 纵深为军队宽度的四分之一，后排离敌人更远
+    const float HalfWidth = Settings->BenchmarkArmyWidth * 0.5f;
+    const float Depth = Settings->BenchmarkArmyWidth * 0.25f;
+
+    int32 Submitted = 0;
+    while (Submitted < UnitsPerSide)
+    {
+        float Roll = RandomStream.FRandRange(0.0f, TotalWeight);
+        int32 CardIndex = 0;
+        while (CardIndex < CardWeights.Num() - 1 && Roll >= CardWeights[CardIndex])
+        {
+            Roll -= CardWeights[CardIndex];
+            ++CardIndex;
+        }
+
+        const FVector Location = ArmyCenter + FVector(
+            Direction * RandomStream.FRandRange(0.0f, Depth),
+            RandomStream.FRandRange(-HalfWidth, HalfWidth),
+            0.0f);
+
+        if (!Spawner->SpawnCardAt(Cards[CardIndex], Location))
+        {
+            break;
+        }
+        Submitted += SGBattleBenchmark::GetUnitsPerCard(Cards[CardIndex]);
+    }
+    return Submitted;
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧推进阶段并采样
+ */
+void USG_BattleBenchmarkSubsystem::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    switch (Phase)
+    {
+    case EPhase::Spawning:
+    {
+        const USG_SpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<USG_SpawnSchedulerSubsystem>();
+        if (!Scheduler || Scheduler->GetPendingUnitCount() == 0)
+        {
+            UE_LOG(LogSGGameplay, Log, TEXT("  生成完成，耗时 %.2f 秒，开始预热"), Now - PhaseStartTime);
+            Phase = EPhase::Warmup;
+            PhaseStartTime = Now;
+        }
+        else if (Now - PhaseStartTime > SGBattleBenchmark::MaxSpawnSeconds)
+        {
+            UE_LOG(LogSGGameplay, Error, TEXT("❌ 性能基准：%.0f 秒内未生成完毕，剩余 %d"),
+                SGBattleBenchmark::MaxSpawnSeconds, Scheduler->GetPendingUnitCount());
+            Phase = EPhase::Idle;
+            ExitIfRequested(2);
+        }
+        break;
+    }
+
+    case EPhase::Warmup:
+        if (Now - PhaseStartTime >= USG_DebugSettings::Get()->BenchmarkWarmupSeconds)
+        {
+            BeginCapture();
+        }
+        break;
+
+    case EPhase::Capture:
+    {
+        FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+        Sample.FrameMs = static_cast<float>((Now - LastFrameTime) * 1000.0);
+        // 无渲染时 GGameThreadTime 可能不更新，退回帧时间
+        Sample.GameThreadMs = GGameThreadTime > 0 ? FPlatformTime::ToMilliseconds(GGameThreadTime) : Sample.FrameMs;
+        if (const USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>())
+        {
+            Sample.AliveUnits = Registry->GetActiveCount();
+        }
+        LastFrameTime = Now;
+
+        if (Now - PhaseStartTime >= DurationSeconds)
+        {
+            FinishBenchmark();
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 开始采样
+ */
+void USG_BattleBenchmarkSubsystem::BeginCapture()
+{
+    FSGScopeTimer::ResetAll();
+    FSGScopeTimer::SetCaptureEnabled(true);
+
+    Phase = EPhase::Capture;
+    PhaseStartTime = FPlatformTime::Seconds();
+    LastFrameTime = PhaseStartTime;
+
+    UE_LOG(LogSGGameplay, Log, TEXT("  开始采样 %.1f 秒"), DurationSeconds);
+}
+
+/**
+ * @brief 结束采样
+ * @details
+ * 详细流程：
+ * 1. 计算游戏线程平均、P95、最大耗时
+ * 2. 按名字汇总各计时作用域，换算为每帧平均耗时
+ * 3. 按总单位数选择帧时间预算，检查游戏线程和各作用域是否超预算
+ * 4. 输出报告，命令行启动时退出进程
+ */
+void USG_BattleBenchmarkSubsystem::FinishBenchmark()
+{
+    FSGScopeTimer::SetCaptureEnabled(false);
+    Phase = EPhase::Idle;
+
+    const USG_DebugSettings* Settings = USG_DebugSettings::Get();
+    const int32 NumFrames = FMath::Max(1, Samples.Num());
+
+    // ========== 游戏线程 ==========
+
+    TArray<float> GameThreadMs;
+    GameThreadMs.Reserve(Samples.Num());
+    double SumMs = 0.0;
+    for (const FFrameSample& Sample : Samples)
+    {
+        GameThreadMs.Add(Sample.GameThreadMs);
+        SumMs += Sample.GameThreadMs;
+    }
+    GameThreadMs.Sort();
+
+    const float AvgMs = static_cast<float>(SumMs / NumFrames);
+    const float P95Ms = GameThreadMs.Num() > 0 ? GameThreadMs[FMath::Clamp(FMath::CeilToInt(GameThreadMs.Num() * 0.95f) - 1, 0, GameThreadMs.Num() - 1)] : 0.0f;
+    const float MaxMs = GameThreadMs.Num() > 0 ? GameThreadMs.Last() : 0.0f;
+
+    // ========== 计时作用域 ==========
+
+    TMap<FString, FSGBenchmarkScopeResult> ScopeMap;
+    for (const FSGScopeTimer* Timer = FSGScopeTimer::GetFirst(); Timer; Timer = Timer->GetNext())
+    {
+        FSGBenchmarkScopeResult& Result = ScopeMap.FindOrAdd(Timer->GetName());
+        Result.Name = Timer->GetName();
+        Result.TotalMs += FPlatformTime::ToMilliseconds64(Timer->GetCycles());
+        Result.Calls += Timer->GetCalls();
+    }
+
+    TArray<FSGBenchmarkScopeResult> ScopeResults;
+    bool bScopesPassed = true;
+    for (TPair<FString, FSGBenchmarkScopeResult>& Pair : ScopeMap)
+    {
+        FSGBenchmarkScopeResult& Result = Pair.Value;
+        Result.PerFrameMs = Result.TotalMs / NumFrames;
+        if (const float* Budget = Settings->BenchmarkScopeBudgetsMs.Find(FName(*Result.Name)))
+        {
+            Result.BudgetMs = *Budget;
+            Result.bOverBudget = Result.PerFrameMs > *Budget;
+            bScopesPassed &= !Result.bOverBudget;
+        }
+        ScopeResults.Add(MoveTemp(Result));
+    }
+    ScopeResults.Sort([](const FSGBenchmarkScopeResult& A, const FSGBenchmarkScopeResult& B) { return A.TotalMs > B.TotalMs; });
+
+    // ========== 预算 ==========
+
+    const int32 TotalUnits = SpawnedUnitCount;
+    const FSGBenchmarkBudget* Budget = Settings->BenchmarkBudgets.FindByPredicate(
+        [TotalUnits](const FSGBenchmarkBudget& Entry) { return Entry.UnitCount >= TotalUnits; });
+    if (!Budget && Settings->BenchmarkBudgets.Num() > 0)
+    {
+        Budget = &Settings->BenchmarkBudgets.Last();
+    }
+
+    const float AvgBudgetMs = Budget ? Budget->AvgGameThreadMs : 0.0f;
+    const float P95BudgetMs = Budget ? Budget->P95GameThreadMs : 0.0f;
+    const bool bFramePassed = !Budget || (AvgMs <= AvgBudgetMs && P95Ms <= P95BudgetMs);
+    const bool bPassed = bFramePassed && bScopesPassed;
+
+    UE_LOG(LogSGGameplay, Display, TEXT("========== 战斗性能基准结果 =========="));
+    UE_LOG(LogSGGameplay, Display, TEXT("单位：%d  帧数：%d  游戏线程 平均 %.2f / P95 %.2f / 最大 %.2f 毫秒（预算 %.2f / %.2f）"),
+        TotalUnits, Samples.Num(), AvgMs, P95Ms, MaxMs, AvgBudgetMs, P95BudgetMs);
+    for (const FSGBenchmarkScopeResult& Result : ScopeResults)
+    {
+        UE_LOG(LogSGGameplay, Display, TEXT("  %-24s 每帧 %8.3f 毫秒  调用 %10llu%s"),
+            *Result.Name, Result.PerFrameMs, Result.Calls, Result.bOverBudget ? TEXT("  ❌ 超预算") : TEXT(""));
+    }
+    UE_LOG(LogSGGameplay, Display, TEXT("结果：%s"), bPassed ? TEXT("✅ 通过") : TEXT("❌ 超预算"));
+
+    // ✨ 新增 - 保存汇总结果供自动化测试断言
+    LastSummary.bCompleted = true;
+    LastSummary.TotalUnits = TotalUnits;
+    LastSummary.Frames = Samples.Num();
+    LastSummary.AvgGameThreadMs = AvgMs;
+    LastSummary.P95GameThreadMs = P95Ms;
+    LastSummary.MaxGameThreadMs = MaxMs;
+    LastSummary.bHasFrameBudget = Budget != nullptr;
+    LastSummary.AvgBudgetMs = AvgBudgetMs;
+    LastSummary.P95BudgetMs = P95BudgetMs;
+    LastSummary.bFramePassed = bFramePassed;
+    LastSummary.bScopesPassed = bScopesPassed;
+    LastSummary.bPassed = bPassed;
+    LastSummary.Scopes = ScopeResults;
+
+    WriteReports(ScopeResults, AvgMs, P95Ms, MaxMs, AvgBudgetMs, P95BudgetMs, bPassed);
+    ExitIfRequested(bPassed ? 0 : 1);
+}
+
+/**
+ * @brief 写出报告
+ * @details 文件名 SGBattle_<总单位数>_<时间戳>，JSON 为汇总，CSV 为逐帧数据
+ */
+void USG_BattleBenchmarkSubsystem::WriteReports(const TArray<FSGBenchmarkScopeResult>& ScopeResults, float AvgMs, float P95Ms, float MaxMs,
+    float AvgBudgetMs, float P95BudgetMs, bool bPassed) const
+{
+    const FString Directory = OutputDir.IsEmpty() ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks")) : OutputDir;
+    const FString BaseName = FString::Printf(TEXT("SGBattle_%d_%s"), SpawnedUnitCount, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+
+    // ========== JSON ==========
+
+    FString Json;
+    Json += TEXT("{\n");
+    Json += FString::Printf(TEXT("  \"tag\": \"%s\",\n"), *RunTag.ReplaceCharWithEscapedChar());
+    Json += FString::Printf(TEXT("  \"map\": \"%s\",\n"), *GetWorld()->GetMapName());
+    Json += FString::Printf(TEXT("  \"unitsPerSide\": %d,\n  \"totalUnits\": %d,\n  \"seed\": %d,\n"), UnitsPerSide, SpawnedUnitCount, Seed);
+    Json += FString::Printf(TEXT("  \"durationSeconds\": %.2f,\n  \"frames\": %d,\n"), DurationSeconds, Samples.Num());
+    Json += FString::Printf(TEXT("  \"gameThreadMs\": { \"avg\": %.3f, \"p95\": %.3f, \"max\": %.3f, \"avgBudget\": %.3f, \"p95Budget\": %.3f },\n"),
+        AvgMs, P95Ms, MaxMs, AvgBudgetMs, P95BudgetMs);
+    Json += TEXT("  \"scopes\": [\n");
+    for (int32 Index = 0; Index < ScopeResults.Num(); ++Index)
+    {
+        const FSGBenchmarkScopeResult& Result = ScopeResults[Index];
+        Json += FString::Printf(TEXT("    { \"name\": \"%s\", \"totalMs\": %.3f, \"perFrameMs\": %.4f, \"calls\": %llu, \"budgetMs\": %.3f, \"overBudget\": %s }%s\n"),
+            *Result.Name, Result.TotalMs, Result.PerFrameMs, Result.Calls, Result.BudgetMs,
+            Result.bOverBudget ? TEXT("true") : TEXT("false"), Index + 1 < ScopeResults.Num() ? TEXT(",") : TEXT(""));
+    }
+    Json += TEXT("  ],\n");
+    Json += FString::Printf(TEXT("  \"passed\": %s\n}\n"), bPassed ? TEXT("true") : TEXT("false"));
+
+    // ========== CSV ==========
+
+    FString Csv = TEXT("Frame,FrameMs,GameThreadMs,AliveUnits\n");
+    for (int32 Index = 0; Index < Samples.Num(); ++Index)
+    {
+        const FFrameSample& Sample = Samples[Index];
+        Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%d\n"), Index, Sample.FrameMs, Sample.GameThreadMs, Sample.AliveUnits);
+    }
+
+    const FString JsonPath = FPaths::Combine(Directory, BaseName + TEXT(".json"));
+    const FString CsvPath = FPaths::Combine(Directory, BaseName + TEXT(".csv"));
+    if (FFileHelper::SaveStringToFile(Json, *JsonPath) && FFileHelper::SaveStringToFile(Csv, *CsvPath))
+    {
+        UE_LOG(LogSGGameplay, Display, TEXT("报告已写入：%s"), *JsonPath);
+    }
+    else
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 报告写入失败：%s"), *Directory);
+    }
+}
+
+void USG_BattleBenchmarkSubsystem::ExitIfRequested(int32 ExitCode) const
+{
+    if (bExitWhenDone)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, static_cast<uint8>(ExitCode));
+    }
+}
@@ -0,0 +1,158 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_BattleBenchmarkTest.cpp
+// ✨ 新增 - 战斗性能基准自动化测试
+// ✅ 这是完整文件
+
+#include "Debug/SG_BattleBenchmarkSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SGBattleBenchmarkTest
+{
+    // 标准基准地图
+    const TCHAR* const MapName = TEXT("/Game/Map/Lvl_TestDown");
+
+    // 最小档位：每方 100 单位（总 200，对应第一档预算）
+    constexpr int32 UnitsPerSide = 100;
+    constexpr float DurationSeconds = 10.0f;
+    constexpr int32 Seed = 1337;
+
+    // 等待基准结束的最长时间（秒）：生成上限 60 + 预热 + 采样 + 余量
+    constexpr double TimeoutSeconds = 120.0;
+
+    /**
+     * @brief 获取当前游戏世界的性能基准子系统
+     */
+    USG_BattleBenchmarkSubsystem* GetBenchmark()
+    {
+        if (!GEngine)
+        {
+            return nullptr;
+        }
+
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            UWorld* World = Context.World();
+            if (World && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE))
+            {
+                return World->GetSubsystem<USG_BattleBenchmarkSubsystem>();
+            }
+        }
+        return nullptr;
+    }
+}
+
+/**
+ * @brief 开始基准
+ */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FSGStartBattleBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FSGStartBattleBenchmarkCommand::Update()
+{
+    using namespace SGBattleBenchmarkTest;
+
+    USG_BattleBenchmarkSubsystem* Benchmark = GetBenchmark();
+    if (!Test->TestNotNull(TEXT("性能基准子系统"), Benchmark))
+    {
+        return true;
+    }
+
+    Test->TestTrue(TEXT("开始基准（项目设置中需配置基准卡牌）"), Benchmark->StartBenchmark(UnitsPerSide, DurationSeconds, Seed));
+    return true;
+}
+
+/**
+ * @brief 等待基准结束并断言预算
+ */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FSGWaitBattleBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FSGWaitBattleBenchmarkCommand::Update()
+{
+    using namespace SGBattleBenchmarkTest;
+
+    USG_BattleBenchmarkSubsystem* Benchmark = GetBenchmark();
+    if (!Benchmark)
+    {
+        Test->AddError(TEXT("等待期间性能基准子系统失效"));
+        return true;
+    }
+
+    if (Benchmark->IsRunning())
+    {
+        if (GetCurrentRunTime() > TimeoutSeconds)
+        {
+            Test->AddError(FString::Printf(TEXT("性能基准 %.0f 秒内未结束"), TimeoutSeconds));
+            return true;
+        }
+        return false;
+    }
+
+    const FSGBenchmarkSummary& Summary = Benchmark->GetLastSummary();
+    if (!Test->TestTrue(TEXT("基准完整跑完（生成未超时）"), Summary.bCompleted))
+    {
+        return true;
+    }
+
+    Test->TestTrue(TEXT("双方单位全部提交"), Summary.TotalUnits >= UnitsPerSide * 2);
+    Test->TestTrue(TEXT("采样到帧数据"), Summary.Frames > 0);
+
+    // 帧时间预算
+    if (Test->TestTrue(TEXT("配置了对应单位数的帧时间预算"), Summary.bHasFrameBudget))
+    {
+        Test->TestTrue(
+            FString::Printf(TEXT("游戏线程平均 %.2f 毫秒 ≤ 预算 %.2f"), Summary.AvgGameThreadMs, Summary.AvgBudgetMs),
+            Summary.AvgGameThreadMs <= Summary.AvgBudgetMs);
+        Test->TestTrue(
+            FString::Printf(TEXT("游戏线程 P95 %.2f 毫秒 ≤ 预算 %.2f"), Summary.P95GameThreadMs, Summary.P95BudgetMs),
+            Summary.P95GameThreadMs <= Summary.P95BudgetMs);
+    }
+
+    // 作用域预算
+    for (const FSGBenchmarkScopeResult& Scope : Summary.Scopes)
+    {
+        if (Scope.BudgetMs > 0.0f)
+        {
+            Test->TestFalse(
+                FString::Printf(TEXT("%s 每帧 %.3f 毫秒 ≤ 预算 %.3f"), *Scope.Name, Scope.PerFrameMs, Scope.BudgetMs),
+                Scope.bOverBudget);
+        }
+    }
+
+    Test->TestTrue(TEXT("基准总体通过"), Summary.bPassed);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSGBattleBenchmarkTest, "Sguo.Perf.BattleBenchmark",
+    EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief 战斗性能基准测试
+ * @details
+ * 测试项：
+ * 1. 在标准地图上以固定种子生成每方 100 单位并交战 10 秒
+ * 2. 单位全部生成，采样到帧数据
+ * 3. 游戏线程平均与 P95 耗时不超过 Config/DefaultGame.ini 中对应档位的预算
+ * 4. 配置了预算的计时作用域均不超预算
+ * 注意事项：
+ * - 需要真实游戏世界，只在 -game 下运行（例如 -nullrhi -ExecCmds="Automation RunTests Sguo.Perf"）
+ * - 战斗细节仍有全局随机，结果只断言预算，不断言具体耗时
+ */
+bool FSGBattleBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace SGBattleBenchmarkTest;
+
+    if (!AutomationOpenMap(MapName))
+    {
+        AddError(FString::Printf(TEXT("无法打开地图 %s"), MapName));
+        return false;
+    }
+
+    ADD_LATENT_AUTOMATION_COMMAND(FSGStartBattleBenchmarkCommand(this));
+    ADD_LATENT_AUTOMATION_COMMAND(FSGWaitBattleBenchmarkCommand(this));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
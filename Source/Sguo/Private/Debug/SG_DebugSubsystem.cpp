@@ -19,6 +19,16 @@
 #include "Kismet/GameplayStatics.h"
 #include "Debug/SG_LogCategories.h"
 #include "Engine/World.h"
+// ✨ 新增 - 批量叠加层
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "AbilitySystem/SG_AttributeSet.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "CanvasItem.h"
+#include "SceneView.h"
+#include "RenderUtils.h"
+#include "Algo/Sort.h"
 
 // ========== 公共接口实现 ==========
 
@@ -113,6 +123,9 @@ void USG_DebugSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		Settings->bAutoEnableOnBeginPlay ? TEXT("是") : TEXT("否"));
 	UE_LOG(LogSGGameplay, Log, TEXT("  自动监听新单位：%s"), 
 		Settings->bAutoAddToNewUnits ? TEXT("是") : TEXT("否"));
+	// ✨ 新增 - 显示方式
+	UE_LOG(LogSGGameplay, Log, TEXT("  显示方式：%s"), 
+		Settings->bUseBatchedOverlay ? TEXT("批量叠加层") : TEXT("逐单位 Widget"));
 	UE_LOG(LogSGGameplay, Log, TEXT("  偏移高度：%.0f"), Settings->WidgetHeightOffset);
 	UE_LOG(LogSGGameplay, Log, TEXT("  Widget 大小：[%.0f, %.0f]"), 
 		Settings->WidgetDrawSize.X, Settings->WidgetDrawSize.Y);
@@ -158,6 +171,9 @@ void USG_DebugSubsystem::Deinitialize()
 	
 	// 移除所有调试 Widget
 	RemoveAllDebugWidgets();
+
+	// ✨ 新增 - 注销叠加层绘制
+	StopUnitOverlay();
 	
 	// 调用父类实现
 	Super::Deinitialize();
@@ -198,11 +214,20 @@ void USG_DebugSubsystem::EnableUnitDebugDisplay()
 	// 标记为已启用
 	bDebugDisplayEnabled = true;
 	
+	// ✨ 新增 - 批量叠加层模式：不创建 Widget，也不需要监听生成（每帧直接读取单位注册表）
+	const USG_DebugSettings* Settings = GetDebugSettings();
+	if (Settings && Settings->bUseBatchedOverlay)
+	{
+		StartUnitOverlay();
+		UE_LOG(LogSGGameplay, Log, TEXT("✓ 已启用批量调试叠加层"));
+		UE_LOG(LogSGGameplay, Log, TEXT("========================================"));
+		return;
+	}
+	
 	// 为所有现有单位添加调试 Widget
 	AddDebugWidgetToAllUnits();
 	
 	// 从配置读取是否自动监听新单位
-	const USG_DebugSettings* Settings = GetDebugSettings();
 	if (Settings && Settings->bAutoAddToNewUnits)
 	{
 		// 开始监听新单位生成
@@ -251,6 +276,9 @@ void USG_DebugSubsystem::DisableUnitDebugDisplay()
 	
 	// 移除所有调试 Widget
 	RemoveAllDebugWidgets();
+
+	// ✨ 新增 - 注销叠加层绘制
+	StopUnitOverlay();
 	
 	// 输出日志
 	UE_LOG(LogSGGameplay, Log, TEXT("✓ 已移除所有调试显示"));
@@ -676,3 +704,280 @@ void USG_DebugSubsystem::StopListeningForUnitSpawns()
 	// 输出日志
 	UE_LOG(LogSGGameplay, Verbose, TEXT("✓ 已停止监听单位生成"));
 }
+
+
+// ========== ✨ 新增 - 批量叠加层实现 ==========
+
+namespace SGDebugOverlay
+{
+	// 血条尺寸（像素）
+	const FVector2D HealthBarSize(60.0f, 6.0f);
+
+	// 视锥裁剪时单位的包围半径
+	constexpr float UnitCullRadius = 150.0f;
+
+	// 阵营颜色（与 USG_UnitDebugWidget 默认值一致）
+	const FLinearColor PlayerColor(0.2f, 0.6f, 1.0f);
+	const FLinearColor EnemyColor(1.0f, 0.3f, 0.3f);
+
+	/**
+	 * @brief 世界坐标投影到画布，摄像机背后返回 false
+	 */
+	bool ProjectToCanvas(const UCanvas* Canvas, const FVector& WorldLocation, FVector2D& OutScreen)
+	{
+		const FVector Projected = Canvas->Project(WorldLocation, false);
+		OutScreen = FVector2D(Projected.X, Projected.Y);
+		return Projected.Z > 0.0;
+	}
+
+	/**
+	 * @brief 血条颜色（与 USG_UnitDebugWidget::GetHealthBarColor 阈值一致）
+	 */
+	FLinearColor GetHealthColor(float HealthPercent)
+	{
+		if (HealthPercent > 0.7f)
+		{
+			return FLinearColor::Green;
+		}
+		if (HealthPercent > 0.3f)
+		{
+			return FLinearColor::Yellow;
+		}
+		return FLinearColor::Red;
+	}
+
+	void DrawRect(UCanvas* Canvas, const FVector2D& Position, const FVector2D& Size, const FLinearColor& Color)
+	{
+		FCanvasTileItem Tile(Position, GWhiteTexture, Size, Color);
+		Tile.BlendMode = SE_BLEND_Translucent;
+		Canvas->DrawItem(Tile);
+	}
+}
+
+bool USG_DebugSubsystem::IsUnitOverlayActive(const UWorld* World)
+{
+	const USG_DebugSubsystem* DebugSubsystem = World ? World->GetSubsystem<USG_DebugSubsystem>() : nullptr;
+	return DebugSubsystem && DebugSubsystem->OverlayDrawHandle.IsValid();
+}
+
+void USG_DebugSubsystem::StartUnitOverlay()
+{
+	if (OverlayDrawHandle.IsValid())
+	{
+		return;
+	}
+
+	// "Game" 显示标记在游戏视口默认开启
+	OverlayDrawHandle = UDebugDrawService::Register(
+		TEXT("Game"),
+		FDebugDrawDelegate::CreateUObject(this, &USG_DebugSubsystem::DrawUnitOverlay)
+	);
+}
+
+void USG_DebugSubsystem::StopUnitOverlay()
+{
+	if (!OverlayDrawHandle.IsValid())
+	{
+		return;
+	}
+
+	UDebugDrawService::Unregister(OverlayDrawHandle);
+	OverlayDrawHandle.Reset();
+	OverlayCandidates.Empty();
+}
+
+void USG_DebugSubsystem::DrawUnitOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	using namespace SGDebugOverlay;
+
+	// 调试绘制服务对所有世界的视口广播，只处理自己的世界
+	if (!Canvas || !Canvas->SceneView || !Canvas->SceneView->Family || Canvas->SceneView->Family->Scene != GetWorld()->Scene)
+	{
+		return;
+	}
+
+	const USG_DebugSettings* Settings = GetDebugSettings();
+	const USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>();
+	if (!Settings || !Registry)
+	{
+		return;
+	}
+
+	// ========== 步骤1：距离 + 视锥裁剪 ==========
+
+	const FSceneView* View = Canvas->SceneView;
+	const FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+	const float MaxDistanceSq = FMath::Square(Settings->OverlayMaxDistance);
+	const float DetailDistanceSq = FMath::Square(Settings->OverlayDetailDistance);
+
+	const TBitArray<>& ActiveMask = Registry->GetActiveMask();
+	const TArray<FVector>& Positions = Registry->GetPositions();
+
+	OverlayCandidates.Reset();
+	for (TConstSetBitIterator<> It(ActiveMask); It; ++It)
+	{
+		const int32 SlotIndex = It.GetIndex();
+		const FVector& Position = Positions[SlotIndex];
+
+		const float DistanceSq = static_cast<float>(FVector::DistSquared(ViewOrigin, Position));
+		if (DistanceSq > MaxDistanceSq)
+		{
+			continue;
+		}
+
+		if (!View->ViewFrustum.IntersectSphere(Position, UnitCullRadius))
+		{
+			continue;
+		}
+
+		OverlayCandidates.Emplace(DistanceSq, SlotIndex);
+	}
+
+	const int32 VisibleCount = OverlayCandidates.Num();
+
+	// ========== 步骤2：按距离排序，截断到每帧上限 ==========
+
+	const int32 MaxUnits = FMath::Max(1, Settings->OverlayMaxUnitsPerFrame);
+	if (OverlayCandidates.Num() > MaxUnits)
+	{
+		Algo::Sort(OverlayCandidates, [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+		OverlayCandidates.SetNum(MaxUnits, EAllowShrinking::No);
+	}
+
+	// ========== 步骤3：绘制 ==========
+
+	UFont* Font = GEngine->GetSmallFont();
+	const TArray<uint8>& FactionIndices = Registry->GetFactionIndices();
+	const int32 PlayerFactionIndex = Registry->FindFactionIndex(FGameplayTag::RequestGameplayTag(TEXT("Unit.Faction.Player")));
+
+	int32 DrawnCount = 0;
+	for (const TPair<float, int32>& Candidate : OverlayCandidates)
+	{
+		const int32 SlotIndex = Candidate.Value;
+		ASG_UnitsBase* Unit = Registry->GetUnitAt(SlotIndex);
+		if (!Unit || !Unit->AttributeSet)
+		{
+			continue;
+		}
+
+		const USG_AttributeSet* AttributeSet = Unit->AttributeSet;
+		const FVector ActorLocation = Unit->GetActorLocation();
+		const bool bDetailed = Candidate.Key <= DetailDistanceSq;
+
+		// 范围圈（原先在单位 Tick 中绘制）
+		if (bDetailed && Unit->bShowAttackRange)
+		{
+			DrawGroundCircle(Canvas, ActorLocation, AttributeSet->GetAttackRange(), 32, Unit->AttackRangeColor);
+		}
+		if (bDetailed && Unit->bShowSearchRange)
+		{
+			const float Range = Unit->GetDetectionRange();
+			if (Unit->TargetSearchShape == ESGTargetSearchShape::Square)
+			{
+				// 4 段、起始 45° 的"圆"即边长 2*Range 的正方形
+				DrawGroundCircle(Canvas, ActorLocation, Range * UE_SQRT_2, 4, Unit->VisionRangeColor, UE_PI * 0.25f);
+			}
+			else
+			{
+				DrawGroundCircle(Canvas, ActorLocation, Range, 48, Unit->VisionRangeColor);
+			}
+		}
+
+		FVector2D HeadScreen;
+		if (!ProjectToCanvas(Canvas, ActorLocation + FVector(0.0f, 0.0f, Settings->WidgetHeightOffset), HeadScreen))
+		{
+			continue;
+		}
+
+		++DrawnCount;
+
+		// 血条
+		const float MaxHealth = AttributeSet->GetMaxHealth();
+		const float HealthPercent = MaxHealth > 0.0f ? FMath::Clamp(AttributeSet->GetHealth() / MaxHealth, 0.0f, 1.0f) : 0.0f;
+		const FVector2D BarPosition = HeadScreen - HealthBarSize * 0.5f;
+		DrawRect(Canvas, BarPosition, HealthBarSize, FLinearColor(0.0f, 0.0f, 0.0f, 0.6f));
+		DrawRect(Canvas, BarPosition, FVector2D(HealthBarSize.X * HealthPercent, HealthBarSize.Y), GetHealthColor(HealthPercent));
+
+		if (!bDetailed)
+		{
+			continue;
+		}
+
+		// 名字（阵营颜色）
+		const bool bIsPlayer = FactionIndices.IsValidIndex(SlotIndex) && FactionIndices[SlotIndex] == PlayerFactionIndex;
+		float TextY = BarPosition.Y - 14.0f;
+		Canvas->SetDrawColor((bIsPlayer ? PlayerColor : EnemyColor).ToFColor(true));
+		Canvas->DrawText(Font, FString::Printf(TEXT("%s %s"), bIsPlayer ? TEXT("[玩家]") : TEXT("[敌人]"), *Unit->GetName()),
+			BarPosition.X, TextY);
+
+		// 生命值 + 详细属性（与 USG_UnitDebugWidget 内容一致）
+		TextY = BarPosition.Y + HealthBarSize.Y + 2.0f;
+		Canvas->SetDrawColor(FColor::White);
+		Canvas->DrawText(Font, FString::Printf(TEXT("%.0f / %.0f  攻:%.0f 速:%.0f 攻速:%.2f 围:%.0f"),
+			AttributeSet->GetHealth(), MaxHealth,
+			AttributeSet->GetAttackDamage(), AttributeSet->GetMoveSpeed(),
+			AttributeSet->GetAttackSpeed(), AttributeSet->GetAttackRange()),
+			BarPosition.X, TextY);
+
+		// 技能冷却 + 动画状态（原先在单位 Tick 中 DrawDebugString）
+		if (Unit->bShowAbilityCooldowns)
+		{
+			FString CooldownInfo = TEXT("技能冷却：");
+			for (int32 i = 0; i < Unit->AbilityCooldowns.Num(); ++i)
+			{
+				if (Unit->AbilityCooldowns[i] > 0.0f)
+				{
+					CooldownInfo += FString::Printf(TEXT("[%d]:%.1f "), i, Unit->AbilityCooldowns[i]);
+				}
+				else
+				{
+					CooldownInfo += FString::Printf(TEXT("[%d]:OK "), i);
+				}
+			}
+			if (Unit->bIsAttacking)
+			{
+				CooldownInfo += FString::Printf(TEXT(" 动画：%.1f秒"), Unit->AttackAnimationRemainingTime);
+			}
+
+			TextY += 12.0f;
+			Canvas->SetDrawColor(FColor::Cyan);
+			Canvas->DrawText(Font, CooldownInfo, BarPosition.X, TextY);
+		}
+	}
+
+	// ========== 步骤4：统计 ==========
+
+	Canvas->SetDrawColor(FColor::White);
+	Canvas->DrawText(Font, FString::Printf(TEXT("调试叠加层：绘制 %d / 视野内 %d / 总数 %d"),
+		DrawnCount, VisibleCount, Registry->GetActiveCount()), 10.0f, 10.0f);
+}
+
+void USG_DebugSubsystem::DrawGroundCircle(UCanvas* Canvas, const FVector& Center, float Radius, int32 Segments, const FLinearColor& Color, float StartAngle)
+{
+	using namespace SGDebugOverlay;
+
+	Segments = FMath::Max(3, Segments);
+
+	const float AngleStep = UE_TWO_PI / Segments;
+	FVector2D PrevScreen;
+	bool bPrevVisible = ProjectToCanvas(Canvas, Center + FVector(FMath::Cos(StartAngle), FMath::Sin(StartAngle), 0.0f) * Radius, PrevScreen);
+
+	for (int32 Index = 1; Index <= Segments; ++Index)
+	{
+		const float Angle = StartAngle + AngleStep * Index;
+		FVector2D Screen;
+		const bool bVisible = ProjectToCanvas(Canvas, Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius, Screen);
+
+		// 两端都在摄像机前方才画，避免背后的点投影翻转
+		if (bVisible && bPrevVisible)
+		{
+			FCanvasLineItem Line(PrevScreen, Screen);
+			Line.SetColor(Color);
+			Line.LineThickness = 2.0f;
+			Canvas->DrawItem(Line);
+		}
+
+		PrevScreen = Screen;
+		bPrevVisible = bVisible;
+	}
+}
@@ -0,0 +1,216 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_DeckSimulationCommandlet.cpp
+// ✨ 新增 - 离线抽卡模拟命令行工具实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_DeckSimulationCommandlet.h"
+#include "CardsAndUnits/SG_CardDeckComponent.h"
+#include "Data/SG_DeckConfig.h"
+#include "Data/SG_CardDataBase.h"
+#include "Debug/SG_LogCategories.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+
+USG_DeckSimulationCommandlet::USG_DeckSimulationCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+/**
+ * @brief 运行抽卡模拟
+ * @details
+ * 详细流程：
+ * 1. 按卡牌汇总配置权重，标记唯一卡牌和限制出现次数的卡牌
+ * 2. 每轮用 Seed + 轮次 初始化卡组，循环"随机打出一张手牌 → 抽一张"
+ * 3. 每次抽卡读取 GetLastDrawInfo 记录保底信息
+ * 注意事项：
+ * - 抽牌池耗尽时本轮提前结束，连续未抽中按实际抽卡次数计算
+ */
+FSGDeckSimulationResult USG_DeckSimulationCommandlet::RunSimulation(USG_DeckConfig* DeckConfig, int32 NumDraws, int32 Seed, int32 NumRuns)
+{
+    FSGDeckSimulationResult Result;
+    if (!DeckConfig)
+    {
+        return Result;
+    }
+
+    for (const FSGCardConfigSlot& ConfigSlot : DeckConfig->AllowedCards)
+    {
+        USG_CardDataBase* CardAsset = ConfigSlot.CardData.LoadSynchronous();
+        if (!CardAsset)
+        {
+            continue;
+        }
+
+        FSGDeckSimulationCardStats& CardStats = Result.Cards.FindOrAdd(CardAsset->GetPrimaryAssetId());
+        CardStats.DisplayName = CardAsset->CardName.ToString();
+        CardStats.BaseWeight += FMath::Max(0.0f, ConfigSlot.DrawWeight);
+        CardStats.bLimited |= CardAsset->bIsUnique || ConfigSlot.MaxOccurrences > 0;
+        Result.TotalBaseWeight += FMath::Max(0.0f, ConfigSlot.DrawWeight);
+    }
+
+    USG_CardDeckComponent* Deck = NewObject<USG_CardDeckComponent>(GetTransientPackage());
+
+    // 模拟期间屏蔽卡牌日志
+    const ELogVerbosity::Type PreviousVerbosity = LogSGCard.GetVerbosity();
+    LogSGCard.SetVerbosity(ELogVerbosity::Error);
+
+    for (int32 Run = 0; Run < NumRuns; ++Run)
+    {
+        Deck->InitializeForSimulation(DeckConfig, Seed + Run);
+        FRandomStream PlayStream(Seed + Run);
+
+        for (TPair<FPrimaryAssetId, FSGDeckSimulationCardStats>& Pair : Result.Cards)
+        {
+            Pair.Value.LastHitStep = -1;
+        }
+
+        int32 StepsDone = 0;
+        for (int32 Step = 0; Step < NumDraws; ++Step)
+        {
+            const TArray<FSGCardInstance>& Hand = Deck->GetHand();
+            if (Hand.Num() > 0)
+            {
+                Deck->PlayCardForSimulation(PlayStream.RandRange(0, Hand.Num() - 1));
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            const bool bDrawn = Deck->DrawCardForSimulation();
+            Result.DrawSeconds += FPlatformTime::Seconds() - StartTime;
+
+            if (!bDrawn)
+            {
+                break;
+            }
+            ++StepsDone;
+            ++Result.TotalDraws;
+
+            const FSGCardInstance& NewCard = Deck->GetHand().Last();
+            FSGDeckSimulationCardStats* CardStats = Result.Cards.Find(NewCard.CardId);
+            if (!CardStats)
+            {
+                continue;
+            }
+
+            const FSGWeightedDrawInfo& DrawInfo = Deck->GetLastDrawInfo();
+            CardStats->HitCount++;
+            CardStats->PityHitCount += DrawInfo.PityBonus > 1.0 ? 1 : 0;
+            CardStats->CappedHitCount += DrawInfo.bPityCapped ? 1 : 0;
+            CardStats->MaxDrought = FMath::Max(CardStats->MaxDrought, Step - CardStats->LastHitStep - 1);
+            CardStats->LastHitStep = Step;
+        }
+
+        // 本轮结束时仍未抽中的卡牌也计入连续未抽中（按实际抽卡次数）
+        for (TPair<FPrimaryAssetId, FSGDeckSimulationCardStats>& Pair : Result.Cards)
+        {
+            Pair.Value.MaxDrought = FMath::Max(Pair.Value.MaxDrought, StepsDone - Pair.Value.LastHitStep - 1);
+        }
+    }
+
+    LogSGCard.SetVerbosity(PreviousVerbosity);
+
+    return Result;
+}
+
+/**
+ * @brief 命令行入口
+ * @param Params 命令行参数（-Deck= -Draws= -Seed= -Runs= -Tolerance=）
+ * @return 0 成功，1 参数错误，2 出现率偏差超出容差
+ * @details
+ * 详细流程：
+ * 1. 加载卡组配置并运行模拟
+ * 2. 输出每张卡牌的统计和抽卡吞吐
+ * 3. 不受限卡牌的实际出现率与其在不受限卡牌中的权重占比比较，超出容差时返回 2
+ */
+int32 USG_DeckSimulationCommandlet::Main(const FString& Params)
+{
+    FString DeckPath;
+    int32 NumDraws = 100000;
+    int32 Seed = 1337;
+    int32 NumRuns = 1;
+    float TolerancePercent = 5.0f;
+
+    FParse::Value(*Params, TEXT("Deck="), DeckPath);
+    FParse::Value(*Params, TEXT("Draws="), NumDraws);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Runs="), NumRuns);
+    FParse::Value(*Params, TEXT("Tolerance="), TolerancePercent);
+    NumDraws = FMath::Max(1, NumDraws);
+    NumRuns = FMath::Max(1, NumRuns);
+
+    if (DeckPath.IsEmpty())
+    {
+        UE_LOG(LogSGCard, Error, TEXT("用法：-run=SG_DeckSimulation -Deck=<卡组配置路径> [-Draws=100000] [-Seed=1337] [-Runs=1] [-Tolerance=5]"));
+        return 1;
+    }
+
+    USG_DeckConfig* DeckConfig = LoadObject<USG_DeckConfig>(nullptr, *DeckPath);
+    if (!DeckConfig)
+    {
+        UE_LOG(LogSGCard, Error, TEXT("❌ 无法加载卡组配置：%s"), *DeckPath);
+        return 1;
+    }
+
+    const FSGDeckSimulationResult Result = RunSimulation(DeckConfig, NumDraws, Seed, NumRuns);
+
+    // 不受限卡牌的权重和命中数（偏差检查的基数）
+    double UnlimitedWeight = 0.0;
+    int64 UnlimitedHits = 0;
+    for (const TPair<FPrimaryAssetId, FSGDeckSimulationCardStats>& Pair : Result.Cards)
+    {
+        if (!Pair.Value.bLimited)
+        {
+            UnlimitedWeight += Pair.Value.BaseWeight;
+            UnlimitedHits += Pair.Value.HitCount;
+        }
+    }
+
+    // ========== 输出报告 ==========
+
+    UE_LOG(LogSGCard, Display, TEXT("========== 抽卡模拟报告 =========="));
+    UE_LOG(LogSGCard, Display, TEXT("卡组：%s  种子：%d  轮数：%d  抽卡次数：%lld"), *DeckPath, Seed, NumRuns, Result.TotalDraws);
+    UE_LOG(LogSGCard, Display, TEXT("%-24s %10s %10s %10s %10s %10s %10s"),
+        TEXT("卡牌"), TEXT("次数"), TEXT("实际%"), TEXT("权重%"), TEXT("保底%"), TEXT("封顶%"), TEXT("最长未中"));
+
+    int64 TotalPityHits = 0;
+    int64 TotalCappedHits = 0;
+    int32 OutOfToleranceCount = 0;
+    for (const TPair<FPrimaryAssetId, FSGDeckSimulationCardStats>& Pair : Result.Cards)
+    {
+        const FSGDeckSimulationCardStats& CardStats = Pair.Value;
+        const double ObservedPercent = Result.TotalDraws > 0 ? 100.0 * CardStats.HitCount / Result.TotalDraws : 0.0;
+        const double BasePercent = Result.TotalBaseWeight > 0.0 ? 100.0 * CardStats.BaseWeight / Result.TotalBaseWeight : 0.0;
+        const double PityPercent = CardStats.HitCount > 0 ? 100.0 * CardStats.PityHitCount / CardStats.HitCount : 0.0;
+        const double CappedPercent = CardStats.HitCount > 0 ? 100.0 * CardStats.CappedHitCount / CardStats.HitCount : 0.0;
+
+        UE_LOG(LogSGCard, Display, TEXT("%-24s %10lld %9.2f%% %9.2f%% %9.2f%% %9.2f%% %10lld%s"),
+            *CardStats.DisplayName, CardStats.HitCount, ObservedPercent, BasePercent, PityPercent, CappedPercent, CardStats.MaxDrought,
+            CardStats.bLimited ? TEXT("  (受限)") : TEXT(""));
+
+        TotalPityHits += CardStats.PityHitCount;
+        TotalCappedHits += CardStats.CappedHitCount;
+
+        if (!CardStats.bLimited && UnlimitedHits > 0 && UnlimitedWeight > 0.0)
+        {
+            const double UnlimitedObserved = 100.0 * CardStats.HitCount / UnlimitedHits;
+            const double UnlimitedExpected = 100.0 * CardStats.BaseWeight / UnlimitedWeight;
+            if (FMath::Abs(UnlimitedObserved - UnlimitedExpected) > TolerancePercent)
+            {
+                UE_LOG(LogSGCard, Error, TEXT("❌ %s 出现率偏差超出容差：实际 %.2f%%，期望 %.2f%%，容差 %.2f"),
+                    *CardStats.DisplayName, UnlimitedObserved, UnlimitedExpected, TolerancePercent);
+                OutOfToleranceCount++;
+            }
+        }
+    }
+
+    UE_LOG(LogSGCard, Display, TEXT("保底加成命中：%.2f%%  保底封顶命中：%.2f%%"),
+        Result.TotalDraws > 0 ? 100.0 * TotalPityHits / Result.TotalDraws : 0.0,
+        Result.TotalDraws > 0 ? 100.0 * TotalCappedHits / Result.TotalDraws : 0.0);
+    UE_LOG(LogSGCard, Display, TEXT("抽卡耗时：%.3f 毫秒  吞吐：%.0f 次/秒"),
+        Result.DrawSeconds * 1000.0, Result.DrawSeconds > 0.0 ? Result.TotalDraws / Result.DrawSeconds : 0.0);
+    UE_LOG(LogSGCard, Display, TEXT("=================================="));
+
+    return OutOfToleranceCount > 0 ? 2 : 0;
+}
@@ -0,0 +1,135 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_DeckSimulationTest.cpp
+// ✨ 新增 - 抽卡模拟自动化测试
+// ✅ 这是完整文件
+
+#include "Debug/SG_DeckSimulationCommandlet.h"
+#include "Data/SG_DeckConfig.h"
+#include "Data/SG_CardDataBase.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SGDeckSimulationTest
+{
+    /**
+     * @brief 创建内存中的卡牌数据
+     */
+    USG_CardDataBase* MakeCard(const TCHAR* Name, bool bIsUnique = false)
+    {
+        USG_CardDataBase* Card = NewObject<USG_CardDataBase>(
+            GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), USG_CardDataBase::StaticClass(), Name));
+        Card->CardName = FText::FromString(Name);
+        Card->bIsUnique = bIsUnique;
+        return Card;
+    }
+
+    /**
+     * @brief 向卡组配置添加一个槽位
+     */
+    void AddSlot(USG_DeckConfig* Config, USG_CardDataBase* Card, float Weight, float PityMultiplier, float PityMaxMultiplier, int32 MaxOccurrences = 0)
+    {
+        FSGCardConfigSlot& ConfigSlot = Config->AllowedCards.AddDefaulted_GetRef();
+        ConfigSlot.CardData = Card;
+        ConfigSlot.DrawWeight = Weight;
+        ConfigSlot.PityMultiplier = PityMultiplier;
+        ConfigSlot.PityMaxMultiplier = PityMaxMultiplier;
+        ConfigSlot.MaxOccurrences = MaxOccurrences;
+    }
+
+    const FSGDeckSimulationCardStats& GetStats(const FSGDeckSimulationResult& Result, const USG_CardDataBase* Card)
+    {
+        return Result.Cards.FindChecked(Card->GetPrimaryAssetId());
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSGDeckSimulationTest, "Sguo.Cards.DeckSimulation",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief 抽卡模拟测试
+ * @details
+ * 测试项：
+ * 1. 关闭保底时，不受限卡牌的出现率符合权重占比
+ * 2. 唯一卡牌最多抽中一次，限制出现次数的卡牌不超过上限
+ * 3. 开启保底后低权重卡牌的最长连续未抽中明显缩短，并记录保底命中
+ * 4. 种子相同则结果完全相同
+ */
+bool FSGDeckSimulationTest::RunTest(const FString& Parameters)
+{
+    using namespace SGDeckSimulationTest;
+
+    constexpr int32 NumDraws = 20000;
+    constexpr int32 Seed = 1337;
+
+    // ========== 分布、唯一卡牌、出现次数上限 ==========
+
+    USG_DeckConfig* DistributionDeck = NewObject<USG_DeckConfig>(GetTransientPackage());
+    DistributionDeck->InitialHand = 3;
+
+    USG_CardDataBase* Light = MakeCard(TEXT("SGTest_Light"));
+    USG_CardDataBase* Heavy = MakeCard(TEXT("SGTest_Heavy"));
+    USG_CardDataBase* Hero = MakeCard(TEXT("SGTest_Hero"), true);
+    USG_CardDataBase* Limited = MakeCard(TEXT("SGTest_Limited"));
+    AddSlot(DistributionDeck, Light, 1.0f, 0.0f, 1.0f);
+    AddSlot(DistributionDeck, Heavy, 3.0f, 0.0f, 1.0f);
+    AddSlot(DistributionDeck, Hero, 1.0f, 0.0f, 1.0f);
+    AddSlot(DistributionDeck, Limited, 1.0f, 0.0f, 1.0f, 3);
+
+    const FSGDeckSimulationResult Distribution = USG_DeckSimulationCommandlet::RunSimulation(DistributionDeck, NumDraws, Seed, 1);
+    TestEqual(TEXT("每一步都抽到卡牌"), Distribution.TotalDraws, static_cast<int64>(NumDraws));
+
+    const int64 LightHits = GetStats(Distribution, Light).HitCount;
+    const int64 HeavyHits = GetStats(Distribution, Heavy).HitCount;
+    TestTrue(TEXT("不受限卡牌都被抽中"), LightHits > 0 && HeavyHits > 0);
+    if (LightHits + HeavyHits > 0)
+    {
+        const double HeavyShare = static_cast<double>(HeavyHits) / (LightHits + HeavyHits);
+        TestTrue(FString::Printf(TEXT("权重 1:3 的出现率接近 75%%（实际 %.2f%%）"), HeavyShare * 100.0),
+            FMath::IsNearlyEqual(HeavyShare, 0.75, 0.02));
+    }
+
+    TestTrue(TEXT("唯一卡牌最多抽中一次"), GetStats(Distribution, Hero).HitCount <= 1);
+    TestTrue(TEXT("限制出现次数的卡牌不超过上限"), GetStats(Distribution, Limited).HitCount <= 3);
+    TestTrue(TEXT("唯一卡牌标记为受限"), GetStats(Distribution, Hero).bLimited);
+    TestTrue(TEXT("限制出现次数的卡牌标记为受限"), GetStats(Distribution, Limited).bLimited);
+
+    // ========== 保底 ==========
+
+    auto MakePityDeck = [](float PityMultiplier, float PityMaxMultiplier, USG_CardDataBase* Common, USG_CardDataBase* Rare)
+    {
+        USG_DeckConfig* Deck = NewObject<USG_DeckConfig>(GetTransientPackage());
+        Deck->InitialHand = 1;
+        AddSlot(Deck, Common, 10.0f, 0.0f, 1.0f);
+        AddSlot(Deck, Rare, 0.05f, PityMultiplier, PityMaxMultiplier);
+        return Deck;
+    };
+
+    USG_CardDataBase* Common = MakeCard(TEXT("SGTest_Common"));
+    USG_CardDataBase* Rare = MakeCard(TEXT("SGTest_Rare"));
+
+    const FSGDeckSimulationResult NoPity = USG_DeckSimulationCommandlet::RunSimulation(MakePityDeck(0.0f, 1.0f, Common, Rare), NumDraws, Seed, 1);
+    const FSGDeckSimulationResult WithPity = USG_DeckSimulationCommandlet::RunSimulation(MakePityDeck(1.0f, 400.0f, Common, Rare), NumDraws, Seed, 1);
+
+    const FSGDeckSimulationCardStats& RareNoPity = GetStats(NoPity, Rare);
+    const FSGDeckSimulationCardStats& RareWithPity = GetStats(WithPity, Rare);
+    TestEqual(TEXT("关闭保底时没有保底命中"), RareNoPity.PityHitCount, static_cast<int64>(0));
+    TestTrue(TEXT("开启保底后低权重卡牌通过保底命中"), RareWithPity.PityHitCount > 0);
+    TestTrue(FString::Printf(TEXT("开启保底后最长连续未抽中缩短（%lld → %lld）"), RareNoPity.MaxDrought, RareWithPity.MaxDrought),
+        RareWithPity.MaxDrought < RareNoPity.MaxDrought);
+    TestTrue(TEXT("开启保底后低权重卡牌出现率提高"), RareWithPity.HitCount > RareNoPity.HitCount);
+
+    // ========== 确定性 ==========
+
+    const FSGDeckSimulationResult Repeat = USG_DeckSimulationCommandlet::RunSimulation(DistributionDeck, NumDraws, Seed, 1);
+    for (const TPair<FPrimaryAssetId, FSGDeckSimulationCardStats>& Pair : Distribution.Cards)
+    {
+        const FSGDeckSimulationCardStats* RepeatStats = Repeat.Cards.Find(Pair.Key);
+        TestTrue(FString::Printf(TEXT("种子相同结果相同：%s"), *Pair.Value.DisplayName),
+            RepeatStats && RepeatStats->HitCount == Pair.Value.HitCount && RepeatStats->MaxDrought == Pair.Value.MaxDrought);
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,488 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_MatchTelemetrySubsystem.cpp
+// ✨ 新增 - 对局性能遥测实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_MatchTelemetrySubsystem.h"
+#include "Debug/SG_DebugSettings.h"
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Actors/SG_Projectile.h"
+#include "CardsAndUnits/SG_CardDeckComponent.h"
+#include "Data/SG_DeckConfig.h"
+#include "Player/SG_PlayerController.h"
+#include "Units/SG_SpawnSchedulerSubsystem.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace SGMatchTelemetry
+{
+    // 每个慢帧记录的作用域数量
+    constexpr int32 TopScopesPerFrame = 3;
+
+    // 计入目标查询次数的作用域
+    const TCHAR* const TargetQueryScopes[] = { TEXT("FindBestTarget"), TEXT("FindBestTargetWithSlot"), TEXT("FindEnemyUnitsOnly") };
+
+    /**
+     * @brief 已排序数组的分位数
+     */
+    float Percentile(const TArray<float>& Sorted, float Fraction)
+    {
+        return Sorted.Num() > 0 ? Sorted[FMath::Clamp(FMath::CeilToInt(Sorted.Num() * Fraction) - 1, 0, Sorted.Num() - 1)] : 0.0f;
+    }
+
+    /**
+     * @brief 一组帧耗时的 JSON：平均、P50、P90、P95、P99、最大
+     */
+    FString DistributionJson(TArray<float>& Values)
+    {
+        Values.Sort();
+        double Sum = 0.0;
+        for (const float Value : Values)
+        {
+            Sum += Value;
+        }
+        const float Avg = Values.Num() > 0 ? static_cast<float>(Sum / Values.Num()) : 0.0f;
+
+        return FString::Printf(TEXT("{ \"avg\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f }"),
+            Avg, Percentile(Values, 0.5f), Percentile(Values, 0.9f), Percentile(Values, 0.95f), Percentile(Values, 0.99f),
+            Values.Num() > 0 ? Values.Last() : 0.0f);
+    }
+
+    /**
+     * @brief 计算统计并写出报告（线程池中执行）
+     */
+    void WriteReport(const FSGMatchTelemetryReport& Report)
+    {
+        TArray<float> FrameMs;
+        TArray<float> GameThreadMs;
+        FrameMs.Reserve(Report.Samples.Num());
+        GameThreadMs.Reserve(Report.Samples.Num());
+
+        int32 OverBudgetFrames = 0;
+        int64 UnitSum = 0;
+        for (const FSGTelemetryFrameSample& Sample : Report.Samples)
+        {
+            FrameMs.Add(Sample.FrameMs);
+            GameThreadMs.Add(Sample.GameThreadMs);
+            OverBudgetFrames += Sample.FrameMs > Report.FrameBudgetMs ? 1 : 0;
+            UnitSum += Sample.Units;
+        }
+
+        const int32 NumFrames = Report.Samples.Num();
+        const double Duration = FMath::Max(Report.DurationSeconds, 0.001);
+
+        TArray<TPair<FString, TPair<double, uint64>>> Scopes;
+        for (const TPair<FString, TPair<double, uint64>>& Pair : Report.Scopes)
+        {
+            Scopes.Add(Pair);
+        }
+        Scopes.Sort([](const TPair<FString, TPair<double, uint64>>& A, const TPair<FString, TPair<double, uint64>>& B) { return A.Value.Key > B.Value.Key; });
+
+        FString Json;
+        Json += TEXT("{\n");
+        Json += FString::Printf(TEXT("  \"map\": \"%s\",\n  \"result\": \"%s\",\n  \"deck\": \"%s\",\n"),
+            *Report.MapName.ReplaceCharWithEscapedChar(), *Report.Result, *Report.DeckName.ReplaceCharWithEscapedChar());
+        Json += FString::Printf(TEXT("  \"durationSeconds\": %.2f,\n  \"frames\": %d,\n"), Report.DurationSeconds, NumFrames);
+        Json += FString::Printf(TEXT("  \"frameMs\": %s,\n"), *DistributionJson(FrameMs));
+        Json += FString::Printf(TEXT("  \"gameThreadMs\": %s,\n"), *DistributionJson(GameThreadMs));
+        Json += FString::Printf(TEXT("  \"frameBudgetMs\": %.2f,\n  \"framesOverBudget\": %d,\n"), Report.FrameBudgetMs, OverBudgetFrames);
+        Json += FString::Printf(TEXT("  \"units\": { \"avg\": %.1f, \"peak\": %d },\n"),
+            NumFrames > 0 ? static_cast<double>(UnitSum) / NumFrames : 0.0, Report.PeakUnits);
+        Json += FString::Printf(TEXT("  \"projectiles\": { \"peak\": %d },\n"), Report.PeakProjectiles);
+        Json += FString::Printf(TEXT("  \"spawning\": { \"peakPending\": %d, \"spawned\": %d, \"reused\": %d, \"peakPooled\": %d },\n"),
+            Report.PeakPendingSpawns, Report.UnitsSpawned, Report.UnitsReused, Report.PeakPooledUnits);
+        Json += FString::Printf(TEXT("  \"targeting\": { \"queries\": %llu, \"queriesPerSecond\": %.1f },\n"),
+            Report.TargetQueries, Report.TargetQueries / Duration);
+        Json += FString::Printf(TEXT("  \"gc\": { \"count\": %d, \"totalMs\": %.3f, \"maxMs\": %.3f },\n"),
+            Report.GCCount, Report.GCTotalMs, Report.GCMaxMs);
+        const int32 PreloadUses = Report.CardPreloadHits + Report.CardPreloadMisses;
+        Json += FString::Printf(TEXT("  \"cardPreload\": { \"hits\": %d, \"misses\": %d, \"notPreloadable\": %d, \"hitRate\": %.3f, \"residentMB\": %.2f },\n"),
+            Report.CardPreloadHits, Report.CardPreloadMisses, Report.CardPreloadNotPreloadable,
+            PreloadUses > 0 ? static_cast<double>(Report.CardPreloadHits) / PreloadUses : 0.0,
+            Report.CardPreloadResidentBytes / (1024.0 * 1024.0));
+
+        Json += TEXT("  \"cardUses\": {");
+        int32 CardIndex = 0;
+        for (const TPair<FString, int32>& Pair : Report.CardUses)
+        {
+            Json += FString::Printf(TEXT("%s\"%s\": %d"), CardIndex++ > 0 ? TEXT(", ") : TEXT(" "), *Pair.Key.ReplaceCharWithEscapedChar(), Pair.Value);
+        }
+        Json += TEXT(" },\n");
+
+        Json += TEXT("  \"scopes\": [\n");
+        for (int32 Index = 0; Index < Scopes.Num(); ++Index)
+        {
+            Json += FString::Printf(TEXT("    { \"name\": \"%s\", \"totalMs\": %.3f, \"perFrameMs\": %.4f, \"calls\": %llu }%s\n"),
+                *Scopes[Index].Key, Scopes[Index].Value.Key, Scopes[Index].Value.Key / FMath::Max(1, NumFrames), Scopes[Index].Value.Value,
+                Index + 1 < Scopes.Num() ? TEXT(",") : TEXT(""));
+        }
+        Json += TEXT("  ],\n");
+
+        Json += TEXT("  \"slowestFrames\": [\n");
+        for (int32 Index = 0; Index < Report.SlowFrames.Num(); ++Index)
+        {
+            const FSGTelemetrySlowFrame& Slow = Report.SlowFrames[Index];
+            Json += FString::Printf(TEXT("    { \"frame\": %d, \"frameMs\": %.3f, \"units\": %d, \"topScopes\": ["), Slow.FrameIndex, Slow.FrameMs, Slow.Units);
+            for (int32 ScopeIndex = 0; ScopeIndex < Slow.TopScopes.Num(); ++ScopeIndex)
+            {
+                Json += FString::Printf(TEXT("%s{ \"name\": \"%s\", \"ms\": %.3f }"), ScopeIndex > 0 ? TEXT(", ") : TEXT(" "),
+                    *Slow.TopScopes[ScopeIndex].Key, Slow.TopScopes[ScopeIndex].Value);
+            }
+            Json += FString::Printf(TEXT(" ] }%s\n"), Index + 1 < Report.SlowFrames.Num() ? TEXT(",") : TEXT(""));
+        }
+        Json += TEXT("  ]\n}\n");
+
+        if (FFileHelper::SaveStringToFile(Json, *Report.FilePath))
+        {
+            UE_LOG(LogSGGameplay, Display, TEXT("📈 对局遥测已写入：%s（%d 帧，P95 %.2f 毫秒）"),
+                *Report.FilePath, NumFrames, Percentile(FrameMs, 0.95f));
+        }
+        else
+        {
+            UE_LOG(LogSGGameplay, Error, TEXT("❌ 对局遥测写入失败：%s"), *Report.FilePath);
+        }
+    }
+}
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 只在非 Shipping 的游戏世界创建
+ */
+bool USG_MatchTelemetrySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    const UWorld* World = Outer ? Outer->GetWorld() : nullptr;
+    return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void USG_MatchTelemetrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (USG_DebugSettings::Get()->bEnableMatchTelemetry || FParse::Param(FCommandLine::Get(), TEXT("SGTelemetry")))
+    {
+        StartCapture();
+    }
+}
+
+/**
+ * @brief 世界销毁时停止采集（未结束的对局不写报告），并等待正在写入的报告
+ */
+void USG_MatchTelemetrySubsystem::Deinitialize()
+{
+    if (bCapturing)
+    {
+        StopCapture();
+    }
+
+    if (PendingWrite.IsValid())
+    {
+        PendingWrite.Wait();
+    }
+
+    Super::Deinitialize();
+}
+
+// ========== 遥测接口 ==========
+
+void USG_MatchTelemetrySubsystem::StartCapture()
+{
+    if (bCapturing)
+    {
+        return;
+    }
+
+    Report = FSGMatchTelemetryReport();
+    Report.Samples.Reserve(60 * 60 * 10);
+
+    // 开启作用域计时器，并记下当前累计值（只统计本局的增量）
+    bScopeCaptureWasEnabled = FSGScopeTimer::IsCaptureEnabled();
+    FSGScopeTimer::SetCaptureEnabled(true);
+
+    LastCycles.Reset();
+    StartTotals.Reset();
+    for (const FSGScopeTimer* Timer = FSGScopeTimer::GetFirst(); Timer; Timer = Timer->GetNext())
+    {
+        LastCycles.Add(Timer, Timer->GetCycles());
+        StartTotals.Add(Timer, TPair<uint64, uint64>(Timer->GetCycles(), Timer->GetCalls()));
+    }
+
+    if (const USG_AssetManager* AssetManager = USG_AssetManager::Get())
+    {
+        StartPreloadStats = AssetManager->GetCardPreloadStats();
+    }
+
+    PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &USG_MatchTelemetrySubsystem::HandlePreGarbageCollect);
+    PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &USG_MatchTelemetrySubsystem::HandlePostGarbageCollect);
+
+    StartTime = FPlatformTime::Seconds();
+    LastFrameTime = StartTime;
+    bCapturing = true;
+
+    UE_LOG(LogSGGameplay, Log, TEXT("📈 开始采集对局遥测"));
+}
+
+/**
+ * @brief 对局结束
+ * @details
+ * 详细流程：
+ * 1. 汇总本局各作用域的耗时和调用次数（目标查询次数取自查询作用域的调用次数）
+ * 2. 读取单位注册表、对象池的峰值和累计数
+ * 3. 停止采集，把报告移交线程池写出
+ */
+void USG_MatchTelemetrySubsystem::FinishMatch(const FString& Result)
+{
+    if (!bCapturing)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    const USG_DebugSettings* Settings = USG_DebugSettings::Get();
+
+    Report.Result = Result;
+    Report.MapName = World ? World->GetMapName() : FString();
+    Report.DurationSeconds = FPlatformTime::Seconds() - StartTime;
+    Report.FrameBudgetMs = Settings->TelemetryFrameBudgetMs;
+
+    for (const FSGScopeTimer* Timer = FSGScopeTimer::GetFirst(); Timer; Timer = Timer->GetNext())
+    {
+        const TPair<uint64, uint64>* Start = StartTotals.Find(Timer);
+        const uint64 Cycles = Timer->GetCycles();
+        const uint64 Calls = Timer->GetCalls();
+        // 计时器被性能基准清零时，视为从零开始
+        const uint64 DeltaCycles = Start && Cycles >= Start->Key ? Cycles - Start->Key : Cycles;
+        const uint64 DeltaCalls = Start && Calls >= Start->Value ? Calls - Start->Value : Calls;
+
+        TPair<double, uint64>& Entry = Report.Scopes.FindOrAdd(Timer->GetName(), TPair<double, uint64>(0.0, 0));
+        Entry.Key += FPlatformTime::ToMilliseconds64(DeltaCycles);
+        Entry.Value += DeltaCalls;
+
+        for (const TCHAR* QueryScope : SGMatchTelemetry::TargetQueryScopes)
+        {
+            if (FCString::Strcmp(Timer->GetName(), QueryScope) == 0)
+            {
+                Report.TargetQueries += DeltaCalls;
+            }
+        }
+    }
+
+    if (World)
+    {
+        if (const USG_UnitRegistrySubsystem* Registry = World->GetSubsystem<USG_UnitRegistrySubsystem>())
+        {
+            Report.PeakUnits = Registry->GetPeakActiveCount();
+        }
+        if (const USG_UnitPoolSubsystem* UnitPool = World->GetSubsystem<USG_UnitPoolSubsystem>())
+        {
+            Report.UnitsSpawned = UnitPool->GetSpawnedCount();
+            Report.UnitsReused = UnitPool->GetReusedCount();
+            Report.PeakPooledUnits = UnitPool->GetPeakPooledCount();
+        }
+    }
+
+    if (const USG_AssetManager* AssetManager = USG_AssetManager::Get())
+    {
+        const FSGCardPreloadStats& PreloadStats = AssetManager->GetCardPreloadStats();
+        Report.CardPreloadHits = PreloadStats.CacheHits - StartPreloadStats.CacheHits;
+        Report.CardPreloadMisses = PreloadStats.CacheMisses - StartPreloadStats.CacheMisses;
+        Report.CardPreloadNotPreloadable = PreloadStats.NotPreloadable - StartPreloadStats.NotPreloadable;
+        Report.CardPreloadResidentBytes = PreloadStats.ResidentBytes;
+    }
+
+    if (const USG_CardDeckComponent* Deck = BoundDeck.Get())
+    {
+        const USG_DeckConfig* DeckConfig = Deck->GetDeckConfig();
+        Report.DeckName = DeckConfig ? DeckConfig->GetName() : FString();
+    }
+
+    StopCapture();
+
+    Report.FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"),
+        FString::Printf(TEXT("SGMatch_%s_%s.json"), *Report.MapName, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+
+    if (PendingWrite.IsValid())
+    {
+        PendingWrite.Wait();
+    }
+    PendingWrite = Async(EAsyncExecution::ThreadPool, [FinishedReport = MoveTemp(Report)]()
+    {
+        SGMatchTelemetry::WriteReport(FinishedReport);
+    });
+    Report = FSGMatchTelemetryReport();
+}
+
+// ========== 采样 ==========
+
+void USG_MatchTelemetrySubsystem::Tick(float DeltaTime)
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    FSGTelemetryFrameSample Sample;
+    Sample.FrameMs = static_cast<float>((Now - LastFrameTime) * 1000.0);
+    // 无渲染时 GGameThreadTime 可能不更新，退回帧时间
+    Sample.GameThreadMs = GGameThreadTime > 0 ? FPlatformTime::ToMilliseconds(GGameThreadTime) : Sample.FrameMs;
+    Sample.Projectiles = ASG_Projectile::GetActiveProjectileCount();
+    if (const USG_UnitRegistrySubsystem* Registry = World->GetSubsystem<USG_UnitRegistrySubsystem>())
+    {
+        Sample.Units = Registry->GetActiveCount();
+    }
+    if (const USG_SpawnSchedulerSubsystem* Scheduler = World->GetSubsystem<USG_SpawnSchedulerSubsystem>())
+    {
+        Report.PeakPendingSpawns = FMath::Max(Report.PeakPendingSpawns, Scheduler->GetPendingUnitCount());
+    }
+    Report.PeakProjectiles = FMath::Max(Report.PeakProjectiles, Sample.Projectiles);
+    LastFrameTime = Now;
+
+    UpdateScopeDeltas(Sample, Report.Samples.Num());
+    Report.Samples.Add(Sample);
+
+    if (!BoundDeck.IsValid())
+    {
+        TryBindPlayerDeck();
+    }
+}
+
+/**
+ * @brief 按作用域计时器的增量更新最慢帧列表
+ * @details
+ * - 每帧都更新各计时器的上一帧累计值（约二十个计时器）
+ * - 只有本帧进入最慢帧列表时才按名字合并增量并排序
+ * - 最慢帧列表按帧时间降序保存
+ */
+void USG_MatchTelemetrySubsystem::UpdateScopeDeltas(const FSGTelemetryFrameSample& Sample, int32 FrameIndex)
+{
+    const int32 MaxSlowFrames = USG_DebugSettings::Get()->TelemetrySlowFrameCount;
+    const bool bSlowFrame = MaxSlowFrames > 0
+        && (Report.SlowFrames.Num() < MaxSlowFrames || Sample.FrameMs > Report.SlowFrames.Last().FrameMs);
+
+    TArray<TPair<const TCHAR*, uint64>, TInlineAllocator<32>> Deltas;
+    for (const FSGScopeTimer* Timer = FSGScopeTimer::GetFirst(); Timer; Timer = Timer->GetNext())
+    {
+        const uint64 Cycles = Timer->GetCycles();
+        uint64& Last = LastCycles.FindOrAdd(Timer, 0);
+        const uint64 Delta = Cycles >= Last ? Cycles - Last : Cycles;
+        Last = Cycles;
+
+        if (!bSlowFrame || Delta == 0)
+        {
+            continue;
+        }
+
+        TPair<const TCHAR*, uint64>* Existing = Deltas.FindByPredicate(
+            [Timer](const TPair<const TCHAR*, uint64>& Entry) { return FCString::Strcmp(Entry.Key, Timer->GetName()) == 0; });
+        if (Existing)
+        {
+            Existing->Value += Delta;
+        }
+        else
+        {
+            Deltas.Emplace(Timer->GetName(), Delta);
+        }
+    }
+
+    if (!bSlowFrame)
+    {
+        return;
+    }
+
+    Deltas.Sort([](const TPair<const TCHAR*, uint64>& A, const TPair<const TCHAR*, uint64>& B) { return A.Value > B.Value; });
+
+    FSGTelemetrySlowFrame Slow;
+    Slow.FrameIndex = FrameIndex;
+    Slow.FrameMs = Sample.FrameMs;
+    Slow.Units = Sample.Units;
+    for (int32 Index = 0; Index < FMath::Min(Deltas.Num(), SGMatchTelemetry::TopScopesPerFrame); ++Index)
+    {
+        Slow.TopScopes.Emplace(Deltas[Index].Key, FPlatformTime::ToMilliseconds64(Deltas[Index].Value));
+    }
+
+    const int32 InsertIndex = Report.SlowFrames.IndexOfByPredicate(
+        [&Slow](const FSGTelemetrySlowFrame& Entry) { return Slow.FrameMs > Entry.FrameMs; });
+    Report.SlowFrames.Insert(MoveTemp(Slow), InsertIndex == INDEX_NONE ? Report.SlowFrames.Num() : InsertIndex);
+    if (Report.SlowFrames.Num() > MaxSlowFrames)
+    {
+        Report.SlowFrames.Pop(EAllowShrinking::No);
+    }
+}
+
+void USG_MatchTelemetrySubsystem::TryBindPlayerDeck()
+{
+    const ASG_PlayerController* PlayerController = Cast<ASG_PlayerController>(GetWorld()->GetFirstPlayerController());
+    USG_CardDeckComponent* Deck = PlayerController ? PlayerController->GetCardDeckComponent() : nullptr;
+    if (Deck)
+    {
+        Deck->OnCardUsed.AddDynamic(this, &USG_MatchTelemetrySubsystem::HandleCardUsed);
+        BoundDeck = Deck;
+    }
+}
+
+void USG_MatchTelemetrySubsystem::HandleCardUsed(const FSGCardInstance& UsedCard)
+{
+    ++Report.CardUses.FindOrAdd(UsedCard.CardId.ToString(), 0);
+}
+
+// ========== GC ==========
+
+void USG_MatchTelemetrySubsystem::HandlePreGarbageCollect()
+{
+    GCStartTime = FPlatformTime::Seconds();
+}
+
+void USG_MatchTelemetrySubsystem::HandlePostGarbageCollect()
+{
+    if (GCStartTime <= 0.0)
+    {
+        return;
+    }
+
+    const double PauseMs = (FPlatformTime::Seconds() - GCStartTime) * 1000.0;
+    GCStartTime = 0.0;
+
+    ++Report.GCCount;
+    Report.GCTotalMs += PauseMs;
+    Report.GCMaxMs = FMath::Max(Report.GCMaxMs, PauseMs);
+}
+
+void USG_MatchTelemetrySubsystem::StopCapture()
+{
+    FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+    PreGCHandle.Reset();
+    PostGCHandle.Reset();
+    GCStartTime = 0.0;
+
+    if (USG_CardDeckComponent* Deck = BoundDeck.Get())
+    {
+        Deck->OnCardUsed.RemoveDynamic(this, &USG_MatchTelemetrySubsystem::HandleCardUsed);
+    }
+    BoundDeck.Reset();
+
+    if (!bScopeCaptureWasEnabled)
+    {
+        FSGScopeTimer::SetCaptureEnabled(false);
+    }
+
+    LastCycles.Reset();
+    StartTotals.Reset();
+    bCapturing = false;
+}
@@ -0,0 +1,165 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_MemoryTracking.cpp
+// ✨ 新增 - 分系统内存追踪实现 + SG.Mem.Dump 控制台命令
+// ✅ 这是完整文件
+
+#include "Debug/SG_MemoryTracking.h"
+#include "AbilitySystem/SG_AbilitySystemComponent.h"
+#include "AI/SG_CombatTargetManager.h"
+#include "Actors/SG_Projectile.h"
+#include "Actors/SG_RollingLog.h"
+#include "Strategies/SG_StrategyEffectBase.h"
+#include "UIHud/SG_CardHandViewModel.h"
+#include "UIHud/SG_CardViewModel.h"
+#include "CardsAndUnits/SG_CardDeckComponent.h"
+#include "Units/SG_UnitsBase.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "AIController.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectHash.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+LLM_DEFINE_TAG(Sguo);
+LLM_DEFINE_TAG(Sguo_Units);
+LLM_DEFINE_TAG(Sguo_Projectiles);
+LLM_DEFINE_TAG(Sguo_AI);
+LLM_DEFINE_TAG(Sguo_CardsUI);
+LLM_DEFINE_TAG(Sguo_Strategies);
+
+#endif
+
+namespace SGMemoryTracking
+{
+	/**
+	 * @brief 统计世界中某类对象的存活数量（不含 CDO 和待销毁对象）
+	 */
+	int32 CountLiveObjects(const UWorld* World, const UClass* Class)
+	{
+		int32 Count = 0;
+		ForEachObjectOfClass(Class, [World, &Count](UObject* Object)
+		{
+			if (!Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) && IsValid(Object) && Object->GetWorld() == World)
+			{
+				++Count;
+			}
+		});
+		return Count;
+	}
+
+	/**
+	 * @brief 读取 LLM 标签当前占用（MB），LLM 未开启返回负数
+	 */
+	double GetTagMegabytes(FName TagName)
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			const int64 Bytes = FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, TagName, ELLMTagSet::None);
+			return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+		}
+#endif
+		return -1.0;
+	}
+
+	FString FormatMegabytes(double Megabytes)
+	{
+		return Megabytes < 0.0 ? FString(TEXT("-")) : FString::Printf(TEXT("%.2f"), Megabytes);
+	}
+
+	/**
+	 * @brief 控制台命令：SG.Mem.Dump
+	 * @details
+	 * 功能说明：
+	 * - 输出每个分类的 LLM 占用、存活对象数和对象池 / 注册表高水位线
+	 * - 攻击槽位表中目标已失效的条目单独列出，用于发现 TargetCombatInfoMap 泄漏
+	 */
+	void DumpMemory(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World)
+		{
+			Ar.Log(TEXT("SG.Mem.Dump：没有可用的世界"));
+			return;
+		}
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		const bool bLLMEnabled = FLowLevelMemTracker::IsEnabled();
+		const FName UnitsTag = LLMTagDeclaration_Sguo_Units.GetUniqueName();
+		const FName ProjectilesTag = LLMTagDeclaration_Sguo_Projectiles.GetUniqueName();
+		const FName AITag = LLMTagDeclaration_Sguo_AI.GetUniqueName();
+		const FName CardsUITag = LLMTagDeclaration_Sguo_CardsUI.GetUniqueName();
+		const FName StrategiesTag = LLMTagDeclaration_Sguo_Strategies.GetUniqueName();
+#else
+		const bool bLLMEnabled = false;
+		const FName UnitsTag, ProjectilesTag, AITag, CardsUITag, StrategiesTag;
+#endif
+
+		const USG_UnitRegistrySubsystem* Registry = World->GetSubsystem<USG_UnitRegistrySubsystem>();
+		const USG_UnitPoolSubsystem* UnitPool = World->GetSubsystem<USG_UnitPoolSubsystem>();
+		const USG_CombatTargetManager* CombatTargetManager = World->GetSubsystem<USG_CombatTargetManager>();
+
+		// 卡牌视图模型池（每个手牌视图模型一个）
+		int32 PooledCardViewModels = 0;
+		int32 PeakPooledCardViewModels = 0;
+		ForEachObjectOfClass(USGCardHandViewModel::StaticClass(), [World, &PooledCardViewModels, &PeakPooledCardViewModels](UObject* Object)
+		{
+			const USGCardHandViewModel* HandViewModel = Cast<USGCardHandViewModel>(Object);
+			if (HandViewModel && !HandViewModel->HasAnyFlags(RF_ClassDefaultObject) && HandViewModel->GetWorld() == World)
+			{
+				PooledCardViewModels += HandViewModel->GetPooledCardViewModelCount();
+				PeakPooledCardViewModels += HandViewModel->GetPeakPooledCardViewModelCount();
+			}
+		});
+
+		Ar.Logf(TEXT("========== SG 内存统计 =========="));
+		if (!bLLMEnabled)
+		{
+			Ar.Logf(TEXT("LLM 未开启（启动参数加 -llm），内存列显示为 -"));
+		}
+
+		Ar.Logf(TEXT("%-12s %10s  %s"), TEXT("分类"), TEXT("LLM(MB)"), TEXT("存活对象 / 高水位"));
+
+		Ar.Logf(TEXT("%-12s %10s  单位 %d，ASC %d，注册表 %d（峰值 %d，槽位 %d），池中 %d（峰值 %d）"),
+			TEXT("Units"), *FormatMegabytes(GetTagMegabytes(UnitsTag)),
+			CountLiveObjects(World, ASG_UnitsBase::StaticClass()),
+			CountLiveObjects(World, USG_AbilitySystemComponent::StaticClass()),
+			Registry ? Registry->GetActiveCount() : 0,
+			Registry ? Registry->GetPeakActiveCount() : 0,
+			Registry ? Registry->GetSlotCount() : 0,
+			UnitPool ? UnitPool->GetTotalPooledCount() : 0,
+			UnitPool ? UnitPool->GetPeakPooledCount() : 0);
+
+		Ar.Logf(TEXT("%-12s %10s  投射物 %d"),
+			TEXT("Projectiles"), *FormatMegabytes(GetTagMegabytes(ProjectilesTag)),
+			CountLiveObjects(World, ASG_Projectile::StaticClass()));
+
+		Ar.Logf(TEXT("%-12s %10s  AI 控制器 %d，槽位目标 %d（峰值 %d，已失效 %d）"),
+			TEXT("AI"), *FormatMegabytes(GetTagMegabytes(AITag)),
+			CountLiveObjects(World, AAIController::StaticClass()),
+			CombatTargetManager ? CombatTargetManager->GetTrackedTargetCount() : 0,
+			CombatTargetManager ? CombatTargetManager->GetPeakTrackedTargetCount() : 0,
+			CombatTargetManager ? CombatTargetManager->CountStaleTargetEntries() : 0);
+
+		Ar.Logf(TEXT("%-12s %10s  卡组 %d，卡牌视图模型 %d（池中 %d，峰值 %d），Widget %d"),
+			TEXT("CardsUI"), *FormatMegabytes(GetTagMegabytes(CardsUITag)),
+			CountLiveObjects(World, USG_CardDeckComponent::StaticClass()),
+			CountLiveObjects(World, USGCardViewModel::StaticClass()),
+			PooledCardViewModels,
+			PeakPooledCardViewModels,
+			CountLiveObjects(World, UUserWidget::StaticClass()));
+
+		Ar.Logf(TEXT("%-12s %10s  计谋效果 %d，滚木 %d"),
+			TEXT("Strategies"), *FormatMegabytes(GetTagMegabytes(StrategiesTag)),
+			CountLiveObjects(World, ASG_StrategyEffectBase::StaticClass()),
+			CountLiveObjects(World, ASG_RollingLog::StaticClass()));
+
+		Ar.Logf(TEXT("================================="));
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("SG.Mem.Dump"),
+		TEXT("输出 Sguo 各分类的 LLM 内存、存活对象数和对象池高水位线（内存列需要 -llm）"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpMemory));
+}
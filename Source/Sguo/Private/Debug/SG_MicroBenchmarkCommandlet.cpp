@@ -0,0 +1,528 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_MicroBenchmarkCommandlet.cpp
+// ✨ 新增 - 微基准命令行工具实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_MicroBenchmarkCommandlet.h"
+#include "AI/SG_TargetingSubsystem.h"
+#include "AI/SG_CombatTargetManager.h"
+#include "Actors/SG_FrontLineManager.h"
+#include "CardsAndUnits/SG_CardDeckComponent.h"
+#include "Data/SG_CharacterCardData.h"
+#include "Data/SG_DeckConfig.h"
+#include "Units/SG_UnitsBase.h"
+#include "Debug/SG_LogCategories.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace SGMicroBenchmark
+{
+    // 合成布局的半边长（厘米）
+    constexpr float HalfExtent = 10000.0f;
+
+    // 聚团布局的团数和团半径
+    constexpr int32 ClumpCount = 8;
+    constexpr float ClumpRadius = 600.0f;
+
+    // 分路布局的路数、路间距和路宽
+    constexpr int32 LaneCount = 3;
+    constexpr float LaneSpacing = 6000.0f;
+    constexpr float LaneHalfWidth = 200.0f;
+
+    // 前线重新扫描每轮执行的次数
+    constexpr int32 FrontLineRescansPerIteration = 20;
+
+    // 每个卡池大小执行的抽卡次数
+    constexpr int32 DrawsPerIteration = 20000;
+
+    /**
+     * @brief 统计游戏线程分配次数的转发分配器
+     * @details 只转发，不改变分配行为；只在 FScopedAllocationCounter 作用域内替换 GMalloc
+     * 注意事项：
+     * - 静态对象，生命周期覆盖整个进程，替换期间其他线程拿到的指针始终有效
+     * - 替换期间分配、恢复后释放（或反之）的内存都由同一个内部分配器处理
+     */
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        void SetInner(FMalloc* InInner) { Inner = InInner; }
+        FMalloc* GetInner() const { return Inner; }
+
+        void ResetCount() { Count = 0; }
+        uint64 GetCount() const { return Count; }
+
+        virtual void* Malloc(SIZE_T InCount, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Malloc(InCount, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T InCount, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryMalloc(InCount, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T InCount, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Realloc(Original, InCount, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T InCount, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryRealloc(Original, InCount, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T InCount, uint32 Alignment) override { return Inner->QuantizeSize(InCount, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+        virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        void CountAllocation()
+        {
+            if (IsInGameThread())
+            {
+                ++Count;
+            }
+        }
+
+        FMalloc* Inner = nullptr;
+        uint64 Count = 0;
+    };
+
+    // 进程级的计数分配器（不放在栈上，替换结束后仍然有效）
+    FCountingMalloc GCountingMalloc;
+
+    /**
+     * @brief 作用域内用计数分配器替换 GMalloc，离开作用域时恢复
+     */
+    struct FScopedAllocationCounter
+    {
+        FScopedAllocationCounter()
+        {
+            GCountingMalloc.SetInner(GMalloc);
+            GCountingMalloc.ResetCount();
+            FPlatformMisc::MemoryBarrier();
+            GMalloc = &GCountingMalloc;
+        }
+
+        ~FScopedAllocationCounter()
+        {
+            GMalloc = GCountingMalloc.GetInner();
+            FPlatformMisc::MemoryBarrier();
+        }
+
+        uint64 GetCount() const { return GCountingMalloc.GetCount(); }
+    };
+
+    /**
+     * @brief 解析逗号分隔的整数列表
+     */
+    TArray<int32> ParseIntList(const FString& Text, const TArray<int32>& Default)
+    {
+        TArray<FString> Parts;
+        Text.ParseIntoArray(Parts, TEXT(","));
+
+        TArray<int32> Result;
+        for (const FString& Part : Parts)
+        {
+            const int32 Value = FCString::Atoi(*Part);
+            if (Value > 0)
+            {
+                Result.Add(Value);
+            }
+        }
+        return Result.Num() > 0 ? Result : Default;
+    }
+
+    /**
+     * @brief 创建用于基准的最小游戏世界
+     */
+    UWorld* CreateBenchmarkWorld()
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SGMicroBenchmark"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+        return World;
+    }
+
+    /**
+     * @brief 销毁基准世界
+     */
+    void DestroyBenchmarkWorld(UWorld* World)
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        CollectGarbage(RF_NoFlags);
+    }
+}
+
+USG_MicroBenchmarkCommandlet::USG_MicroBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+/**
+ * @brief 命令行入口
+ * @param Params 命令行参数
+ * @return 0 成功，1 无法创建世界
+ * @details
+ * 详细流程：
+ * 1. 创建最小世界，按最大单位数生成一次合成单位（无 AI 控制器）
+ * 2. 对每个单位数：多余单位移出查询范围，对每个布局重新摆放后执行各套件
+ * 3. 每项先预热一轮（排除首次调用的缓存分配），再计时一轮，最后单独统计一轮的分配次数
+ * 4. 抽卡套件独立于世界，按卡池大小测量
+ * 5. 输出日志表格和 CSV
+ */
+int32 USG_MicroBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace SGMicroBenchmark;
+
+    FString SuitesText = TEXT("Targeting,Slots,FrontLine,Draw");
+    FString CountsText;
+    FString LayoutsText = TEXT("Uniform,Clumped,Lane");
+    FString OutPath;
+    int32 Iterations = 5;
+    int32 Seed = 1337;
+    float Radius = 1500.0f;
+
+    FParse::Value(*Params, TEXT("Suites="), SuitesText);
+    FParse::Value(*Params, TEXT("Counts="), CountsText);
+    FParse::Value(*Params, TEXT("Layouts="), LayoutsText);
+    FParse::Value(*Params, TEXT("Out="), OutPath);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Radius="), Radius);
+    Iterations = FMath::Max(1, Iterations);
+
+    TArray<int32> Counts = ParseIntList(CountsText, { 100, 500, 1000, 2000 });
+    Counts.Sort();
+
+    TArray<FString> Suites;
+    SuitesText.ParseIntoArray(Suites, TEXT(","));
+    TArray<FString> Layouts;
+    LayoutsText.ParseIntoArray(Layouts, TEXT(","));
+
+    const bool bTargeting = Suites.Contains(TEXT("Targeting"));
+    const bool bSlots = Suites.Contains(TEXT("Slots"));
+    const bool bFrontLine = Suites.Contains(TEXT("FrontLine"));
+    const bool bDraw = Suites.Contains(TEXT("Draw"));
+
+    // 基准期间屏蔽游戏日志
+    const ELogVerbosity::Type PreviousGameplayVerbosity = LogSGGameplay.GetVerbosity();
+    const ELogVerbosity::Type PreviousUnitVerbosity = LogSGUnit.GetVerbosity();
+    const ELogVerbosity::Type PreviousCardVerbosity = LogSGCard.GetVerbosity();
+    LogSGGameplay.SetVerbosity(ELogVerbosity::Error);
+    LogSGUnit.SetVerbosity(ELogVerbosity::Error);
+    LogSGCard.SetVerbosity(ELogVerbosity::Error);
+
+    ReportLines.Reset();
+    CsvReport = TEXT("Suite,Layout,Count,Operations,NsPerOp,AllocsPerOp\n");
+
+    int32 ExitCode = 0;
+
+    if (bTargeting || bSlots || bFrontLine)
+    {
+        UWorld* World = CreateBenchmarkWorld();
+        if (!World)
+        {
+            UE_LOG(LogSGGameplay, Error, TEXT("❌ 无法创建基准世界"));
+            ExitCode = 1;
+        }
+        else
+        {
+            const FGameplayTag PlayerTag = FGameplayTag::RequestGameplayTag(TEXT("Unit.Faction.Player"));
+            const FGameplayTag EnemyTag = FGameplayTag::RequestGameplayTag(TEXT("Unit.Faction.Enemy"));
+
+            // ========== 生成合成单位 ==========
+
+            const int32 MaxCount = Counts.Last();
+            TArray<ASG_UnitsBase*> AllUnits;
+            AllUnits.Reserve(MaxCount);
+
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+            SpawnParams.bDeferConstruction = true;
+
+            for (int32 Index = 0; Index < MaxCount; ++Index)
+            {
+                ASG_UnitsBase* Unit = World->SpawnActor<ASG_UnitsBase>(ASG_UnitsBase::StaticClass(), FTransform::Identity, SpawnParams);
+                if (!Unit)
+                {
+                    continue;
+                }
+                Unit->AutoPossessAI = EAutoPossessAI::Disabled;
+                Unit->FactionTag = (Index % 2 == 0) ? PlayerTag : EnemyTag;
+                Unit->FinishSpawning(FTransform::Identity);
+                AllUnits.Add(Unit);
+            }
+
+            USG_TargetingSubsystem* Targeting = World->GetSubsystem<USG_TargetingSubsystem>();
+            USG_CombatTargetManager* CombatManager = World->GetSubsystem<USG_CombatTargetManager>();
+            ASG_FrontLineManager* FrontLine = bFrontLine ? World->SpawnActor<ASG_FrontLineManager>() : nullptr;
+
+            TArray<FSGTargetCandidate> Candidates;
+            const TSet<TWeakObjectPtr<AActor>> IgnoredActors;
+
+            for (const int32 Count : Counts)
+            {
+                const int32 UnitCount = FMath::Min(Count, AllUnits.Num());
+                TArray<ASG_UnitsBase*> Units(AllUnits.GetData(), UnitCount);
+
+                // 多余单位移到远处，不参与查询
+                for (int32 Index = UnitCount; Index < AllUnits.Num(); ++Index)
+                {
+                    AllUnits[Index]->SetActorLocation(FVector(0.0f, 0.0f, -1.0e6f - Index * 1000.0f), false, nullptr, ETeleportType::TeleportPhysics);
+                }
+
+                for (const FString& Layout : Layouts)
+                {
+                    FRandomStream LayoutStream(Seed);
+                    ArrangeUnits(Units, Layout, LayoutStream);
+
+                    const int64 QueryCount = static_cast<int64>(Iterations) * Units.Num();
+
+                    if (bTargeting && Targeting)
+                    {
+                        Measure(TEXT("FindBestTarget"), Layout, UnitCount, QueryCount, [&]()
+                        {
+                            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+                            {
+                                for (ASG_UnitsBase* Unit : Units)
+                                {
+                                    Targeting->FindBestTarget(Unit, Radius, Candidates, IgnoredActors);
+                                }
+                            }
+                        });
+
+                        Measure(TEXT("FindEnemyUnitsOnly"), Layout, UnitCount, QueryCount, [&]()
+                        {
+                            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+                            {
+                                for (ASG_UnitsBase* Unit : Units)
+                                {
+                                    Targeting->FindEnemyUnitsOnly(Unit, Radius, Candidates, IgnoredActors);
+                                }
+                            }
+                        });
+                    }
+
+                    if (bSlots && CombatManager)
+                    {
+                        Measure(TEXT("SlotQueryReserve"), Layout, UnitCount, QueryCount, [&]()
+                        {
+                            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+                            {
+                                for (ASG_UnitsBase* Unit : Units)
+                                {
+                                    AActor* Target = CombatManager->FindBestTargetWithSlot(Unit);
+                                    FVector SlotPosition;
+                                    if (Target && CombatManager->TryReserveAttackSlot(Unit, Target, SlotPosition))
+                                    {
+                                        CombatManager->ReleaseAttackSlot(Unit, Target);
+                                    }
+                                }
+                            }
+                        });
+                    }
+
+                    if (FrontLine)
+                    {
+                        Measure(TEXT("FrontLineRescan"), Layout, UnitCount, static_cast<int64>(Iterations) * FrontLineRescansPerIteration, [&]()
+                        {
+                            for (int32 Rescan = 0; Rescan < Iterations * FrontLineRescansPerIteration; ++Rescan)
+                            {
+                                FrontLine->ForceRescan();
+                            }
+                        });
+
+                        Measure(TEXT("FrontLineZone"), Layout, UnitCount, QueryCount, [&]()
+                        {
+                            // volatile 防止循环被优化掉
+                            volatile int32 PlayerZoneCount = 0;
+                            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+                            {
+                                for (const ASG_UnitsBase* Unit : Units)
+                                {
+                                    PlayerZoneCount += FrontLine->IsInPlayerZone(Unit->GetActorLocation()) ? 1 : 0;
+                                }
+                            }
+                        });
+                    }
+                }
+            }
+
+            DestroyBenchmarkWorld(World);
+        }
+    }
+
+    if (bDraw)
+    {
+        RunDrawSuite(Counts.Last() >= 512 ? TArray<int32>{ 8, 32, 128, 512 } : TArray<int32>{ 8, 32, 128 }, Iterations, Seed);
+    }
+
+    LogSGGameplay.SetVerbosity(PreviousGameplayVerbosity);
+    LogSGUnit.SetVerbosity(PreviousUnitVerbosity);
+    LogSGCard.SetVerbosity(PreviousCardVerbosity);
+
+    // ========== 输出报告 ==========
+
+    UE_LOG(LogSGGameplay, Display, TEXT("========== 微基准 =========="));
+    UE_LOG(LogSGGameplay, Display, TEXT("%-18s %-8s %6s %10s %12s %12s"),
+        TEXT("套件"), TEXT("布局"), TEXT("数量"), TEXT("次数"), TEXT("ns/次"), TEXT("分配/次"));
+    for (const FString& Line : ReportLines)
+    {
+        UE_LOG(LogSGGameplay, Display, TEXT("%s"), *Line);
+    }
+
+    if (OutPath.IsEmpty())
+    {
+        OutPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"),
+            FString::Printf(TEXT("SGMicro_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+    }
+
+    if (FFileHelper::SaveStringToFile(CsvReport, *OutPath))
+    {
+        UE_LOG(LogSGGameplay, Display, TEXT("结果已写入：%s"), *OutPath);
+    }
+    UE_LOG(LogSGGameplay, Display, TEXT("============================"));
+
+    return ExitCode;
+}
+
+/**
+ * @brief 摆放单位
+ * @details
+ * - Uniform：整个区域内均匀随机，双方混杂
+ * - Clumped：8 个团，每团内近似正态分布，双方混杂
+ * - Lane：3 条窄路，玩家在 -X 半边、敌方在 +X 半边
+ */
+void USG_MicroBenchmarkCommandlet::ArrangeUnits(const TArray<ASG_UnitsBase*>& Units, const FString& Layout, FRandomStream& RandomStream) const
+{
+    using namespace SGMicroBenchmark;
+
+    TArray<FVector> ClumpCenters;
+    for (int32 Index = 0; Index < ClumpCount; ++Index)
+    {
+        ClumpCenters.Add(FVector(RandomStream.FRandRange(-HalfExtent, HalfExtent), RandomStream.FRandRange(-HalfExtent, HalfExtent), 0.0f));
+    }
+
+    for (int32 Index = 0; Index < Units.Num(); ++Index)
+    {
+        FVector Location = FVector::ZeroVector;
+
+        if (Layout == TEXT("Clumped"))
+        {
+            // 两个均匀分布相加近似正态分布
+            const FVector& Center = ClumpCenters[RandomStream.RandRange(0, ClumpCount - 1)];
+            Location = Center + FVector(
+                (RandomStream.FRand() + RandomStream.FRand() - 1.0f) * ClumpRadius,
+                (RandomStream.FRand() + RandomStream.FRand() - 1.0f) * ClumpRadius,
+                0.0f);
+        }
+        else if (Layout == TEXT("Lane"))
+        {
+            const bool bPlayerSide = Index % 2 == 0;
+            const int32 Lane = RandomStream.RandRange(0, LaneCount - 1);
+            Location = FVector(
+                bPlayerSide ? RandomStream.FRandRange(-HalfExtent, 0.0f) : RandomStream.FRandRange(0.0f, HalfExtent),
+                (Lane - (LaneCount - 1) * 0.5f) * LaneSpacing + RandomStream.FRandRange(-LaneHalfWidth, LaneHalfWidth),
+                0.0f);
+        }
+        else
+        {
+            Location = FVector(RandomStream.FRandRange(-HalfExtent, HalfExtent), RandomStream.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+        }
+
+        Units[Index]->SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+    }
+}
+
+/**
+ * @brief 抽卡基准
+ * @details 用合成卡牌构建不同大小的卡池，每次操作为"打出第一张手牌 + 抽一张"（与离线抽卡模拟的节奏一致）
+ */
+void USG_MicroBenchmarkCommandlet::RunDrawSuite(const TArray<int32>& PoolSizes, int32 Iterations, int32 Seed)
+{
+    using namespace SGMicroBenchmark;
+
+    FRandomStream WeightStream(Seed);
+
+    for (const int32 PoolSize : PoolSizes)
+    {
+        USG_DeckConfig* DeckConfig = NewObject<USG_DeckConfig>(GetTransientPackage());
+        DeckConfig->InitialHand = 5;
+        DeckConfig->MaxHandSize = 99;
+
+        for (int32 Index = 0; Index < PoolSize; ++Index)
+        {
+            USG_CharacterCardData* Card = NewObject<USG_CharacterCardData>(GetTransientPackage(),
+                MakeUniqueObjectName(GetTransientPackage(), USG_CharacterCardData::StaticClass(), TEXT("SGMicroCard")));
+
+            FSGCardConfigSlot& Slot = DeckConfig->AllowedCards.AddDefaulted_GetRef();
+            Slot.CardData = Card;
+            Slot.DrawWeight = WeightStream.FRandRange(0.5f, 2.0f);
+        }
+
+        USG_CardDeckComponent* Deck = NewObject<USG_CardDeckComponent>(GetTransientPackage());
+        Deck->InitializeForSimulation(DeckConfig, Seed);
+
+        const int32 NumDraws = DrawsPerIteration * Iterations;
+        Measure(TEXT("Draw"), TEXT("Pool"), PoolSize, NumDraws, [Deck, NumDraws]()
+        {
+            for (int32 Step = 0; Step < NumDraws; ++Step)
+            {
+                Deck->PlayCardForSimulation(0);
+                Deck->DrawCardForSimulation();
+            }
+        });
+    }
+}
+
+void USG_MicroBenchmarkCommandlet::Measure(const TCHAR* Suite, const FString& Layout, int32 Count, int64 Operations, TFunctionRef<void()> Body)
+{
+    using namespace SGMicroBenchmark;
+
+    Body();
+
+    const double StartTime = FPlatformTime::Seconds();
+    Body();
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+    // 🔧 修改 - 分配次数单独跑一轮统计，计数分配器只在这一轮替换 GMalloc，不影响计时
+    uint64 Allocations = 0;
+    {
+        FScopedAllocationCounter AllocationCounter;
+        Body();
+        Allocations = AllocationCounter.GetCount();
+    }
+
+    const double NsPerOp = Operations > 0 ? Seconds * 1.0e9 / Operations : 0.0;
+    const double AllocsPerOp = Operations > 0 ? static_cast<double>(Allocations) / Operations : 0.0;
+
+    ReportLines.Add(FString::Printf(TEXT("%-18s %-8s %6d %10lld %12.1f %12.3f"), Suite, *Layout, Count, Operations, NsPerOp, AllocsPerOp));
+    CsvReport += FString::Printf(TEXT("%s,%s,%d,%lld,%.1f,%.4f\n"), Suite, *Layout, Count, Operations, NsPerOp, AllocsPerOp);
+}
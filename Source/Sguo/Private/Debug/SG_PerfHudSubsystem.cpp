@@ -0,0 +1,379 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_PerfHudSubsystem.cpp
+// ✨ 新增 - 战斗性能面板实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_PerfHudSubsystem.h"
+#include "Debug/SG_DebugSettings.h"
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Debug/DebugDrawService.h"
+#include "Actors/SG_Projectile.h"
+#include "AI/SG_CombatTargetManager.h"
+#include "Units/SG_SpawnSchedulerSubsystem.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Units/SG_UnitsBase.h"
+#include "AIController.h"
+#include "BatchedElements.h"
+#include "CanvasItem.h"
+#include "CanvasTypes.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameplayTagContainer.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "SceneView.h"
+
+namespace SGPerfHud
+{
+    // 面板布局（像素）
+    constexpr float PanelX = 20.0f;
+    constexpr float PanelY = 120.0f;
+    constexpr float GraphWidth = 240.0f;
+    constexpr float GraphHeight = 40.0f;
+    constexpr float LabelHeight = 14.0f;
+    constexpr float GraphSpacing = 6.0f;
+
+    // 同一张图最多几条曲线
+    constexpr int32 MaxLinesPerGraph = 3;
+
+    // 曲线颜色（按图内顺序）
+    const FLinearColor LineColors[MaxLinesPerGraph] = {
+        FLinearColor(0.2f, 0.6f, 1.0f),
+        FLinearColor(1.0f, 0.6f, 0.2f),
+        FLinearColor(0.6f, 0.6f, 0.6f)
+    };
+
+    const FLinearColor BackgroundColor(0.0f, 0.0f, 0.0f, 0.5f);
+    const FLinearColor BudgetColor(1.0f, 0.15f, 0.15f);
+
+    /**
+     * @brief 一张曲线图的定义
+     */
+    struct FGraphDef
+    {
+        const TCHAR* Title;
+
+        // USG_DebugSettings::PerfHudBudgets 中的键
+        const TCHAR* BudgetKey;
+
+        int32 NumLines;
+        FSGPerfHudSample::EValue Values[MaxLinesPerGraph];
+        const TCHAR* LineNames[MaxLinesPerGraph];
+    };
+
+    const FGraphDef Graphs[] = {
+        { TEXT("单位"), TEXT("Units"), 2,
+            { FSGPerfHudSample::PlayerUnits, FSGPerfHudSample::EnemyUnits },
+            { TEXT("玩家"), TEXT("敌人") } },
+        { TEXT("AI（按距离）"), TEXT("AI"), 3,
+            { FSGPerfHudSample::AINear, FSGPerfHudSample::AIMid, FSGPerfHudSample::AIFar },
+            { TEXT("近"), TEXT("中"), TEXT("远") } },
+        { TEXT("目标查询 / 帧"), TEXT("TargetQueries"), 1,
+            { FSGPerfHudSample::QueriesPerFrame },
+            { TEXT("") } },
+        { TEXT("候选 / 查询"), TEXT("CandidatesPerQuery"), 1,
+            { FSGPerfHudSample::CandidatesPerQuery },
+            { TEXT("") } },
+        { TEXT("槽位占用 %"), TEXT("SlotOccupancy"), 1,
+            { FSGPerfHudSample::SlotOccupancy },
+            { TEXT("") } },
+        { TEXT("投射物 / 池中单位"), TEXT("Projectiles"), 2,
+            { FSGPerfHudSample::Projectiles, FSGPerfHudSample::PooledUnits },
+            { TEXT("投射物"), TEXT("池中") } },
+        { TEXT("生成队列"), TEXT("SpawnQueue"), 1,
+            { FSGPerfHudSample::SpawnQueue },
+            { TEXT("") } }
+    };
+
+    /**
+     * @brief 控制台命令：SG.PerfHud [0|1]
+     */
+    void ToggleFromConsole(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        USG_PerfHudSubsystem* PerfHud = World ? World->GetSubsystem<USG_PerfHudSubsystem>() : nullptr;
+        if (!PerfHud)
+        {
+            Ar.Logf(TEXT("SG.PerfHud：当前世界没有性能面板（Shipping 包或非游戏世界）"));
+            return;
+        }
+
+        const bool bShow = Args.Num() > 0 ? FCString::Atoi(*Args[0]) != 0 : !PerfHud->IsVisible();
+        if (bShow)
+        {
+            PerfHud->Show();
+        }
+        else
+        {
+            PerfHud->Hide();
+        }
+    }
+
+    FAutoConsoleCommandWithWorldArgsAndOutputDevice ToggleCommand(
+        TEXT("SG.PerfHud"),
+        TEXT("显示 / 隐藏战斗性能面板。用法：SG.PerfHud [0|1]，不带参数时切换"),
+        FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ToggleFromConsole));
+}
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 只在非 Shipping 的游戏世界创建（PIE 也是游戏世界）
+ */
+bool USG_PerfHudSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    const UWorld* World = Outer ? Outer->GetWorld() : nullptr;
+    return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void USG_PerfHudSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (USG_DebugSettings::Get()->bShowPerfHud)
+    {
+        Show();
+    }
+}
+
+void USG_PerfHudSubsystem::Deinitialize()
+{
+    Hide();
+
+    Super::Deinitialize();
+}
+
+// ========== 面板接口 ==========
+
+void USG_PerfHudSubsystem::Show()
+{
+    if (DrawHandle.IsValid())
+    {
+        return;
+    }
+
+    History.SetNum(FMath::Max(USG_DebugSettings::Get()->PerfHudHistoryLength, 2));
+    HistoryHead = 0;
+    HistoryCount = 0;
+
+    // 从当前读数开始计算增量，避免第一段曲线包含开启前的全部查询
+    LastSampleTime = 0.0;
+    LastSampleFrame = GFrameCounter;
+    LastQueries = FSGCounter::Sum(TEXT("TargetQueries"));
+    LastCandidates = FSGCounter::Sum(TEXT("TargetCandidates"));
+
+    DrawHandle = UDebugDrawService::Register(
+        TEXT("Game"),
+        FDebugDrawDelegate::CreateUObject(this, &USG_PerfHudSubsystem::DrawPerfHud)
+    );
+
+    UE_LOG(LogSGGameplay, Log, TEXT("性能面板已开启"));
+}
+
+void USG_PerfHudSubsystem::Hide()
+{
+    if (!DrawHandle.IsValid())
+    {
+        return;
+    }
+
+    UDebugDrawService::Unregister(DrawHandle);
+    DrawHandle.Reset();
+    History.Empty();
+    HistoryHead = 0;
+    HistoryCount = 0;
+}
+
+// ========== 采样 ==========
+
+void USG_PerfHudSubsystem::TakeSample(const FVector& ViewLocation)
+{
+    const USG_DebugSettings* Settings = USG_DebugSettings::Get();
+    UWorld* World = GetWorld();
+
+    FSGPerfHudSample& Sample = History[HistoryHead];
+    Sample = FSGPerfHudSample();
+
+    // 单位和 AI：直接遍历注册表的有效槽位
+    if (const USG_UnitRegistrySubsystem* Registry = World->GetSubsystem<USG_UnitRegistrySubsystem>())
+    {
+        static const FGameplayTag PlayerTag = FGameplayTag::RequestGameplayTag(TEXT("Unit.Faction.Player"), false);
+        static const FGameplayTag EnemyTag = FGameplayTag::RequestGameplayTag(TEXT("Unit.Faction.Enemy"), false);
+        const int32 PlayerIndex = Registry->FindFactionIndex(PlayerTag);
+        const int32 EnemyIndex = Registry->FindFactionIndex(EnemyTag);
+
+        const float NearDistSq = FMath::Square(Settings->PerfHudNearDistance);
+        const float FarDistSq = FMath::Square(Settings->PerfHudFarDistance);
+
+        const TArray<FVector>& Positions = Registry->GetPositions();
+        const TArray<uint8>& FactionIndices = Registry->GetFactionIndices();
+
+        for (TConstSetBitIterator<> It(Registry->GetActiveMask()); It; ++It)
+        {
+            const int32 SlotIndex = It.GetIndex();
+            const int32 FactionIndex = FactionIndices[SlotIndex];
+            if (FactionIndex == PlayerIndex)
+            {
+                Sample.Values[FSGPerfHudSample::PlayerUnits] += 1.0f;
+            }
+            else if (FactionIndex == EnemyIndex)
+            {
+                Sample.Values[FSGPerfHudSample::EnemyUnits] += 1.0f;
+            }
+
+            // 只统计由 AI 控制器驱动的单位（含立定弓手控制器）
+            const ASG_UnitsBase* Unit = Registry->GetUnitAt(SlotIndex);
+            if (!Unit || !Cast<AAIController>(Unit->GetController()))
+            {
+                continue;
+            }
+
+            const double DistSq = FVector::DistSquared(Positions[SlotIndex], ViewLocation);
+            const FSGPerfHudSample::EValue Bucket = DistSq <= NearDistSq ? FSGPerfHudSample::AINear
+                : (DistSq <= FarDistSq ? FSGPerfHudSample::AIMid : FSGPerfHudSample::AIFar);
+            Sample.Values[Bucket] += 1.0f;
+        }
+    }
+
+    // 目标查询：计数器增量按帧数平均
+    const uint64 Queries = FSGCounter::Sum(TEXT("TargetQueries"));
+    const uint64 Candidates = FSGCounter::Sum(TEXT("TargetCandidates"));
+    const uint64 Frames = FMath::Max<uint64>(GFrameCounter - LastSampleFrame, 1);
+    const uint64 DeltaQueries = Queries - LastQueries;
+
+    Sample.Values[FSGPerfHudSample::QueriesPerFrame] = static_cast<float>(DeltaQueries) / Frames;
+    Sample.Values[FSGPerfHudSample::CandidatesPerQuery] = DeltaQueries > 0
+        ? static_cast<float>(Candidates - LastCandidates) / DeltaQueries : 0.0f;
+
+    LastQueries = Queries;
+    LastCandidates = Candidates;
+    LastSampleFrame = GFrameCounter;
+
+    if (const USG_CombatTargetManager* CombatManager = World->GetSubsystem<USG_CombatTargetManager>())
+    {
+        int32 UsedSlots = 0;
+        int32 TotalSlots = 0;
+        CombatManager->GetSlotTotals(UsedSlots, TotalSlots);
+        Sample.Values[FSGPerfHudSample::SlotOccupancy] = TotalSlots > 0 ? 100.0f * UsedSlots / TotalSlots : 0.0f;
+    }
+
+    Sample.Values[FSGPerfHudSample::Projectiles] = ASG_Projectile::GetActiveProjectileCount();
+
+    if (const USG_UnitPoolSubsystem* UnitPool = World->GetSubsystem<USG_UnitPoolSubsystem>())
+    {
+        Sample.Values[FSGPerfHudSample::PooledUnits] = UnitPool->GetTotalPooledCount();
+    }
+
+    if (const USG_SpawnSchedulerSubsystem* Scheduler = World->GetSubsystem<USG_SpawnSchedulerSubsystem>())
+    {
+        Sample.Values[FSGPerfHudSample::SpawnQueue] = Scheduler->GetPendingUnitCount();
+    }
+
+    HistoryHead = (HistoryHead + 1) % History.Num();
+    HistoryCount = FMath::Min(HistoryCount + 1, History.Num());
+}
+
+// ========== 绘制 ==========
+
+void USG_PerfHudSubsystem::DrawPerfHud(UCanvas* Canvas, APlayerController* PlayerController)
+{
+    using namespace SGPerfHud;
+
+    // 调试绘制服务对所有世界的视口广播，只处理自己的世界
+    if (!Canvas || !Canvas->Canvas || !Canvas->SceneView || !Canvas->SceneView->Family || Canvas->SceneView->Family->Scene != GetWorld()->Scene)
+    {
+        return;
+    }
+
+    const USG_DebugSettings* Settings = USG_DebugSettings::Get();
+
+    // 用真实时间采样：暂停时曲线继续向前推进
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastSampleTime >= Settings->PerfHudSampleInterval)
+    {
+        LastSampleTime = Now;
+        TakeSample(Canvas->SceneView->ViewLocation);
+    }
+
+    if (HistoryCount == 0)
+    {
+        return;
+    }
+
+    UFont* Font = GEngine->GetSmallFont();
+    const FSGPerfHudSample& Latest = GetHistorySample(HistoryCount - 1);
+    const float StepX = GraphWidth / (History.Num() - 1);
+
+    float Y = PanelY;
+    for (const FGraphDef& Graph : Graphs)
+    {
+        const float* BudgetPtr = Settings->PerfHudBudgets.Find(FName(Graph.BudgetKey));
+        const float Budget = BudgetPtr ? *BudgetPtr : 0.0f;
+
+        // 标题行：当前值，超出预算标红
+        FString Label = Graph.Title;
+        bool bOverBudget = false;
+        for (int32 LineIndex = 0; LineIndex < Graph.NumLines; ++LineIndex)
+        {
+            const float Value = Latest.Values[Graph.Values[LineIndex]];
+            bOverBudget |= Budget > 0.0f && Value > Budget;
+            Label += FString::Printf(LineIndex == 0 ? TEXT("  %s %.1f") : TEXT(" / %s %.1f"), Graph.LineNames[LineIndex], Value);
+        }
+        if (Budget > 0.0f)
+        {
+            Label += FString::Printf(TEXT("  (预算 %.0f)"), Budget);
+        }
+
+        Canvas->SetDrawColor(bOverBudget ? FColor::Red : FColor::White);
+        Canvas->DrawText(Font, Label, PanelX, Y);
+        Y += LabelHeight;
+
+        // 纵轴上限：历史最大值与预算取大，预算线始终可见
+        float MaxValue = Budget * 1.2f;
+        for (int32 Index = 0; Index < HistoryCount; ++Index)
+        {
+            const FSGPerfHudSample& Sample = GetHistorySample(Index);
+            for (int32 LineIndex = 0; LineIndex < Graph.NumLines; ++LineIndex)
+            {
+                MaxValue = FMath::Max(MaxValue, Sample.Values[Graph.Values[LineIndex]]);
+            }
+        }
+        MaxValue = FMath::Max(MaxValue, 1.0f);
+
+        FCanvasTileItem Background(FVector2D(PanelX, Y), GWhiteTexture, FVector2D(GraphWidth, GraphHeight), BackgroundColor);
+        Background.BlendMode = SE_BLEND_Translucent;
+        Canvas->DrawItem(Background);
+
+        // 在背景之后取线段批次，保证曲线画在背景上面
+        FBatchedElements* Lines = Canvas->Canvas->GetBatchedElements(FCanvas::ET_Line);
+        const float Bottom = Y + GraphHeight;
+        const float ScaleY = GraphHeight / MaxValue;
+
+        if (Budget > 0.0f)
+        {
+            const float BudgetY = Bottom - Budget * ScaleY;
+            Lines->AddLine(FVector(PanelX, BudgetY, 0.0f), FVector(PanelX + GraphWidth, BudgetY, 0.0f), BudgetColor, FHitProxyId());
+        }
+
+        // 最新的采样在右端
+        const float StartX = PanelX + GraphWidth - (HistoryCount - 1) * StepX;
+        for (int32 LineIndex = 0; LineIndex < Graph.NumLines; ++LineIndex)
+        {
+            const FSGPerfHudSample::EValue ValueIndex = Graph.Values[LineIndex];
+            FVector Prev(StartX, Bottom - GetHistorySample(0).Values[ValueIndex] * ScaleY, 0.0f);
+            for (int32 Index = 1; Index < HistoryCount; ++Index)
+            {
+                const FVector Next(StartX + Index * StepX, Bottom - GetHistorySample(Index).Values[ValueIndex] * ScaleY, 0.0f);
+                Lines->AddLine(Prev, Next, LineColors[LineIndex], FHitProxyId());
+                Prev = Next;
+            }
+        }
+
+        Y += GraphHeight + GraphSpacing;
+    }
+}
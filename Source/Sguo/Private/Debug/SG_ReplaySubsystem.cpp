@@ -0,0 +1,530 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_ReplaySubsystem.cpp
+// ✨ 新增 - 确定性对局录像实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_ReplaySubsystem.h"
+#include "Debug/SG_LogCategories.h"
+#include "Actors/SG_EnemySpawner.h"
+#include "AssetManger/SG_AssetManager.h"
+#include "CardsAndUnits/SG_CardDeckComponent.h"
+#include "Data/SG_CardDataBase.h"
+#include "Player/SG_PlayerController.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SGReplay
+{
+    // 文件头
+    constexpr uint32 FileMagic = 0x50524753; // 'SGRP'
+    constexpr uint32 FileVersion = 1;
+
+    // 字符串表上限（索引为 uint16）
+    constexpr int32 MaxNames = MAX_uint16;
+
+    /**
+     * @brief 序列化一条事件（读写共用）
+     */
+    void SerializeEvent(FArchive& Ar, FSGReplayEvent& Event)
+    {
+        uint8 Type = static_cast<uint8>(Event.Type);
+        Ar << Event.Frame << Event.Time << Type << Event.CardIndex << Event.SourceIndex;
+        Ar << Event.Location.X << Event.Location.Y << Event.Location.Z;
+        Event.Type = static_cast<ESGReplayEventType>(Type);
+    }
+
+    /**
+     * @brief 控制台命令：SG.Replay.Save
+     */
+    void SaveFromConsole(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        USG_ReplaySubsystem* Replay = World ? World->GetSubsystem<USG_ReplaySubsystem>() : nullptr;
+        if (!Replay || !Replay->IsRecording())
+        {
+            Ar.Logf(TEXT("SG.Replay.Save：当前没有在录制（启动参数 -SGReplayRecord）"));
+            return;
+        }
+
+        Ar.Logf(Replay->SaveRecording() ? TEXT("录像已保存") : TEXT("录像保存失败"));
+    }
+
+    FAutoConsoleCommandWithWorldArgsAndOutputDevice SaveCommand(
+        TEXT("SG.Replay.Save"),
+        TEXT("立即把当前对局录像写入文件（世界结束时也会自动写入）"),
+        FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&SaveFromConsole));
+}
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 只在非 Shipping 的游戏世界创建
+ */
+bool USG_ReplaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    const UWorld* World = Outer ? Outer->GetWorld() : nullptr;
+    return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+/**
+ * @brief 世界开始时检查命令行
+ * @details 在所有 Actor 的 BeginPlay 之前执行，卡组和生成器初始化随机流时模式已确定
+ */
+void USG_ReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    FString PlayPath;
+    if (FParse::Value(CommandLine, TEXT("SGReplayPlay="), PlayPath))
+    {
+        StartPlayback(PlayPath);
+        return;
+    }
+
+    if (FParse::Param(CommandLine, TEXT("SGReplayRecord")))
+    {
+        FString RecordPath;
+        FParse::Value(CommandLine, TEXT("SGReplayRecord="), RecordPath);
+
+        int32 Seed = static_cast<int32>(FDateTime::Now().GetTicks() & MAX_int32);
+        FParse::Value(CommandLine, TEXT("SGReplaySeed="), Seed);
+
+        StartRecording(Seed, RecordPath);
+    }
+}
+
+void USG_ReplaySubsystem::Deinitialize()
+{
+    if (Mode == EMode::Recording)
+    {
+        SaveRecording();
+    }
+    else if (Mode == EMode::Playback && NextEventIndex < Events.Num())
+    {
+        // 全部派发完成时已在 Tick 中输出
+        ReportPlayback();
+    }
+
+    Mode = EMode::None;
+    Events.Empty();
+    NameTable.Empty();
+    NameLookup.Empty();
+    PlaybackCards.Empty();
+    PlaybackSpawners.Empty();
+
+    Super::Deinitialize();
+}
+
+// ========== 模式 ==========
+
+void USG_ReplaySubsystem::StartRecording(int32 InMatchSeed, const FString& InFilePath)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    Mode = EMode::Recording;
+    MatchSeed = InMatchSeed;
+    MapName = World->GetMapName();
+    Events.Empty();
+    NameTable.Empty();
+    NameLookup.Empty();
+
+    FilePath = InFilePath;
+    if (FilePath.IsEmpty())
+    {
+        FilePath = FPaths::ProjectSavedDir() / TEXT("Replays")
+            / FString::Printf(TEXT("%s_%s.sgreplay"), *MapName, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+    }
+
+    // 固定全局随机数（AI 和使用 FMath::Rand 的逻辑）
+    FMath::RandInit(MatchSeed);
+    FMath::SRandInit(MatchSeed);
+
+    StartFrame = GFrameCounter;
+    StartTime = World->GetTimeSeconds();
+
+    UE_LOG(LogSGGameplay, Log, TEXT("🎬 开始录制对局：种子 %d → %s"), MatchSeed, *FilePath);
+}
+
+/**
+ * @brief 加载录像并开始回放
+ * @details
+ * 详细流程：
+ * 1. 读取并校验文件头、字符串表和事件
+ * 2. 同步加载字符串表中的全部卡牌（回放是调试工具，开局一次性加载避免回放中途卡顿）
+ * 3. 用录像中的种子固定全局随机数
+ */
+bool USG_ReplaySubsystem::StartPlayback(const FString& InFilePath)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *InFilePath))
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 无法读取录像：%s"), *InFilePath);
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    Reader << Magic << Version;
+    if (Magic != SGReplay::FileMagic || Version != SGReplay::FileVersion)
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 录像格式不正确：%s（版本 %u，期望 %u）"), *InFilePath, Version, SGReplay::FileVersion);
+        return false;
+    }
+
+    int32 NumEvents = 0;
+    Reader << MatchSeed << MapName << NameTable << NumEvents;
+    if (Reader.IsError() || NumEvents < 0 || NameTable.Num() > SGReplay::MaxNames)
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 录像已损坏：%s"), *InFilePath);
+        return false;
+    }
+
+    Events.SetNum(NumEvents);
+    for (FSGReplayEvent& Event : Events)
+    {
+        SGReplay::SerializeEvent(Reader, Event);
+    }
+    if (Reader.IsError())
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 录像已损坏：%s"), *InFilePath);
+        Events.Empty();
+        return false;
+    }
+
+    if (MapName != World->GetMapName())
+    {
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 录像地图 %s 与当前地图 %s 不一致，回放结果可能不可信"), *MapName, *World->GetMapName());
+    }
+
+    // 预加载卡牌（生成器名字不是合法的主资产 ID，对应位置留空）
+    PlaybackCards.SetNum(NameTable.Num());
+    if (USG_AssetManager* AssetManager = USG_AssetManager::Get())
+    {
+        for (int32 Index = 0; Index < NameTable.Num(); ++Index)
+        {
+            const FPrimaryAssetId CardId = FPrimaryAssetId::FromString(NameTable[Index]);
+            if (CardId.IsValid())
+            {
+                PlaybackCards[Index] = Cast<USG_CardDataBase>(AssetManager->GetPrimaryAssetPath(CardId).TryLoad());
+            }
+        }
+    }
+
+    FilePath = InFilePath;
+    Mode = EMode::Playback;
+    NextEventIndex = 0;
+    DivergenceCount = 0;
+    DeferredFrames = 0;
+
+    FMath::RandInit(MatchSeed);
+    FMath::SRandInit(MatchSeed);
+
+    StartFrame = GFrameCounter;
+    StartTime = World->GetTimeSeconds();
+
+    UE_LOG(LogSGGameplay, Log, TEXT("▶️ 开始回放对局：%s（种子 %d，%d 个事件，按%s派发）"),
+        *FilePath, MatchSeed, Events.Num(), FApp::UseFixedTimeStep() ? TEXT("帧") : TEXT("时间"));
+    return true;
+}
+
+bool USG_ReplaySubsystem::SaveRecording()
+{
+    if (Mode != EMode::Recording)
+    {
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = SGReplay::FileMagic;
+    uint32 Version = SGReplay::FileVersion;
+    int32 NumEvents = Events.Num();
+    Writer << Magic << Version << MatchSeed << MapName << NameTable << NumEvents;
+    for (FSGReplayEvent& Event : Events)
+    {
+        SGReplay::SerializeEvent(Writer, Event);
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+    {
+        UE_LOG(LogSGGameplay, Error, TEXT("❌ 录像写入失败：%s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogSGGameplay, Log, TEXT("💾 录像已保存：%s（%d 个事件，%d 字节）"), *FilePath, Events.Num(), Bytes.Num());
+    return true;
+}
+
+bool USG_ReplaySubsystem::ResolveStreamSeed(FName StreamName, int32& InOutSeed) const
+{
+    if (Mode == EMode::None)
+    {
+        return false;
+    }
+
+    InOutSeed = static_cast<int32>(HashCombine(GetTypeHash(MatchSeed), GetTypeHash(StreamName)) & MAX_int32);
+    UE_LOG(LogSGGameplay, Log, TEXT("  🎬 录像种子：%s = %d"), *StreamName.ToString(), InOutSeed);
+    return true;
+}
+
+// ========== 录制 ==========
+
+void USG_ReplaySubsystem::RecordCardUse(int32 HandIndex, const FPrimaryAssetId& CardId, const FVector& Location)
+{
+    if (Mode != EMode::Recording)
+    {
+        return;
+    }
+
+    FSGReplayEvent& Event = AddEvent(ESGReplayEventType::CardUse);
+    Event.CardIndex = FindOrAddName(CardId.ToString());
+    Event.SourceIndex = static_cast<uint16>(FMath::Clamp(HandIndex, 0, static_cast<int32>(MAX_uint16)));
+    Event.Location = FVector3f(Location);
+}
+
+void USG_ReplaySubsystem::RecordSkip()
+{
+    if (Mode != EMode::Recording)
+    {
+        return;
+    }
+
+    AddEvent(ESGReplayEventType::Skip);
+}
+
+void USG_ReplaySubsystem::RecordSpawnerWave(const ASG_EnemySpawner* Spawner, const FPrimaryAssetId& CardId, const FVector& Location)
+{
+    if (Mode != EMode::Recording || !Spawner)
+    {
+        return;
+    }
+
+    FSGReplayEvent& Event = AddEvent(ESGReplayEventType::SpawnerWave);
+    Event.CardIndex = FindOrAddName(CardId.ToString());
+    Event.SourceIndex = FindOrAddName(Spawner->GetName());
+    Event.Location = FVector3f(Location);
+}
+
+FSGReplayEvent& USG_ReplaySubsystem::AddEvent(ESGReplayEventType Type)
+{
+    const UWorld* World = GetWorld();
+
+    FSGReplayEvent& Event = Events.AddDefaulted_GetRef();
+    Event.Frame = static_cast<uint32>(GFrameCounter - StartFrame);
+    Event.Time = World ? static_cast<float>(World->GetTimeSeconds() - StartTime) : 0.0f;
+    Event.Type = Type;
+    return Event;
+}
+
+uint16 USG_ReplaySubsystem::FindOrAddName(const FString& Name)
+{
+    if (const uint16* Existing = NameLookup.Find(Name))
+    {
+        return *Existing;
+    }
+
+    if (NameTable.Num() >= SGReplay::MaxNames)
+    {
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 录像字符串表已满，%s 记为第一项"), *Name);
+        return 0;
+    }
+
+    const uint16 Index = static_cast<uint16>(NameTable.Add(Name));
+    NameLookup.Add(Name, Index);
+    return Index;
+}
+
+// ========== 回放 ==========
+
+/**
+ * @brief 派发到期的事件
+ * @details
+ * - 固定步长（-benchmark -fps=N）时按帧比较，否则按世界时间比较
+ * - 卡组冷却中的出牌 / 跳过暂缓到下一帧，保持事件顺序
+ */
+void USG_ReplaySubsystem::Tick(float DeltaTime)
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const bool bByFrame = FApp::UseFixedTimeStep();
+    const uint64 Frame = GFrameCounter - StartFrame;
+    const double Time = World->GetTimeSeconds() - StartTime;
+
+    while (NextEventIndex < Events.Num())
+    {
+        const FSGReplayEvent& Event = Events[NextEventIndex];
+        const bool bDue = bByFrame ? Event.Frame <= Frame : Event.Time <= Time;
+        if (!bDue)
+        {
+            break;
+        }
+
+        if (!DispatchEvent(Event))
+        {
+            ++DeferredFrames;
+            break;
+        }
+        ++NextEventIndex;
+    }
+
+    if (NextEventIndex >= Events.Num())
+    {
+        ReportPlayback();
+    }
+}
+
+bool USG_ReplaySubsystem::DispatchEvent(const FSGReplayEvent& Event)
+{
+    switch (Event.Type)
+    {
+    case ESGReplayEventType::CardUse:
+        return DispatchCardUse(Event);
+
+    case ESGReplayEventType::Skip:
+        return DispatchSkip();
+
+    case ESGReplayEventType::SpawnerWave:
+        DispatchSpawnerWave(Event);
+        return true;
+
+    default:
+        ++DivergenceCount;
+        return true;
+    }
+}
+
+/**
+ * @brief 回放玩家出牌
+ * @details
+ * 1. 卡组冷却中时暂缓
+ * 2. 优先使用录像中的手牌位置；该位置的卡牌与录像不一致时在手牌中按卡牌 ID 查找，并记为分歧
+ * 3. 交给 ASG_PlayerController::PlayCardAt，与玩家操作走相同的生成和用牌流程
+ */
+bool USG_ReplaySubsystem::DispatchCardUse(const FSGReplayEvent& Event)
+{
+    ASG_PlayerController* PlayerController = Cast<ASG_PlayerController>(GetWorld()->GetFirstPlayerController());
+    USG_CardDeckComponent* Deck = PlayerController ? PlayerController->GetCardDeckComponent() : nullptr;
+    if (!Deck)
+    {
+        ++DivergenceCount;
+        return true;
+    }
+
+    if (!Deck->CanAct())
+    {
+        return false;
+    }
+
+    const FPrimaryAssetId CardId = NameTable.IsValidIndex(Event.CardIndex)
+        ? FPrimaryAssetId::FromString(NameTable[Event.CardIndex]) : FPrimaryAssetId();
+    const TArray<FSGCardInstance>& Hand = Deck->GetHand();
+
+    int32 HandIndex = Event.SourceIndex;
+    if (!Hand.IsValidIndex(HandIndex) || Hand[HandIndex].CardId != CardId)
+    {
+        HandIndex = Hand.IndexOfByPredicate([&CardId](const FSGCardInstance& Card) { return Card.CardId == CardId; });
+        ++DivergenceCount;
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 回放分歧：第 %d 个事件的手牌位置 %d 不是 %s（%s）"),
+            NextEventIndex, Event.SourceIndex, *CardId.ToString(), HandIndex == INDEX_NONE ? TEXT("手牌中没有，跳过") : TEXT("改用手牌中的同名卡"));
+        if (HandIndex == INDEX_NONE)
+        {
+            return true;
+        }
+    }
+
+    if (!PlayerController->PlayCardAt(Hand[HandIndex].InstanceId, FVector(Event.Location)))
+    {
+        ++DivergenceCount;
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 回放分歧：第 %d 个事件 %s 使用失败"), NextEventIndex, *CardId.ToString());
+    }
+    return true;
+}
+
+bool USG_ReplaySubsystem::DispatchSkip()
+{
+    const ASG_PlayerController* PlayerController = Cast<ASG_PlayerController>(GetWorld()->GetFirstPlayerController());
+    USG_CardDeckComponent* Deck = PlayerController ? PlayerController->GetCardDeckComponent() : nullptr;
+    if (!Deck)
+    {
+        ++DivergenceCount;
+        return true;
+    }
+
+    if (!Deck->CanAct())
+    {
+        return false;
+    }
+
+    Deck->SkipAction();
+    return true;
+}
+
+void USG_ReplaySubsystem::DispatchSpawnerWave(const FSGReplayEvent& Event)
+{
+    ASG_EnemySpawner* Spawner = nullptr;
+    if (const TWeakObjectPtr<ASG_EnemySpawner>* Cached = PlaybackSpawners.Find(Event.SourceIndex))
+    {
+        Spawner = Cached->Get();
+    }
+    else if (NameTable.IsValidIndex(Event.SourceIndex))
+    {
+        for (TActorIterator<ASG_EnemySpawner> It(GetWorld()); It; ++It)
+        {
+            if (It->GetName() == NameTable[Event.SourceIndex])
+            {
+                Spawner = *It;
+                break;
+            }
+        }
+        PlaybackSpawners.Add(Event.SourceIndex, Spawner);
+    }
+
+    USG_CardDataBase* Card = PlaybackCards.IsValidIndex(Event.CardIndex) ? PlaybackCards[Event.CardIndex].Get() : nullptr;
+    if (!Spawner || !Card || !Spawner->SpawnCardAt(Card, FVector(Event.Location)))
+    {
+        ++DivergenceCount;
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 回放分歧：第 %d 个事件找不到生成器或卡牌（%s / %s）"), NextEventIndex,
+            NameTable.IsValidIndex(Event.SourceIndex) ? *NameTable[Event.SourceIndex] : TEXT("?"),
+            NameTable.IsValidIndex(Event.CardIndex) ? *NameTable[Event.CardIndex] : TEXT("?"));
+    }
+}
+
+void USG_ReplaySubsystem::ReportPlayback() const
+{
+    if (Mode != EMode::Playback)
+    {
+        return;
+    }
+
+    UE_LOG(LogSGGameplay, Log, TEXT("⏹️ 回放%s：%d/%d 个事件，分歧 %d，冷却暂缓 %d 帧"),
+        NextEventIndex >= Events.Num() ? TEXT("完成") : TEXT("中断"),
+        NextEventIndex, Events.Num(), DivergenceCount, DeferredFrames);
+}
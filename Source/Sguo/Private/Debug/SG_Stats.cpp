@@ -0,0 +1,105 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_Stats.cpp
+// ✨ 新增 - 性能统计定义
+// ✅ 这是完整文件
+
+#include "Debug/SG_Stats.h"
+
+// ========== 耗时 ==========
+
+DEFINE_STAT(STAT_SGFindBestTarget);
+DEFINE_STAT(STAT_SGFindEnemyUnitsOnly);
+DEFINE_STAT(STAT_SGFindBestTargetWithSlot);
+DEFINE_STAT(STAT_SGReserveAttackSlot);
+DEFINE_STAT(STAT_SGReleaseAttackSlot);
+DEFINE_STAT(STAT_SGAIControllerTick);
+DEFINE_STAT(STAT_SGUnitTick);
+DEFINE_STAT(STAT_SGProjectileTick);
+DEFINE_STAT(STAT_SGMeleeDetection);
+DEFINE_STAT(STAT_SGEnemySpawnUnit);
+DEFINE_STAT(STAT_SGSpawnSchedulerTick);
+DEFINE_STAT(STAT_SGUnitPoolAcquire);
+DEFINE_STAT(STAT_SGCardDraw);
+DEFINE_STAT(STAT_SGFrontLineUpdate);
+
+// ========== 每帧计数 ==========
+
+DEFINE_STAT(STAT_SGTargetQueries);
+DEFINE_STAT(STAT_SGTargetCandidates);
+DEFINE_STAT(STAT_SGSlotReservations);
+DEFINE_STAT(STAT_SGProjectileTicks);
+DEFINE_STAT(STAT_SGMeleeSweepHits);
+DEFINE_STAT(STAT_SGUnitsSpawned);
+DEFINE_STAT(STAT_SGUnitsReused);
+DEFINE_STAT(STAT_SGCardsDrawn);
+
+// ========== 当前数量 ==========
+
+DEFINE_STAT(STAT_SGActiveProjectiles);
+DEFINE_STAT(STAT_SGPooledUnits);
+DEFINE_STAT(STAT_SGCardPreloadHits);
+DEFINE_STAT(STAT_SGCardPreloadMisses);
+DEFINE_STAT(STAT_SGCardPreloadHitRate);
+DEFINE_STAT(STAT_SGCardPreloadResident);
+
+CSV_DEFINE_CATEGORY_MODULE(SGUO_API, Sguo, true);
+
+// ========== 作用域计时器 ==========
+
+std::atomic<FSGScopeTimer*> FSGScopeTimer::Head{ nullptr };
+std::atomic<bool> FSGScopeTimer::bCaptureEnabled{ false };
+
+/**
+ * @brief 注册计时器
+ * @details 无锁头插：函数内静态变量只构造一次，链表只增不减
+ */
+FSGScopeTimer::FSGScopeTimer(const TCHAR* InName)
+	: Name(InName)
+{
+	FSGScopeTimer* OldHead = Head.load(std::memory_order_relaxed);
+	do
+	{
+		Next = OldHead;
+	}
+	while (!Head.compare_exchange_weak(OldHead, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void FSGScopeTimer::ResetAll()
+{
+	for (FSGScopeTimer* Timer = Head.load(std::memory_order_acquire); Timer; Timer = Timer->Next)
+	{
+		Timer->Cycles.store(0, std::memory_order_relaxed);
+		Timer->Calls.store(0, std::memory_order_relaxed);
+	}
+}
+
+// ========== ✨ 新增 - 累计计数器 ==========
+
+std::atomic<FSGCounter*> FSGCounter::Head{ nullptr };
+
+/**
+ * @brief 注册计数器
+ * @details 与 FSGScopeTimer 相同的无锁头插
+ */
+FSGCounter::FSGCounter(const TCHAR* InName)
+	: Name(InName)
+{
+	FSGCounter* OldHead = Head.load(std::memory_order_relaxed);
+	do
+	{
+		Next = OldHead;
+	}
+	while (!Head.compare_exchange_weak(OldHead, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint64 FSGCounter::Sum(const TCHAR* InName)
+{
+	uint64 Total = 0;
+	for (const FSGCounter* Counter = Head.load(std::memory_order_acquire); Counter; Counter = Counter->Next)
+	{
+		if (FCString::Strcmp(Counter->Name, InName) == 0)
+		{
+			Total += Counter->GetValue();
+		}
+	}
+	return Total;
+}
@@ -0,0 +1,237 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_StructuredLog.cpp
+// ✨ 新增 - 结构化游戏日志实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_StructuredLog.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/OutputDeviceRedirector.h"
+#include <atomic>
+
+namespace SGStructuredLog
+{
+	/**
+	 * @brief 事件描述：名字和文本格式（{0}{1} 为名字槽，之后依次为数值槽）
+	 */
+	struct FEventDesc
+	{
+		const TCHAR* Name;
+		const TCHAR* Format;
+	};
+
+	const FEventDesc EventDescs[] =
+	{
+		{ TEXT("TargetSelected"),       TEXT("🎯 {0} 选择敌方单位：{1} (距离: {2}, 攻击者: {3}, 评分: {4})") },
+		{ TEXT("TargetSearchCity"),     TEXT("📍 {0} 视野内无敌方单位，查找敌方主城...") },
+		{ TEXT("TargetFallbackCity"),   TEXT("🏰 {0} 回退到敌方主城：{1} (距离: {2}, 攻击者: {3})") },
+		{ TEXT("TargetNone"),           TEXT("⚠️ {0} 未找到任何敌方目标（单位和主城都没有）") },
+		{ TEXT("AttackUnitFound"),      TEXT("    {0} 找到敌方单位：{1}") },
+		{ TEXT("AttackCityHit"),        TEXT("    {0} 找到敌方主城（通过攻击检测盒）：{1}，到表面距离：{2} / 攻击范围：{3}") },
+		{ TEXT("AttackCityOutOfRange"), TEXT("    {0} 检测到主城 {1} 但距离不足：{2} > {3}") },
+		{ TEXT("DamageComputed"),       TEXT("  伤害计算：{0} → {1}，攻击力 {2} × 倍率 {3} = {4}") },
+	};
+	constexpr int32 NumEventDescs = static_cast<int32>(UE_ARRAY_COUNT(EventDescs));
+	static_assert(NumEventDescs == static_cast<int32>(ESGLogEvent::Count), "ESGLogEvent 与事件表不一致");
+
+	// 每个线程缓冲区的容量（2 的幂）
+	constexpr uint32 RingCapacity = 1024;
+
+	/**
+	 * @brief 单线程环形缓冲区
+	 * @details
+	 * - 只有所属线程写入：先把槽位序号置为奇数（写入中），写完记录后置为偶数（已完成）
+	 * - 转储线程读取前后比较序号，序号不一致（正在被覆盖）的槽位跳过
+	 */
+	struct FRing
+	{
+		uint32 ThreadId = 0;
+		std::atomic<uint64> Head{ 0 };
+		std::atomic<uint64> Sequences[RingCapacity] = {};
+		FSGLogRecord Records[RingCapacity];
+		FRing* Next = nullptr;
+	};
+
+	// 所有线程缓冲区（只增不减，线程退出后缓冲区保留以便崩溃转储）
+	std::atomic<FRing*> RingListHead{ nullptr };
+
+	// 当前线程的缓冲区
+	thread_local FRing* ThreadRing = nullptr;
+
+	/**
+	 * @brief 崩溃时转储
+	 */
+	void DumpOnSystemError()
+	{
+		if (GLog)
+		{
+			SGLog::DumpRings(*GLog, 64);
+			GLog->Flush();
+		}
+	}
+
+	/**
+	 * @brief 创建并注册当前线程的缓冲区
+	 */
+	FRing* CreateThreadRing()
+	{
+		// 首个线程注册时挂接崩溃转储（静态局部变量初始化保证只执行一次）
+		static const bool bCrashHookRegistered = []()
+		{
+			FCoreDelegates::OnHandleSystemError.AddStatic(&DumpOnSystemError);
+			return true;
+		}();
+		(void)bCrashHookRegistered;
+
+		FRing* Ring = new FRing();
+		Ring->ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+		FRing* OldHead = RingListHead.load(std::memory_order_relaxed);
+		do
+		{
+			Ring->Next = OldHead;
+		}
+		while (!RingListHead.compare_exchange_weak(OldHead, Ring, std::memory_order_release, std::memory_order_relaxed));
+
+		return Ring;
+	}
+
+	/**
+	 * @brief 控制台命令：SG.Log.DumpRing [每线程条数]
+	 */
+	void DumpFromConsole(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 MaxRecords = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 256;
+		SGLog::DumpRings(Ar, MaxRecords);
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("SG.Log.DumpRing"),
+		TEXT("按时间顺序输出结构化日志环形缓冲区。用法：SG.Log.DumpRing [每线程条数=256]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpFromConsole));
+}
+
+// ========== 记录 ==========
+
+void SGLog::Record(const FSGLogRecord& InRecord)
+{
+	using namespace SGStructuredLog;
+
+	FRing* Ring = ThreadRing;
+	if (!Ring)
+	{
+		Ring = ThreadRing = CreateThreadRing();
+	}
+
+	const uint64 Index = Ring->Head.load(std::memory_order_relaxed);
+	const uint32 Slot = static_cast<uint32>(Index & (RingCapacity - 1));
+
+	Ring->Sequences[Slot].store(Index * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Ring->Records[Slot] = InRecord;
+	Ring->Sequences[Slot].store(Index * 2 + 2, std::memory_order_release);
+	Ring->Head.store(Index + 1, std::memory_order_release);
+}
+
+// ========== 文本 ==========
+
+FString SGLog::FormatRecord(const FSGLogRecord& InRecord)
+{
+	using namespace SGStructuredLog;
+
+	const int32 EventIndex = static_cast<int32>(InRecord.Event);
+	if (EventIndex < 0 || EventIndex >= NumEventDescs)
+	{
+		return FString::Printf(TEXT("未知事件 %d"), EventIndex);
+	}
+
+	// 名字槽固定占 {0}{1}，数值从 {2} 开始
+	FStringFormatOrderedArguments Args;
+	for (uint8 Index = 0; Index < FSGLogRecord::MaxNames; ++Index)
+	{
+		Args.Add(Index < InRecord.NumNames ? InRecord.Names[Index].ToString() : FString());
+	}
+	for (uint8 Index = 0; Index < InRecord.NumValues; ++Index)
+	{
+		Args.Add(FString::Printf(TEXT("%.2f"), InRecord.Values[Index]));
+	}
+
+	return FString::Format(EventDescs[EventIndex].Format, Args);
+}
+
+void SGLog::EmitText(const FSGLogRecord& InRecord)
+{
+	if (GLog)
+	{
+		GLog->Serialize(*FormatRecord(InRecord), InRecord.Verbosity, InRecord.Category);
+	}
+}
+
+// ========== 转储 ==========
+
+/**
+ * @brief 转储所有线程的缓冲区
+ * @details
+ * 详细流程：
+ * 1. 对每个线程缓冲区，从最近的 MaxRecordsPerThread 条中复制序号一致的记录
+ * 2. 全部记录按时间戳排序
+ * 3. 每条输出 "[帧号] +毫秒 线程 类别 事件 文本"，毫秒相对第一条记录
+ */
+void SGLog::DumpRings(FOutputDevice& Ar, int32 MaxRecordsPerThread)
+{
+	using namespace SGStructuredLog;
+
+	struct FDumpRecord
+	{
+		FSGLogRecord Record;
+		uint32 ThreadId = 0;
+	};
+
+	TArray<FDumpRecord> Dumped;
+	const uint64 MaxPerThread = static_cast<uint64>(FMath::Clamp<int32>(MaxRecordsPerThread, 1, static_cast<int32>(RingCapacity)));
+
+	for (FRing* Ring = RingListHead.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+	{
+		const uint64 Head = Ring->Head.load(std::memory_order_acquire);
+		const uint64 First = Head > MaxPerThread ? Head - MaxPerThread : 0;
+
+		for (uint64 Index = First; Index < Head; ++Index)
+		{
+			const uint32 Slot = static_cast<uint32>(Index & (RingCapacity - 1));
+			const uint64 Expected = Index * 2 + 2;
+			if (Ring->Sequences[Slot].load(std::memory_order_acquire) != Expected)
+			{
+				continue;
+			}
+
+			FDumpRecord& Entry = Dumped.AddDefaulted_GetRef();
+			Entry.Record = Ring->Records[Slot];
+			Entry.ThreadId = Ring->ThreadId;
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (Ring->Sequences[Slot].load(std::memory_order_relaxed) != Expected)
+			{
+				Dumped.Pop(EAllowShrinking::No);
+			}
+		}
+	}
+
+	Dumped.Sort([](const FDumpRecord& A, const FDumpRecord& B) { return A.Record.Cycles < B.Record.Cycles; });
+
+	Ar.Logf(TEXT("========== SG 结构化日志：%d 条 =========="), Dumped.Num());
+
+	const uint64 BaseCycles = Dumped.Num() > 0 ? Dumped[0].Record.Cycles : 0;
+	for (const FDumpRecord& Entry : Dumped)
+	{
+		const int32 EventIndex = static_cast<int32>(Entry.Record.Event);
+		Ar.Logf(TEXT("[%u] +%.3fms T%u %s %s %s"),
+			Entry.Record.FrameNumber,
+			FPlatformTime::ToMilliseconds64(Entry.Record.Cycles - BaseCycles),
+			Entry.ThreadId,
+			*Entry.Record.Category.ToString(),
+			EventIndex >= 0 && EventIndex < NumEventDescs ? EventDescs[EventIndex].Name : TEXT("?"),
+			*FormatRecord(Entry.Record));
+	}
+
+	Ar.Logf(TEXT("=========================================="));
+}
@@ -0,0 +1,189 @@
+// 📄 文件：Source/Sguo/Private/Debug/SG_Trace.cpp
+// ✨ 新增 - Unreal Insights 自定义追踪通道实现
+// ✅ 这是完整文件
+
+#include "Debug/SG_Trace.h"
+
+#if SG_TRACE_ENABLED
+
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/UObjectArray.h"
+
+UE_TRACE_CHANNEL_DEFINE(SguoChannel);
+
+// ========== 事件定义 ==========
+
+UE_TRACE_EVENT_BEGIN(Sguo, TargetChanged)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, UnitId)
+	UE_TRACE_EVENT_FIELD(uint64, OldTargetId)
+	UE_TRACE_EVENT_FIELD(uint64, NewTargetId)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Sguo, AttackSlot)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, AttackerId)
+	UE_TRACE_EVENT_FIELD(uint64, TargetId)
+	UE_TRACE_EVENT_FIELD(int32, SlotIndex)
+	UE_TRACE_EVENT_FIELD(bool, bReserve)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Sguo, Damage)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, SourceId)
+	UE_TRACE_EVENT_FIELD(uint64, TargetId)
+	UE_TRACE_EVENT_FIELD(float, Amount)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Sguo, UnitDied)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, UnitId)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Sguo, CardUsed)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, OwnerId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, CardName)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, InstanceId)
+UE_TRACE_EVENT_END()
+
+// Actor ID 与名称对应关系（每个世界中每个 Actor 只写一次，Important 事件对之后连接的会话重发）
+UE_TRACE_EVENT_BEGIN(Sguo, ActorName, NoSync|Important)
+	UE_TRACE_EVENT_FIELD(uint64, ActorId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+namespace
+{
+	// 已写入名称的 Actor ID（只在游戏线程访问，世界清理时清空）
+	TSet<uint64> NamedActors;
+
+	/**
+	 * @brief 获取 Actor 的追踪 ID，首次出现时写入名称
+	 * @details ID = 对象序列号 << 32 | 对象索引；序列号不会复用，GC 回收对象槽位后新 Actor 的 ID 也不同
+	 */
+	uint64 GetTraceId(const AActor* Actor)
+	{
+		if (!Actor)
+		{
+			return 0;
+		}
+
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Actor);
+		const int32 SerialNumber = GUObjectArray.AllocateSerialNumber(ObjectIndex);
+		const uint64 ActorId = (static_cast<uint64>(SerialNumber) << 32) | static_cast<uint32>(ObjectIndex);
+
+		// 只在游戏线程记录名称表
+		if (IsInGameThread())
+		{
+			static const FDelegateHandle WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda(
+				[](UWorld*, bool, bool)
+				{
+					NamedActors.Empty();
+				});
+
+			bool bAlreadyNamed = false;
+			NamedActors.Add(ActorId, &bAlreadyNamed);
+			if (!bAlreadyNamed)
+			{
+				const FString Name = Actor->GetName();
+				UE_TRACE_LOG(Sguo, ActorName, SguoChannel)
+					<< ActorName.ActorId(ActorId)
+					<< ActorName.Name(*Name, Name.Len());
+			}
+		}
+
+		return ActorId;
+	}
+}
+
+/**
+ * @brief 当前线程 CPU 时间线上的零时长标记
+ * @details 每种事件一个固定名称（只注册一次），具体参数在对应的 Sguo 事件中
+ */
+#define SG_TRACE_TIMELINE_MARKER(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, SguoChannel)
+
+// ========== 事件写入 ==========
+
+void SGTrace::TargetChanged(const AActor* Unit, const AActor* OldTarget, const AActor* NewTarget)
+{
+	UE_TRACE_LOG(Sguo, TargetChanged, SguoChannel)
+		<< TargetChanged.Cycle(FPlatformTime::Cycles64())
+		<< TargetChanged.UnitId(GetTraceId(Unit))
+		<< TargetChanged.OldTargetId(GetTraceId(OldTarget))
+		<< TargetChanged.NewTargetId(GetTraceId(NewTarget));
+
+	SG_TRACE_TIMELINE_MARKER("SG.TargetChanged");
+}
+
+void SGTrace::SlotReserved(const AActor* Attacker, const AActor* Target, int32 SlotIndex)
+{
+	UE_TRACE_LOG(Sguo, AttackSlot, SguoChannel)
+		<< AttackSlot.Cycle(FPlatformTime::Cycles64())
+		<< AttackSlot.AttackerId(GetTraceId(Attacker))
+		<< AttackSlot.TargetId(GetTraceId(Target))
+		<< AttackSlot.SlotIndex(SlotIndex)
+		<< AttackSlot.bReserve(true);
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		SG_TRACE_TIMELINE_MARKER("SG.SlotFull");
+	}
+	else
+	{
+		SG_TRACE_TIMELINE_MARKER("SG.SlotReserved");
+	}
+}
+
+void SGTrace::SlotReleased(const AActor* Attacker, const AActor* Target)
+{
+	UE_TRACE_LOG(Sguo, AttackSlot, SguoChannel)
+		<< AttackSlot.Cycle(FPlatformTime::Cycles64())
+		<< AttackSlot.AttackerId(GetTraceId(Attacker))
+		<< AttackSlot.TargetId(GetTraceId(Target))
+		<< AttackSlot.SlotIndex(INDEX_NONE)
+		<< AttackSlot.bReserve(false);
+
+	SG_TRACE_TIMELINE_MARKER("SG.SlotReleased");
+}
+
+void SGTrace::Damage(const AActor* Source, const AActor* Target, float Amount)
+{
+	UE_TRACE_LOG(Sguo, Damage, SguoChannel)
+		<< Damage.Cycle(FPlatformTime::Cycles64())
+		<< Damage.SourceId(GetTraceId(Source))
+		<< Damage.TargetId(GetTraceId(Target))
+		<< Damage.Amount(Amount);
+
+	SG_TRACE_TIMELINE_MARKER("SG.Damage");
+}
+
+void SGTrace::UnitDied(const AActor* Unit)
+{
+	UE_TRACE_LOG(Sguo, UnitDied, SguoChannel)
+		<< UnitDied.Cycle(FPlatformTime::Cycles64())
+		<< UnitDied.UnitId(GetTraceId(Unit));
+
+	SG_TRACE_TIMELINE_MARKER("SG.UnitDied");
+}
+
+void SGTrace::CardUsed(const AActor* Owner, const FText& CardName, const FGuid& InstanceId)
+{
+	const FString CardNameString = CardName.ToString();
+	const FString InstanceIdString = InstanceId.ToString();
+
+	UE_TRACE_LOG(Sguo, CardUsed, SguoChannel)
+		<< CardUsed.Cycle(FPlatformTime::Cycles64())
+		<< CardUsed.OwnerId(GetTraceId(Owner))
+		<< CardUsed.CardName(*CardNameString, CardNameString.Len())
+		<< CardUsed.InstanceId(*InstanceIdString, InstanceIdString.Len());
+
+	SG_TRACE_TIMELINE_MARKER("SG.CardUsed");
+}
+
+#undef SG_TRACE_TIMELINE_MARKER
+
+#endif
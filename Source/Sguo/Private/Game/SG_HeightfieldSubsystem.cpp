@@ -0,0 +1,528 @@
+// 📄 文件：Source/Sguo/Private/Game/SG_HeightfieldSubsystem.cpp
+// ✨ 新增 - 战场高度图缓存实现
+// ✅ 这是完整文件
+
+#include "Game/SG_HeightfieldSubsystem.h"
+#include "Debug/SG_LogCategories.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "Engine/LevelBounds.h"
+#include "NavigationSystem.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // 自动适配关卡范围时，网格每边的最大格子数
+    constexpr int32 MaxFittedGridSize = 1024;
+}
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_HeightfieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGGameplay, Log, TEXT("✓ 战场高度图初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_HeightfieldSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+
+    UE_LOG(LogSGGameplay, Log, TEXT("战场高度图统计：缓存命中 %d，退回射线检测 %d"), CacheHitCount, FallbackTraceCount);
+
+    VertexHeights.Empty();
+    VertexValid.Empty();
+    VertexDirty.Empty();
+    bHeightfieldReady = false;
+    bBuilding = false;
+
+    Super::Deinitialize();
+}
+
+/**
+ * @brief 关卡开始：采样高度图并开始监听阻挡物的生成/销毁
+ */
+void USG_HeightfieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (!bEnableHeightfield)
+    {
+        return;
+    }
+
+    BuildHeightfield();
+
+    ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &USG_HeightfieldSubsystem::HandleActorSpawned));
+    ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(
+        FOnActorDestroyed::FDelegate::CreateUObject(this, &USG_HeightfieldSubsystem::HandleActorDestroyed));
+}
+
+/**
+ * @brief 每帧 Tick：在时间预算内继续采样
+ */
+void USG_HeightfieldSubsystem::Tick(float DeltaTime)
+{
+    ContinueBuild(BuildBudgetMs / 1000.0);
+}
+
+/**
+ * @brief 重新采样整个高度图
+ * @details
+ * 详细流程：
+ * 1. 按导航网格或关卡包围盒确定网格范围
+ * 2. 重置顶点数组，标记为未就绪
+ * 3. 预算 <= 0 时立即采样完成，否则交给 Tick 分帧采样
+ * 注意事项：
+ * - 顶点数 = (GridWidth + 1) × (GridHeight + 1)，每个顶点一次射线检测
+ */
+void USG_HeightfieldSubsystem::BuildHeightfield()
+{
+    // 🔧 修改 - 配置的格子大小只作为输入，自动适配的结果写入运行时格子大小，重复构建不会累积放大
+    ActiveCellSize = CellSize;
+
+    if (bFitToLevelBounds && !FitGridToLevelBounds())
+    {
+        UE_LOG(LogSGGameplay, Warning, TEXT("⚠️ 战场高度图：未找到导航网格或关卡范围，使用手动网格"));
+    }
+
+    const int32 VertexCount = (GridWidth + 1) * (GridHeight + 1);
+    VertexHeights.SetNumUninitialized(VertexCount);
+    VertexValid.Init(false, VertexCount);
+    VertexDirty.Init(false, VertexCount);
+
+    MinHeight = TNumericLimits<float>::Max();
+    MaxHeight = TNumericLimits<float>::Lowest();
+
+    bHeightfieldReady = false;
+    bBuilding = true;
+    BuildCursor = 0;
+    BuildValidCount = 0;
+    BuildSeconds = 0.0;
+
+    UE_LOG(LogSGGameplay, Log, TEXT("🗺️ 战场高度图开始采样：原点 (%.0f, %.0f)，%d×%d 格，格子 %.0f 厘米"),
+        GridOrigin.X, GridOrigin.Y, GridWidth, GridHeight, ActiveCellSize);
+
+    if (BuildBudgetMs <= 0.0f)
+    {
+        ContinueBuild(0.0);
+    }
+}
+
+/**
+ * @brief 按导航网格或关卡包围盒确定网格范围
+ * @details 范围过大时放大格子，保证每边不超过 MaxFittedGridSize 个格子
+ */
+bool USG_HeightfieldSubsystem::FitGridToLevelBounds()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return false;
+    }
+
+    FBox Bounds(ForceInit);
+    if (const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+    {
+        Bounds = NavSystem->GetNavigableWorldBounds();
+    }
+    if (!Bounds.IsValid && World->PersistentLevel)
+    {
+        Bounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+    }
+    if (!Bounds.IsValid)
+    {
+        return false;
+    }
+
+    const FVector Size = Bounds.GetSize();
+    ActiveCellSize = FMath::Max3(CellSize, static_cast<float>(Size.X) / MaxFittedGridSize, static_cast<float>(Size.Y) / MaxFittedGridSize);
+    GridOrigin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+    GridWidth = FMath::Clamp(FMath::CeilToInt32(Size.X / ActiveCellSize), 1, MaxFittedGridSize);
+    GridHeight = FMath::Clamp(FMath::CeilToInt32(Size.Y / ActiveCellSize), 1, MaxFittedGridSize);
+
+    // 射线从范围顶部上方打到底部下方，保证边缘地面也能命中
+    SampleTopZ = Bounds.Max.Z + ActiveCellSize;
+    SampleBottomZ = Bounds.Min.Z - ActiveCellSize;
+    return true;
+}
+
+/**
+ * @brief 在时间预算内继续采样
+ * @param BudgetSeconds 本次采样的时间预算（<= 0 时采样全部剩余顶点）
+ */
+void USG_HeightfieldSubsystem::ContinueBuild(double BudgetSeconds)
+{
+    if (!bBuilding)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 VertexCount = VertexHeights.Num();
+    const int32 RowLength = GridWidth + 1;
+
+    while (BuildCursor < VertexCount)
+    {
+        if (SampleVertex(BuildCursor % RowLength, BuildCursor / RowLength))
+        {
+            BuildValidCount++;
+        }
+        BuildCursor++;
+
+        // 每 64 个顶点检查一次时间，避免频繁读时钟
+        if (BudgetSeconds > 0.0 && (BuildCursor & 63) == 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+
+    BuildSeconds += FPlatformTime::Seconds() - StartTime;
+
+    if (BuildCursor < VertexCount)
+    {
+        return;
+    }
+
+    bBuilding = false;
+    bHeightfieldReady = BuildValidCount > 0;
+
+    UE_LOG(LogSGGameplay, Log, TEXT("🗺️ 战场高度图采样完成：%d/%d 个顶点有地面，高度 [%.0f, %.0f]，采样耗时 %.1f 毫秒"),
+        BuildValidCount, VertexCount, MinHeight, MaxHeight, BuildSeconds * 1000.0);
+}
+
+/**
+ * @brief 采样一个顶点
+ */
+bool USG_HeightfieldSubsystem::SampleVertex(int32 VertexX, int32 VertexY)
+{
+    const int32 VertexIndex = GetVertexIndex(VertexX, VertexY);
+    const float WorldX = GridOrigin.X + VertexX * ActiveCellSize;
+    const float WorldY = GridOrigin.Y + VertexY * ActiveCellSize;
+
+    FHitResult HitResult;
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SGHeightfieldSample), false);
+
+    const bool bHit = GetWorld()->LineTraceSingleByChannel(
+        HitResult,
+        FVector(WorldX, WorldY, SampleTopZ),
+        FVector(WorldX, WorldY, SampleBottomZ),
+        SampleChannel,
+        QueryParams);
+
+    VertexDirty[VertexIndex] = false;
+    VertexValid[VertexIndex] = bHit;
+
+    if (bHit)
+    {
+        const float Height = HitResult.Location.Z;
+        VertexHeights[VertexIndex] = Height;
+        MinHeight = FMath::Min(MinHeight, Height);
+        MaxHeight = FMath::Max(MaxHeight, Height);
+    }
+    return bHit;
+}
+
+/**
+ * @brief 获取顶点高度（失效顶点先重新采样）
+ */
+bool USG_HeightfieldSubsystem::GetVertexHeight(int32 VertexX, int32 VertexY, float& OutHeight)
+{
+    const int32 VertexIndex = GetVertexIndex(VertexX, VertexY);
+    if (VertexDirty[VertexIndex])
+    {
+        SampleVertex(VertexX, VertexY);
+    }
+
+    if (!VertexValid[VertexIndex])
+    {
+        return false;
+    }
+
+    OutHeight = VertexHeights[VertexIndex];
+    return true;
+}
+
+// ========== 查询 ==========
+
+/**
+ * @brief 获取某水平位置的地面高度（双线性插值）
+ */
+bool USG_HeightfieldSubsystem::GetGroundHeight(const FVector& Location, float& OutHeight)
+{
+    if (!bHeightfieldReady)
+    {
+        return false;
+    }
+
+    const float GridX = (Location.X - GridOrigin.X) / ActiveCellSize;
+    const float GridY = (Location.Y - GridOrigin.Y) / ActiveCellSize;
+    if (GridX < 0.0f || GridY < 0.0f || GridX > GridWidth || GridY > GridHeight)
+    {
+        return false;
+    }
+
+    // 最后一行/列落在边界上时归入前一个格子
+    const int32 CellX = FMath::Min(FMath::FloorToInt32(GridX), GridWidth - 1);
+    const int32 CellY = FMath::Min(FMath::FloorToInt32(GridY), GridHeight - 1);
+    const float FracX = GridX - CellX;
+    const float FracY = GridY - CellY;
+
+    float H00, H10, H01, H11;
+    if (!GetVertexHeight(CellX, CellY, H00) ||
+        !GetVertexHeight(CellX + 1, CellY, H10) ||
+        !GetVertexHeight(CellX, CellY + 1, H01) ||
+        !GetVertexHeight(CellX + 1, CellY + 1, H11))
+    {
+        return false;
+    }
+
+    OutHeight = FMath::BiLerp(H00, H10, H01, H11, FracX, FracY);
+    return true;
+}
+
+/**
+ * @brief 获取某水平位置的地面法线（中心差分）
+ */
+bool USG_HeightfieldSubsystem::GetGroundNormal(const FVector& Location, FVector& OutNormal)
+{
+    float CenterHeight;
+    if (!GetGroundHeight(Location, CenterHeight))
+    {
+        return false;
+    }
+
+    // 相邻位置没有地面时用中心高度代替（边缘处退化为单侧差分）
+    auto HeightAt = [this, CenterHeight](const FVector& Sample)
+    {
+        float Height;
+        return GetGroundHeight(Sample, Height) ? Height : CenterHeight;
+    };
+
+    const float HalfStep = ActiveCellSize * 0.5f;
+    const float SlopeX = (HeightAt(Location + FVector(HalfStep, 0.0f, 0.0f)) - HeightAt(Location - FVector(HalfStep, 0.0f, 0.0f))) / ActiveCellSize;
+    const float SlopeY = (HeightAt(Location + FVector(0.0f, HalfStep, 0.0f)) - HeightAt(Location - FVector(0.0f, HalfStep, 0.0f))) / ActiveCellSize;
+
+    OutNormal = FVector(-SlopeX, -SlopeY, 1.0f).GetSafeNormal();
+    return true;
+}
+
+/**
+ * @brief 查找地面位置（替代向下的射线检测）
+ */
+bool USG_HeightfieldSubsystem::FindGroundLocation(
+    const FVector& Location,
+    float TraceUp,
+    float TraceDown,
+    FVector& OutGroundLocation,
+    ECollisionChannel TraceChannel,
+    TArrayView<const AActor* const> IgnoredActors)
+{
+    // 🔧 修改 - 高度图按 SampleChannel 采样，只在调用方使用同一通道时代替射线检测
+    float Height;
+    if (bEnableHeightfield && TraceChannel == SampleChannel && GetGroundHeight(Location, Height) &&
+        Height <= Location.Z + TraceUp && Height >= Location.Z - TraceDown)
+    {
+        CacheHitCount++;
+        OutGroundLocation = FVector(Location.X, Location.Y, Height);
+        return true;
+    }
+
+    // 高度图范围外、空洞或多层地面：退回射线检测
+    FallbackTraceCount++;
+
+    FHitResult HitResult;
+    FCollisionQueryParams QueryParams;
+    for (const AActor* IgnoredActor : IgnoredActors)
+    {
+        QueryParams.AddIgnoredActor(IgnoredActor);
+    }
+
+    if (GetWorld()->LineTraceSingleByChannel(
+        HitResult,
+        Location + FVector(0.0f, 0.0f, TraceUp),
+        Location - FVector(0.0f, 0.0f, TraceDown),
+        TraceChannel,
+        QueryParams))
+    {
+        OutGroundLocation = HitResult.Location;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 射线与高度图求交
+ * @details
+ * 详细流程：
+ * 1. 把射线裁剪到网格水平范围和地面高度范围内
+ * 2. 以半个格子为步长前进，找到第一次穿过地面的区间
+ * 3. 在该区间内二分求交点
+ */
+bool USG_HeightfieldSubsystem::RaycastHeightfield(const FVector& Start, const FVector& Direction, float MaxDistance, FVector& OutHitLocation)
+{
+    if (!bEnableHeightfield || !bHeightfieldReady)
+    {
+        return false;
+    }
+
+    const FBox GridBox(
+        FVector(GridOrigin.X, GridOrigin.Y, MinHeight - 1.0f),
+        FVector(GridOrigin.X + GridWidth * ActiveCellSize, GridOrigin.Y + GridHeight * ActiveCellSize, MaxHeight + 1.0f));
+
+    // 射线与包围盒的进入/离开距离
+    float EnterDistance = 0.0f;
+    float ExitDistance = MaxDistance;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const float Origin = Start[Axis];
+        const float Dir = Direction[Axis];
+        if (FMath::IsNearlyZero(Dir))
+        {
+            if (Origin < GridBox.Min[Axis] || Origin > GridBox.Max[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float Near = (GridBox.Min[Axis] - Origin) / Dir;
+        float Far = (GridBox.Max[Axis] - Origin) / Dir;
+        if (Near > Far)
+        {
+            Swap(Near, Far);
+        }
+        EnterDistance = FMath::Max(EnterDistance, Near);
+        ExitDistance = FMath::Min(ExitDistance, Far);
+        if (EnterDistance > ExitDistance)
+        {
+            return false;
+        }
+    }
+
+    auto IsBelowGround = [this, &Start, &Direction](float Distance, bool& bOutHasGround)
+    {
+        const FVector Point = Start + Direction * Distance;
+        float Height;
+        bOutHasGround = GetGroundHeight(Point, Height);
+        return bOutHasGround && Point.Z <= Height;
+    };
+
+    const float StepDistance = ActiveCellSize * 0.5f;
+    float PrevDistance = EnterDistance;
+    bool bHasGround = false;
+
+    if (IsBelowGround(PrevDistance, bHasGround))
+    {
+        OutHitLocation = Start + Direction * PrevDistance;
+        return true;
+    }
+
+    while (PrevDistance < ExitDistance)
+    {
+        const float NextDistance = FMath::Min(PrevDistance + StepDistance, ExitDistance);
+        if (IsBelowGround(NextDistance, bHasGround))
+        {
+            float Above = PrevDistance;
+            float Below = NextDistance;
+            for (int32 Iteration = 0; Iteration < 10; ++Iteration)
+            {
+                const float Mid = (Above + Below) * 0.5f;
+                (IsBelowGround(Mid, bHasGround) ? Below : Above) = Mid;
+            }
+
+            const FVector HitPoint = Start + Direction * Below;
+            float Height = HitPoint.Z;
+            GetGroundHeight(HitPoint, Height);
+            OutHitLocation = FVector(HitPoint.X, HitPoint.Y, Height);
+            CacheHitCount++;
+            return true;
+        }
+        PrevDistance = NextDistance;
+    }
+
+    return false;
+}
+
+// ========== 失效 ==========
+
+/**
+ * @brief 使某区域失效
+ */
+void USG_HeightfieldSubsystem::InvalidateRegion(const FBox& Bounds)
+{
+    // 采样进行中也要标记：已采样的顶点会在查询时重新采样
+    if (VertexDirty.Num() == 0 || !Bounds.IsValid)
+    {
+        return;
+    }
+
+    const int32 MinX = FMath::Clamp(FMath::FloorToInt32((Bounds.Min.X - GridOrigin.X) / ActiveCellSize), 0, GridWidth);
+    const int32 MaxX = FMath::Clamp(FMath::CeilToInt32((Bounds.Max.X - GridOrigin.X) / ActiveCellSize), 0, GridWidth);
+    const int32 MinY = FMath::Clamp(FMath::FloorToInt32((Bounds.Min.Y - GridOrigin.Y) / ActiveCellSize), 0, GridHeight);
+    const int32 MaxY = FMath::Clamp(FMath::CeilToInt32((Bounds.Max.Y - GridOrigin.Y) / ActiveCellSize), 0, GridHeight);
+
+    for (int32 VertexY = MinY; VertexY <= MaxY; ++VertexY)
+    {
+        for (int32 VertexX = MinX; VertexX <= MaxX; ++VertexX)
+        {
+            VertexDirty[GetVertexIndex(VertexX, VertexY)] = true;
+        }
+    }
+
+    UE_LOG(LogSGGameplay, Verbose, TEXT("🗺️ 高度图区域失效：(%d,%d)-(%d,%d)"), MinX, MinY, MaxX, MaxY);
+}
+
+/**
+ * @brief Actor 是否会影响高度图
+ * @details 只有根组件为 WorldStatic 类型、并阻挡采样通道的非 Pawn Actor 才算地面阻挡物
+ */
+bool USG_HeightfieldSubsystem::AffectsHeightfield(const AActor* Actor) const
+{
+    if (!Actor || Actor->IsA<APawn>())
+    {
+        return false;
+    }
+
+    const UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+    return RootPrimitive &&
+        RootPrimitive->IsCollisionEnabled() &&
+        RootPrimitive->GetCollisionObjectType() == ECC_WorldStatic &&
+        RootPrimitive->GetCollisionResponseToChannel(SampleChannel) == ECR_Block;
+}
+
+/**
+ * @brief 生成 Actor 回调
+ */
+void USG_HeightfieldSubsystem::HandleActorSpawned(AActor* Actor)
+{
+    if (AffectsHeightfield(Actor))
+    {
+        InvalidateRegion(Actor->GetComponentsBoundingBox());
+    }
+}
+
+/**
+ * @brief 销毁 Actor 回调
+ */
+void USG_HeightfieldSubsystem::HandleActorDestroyed(AActor* Actor)
+{
+    if (AffectsHeightfield(Actor))
+    {
+        InvalidateRegion(Actor->GetComponentsBoundingBox());
+    }
+}
@@ -4,6 +4,8 @@
 #include "Player/SG_PlayerController.h"
 #include "EnhancedInputSubsystems.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
+#include "Debug/SG_ReplaySubsystem.h" // ✨ 新增 - 对局录像
 #include "Engine/LocalPlayer.h"
 #include "CardsAndUnits/SG_CardDeckComponent.h"
 #include "UIHud/SG_CardHandWidget.h"
@@ -13,6 +15,9 @@
 #include "Data/SG_CharacterCardData.h"
 #include "Data/SG_StrategyCardData.h"
 #include "Units/SG_UnitsBase.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Units/SG_SpawnSchedulerSubsystem.h"
+#include "Game/SG_HeightfieldSubsystem.h"
 #include "Player/SG_Player.h"
 #include "Buildings/SG_MainCityBase.h"
 #include "Kismet/GameplayStatics.h"
@@ -42,6 +47,7 @@ void ASG_PlayerController::BeginPlay()
 	
 	if (CardHandWidgetClass && CardDeckComponent)
 	{
+		SG_LLM_SCOPE(CardsUI); // ✨ 新增 - LLM 标签
 		CardHandWidget = CreateWidget<USG_CardHandWidget>(this, CardHandWidgetClass);
 		if (CardHandWidget)
 		{
@@ -275,7 +281,8 @@ void ASG_PlayerController::ConfirmPlacement()
 	// 使用卡牌
 	if (CardDeckComponent)
 	{
-		bool bSuccess = CardDeckComponent->UseCard(CurrentSelectedCardInstanceId);
+		// 🔧 修改 - 使用卡牌并写入对局录像
+		bool bSuccess = UseCardAndRecord(CurrentSelectedCardInstanceId, UnitSpawnLocation);
 		if (bSuccess)
 		{
 			UE_LOG(LogTemp, Log, TEXT("✓ 卡牌使用成功，进入冷却"));
@@ -359,7 +366,9 @@ bool ASG_PlayerController::StartStrategyTargetSelection(USG_StrategyCardData* St
 	}
 
 	// 检查效果类是否设置
-	if (!StrategyCardData->EffectActorClass)
+	// 🔧 修改 - 效果类为软引用，卡牌在手牌中时已预加载，这里通常直接返回已加载的类
+	UClass* EffectActorClass = StrategyCardData->EffectActorClass.LoadSynchronous();
+	if (!EffectActorClass)
 	{
 		UE_LOG(LogSGGameplay, Error, TEXT("  ❌ EffectActorClass 未设置！"));
 		return false;
@@ -378,8 +387,9 @@ bool ASG_PlayerController::StartStrategyTargetSelection(USG_StrategyCardData* St
 	SpawnParams.Owner = this;
 	SpawnParams.Instigator = GetPawn();
 
+	SG_LLM_SCOPE(Strategies); // ✨ 新增 - LLM 标签
 	ActiveStrategyEffect = GetWorld()->SpawnActor<ASG_StrategyEffectBase>(
-		StrategyCardData->EffectActorClass,
+		EffectActorClass,
 		InitialLocation,
 		FRotator::ZeroRotator,
 		SpawnParams
@@ -428,7 +438,7 @@ bool ASG_PlayerController::StartStrategyTargetSelection(USG_StrategyCardData* St
 	CurrentPlacementMode = ESGPlacementMode::StrategyTarget;
 
 	UE_LOG(LogSGGameplay, Log, TEXT("  ✓ 计谋目标选择已开始"));
-	UE_LOG(LogSGGameplay, Log, TEXT("    效果类：%s"), *StrategyCardData->EffectActorClass->GetName());
+	UE_LOG(LogSGGameplay, Log, TEXT("    效果类：%s"), *EffectActorClass->GetName());
 	UE_LOG(LogSGGameplay, Log, TEXT("========================================"));
 
 	return true;
@@ -453,6 +463,7 @@ bool ASG_PlayerController::ConfirmStrategyTarget()
 
 	// 🔧 修改 - 先保存需要的数据
 	FGuid CardIdToUse = StrategyCardInstanceId;
+	const FVector TargetLocationToRecord = ActiveStrategyEffect->GetEffectTargetLocation();
 	
 	// 调用效果的确认方法（效果类自己负责验证和执行）
 	bool bSuccess = ActiveStrategyEffect->ConfirmTarget();
@@ -469,7 +480,7 @@ bool ASG_PlayerController::ConfirmStrategyTarget()
 		// 使用卡牌（这会触发 OnSelectionChanged，但此时 CurrentPlacementMode 已经是 None）
 		if (CardDeckComponent && CardIdToUse.IsValid())
 		{
-			bool bCardUsed = CardDeckComponent->UseCard(CardIdToUse);
+			bool bCardUsed = UseCardAndRecord(CardIdToUse, TargetLocationToRecord);
 			if (bCardUsed)
 			{
 				UE_LOG(LogSGGameplay, Log, TEXT("  ✓ 卡牌使用成功，进入冷却"));
@@ -529,7 +540,7 @@ void ASG_PlayerController::UseStrategyCardDirectly(USG_StrategyCardData* Strateg
 		*StrategyCardData->CardName.ToString());
     
 	// 检查效果类是否设置
-	if (!StrategyCardData->EffectActorClass)
+	if (StrategyCardData->EffectActorClass.IsNull())
 	{
 		// 如果没有效果类，尝试使用纯 GE 模式
 		if (StrategyCardData->GameplayEffectClass)
@@ -610,8 +621,9 @@ void ASG_PlayerController::UseStrategyCardDirectly(USG_StrategyCardData* Strateg
 		SpawnParams.Owner = this;
 		SpawnParams.Instigator = GetPawn();
 		
+		SG_LLM_SCOPE(Strategies); // ✨ 新增 - LLM 标签
 		ASG_StrategyEffectBase* EffectActor = GetWorld()->SpawnActor<ASG_StrategyEffectBase>(
-			StrategyCardData->EffectActorClass,
+			StrategyCardData->EffectActorClass.LoadSynchronous(),
 			EffectLocation,
 			FRotator::ZeroRotator,
 			SpawnParams
@@ -633,7 +645,8 @@ void ASG_PlayerController::UseStrategyCardDirectly(USG_StrategyCardData* Strateg
 	// 使用卡牌
 	if (CardDeckComponent)
 	{
-		bool bSuccess = CardDeckComponent->UseCard(CardInstanceId);
+		// 🔧 修改 - 使用卡牌并写入对局录像（全局效果没有目标位置）
+		bool bSuccess = UseCardAndRecord(CardInstanceId, FVector::ZeroVector);
 		if (bSuccess)
 		{
 			UE_LOG(LogSGGameplay, Log, TEXT("  ✓ 卡牌使用成功，进入冷却"));
@@ -681,6 +694,60 @@ bool ASG_PlayerController::DoesCardRequirePreview(USG_CardDataBase* CardData) co
 	return true;
 }
 
+// ✨ 新增 - 在指定位置直接使用手牌（对局回放）
+bool ASG_PlayerController::PlayCardAt(const FGuid& CardInstanceId, const FVector& Location)
+{
+	if (!CardDeckComponent)
+	{
+		return false;
+	}
+
+	auto IsInHand = [this, &CardInstanceId]()
+	{
+		return CardDeckComponent->GetHand().ContainsByPredicate([&CardInstanceId](const FSGCardInstance& Card) { return Card.InstanceId == CardInstanceId; });
+	};
+
+	const FSGCardInstance* Card = CardDeckComponent->GetHand().FindByPredicate([&CardInstanceId](const FSGCardInstance& InCard) { return InCard.InstanceId == CardInstanceId; });
+	USG_CardDataBase* CardData = Card ? Card->CardData.Get() : nullptr;
+	if (!CardData)
+	{
+		UE_LOG(LogSGGameplay, Warning, TEXT("PlayCardAt 失败：手牌中没有卡牌 %s"), *CardInstanceId.ToString());
+		return false;
+	}
+
+	// 取消之前的任何放置模式
+	if (CurrentPlacementMode != ESGPlacementMode::None)
+	{
+		CancelPlacement();
+	}
+
+	if (USG_StrategyCardData* StrategyCard = Cast<USG_StrategyCardData>(CardData))
+	{
+		if (!DoesCardRequirePreview(CardData))
+		{
+			UseStrategyCardDirectly(StrategyCard, CardInstanceId);
+			return !IsInHand();
+		}
+
+		if (!StartStrategyTargetSelection(StrategyCard, CardInstanceId))
+		{
+			return false;
+		}
+
+		ActiveStrategyEffect->UpdateTargetLocation(Location);
+		if (!ConfirmStrategyTarget())
+		{
+			CancelStrategyTargetSelection();
+			return false;
+		}
+		return true;
+	}
+
+	// 角色卡：与 ConfirmPlacement 相同，先生成单位再使用卡牌
+	SpawnUnitFromCard(CardData, Location, CalculateUnitSpawnRotation(Location));
+	return UseCardAndRecord(CardInstanceId, Location);
+}
+
 bool ASG_PlayerController::GetMouseGroundLocation(FVector& OutLocation) const
 {
 	FVector WorldLocation, WorldDirection;
@@ -689,6 +756,21 @@ bool ASG_PlayerController::GetMouseGroundLocation(FVector& OutLocation) const
 		return false;
 	}
 
+	// 🔧 修改 - 与放置预览使用相同的开关：仅检测静态地面且开启高度图时才与高度图求交
+	const ASG_PlacementPreview* PreviewSettings = CurrentPreviewActor
+		? CurrentPreviewActor.Get()
+		: (PlacementPreviewClass ? PlacementPreviewClass->GetDefaultObject<ASG_PlacementPreview>() : nullptr);
+	if (PreviewSettings && PreviewSettings->UsesHeightfieldCache())
+	{
+		if (USG_HeightfieldSubsystem* Heightfield = GetWorld()->GetSubsystem<USG_HeightfieldSubsystem>())
+		{
+			if (Heightfield->RaycastHeightfield(WorldLocation, WorldDirection, 50000.0f, OutLocation))
+			{
+				return true;
+			}
+		}
+	}
+
 	FHitResult HitResult;
 	FVector TraceEnd = WorldLocation + WorldDirection * 50000.0f;
 	
@@ -777,6 +859,31 @@ void ASG_PlayerController::OnCardSelectionChanged(const FGuid& SelectedId)
 
 
 
+// ✨ 新增 - 使用卡牌并写入对局录像
+bool ASG_PlayerController::UseCardAndRecord(const FGuid& CardInstanceId, const FVector& Location)
+{
+	if (!CardDeckComponent)
+	{
+		return false;
+	}
+
+	// 使用前记下手牌位置和卡牌 ID（使用后卡牌已离开手牌）
+	const TArray<FSGCardInstance>& Hand = CardDeckComponent->GetHand();
+	const int32 HandIndex = Hand.IndexOfByPredicate([&CardInstanceId](const FSGCardInstance& Card) { return Card.InstanceId == CardInstanceId; });
+	const FPrimaryAssetId CardId = Hand.IsValidIndex(HandIndex) ? Hand[HandIndex].CardId : FPrimaryAssetId();
+
+	if (!CardDeckComponent->UseCard(CardInstanceId))
+	{
+		return false;
+	}
+
+	if (USG_ReplaySubsystem* Replay = GetWorld()->GetSubsystem<USG_ReplaySubsystem>())
+	{
+		Replay->RecordCardUse(HandIndex, CardId, Location);
+	}
+	return true;
+}
+
 void ASG_PlayerController::SpawnUnitFromCard(USG_CardDataBase* CardData, const FVector& UnitSpawnLocation, const FRotator& UnitSpawnRotation)
 {
 	
@@ -786,11 +893,13 @@ void ASG_PlayerController::SpawnUnitFromCard(USG_CardDataBase* CardData, const F
 
     if (USG_CharacterCardData* CharacterCard = Cast<USG_CharacterCardData>(CardData))
     {
-        if (!CharacterCard->CharacterClass) return;
+        // 🔧 修改 - 角色类为软引用，卡牌在手牌中时已预加载，这里通常直接返回已加载的类
+        UClass* CharacterClass = CharacterCard->CharacterClass.LoadSynchronous();
+        if (!CharacterClass) return;
 
         // 🔧 关键修改 1：获取 CDO 以读取胶囊体尺寸
         float CapsuleHalfHeight = 88.0f; // 默认值（UE小白人标准）
-        ACharacter* CharCDO = Cast<ACharacter>(CharacterCard->CharacterClass->GetDefaultObject());
+        ACharacter* CharCDO = Cast<ACharacter>(CharacterClass->GetDefaultObject());
         if (CharCDO && CharCDO->GetCapsuleComponent())
         {
             CapsuleHalfHeight = CharCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
@@ -799,6 +908,13 @@ void ASG_PlayerController::SpawnUnitFromCard(USG_CardDataBase* CardData, const F
         // 稍微抬高一点点，防止浮点误差导致刚生成就碰撞
         float SpawnZOffset = CapsuleHalfHeight + 2.0f; 
 
+        // ✨ 新增 - 单位对象池
+        const TSubclassOf<ASG_UnitsBase> UnitClass(CharacterClass);
+        USG_UnitPoolSubsystem* UnitPool = GetWorld()->GetSubsystem<USG_UnitPoolSubsystem>();
+
+        // 🔧 修改 - 先计算所有单位的水平位置，Z 预设为未检测到地面时使用的基准高度
+        TArray<FVector> UnitLocations;
+
         if (CharacterCard->bIsTroopCard)
         {
             int32 Rows = CharacterCard->TroopFormation.Y;
@@ -811,10 +927,7 @@ void ASG_PlayerController::SpawnUnitFromCard(USG_CardDataBase* CardData, const F
                 0.0f
             );
 
-            // 准备射线检测参数
-            FCollisionQueryParams QueryParams;
-            QueryParams.AddIgnoredActor(GetPawn()); // 忽略玩家自己
-
+            UnitLocations.Reserve(Rows * Cols);
             for (int32 Row = 0; Row < Rows; ++Row)
             {
                 for (int32 Col = 0; Col < Cols; ++Col)
@@ -823,104 +936,104 @@ void ASG_PlayerController::SpawnUnitFromCard(USG_CardDataBase* CardData, const F
                     
                     // 计算水平位置 (X, Y)
                     FVector TargetLocationXY = UnitSpawnLocation + StartOffset + UnitOffset;
-                    FVector FinalUnitLocation = TargetLocationXY;
-
-                    // 🔧 关键修改 2：为每个单位单独做地面吸附检测
-                    FHitResult HitResult;
-                    FVector TraceStart = TargetLocationXY + FVector(0, 0, 500.0f); // 从上方 500cm 处开始
-                    FVector TraceEnd = TargetLocationXY - FVector(0, 0, 1000.0f);  // 向下探测
-
-                    if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
-                    {
-                        // 地面高度 + 胶囊体半高 + 缓冲
-                        FinalUnitLocation.Z = HitResult.Location.Z + SpawnZOffset;
-                    }
-                    else
-                    {
-                        // 如果没检测到地面（比如悬崖外），使用基准高度
-                        FinalUnitLocation.Z = UnitSpawnLocation.Z + SpawnZOffset;
-                    }
-
-                    FActorSpawnParameters SpawnParams;
-                    SpawnParams.Owner = this;
-                    SpawnParams.Instigator = GetPawn();
-                    SpawnParams.bDeferConstruction = true;
-                    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-                    AActor* SpawnedUnit = GetWorld()->SpawnActor<AActor>(
-                        CharacterCard->CharacterClass,
-                        FinalUnitLocation,
-                        UnitSpawnRotation,
-                        SpawnParams
-                    );
-
-                    if (SpawnedUnit)
-                    {
-                        if (ASG_UnitsBase* Unit = Cast<ASG_UnitsBase>(SpawnedUnit))
-                        {
-                            Unit->SourceCardData = CharacterCard;
-                            Unit->FinishSpawning(FTransform(UnitSpawnRotation, FinalUnitLocation));
-                        }
-                        else
-                        {
-                            SpawnedUnit->FinishSpawning(FTransform(UnitSpawnRotation, FinalUnitLocation));
-                        }
-                    }
+                    UnitLocations.Add(FVector(TargetLocationXY.X, TargetLocationXY.Y, UnitSpawnLocation.Z + SpawnZOffset));
                 }
             }
-            UE_LOG(LogTemp, Log, TEXT("✓ 兵团生成完成"));
         }
         else
         {
             // 生成英雄（单个单位）
-            // 🔧 关键修改 3：英雄也需要地面吸附
-            FVector FinalUnitLocation = UnitSpawnLocation;
-            
-            FHitResult HitResult;
-            FCollisionQueryParams QueryParams;
-            QueryParams.AddIgnoredActor(GetPawn());
-            
-            FVector TraceStart = UnitSpawnLocation + FVector(0, 0, 500.0f);
-            FVector TraceEnd = UnitSpawnLocation - FVector(0, 0, 1000.0f);
-
-            if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
+            UnitLocations.Add(FVector(UnitSpawnLocation.X, UnitSpawnLocation.Y, UnitSpawnLocation.Z + SpawnZOffset));
+        }
+
+        // ✨ 新增 - 单位交给分帧生成调度器，地面吸附在真正生成时进行
+        USG_SpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<USG_SpawnSchedulerSubsystem>();
+        if (UnitClass && Scheduler)
+        {
+            FSGFormationSpawnRequest Request;
+            Request.CardData = CharacterCard;
+            Request.SpawnOwner = this;
+            Request.SpawnInstigator = GetPawn();
+            Request.bSnapToGround = true;
+            Request.GroundTraceUp = 500.0f;
+            Request.GroundTraceDown = 1000.0f;
+            Request.GroundZOffset = SpawnZOffset;
+
+            Request.Slots.Reserve(UnitLocations.Num());
+            for (const FVector& Location : UnitLocations)
             {
-                FinalUnitLocation.Z = HitResult.Location.Z + SpawnZOffset;
+                FSGFormationSpawnSlot& Slot = Request.Slots.AddDefaulted_GetRef();
+                Slot.UnitClass = UnitClass;
+                Slot.Transform = FTransform(UnitSpawnRotation, Location);
             }
-            else
+
+            // 单位全部生成后广播 OnCardUnitsSpawned
+            Scheduler->EnqueueFormation(Request, FSGSpawnRequestCallback::CreateUObject(
+                this, &ASG_PlayerController::HandleCardUnitsSpawned, TWeakObjectPtr<USG_CharacterCardData>(CharacterCard)));
+            UE_LOG(LogTemp, Log, TEXT("✓ 已提交生成请求：%d 个单位"), Request.Slots.Num());
+            return;
+        }
+
+        // 调度器不可用或不是单位类：立即生成
+        USG_HeightfieldSubsystem* Heightfield = GetWorld()->GetSubsystem<USG_HeightfieldSubsystem>();
+        TArray<ASG_UnitsBase*> SpawnedUnits;
+
+        for (FVector FinalUnitLocation : UnitLocations)
+        {
+            // 🔧 修改 - 地面高度查询高度图缓存（从上方 500cm 到下方 1000cm）
+            FVector GroundLocation;
+            if (Heightfield && Heightfield->FindGroundLocation(
+                FVector(FinalUnitLocation.X, FinalUnitLocation.Y, UnitSpawnLocation.Z), 500.0f, 1000.0f, GroundLocation, ECC_WorldStatic, { GetPawn() }))
             {
-                FinalUnitLocation.Z = UnitSpawnLocation.Z + SpawnZOffset;
+                // 地面高度 + 胶囊体半高 + 缓冲
+                FinalUnitLocation.Z = GroundLocation.Z + SpawnZOffset;
             }
 
-            FActorSpawnParameters SpawnParams;
-            SpawnParams.Owner = this;
-            SpawnParams.Instigator = GetPawn();
-            SpawnParams.bDeferConstruction = true;
-            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-            AActor* SpawnedUnit = GetWorld()->SpawnActor<AActor>(
-                CharacterCard->CharacterClass,
-                FinalUnitLocation,
-                UnitSpawnRotation,
-                SpawnParams
-            );
-
-            if (SpawnedUnit)
+            if (UnitClass && UnitPool)
             {
-                if (ASG_UnitsBase* Unit = Cast<ASG_UnitsBase>(SpawnedUnit))
+                if (ASG_UnitsBase* Unit = UnitPool->AcquireUnit(UnitClass, FTransform(UnitSpawnRotation, FinalUnitLocation), CharacterCard, FGameplayTag(), this, GetPawn()))
                 {
-                    Unit->SourceCardData = CharacterCard;
-                    Unit->FinishSpawning(FTransform(UnitSpawnRotation, FinalUnitLocation));
+                    SpawnedUnits.Add(Unit);
                 }
-                else
+            }
+            else
+            {
+                FActorSpawnParameters SpawnParams;
+                SpawnParams.Owner = this;
+                SpawnParams.Instigator = GetPawn();
+                SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+                SG_LLM_SCOPE(Units); // ✨ 新增 - LLM 标签
+                AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(
+                    CharacterClass,
+                    FinalUnitLocation,
+                    UnitSpawnRotation,
+                    SpawnParams
+                );
+                if (ASG_UnitsBase* Unit = Cast<ASG_UnitsBase>(SpawnedActor))
                 {
-                    SpawnedUnit->FinishSpawning(FTransform(UnitSpawnRotation, FinalUnitLocation));
+                    SpawnedUnits.Add(Unit);
                 }
             }
         }
+
+        HandleCardUnitsSpawned(SpawnedUnits, CharacterCard);
     }
 }
 
+/**
+ * @brief 角色卡单位生成完成
+ * @param SpawnedUnits 本次出牌生成的单位
+ * @param CardData 角色卡数据
+ */
+void ASG_PlayerController::HandleCardUnitsSpawned(const TArray<ASG_UnitsBase*>& SpawnedUnits, TWeakObjectPtr<USG_CharacterCardData> CardData)
+{
+	UE_LOG(LogTemp, Log, TEXT("✓ 卡牌单位生成完成：%s，%d 个单位"),
+		CardData.IsValid() ? *CardData->CardName.ToString() : TEXT("（无效卡牌）"), SpawnedUnits.Num());
+
+	OnCardUnitsSpawned.Broadcast(CardData.Get(), SpawnedUnits);
+}
+
 ASG_MainCityBase* ASG_PlayerController::FindEnemyMainCity()
 {
 	if (CachedEnemyMainCity && IsValid(CachedEnemyMainCity))
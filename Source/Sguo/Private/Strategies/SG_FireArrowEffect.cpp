@@ -257,7 +257,8 @@ void ASG_FireArrowEffect::ExecuteEffect_Implementation()
 	float DmgMult = FireArrowCardData ? FireArrowCardData->ArrowDamageMultiplier : 1.0f;
 	float Arc = FireArrowCardData ? FireArrowCardData->ArrowArcHeight : 0.5f;
 	float Speed = FireArrowCardData ? FireArrowCardData->ArrowSpeed : 1500.0f;
-	TSubclassOf<AActor> ProjClass = FireArrowCardData ? FireArrowCardData->FireArrowProjectileClass : nullptr;
+	// 🔧 修改 - 投射物类为软引用（Gameplay 资产包，卡牌在手牌中时已预加载）
+	TSubclassOf<AActor> ProjClass = FireArrowCardData ? FireArrowCardData->FireArrowProjectileClass.LoadSynchronous() : nullptr;
 
 	// 遍历所有弓手，启动他们的计谋模式
 	for (const TWeakObjectPtr<ASG_StationaryUnit>& ArcherPtr : ParticipatingArchers)
@@ -409,10 +410,12 @@ void ASG_FireArrowEffect::CreatePreviewDecal()
 	float Radius = FireArrowCardData ? FireArrowCardData->AreaRadius : 800.0f;
 	PreviewDecal->DecalSize = FVector(1000.0f, Radius, Radius);
 
-	if (FireArrowCardData && FireArrowCardData->PreviewAreaMaterial)
+	// 🔧 修改 - 预览材质为软引用（Gameplay 资产包）
+	UMaterialInterface* PreviewAreaMaterial = FireArrowCardData ? FireArrowCardData->PreviewAreaMaterial.LoadSynchronous() : nullptr;
+	if (PreviewAreaMaterial)
 	{
 		UMaterialInstanceDynamic* DynamicMaterial = UMaterialInstanceDynamic::Create(
-			FireArrowCardData->PreviewAreaMaterial, this);
+			PreviewAreaMaterial, this);
 
 		if (DynamicMaterial)
 		{
@@ -11,6 +11,18 @@
 #include "UIHud/SG_CardViewModel.h"
 // ✨ NEW - 引入日志系统
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+namespace SGCardHandViewModel
+{
+	// 对象池最多保留的卡牌 ViewModel 数量
+	constexpr int32 MaxPooledCardViewModels = 16;
+
+	// 最多等待归还的卡牌 ViewModel 数量
+	constexpr int32 MaxRetiredCardViewModels = 16;
+}
 
 // 初始化 ViewModel
 void USGCardHandViewModel::Initialize(USG_CardDeckComponent* InDeckComponent)
@@ -118,6 +130,7 @@ void USGCardHandViewModel::HandleHandChanged(const TArray<FSGCardInstance>& NewH
 		else
 		{
 			// 新建视图模型
+			SG_LLM_SCOPE(CardsUI);
 			ViewModel = NewObject<USGCardViewModel>(this);
 			if (!ViewModel)
 			{
@@ -153,32 +166,17 @@ void USGCardHandViewModel::HandleHandChanged(const TArray<FSGCardInstance>& NewH
 	 // 输出日志
     UE_LOG(LogSGUI, Log, TEXT("HandleHandChanged - 新手牌数：%d"), NewHand.Num());
     
-    // 🔧 MODIFIED - 找出被移除的卡牌
-    TSet<FGuid> NewHandIds;
-    for (const FSGCardInstance& Instance : NewHand)
-    {
-        NewHandIds.Add(Instance.InstanceId);
-    }
+    // ✨ 新增 - 整次手牌更新作为一个批量事务，下一次 Tick 统一通知
+    FSGCardHandUpdateScope UpdateScope(this);
     
-    // 遍历旧的 ViewModel，通知不在新手牌中的卡
+    // 🔧 修改 - 按 InstanceId 对比新旧手牌
+    TMap<FGuid, USGCardViewModel*> OldViewModels;
+    OldViewModels.Reserve(CardViewModels.Num());
     for (USGCardViewModel* OldVM : CardViewModels)
     {
-        if (OldVM && !NewHandIds.Contains(OldVM->InstanceId))
+        if (OldVM)
         {
-            // 通知卡牌被使用
-            OldVM->NotifyCardUsed();
-            // 输出日志
-            UE_LOG(LogSGUI, Log, TEXT("  📢 通知卡牌被使用：%s"), *OldVM->CardName.ToString());
-        }
-    }
-    
-    // 构建新旧映射，用于复用已有的 ViewModel
-    TMap<FGuid, int32> OldIndexMap;
-    for (int32 i = 0; i < CardViewModels.Num(); ++i)
-    {
-        if (CardViewModels[i])
-        {
-            OldIndexMap.Add(CardViewModels[i]->InstanceId, i);
+            OldViewModels.Add(OldVM->InstanceId, OldVM);
         }
     }
     
@@ -196,30 +194,24 @@ void USGCardHandViewModel::HandleHandChanged(const TArray<FSGCardInstance>& NewH
             continue;
         }
         
-        // 尝试复用已有的 ViewModel
+        // 仍在手牌中的卡牌直接复用，不产生任何通知
         USGCardViewModel* ViewModel = nullptr;
-        if (int32* OldIndex = OldIndexMap.Find(Instance.InstanceId))
+        if (OldViewModels.RemoveAndCopyValue(Instance.InstanceId, ViewModel))
         {
-            // 复用已有的 ViewModel
-            ViewModel = CardViewModels[*OldIndex].Get();
             UE_LOG(LogSGUI, Verbose, TEXT("  ♻️ 复用 ViewModel - 名称: %s"), 
                 *ViewModel->CardName.ToString());
         }
         else
         {
-            // 新建视图模型
-            ViewModel = NewObject<USGCardViewModel>(this);
-            if (!ViewModel)
-            {
-                UE_LOG(LogSGUI, Error, TEXT("❌ 创建 ViewModel 失败"));
-                continue;
-            }
+            // 🔧 修改 - 从对象池取出视图模型
+            ViewModel = AcquireCardViewModel();
+            TrackCardViewModel(ViewModel);
             
             // 初始化视图模型
             ViewModel->InitializeFromInstance(Instance, false, 
                 ObservedDeck ? ObservedDeck->CanAct() : true);
             
-            UE_LOG(LogSGUI, Verbose, TEXT("  ✓ 创建 ViewModel - 名称: %s"), 
+            UE_LOG(LogSGUI, Verbose, TEXT("  ✓ 取出 ViewModel - 名称: %s"), 
                 *ViewModel->CardName.ToString());
         }
         
@@ -227,8 +219,27 @@ void USGCardHandViewModel::HandleHandChanged(const TArray<FSGCardInstance>& NewH
         NewViewModels.Add(ViewModel);
     }
     
-    // 使用 MVVM 宏更新属性
-    UE_MVVM_SET_PROPERTY_VALUE(CardViewModels, NewViewModels);
+    // 剩下的是离开手牌的卡牌
+    for (const TPair<FGuid, USGCardViewModel*>& Pair : OldViewModels)
+    {
+        USGCardViewModel* OldVM = Pair.Value;
+        
+        // 通知卡牌被使用（事件立即广播，Widget 据此播放移除动画）
+        OldVM->NotifyCardUsed();
+        UE_LOG(LogSGUI, Log, TEXT("  📢 通知卡牌被使用：%s"), *OldVM->CardName.ToString());
+        
+        // 等待 Widget 移除动画结束后归还
+        RetiredCardViewModels.Add(OldVM);
+    }
+    
+    // 未归还的 ViewModel 过多时丢弃最早的（交给 GC）
+    if (RetiredCardViewModels.Num() > SGCardHandViewModel::MaxRetiredCardViewModels)
+    {
+        RetiredCardViewModels.RemoveAt(0, RetiredCardViewModels.Num() - SGCardHandViewModel::MaxRetiredCardViewModels);
+    }
+    
+    // 🔧 修改 - 批量更新期间只记录字段变化
+    SetFieldValue(CardViewModels, NewViewModels, FFieldNotificationClassDescriptor::CardViewModels);
     
     // 输出日志
     UE_LOG(LogSGUI, Log, TEXT("✓ CardViewModels 已更新，数量：%d"), CardViewModels.Num());
@@ -245,6 +256,9 @@ void USGCardHandViewModel::HandleHandChanged(const TArray<FSGCardInstance>& NewH
 // 处理选中变化
 void USGCardHandViewModel::HandleSelectionChanged(const FGuid& SelectedId)
 {
+	// ✨ 新增 - 只有选中状态真正变化的卡牌会被通知
+	FSGCardHandUpdateScope UpdateScope(this);
+	
 	// 遍历所有视图模型
 	for (USGCardViewModel* ViewModel : CardViewModels)
 	{
@@ -254,6 +268,7 @@ void USGCardHandViewModel::HandleSelectionChanged(const FGuid& SelectedId)
 			continue;
 		}
 		// 更新选中状态
+		TrackCardViewModel(ViewModel);
 		ViewModel->SetSelected(ViewModel->InstanceId == SelectedId);
 	}
 }
@@ -261,11 +276,24 @@ void USGCardHandViewModel::HandleSelectionChanged(const FGuid& SelectedId)
 // 处理行动状态
 void USGCardHandViewModel::HandleActionStateChanged(bool bCanActValue, float CooldownRemaining)
 {
+	// ✨ 新增 - 行动状态和每张卡牌的可用性合并为一次通知
+	FSGCardHandUpdateScope UpdateScope(this);
+	
 	// 更新行动可用性
-	// 更新并广播行动可用性
-	UE_MVVM_SET_PROPERTY_VALUE(bCanAct, bCanActValue);
+	SetFieldValue(bCanAct, bCanActValue, FFieldNotificationClassDescriptor::bCanAct);
+	// ✨ 新增 - 更新冷却时间戳（UI 本地插值）
+	if (ObservedDeck)
+	{
+		SetFieldValue(CooldownStartTime, ObservedDeck->GetCooldownStartTime(), FFieldNotificationClassDescriptor::CooldownStartTime);
+		SetFieldValue(CooldownEndTime, ObservedDeck->GetCooldownEndTime(), FFieldNotificationClassDescriptor::CooldownEndTime);
+	}
 	// 更新冷却时间
-	UE_MVVM_SET_PROPERTY_VALUE(Cooldown, CooldownRemaining);
+	SetFieldValue(Cooldown, CooldownRemaining, FFieldNotificationClassDescriptor::Cooldown);
+	// 🔧 修改 - 冷却开始时按新的结束时间重新对齐整秒刷新（卡组组件不再每帧广播）
+	if (!bCanActValue)
+	{
+		RefreshCooldown();
+	}
 	// 同步每张视图模型的可用性
 	for (USGCardViewModel* ViewModel : CardViewModels)
 	{
@@ -275,10 +303,174 @@ void USGCardHandViewModel::HandleActionStateChanged(bool bCanActValue, float Coo
 			continue;
 		}
 		// 设置可用标记
+		TrackCardViewModel(ViewModel);
 		ViewModel->SetPlayable(bCanActValue);
 	}
 }
 
+// ✨ 新增 - 开始批量更新
+void USGCardHandViewModel::BeginUpdate()
+{
+	++UpdateDepth;
+}
+
+// ✨ 新增 - 结束批量更新，最外层结束时安排下一次 Tick 统一广播
+void USGCardHandViewModel::EndUpdate()
+{
+	check(UpdateDepth > 0);
+	if (--UpdateDepth > 0 || bFlushScheduled)
+	{
+		return;
+	}
+	
+	if (PendingFieldIds.IsEmpty() && PendingCardViewModels.IsEmpty())
+	{
+		return;
+	}
+	
+	UWorld* World = ObservedDeck ? ObservedDeck->GetWorld() : nullptr;
+	if (!World)
+	{
+		// 没有世界（如编辑器预览）时立即广播
+		FlushPendingNotifications();
+		return;
+	}
+	
+	bFlushScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(
+		FTimerDelegate::CreateUObject(this, &USGCardHandViewModel::FlushPendingNotifications));
+}
+
+// ✨ 新增 - 广播所有待发送的字段通知
+void USGCardHandViewModel::FlushPendingNotifications()
+{
+	bFlushScheduled = false;
+	
+	// 先交换出来，广播回调中触发的新更新进入下一批
+	TArray<TObjectPtr<USGCardViewModel>> CardsToFlush = MoveTemp(PendingCardViewModels);
+	PendingCardViewModels.Reset();
+	TArray<UE::FieldNotification::FFieldId, TInlineAllocator<8>> FieldIds = MoveTemp(PendingFieldIds);
+	PendingFieldIds.Reset();
+	
+	int32 ChangedCardCount = 0;
+	for (USGCardViewModel* ViewModel : CardsToFlush)
+	{
+		if (ViewModel && ViewModel->FlushFieldNotifications())
+		{
+			++ChangedCardCount;
+		}
+	}
+	
+	for (const UE::FieldNotification::FFieldId& FieldId : FieldIds)
+	{
+		BroadcastFieldValueChanged(FieldId);
+	}
+	
+	UE_LOG(LogSGUI, Verbose, TEXT("✓ 批量通知：手牌字段 %d 个，变化卡牌 %d/%d 张"),
+		FieldIds.Num(), ChangedCardCount, CardsToFlush.Num());
+}
+
+// ✨ 新增 - 归还卡牌 ViewModel
+void USGCardHandViewModel::ReleaseCardViewModel(USGCardViewModel* ViewModel)
+{
+	// 仍在手牌中的不能归还
+	if (!ViewModel || CardViewModels.Contains(ViewModel))
+	{
+		return;
+	}
+	
+	RetiredCardViewModels.Remove(ViewModel);
+	ViewModel->ResetForPool();
+	
+	if (CardViewModelPool.Num() < SGCardHandViewModel::MaxPooledCardViewModels)
+	{
+		CardViewModelPool.AddUnique(ViewModel);
+		PooledCardViewModels.Set(CardViewModelPool.Num());
+	}
+}
+
+// ✨ 新增 - 从对象池取出卡牌 ViewModel
+USGCardViewModel* USGCardHandViewModel::AcquireCardViewModel()
+{
+	if (CardViewModelPool.Num() > 0)
+	{
+		USGCardViewModel* ViewModel = CardViewModelPool.Pop(EAllowShrinking::No);
+		PooledCardViewModels.Set(CardViewModelPool.Num());
+		return ViewModel;
+	}
+	SG_LLM_SCOPE(CardsUI);
+	return NewObject<USGCardViewModel>(this);
+}
+
+// ✨ 新增 - 卡牌 ViewModel 加入本次批量更新
+void USGCardHandViewModel::TrackCardViewModel(USGCardViewModel* ViewModel)
+{
+	if (UpdateDepth > 0)
+	{
+		ViewModel->BeginDeferredNotify();
+		PendingCardViewModels.AddUnique(ViewModel);
+	}
+}
+
+// ✨ 新增 - 本地计算剩余冷却时间
+float USGCardHandViewModel::GetCooldownRemainingAt(float WorldTime) const
+{
+	if (bCanAct)
+	{
+		return 0.0f;
+	}
+	return FMath::Max(0.0f, CooldownEndTime - WorldTime);
+}
+
+// 🔧 修改 - Cooldown 字段的 Getter：按冷却结束时间实时计算
+float USGCardHandViewModel::GetCooldown() const
+{
+	const UWorld* World = ObservedDeck ? ObservedDeck->GetWorld() : nullptr;
+	if (!World)
+	{
+		return Cooldown;
+	}
+	return GetCooldownRemainingAt(World->GetTimeSeconds());
+}
+
+// 🔧 修改 - 刷新冷却倒计时
+// 倒计时文本按整秒显示，只在剩余时间跨过整秒时通知一次；连续的进度显示由 Widget 调用 GetCooldownProgressAt 本地插值
+void USGCardHandViewModel::RefreshCooldown()
+{
+	const float Remaining = GetCooldown();
+	SetFieldValue(Cooldown, Remaining, FFieldNotificationClassDescriptor::Cooldown);
+	
+	UWorld* World = ObservedDeck ? ObservedDeck->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	if (!bCanAct && Remaining > 0.0f)
+	{
+		// 距离剩余时间降到下一个整数秒的时长（定时器略早触发时仍视为已到整秒，避免多等一秒）
+		const float TimeToNextSecond = FMath::Min(Remaining, Remaining - (FMath::CeilToFloat(Remaining - 1.0e-3f) - 1.0f));
+		World->GetTimerManager().SetTimer(CooldownRefreshTimer,
+			FTimerDelegate::CreateUObject(this, &USGCardHandViewModel::RefreshCooldown),
+			FMath::Max(TimeToNextSecond, KINDA_SMALL_NUMBER), false);
+	}
+	else
+	{
+		World->GetTimerManager().ClearTimer(CooldownRefreshTimer);
+	}
+}
+
+// ✨ 新增 - 本地计算冷却进度
+float USGCardHandViewModel::GetCooldownProgressAt(float WorldTime) const
+{
+	const float Duration = CooldownEndTime - CooldownStartTime;
+	if (bCanAct || Duration <= 0.0f)
+	{
+		return 1.0f;
+	}
+	return FMath::Clamp((WorldTime - CooldownStartTime) / Duration, 0.0f, 1.0f);
+}
+
 TArray<USGCardViewModel*> USGCardHandViewModel::GetCardViewModels() const
 {
 	// 需要转换 TObjectPtr 数组为原始指针数组
@@ -8,12 +8,23 @@
 #include "UIHud/SG_CardHandViewModel.h"
 #include "UIHud/SG_CardViewModel.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
+#include "Components/InvalidationBox.h"
 #include "UIHud/SG_CardEntryWidget.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundBase.h"
 
+namespace SGCardHandLayout
+{
+	// 判定卡牌静止的位置误差（像素）
+	constexpr float SettlePositionTolerance = 0.5f;
+
+	// 判定卡牌静止的旋转误差（度）
+	constexpr float SettleRotationTolerance = 0.1f;
+}
+
 /**
  * @brief 初始化卡牌 UI
  */
@@ -30,6 +41,7 @@ void USG_CardHandWidget::InitializeCardHand(USG_CardDeckComponent* InDeckCompone
 	}
 	
 	UE_LOG(LogSGUI, Log, TEXT("创建 HandViewModel..."));
+	SG_LLM_SCOPE(CardsUI); // ✨ 新增 - LLM 标签
 	HandViewModel = NewObject<USGCardHandViewModel>(this);
 	
 	HandViewModel->Initialize(DeckComponent);
@@ -139,17 +151,14 @@ void USG_CardHandWidget::OnDeckHandChanged(const TArray<FSGCardInstance>& NewHan
 			UE_LOG(LogSGUI, Log, TEXT("  📥 添加 %d 张新卡牌（所有新卡牌都从右侧推入）"), NewCards.Num());
 		}
 		
-		// 先重新计算现有卡牌布局（为新卡牌腾出空间）
-		CalculateCardLayout();
-		
 		// 所有新卡牌都从右侧推入
 		for (USGCardViewModel* NewCard : NewCards)
 		{
 			AddNewCardWithPushAnimation(NewCard);
 		}
 		
-		// 再次计算布局（包含新卡牌）
-		CalculateCardLayout();
+		// 🔧 修改 - 只标记布局，下一次 Tick 统一计算一次（包含新卡牌）
+		MarkLayoutDirty();
 	}
 	
 	if (bEnablePushAnimationDebug)
@@ -173,6 +182,9 @@ void USG_CardHandWidget::OnDeckSelectionChanged(const FGuid& SelectedId)
 		PlaySound2D(CardSelectSound);
 	}
 	
+	// ✨ 新增 - 选中卡牌的 Z 层级需要重新应用
+	WakeAllCards();
+	
 	HandleHandDataChanged();
 }
 
@@ -269,6 +281,12 @@ void USG_CardHandWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTi
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 	
+	// ✨ 新增 - 手牌静止时不做任何工作
+	if (IsHandIdle())
+	{
+		return;
+	}
+	
 	// 检查是否需要延迟刷新
 	if (bPendingRefresh)
 	{
@@ -289,7 +307,12 @@ void USG_CardHandWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTi
 		}
 	}
 	
+	// ✨ 新增 - 手牌变化后的布局只在这里计算一次
+	FlushLayoutIfDirty();
+	
 	UpdateCardPositions(InDeltaTime);
+	
+	UpdateInvalidationCaching();
 }
 
 /**
@@ -497,6 +520,8 @@ void USG_CardHandWidget::RefreshCardsArea()
 	
 	CardsArea->ClearChildren();
 	CardLayouts.Empty();
+	AnimatingCardIndices.Reset();
+	bLayoutDirty = false;
 	
 	// 配置的牌堆位置（开局时所有卡牌堆叠的位置）
 	UE_LOG(LogSGUI, Log, TEXT("  🎯 配置的牌堆位置（开局）：[%.2f, %.2f]"), DeckPilePositionX, DeckPilePositionY);
@@ -513,6 +538,7 @@ void USG_CardHandWidget::RefreshCardsArea()
 		}
 		
 		// 创建卡牌 Widget
+		SG_LLM_SCOPE(CardsUI); // ✨ 新增 - LLM 标签
 		USG_CardEntryWidget* CardEntry = CreateWidget<USG_CardEntryWidget>(
 			this, 
 			CardEntryWidgetClass
@@ -619,6 +645,8 @@ void USG_CardHandWidget::RefreshCardsArea()
 		bCanInteract = true;
 	}
 	
+	UpdateInvalidationCaching();
+	
 	UE_LOG(LogSGUI, Log, TEXT("✓ CardsArea 刷新完成"));
 	UE_LOG(LogSGUI, Log, TEXT("========================================"));
 }
@@ -854,6 +882,7 @@ void USG_CardHandWidget::OnOpeningDelayCompleted()
 	
 	// 标记正在播放开局飞出动画
 	bIsPlayingOpeningAnimation = true;
+	UpdateInvalidationCaching();
 	
 	// 播放展开音效
 	PlaySound2D(CardOpeningSound);
@@ -1227,6 +1256,9 @@ void USG_CardHandWidget::UpdateCardPositions(float DeltaTime)
 			bIsPlayingOpeningAnimation = false;
 			bCanInteract = true;
 			
+			// ✨ 新增 - 仍在被推动的卡牌交给活跃动画列表继续插值
+			WakeUnsettledCards();
+			
 			UE_LOG(LogSGUI, Log, TEXT("✓ 开局飞出动画完成，启用交互"));
 			HandleOpeningAnimationCompleted();
 		}
@@ -1236,15 +1268,21 @@ void USG_CardHandWidget::UpdateCardPositions(float DeltaTime)
 	
 	// ========== 正常的动画处理（非开局） ==========
 	
-	for (int32 i = CardLayouts.Num() - 1; i >= 0; --i)
+	// 🔧 修改 - 只更新活跃动画列表中的卡牌，静止卡牌不再逐帧写入 Slate
+	TArray<USG_CardEntryWidget*, TInlineAllocator<4>> FinishedRemovals;
+	
+	for (int32 ActiveIndex = AnimatingCardIndices.Num() - 1; ActiveIndex >= 0; --ActiveIndex)
 	{
-		FSGCardLayoutInfo& LayoutInfo = CardLayouts[i];
+		const int32 i = AnimatingCardIndices[ActiveIndex];
 		
-		if (!LayoutInfo.CardWidget)
+		if (!CardLayouts.IsValidIndex(i) || !CardLayouts[i].CardWidget)
 		{
+			AnimatingCardIndices.RemoveAtSwap(ActiveIndex, EAllowShrinking::No);
 			continue;
 		}
 		
+		FSGCardLayoutInfo& LayoutInfo = CardLayouts[i];
+		
 		// 处理移除动画
 		if (LayoutInfo.bIsPlayingRemoveAnimation)
 		{
@@ -1252,7 +1290,9 @@ void USG_CardHandWidget::UpdateCardPositions(float DeltaTime)
 			
 			if (LayoutInfo.RemoveAnimationProgress >= 1.0f)
 			{
-				RemoveCardWidget(LayoutInfo.CardWidget);
+				// 移除会改变索引，循环结束后统一处理
+				FinishedRemovals.Add(LayoutInfo.CardWidget);
+				AnimatingCardIndices.RemoveAtSwap(ActiveIndex, EAllowShrinking::No);
 				continue;
 			}
 			
@@ -1332,8 +1372,22 @@ void USG_CardHandWidget::UpdateCardPositions(float DeltaTime)
 			);
 		}
 		
+		// ✨ 新增 - 到达目标后对齐并移出活跃列表
+		if (IsCardSettled(LayoutInfo))
+		{
+			LayoutInfo.CurrentPositionX = LayoutInfo.TargetPositionX;
+			LayoutInfo.CurrentOffsetY = LayoutInfo.TargetOffsetY;
+			LayoutInfo.CurrentRotation = LayoutInfo.TargetRotation;
+			AnimatingCardIndices.RemoveAtSwap(ActiveIndex, EAllowShrinking::No);
+		}
+		
 		ApplyCardPosition(LayoutInfo);
 	}
+	
+	for (USG_CardEntryWidget* FinishedWidget : FinishedRemovals)
+	{
+		RemoveCardWidget(FinishedWidget);
+	}
 }
 
 /**
@@ -1375,6 +1429,121 @@ void USG_CardHandWidget::ApplyCardPosition(FSGCardLayoutInfo& LayoutInfo)
 	}
 }
 
+/**
+ * @brief ✨ 新增 - 标记布局需要重新计算
+ * @details 同一帧内多次手牌变化只计算一次布局
+ */
+void USG_CardHandWidget::MarkLayoutDirty()
+{
+	bLayoutDirty = true;
+	UpdateInvalidationCaching();
+}
+
+/**
+ * @brief ✨ 新增 - 布局已标记时重新计算
+ */
+void USG_CardHandWidget::FlushLayoutIfDirty()
+{
+	// 开局飞出期间目标位置由飞出动画计算，完成后再布局
+	if (!bLayoutDirty || bPendingRefresh || bIsPlayingOpeningAnimation)
+	{
+		return;
+	}
+	
+	bLayoutDirty = false;
+	
+	CalculateCardLayout();
+	WakeUnsettledCards();
+}
+
+/**
+ * @brief ✨ 新增 - 把卡牌加入活跃动画列表
+ */
+void USG_CardHandWidget::WakeCard(int32 CardIndex)
+{
+	if (!CardLayouts.IsValidIndex(CardIndex))
+	{
+		return;
+	}
+	
+	AnimatingCardIndices.AddUnique(CardIndex);
+	UpdateInvalidationCaching();
+}
+
+/**
+ * @brief ✨ 新增 - 唤醒所有卡牌
+ * @details 静止卡牌被唤醒后只会应用一次位置，随即移出活跃列表
+ */
+void USG_CardHandWidget::WakeAllCards()
+{
+	for (int32 i = 0; i < CardLayouts.Num(); ++i)
+	{
+		AnimatingCardIndices.AddUnique(i);
+	}
+	
+	UpdateInvalidationCaching();
+}
+
+/**
+ * @brief ✨ 新增 - 唤醒所有未到达目标的卡牌
+ */
+void USG_CardHandWidget::WakeUnsettledCards()
+{
+	for (int32 i = 0; i < CardLayouts.Num(); ++i)
+	{
+		if (CardLayouts[i].CardWidget && !IsCardSettled(CardLayouts[i]))
+		{
+			AnimatingCardIndices.AddUnique(i);
+		}
+	}
+	
+	UpdateInvalidationCaching();
+}
+
+/**
+ * @brief ✨ 新增 - 卡牌是否已静止
+ */
+bool USG_CardHandWidget::IsCardSettled(const FSGCardLayoutInfo& LayoutInfo) const
+{
+	using namespace SGCardHandLayout;
+	
+	return !LayoutInfo.bIsNewCard
+		&& !LayoutInfo.bIsPlayingRemoveAnimation
+		&& !LayoutInfo.bIsPlayingOpeningFlyOut
+		&& FMath::IsNearlyEqual(LayoutInfo.CurrentPositionX, LayoutInfo.TargetPositionX, SettlePositionTolerance)
+		&& FMath::IsNearlyEqual(LayoutInfo.CurrentOffsetY, LayoutInfo.TargetOffsetY, SettlePositionTolerance)
+		&& FMath::IsNearlyEqual(LayoutInfo.CurrentRotation, LayoutInfo.TargetRotation, SettleRotationTolerance);
+}
+
+/**
+ * @brief ✨ 新增 - 手牌是否完全空闲
+ */
+bool USG_CardHandWidget::IsHandIdle() const
+{
+	return !bPendingRefresh
+		&& !bLayoutDirty
+		&& !bIsPlayingOpeningAnimation
+		&& AnimatingCardIndices.IsEmpty();
+}
+
+/**
+ * @brief ✨ 新增 - 根据是否空闲开关失效缓存
+ * @details 未在 UMG 中放置 CardsInvalidationBox 时不做任何事
+ */
+void USG_CardHandWidget::UpdateInvalidationCaching()
+{
+	if (!CardsInvalidationBox)
+	{
+		return;
+	}
+	
+	const bool bShouldCache = IsHandIdle();
+	if (CardsInvalidationBox->GetCanCache() != bShouldCache)
+	{
+		CardsInvalidationBox->SetCanCache(bShouldCache);
+	}
+}
+
 /**
  * @brief 添加新卡牌
  */
@@ -1385,6 +1554,7 @@ void USG_CardHandWidget::AddNewCardWithPushAnimation(USGCardViewModel* CardVM)
 		return;
 	}
 	
+	SG_LLM_SCOPE(CardsUI); // ✨ 新增 - LLM 标签
 	USG_CardEntryWidget* CardEntry = CreateWidget<USG_CardEntryWidget>(this, CardEntryWidgetClass);
 	
 	if (!CardEntry)
@@ -1444,6 +1614,7 @@ void USG_CardHandWidget::AddNewCardWithPushAnimation(USGCardViewModel* CardVM)
 	LayoutInfo.FlyOutIndex = CardLayouts.Num();
 	
 	CardLayouts.Add(LayoutInfo);
+	WakeCard(CardLayouts.Num() - 1);
 	
 	PlaySound2D(CardDrawSound);
 }
@@ -1477,12 +1648,14 @@ void USG_CardHandWidget::OnCardUsed(USGCardViewModel* UsedCard)
 	
 	PlaySound2D(CardUseSound);
 	
-	for (FSGCardLayoutInfo& LayoutInfo : CardLayouts)
+	for (int32 i = 0; i < CardLayouts.Num(); ++i)
 	{
+		FSGCardLayoutInfo& LayoutInfo = CardLayouts[i];
 		if (LayoutInfo.CardViewModel == UsedCard)
 		{
 			LayoutInfo.bIsPlayingRemoveAnimation = true;
 			LayoutInfo.RemoveAnimationProgress = 0.0f;
+			WakeCard(i);
 			
 			UE_LOG(LogSGUI, Log, TEXT("  ✓ 开始播放卡牌移除动画"));
 			return;
@@ -1537,11 +1710,35 @@ void USG_CardHandWidget::RemoveCardWidget(USG_CardEntryWidget* CardWidget)
 		CardsArea->RemoveChild(CardWidget);
 	}
 	
+	// ✨ 新增 - 移除动画结束后把卡牌 ViewModel 归还对象池
+	const FSGCardLayoutInfo* RemovedLayout = CardLayouts.FindByPredicate([CardWidget](const FSGCardLayoutInfo& Info) {
+		return Info.CardWidget == CardWidget;
+	});
+	if (USGCardViewModel* CardVM = RemovedLayout ? RemovedLayout->CardViewModel.Get() : nullptr)
+	{
+		CardVM->OnCardUsedNotification.RemoveDynamic(this, &USG_CardHandWidget::OnCardUsed);
+		
+		if (HandViewModel)
+		{
+			HandViewModel->ReleaseCardViewModel(CardVM);
+		}
+	}
+	
 	CardLayouts.RemoveAll([CardWidget](const FSGCardLayoutInfo& Info) {
 		return Info.CardWidget == CardWidget;
 	});
 	
-	CalculateCardLayout();
+	// 🔧 修改 - 索引已变化，重建活跃列表（仍在移除动画中的卡牌保留）
+	AnimatingCardIndices.Reset();
+	for (int32 i = 0; i < CardLayouts.Num(); ++i)
+	{
+		if (CardLayouts[i].bIsPlayingRemoveAnimation)
+		{
+			AnimatingCardIndices.Add(i);
+		}
+	}
+	
+	MarkLayoutDirty();
 	
 	UE_LOG(LogSGUI, Log, TEXT("  ✓ 卡牌 Widget 已移除，剩余：%d"), CardLayouts.Num());
 }
\ No newline at end of file
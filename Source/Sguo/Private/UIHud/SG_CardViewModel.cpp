@@ -13,22 +13,23 @@
 // 初始化 ViewModel
 void USGCardViewModel::InitializeFromInstance(const FSGCardInstance& Instance, bool bInIsSelected, bool bInPlayable)
 {
+	// 🔧 修改 - 字段通过 SetFieldValue 修改，批量更新期间只在结束时通知一次
 	// 保存卡牌数据引用
 	CardData = Instance.CardData;
 	// 设置实例 ID
-	UE_MVVM_SET_PROPERTY_VALUE(InstanceId, Instance.InstanceId);
+	SetFieldValue(InstanceId, Instance.InstanceId, FFieldNotificationClassDescriptor::InstanceId);
 	// 设置卡牌名称
-	UE_MVVM_SET_PROPERTY_VALUE(CardName, Instance.CardData ? Instance.CardData->CardName : FText::GetEmpty());
+	SetFieldValue(CardName, Instance.CardData ? Instance.CardData->CardName : FText::GetEmpty(), FFieldNotificationClassDescriptor::CardName);
 	// 设置卡牌描述
-	UE_MVVM_SET_PROPERTY_VALUE(CardDescription, Instance.CardData ? Instance.CardData->CardDescription : FText::GetEmpty());
+	SetFieldValue(CardDescription, Instance.CardData ? Instance.CardData->CardDescription : FText::GetEmpty(), FFieldNotificationClassDescriptor::CardDescription);
 	// 设置卡牌图标
-	UE_MVVM_SET_PROPERTY_VALUE(CardIcon, Instance.CardData ? Instance.CardData->CardIcon : nullptr);
+	SetFieldValue(CardIcon, Instance.CardData ? Instance.CardData->CardIcon : nullptr, FFieldNotificationClassDescriptor::CardIcon);
 	// 更新选中状态
-	UE_MVVM_SET_PROPERTY_VALUE(bIsSelected, bInIsSelected);
+	SetFieldValue(bIsSelected, bInIsSelected, FFieldNotificationClassDescriptor::bIsSelected);
 	// 更新可用状态
-	UE_MVVM_SET_PROPERTY_VALUE(bIsPlayable, bInPlayable);
+	SetFieldValue(bIsPlayable, bInPlayable, FFieldNotificationClassDescriptor::bIsPlayable);
 	// 记录是否唯一
-	UE_MVVM_SET_PROPERTY_VALUE(bIsUnique, Instance.bIsUnique);
+	SetFieldValue(bIsUnique, Instance.bIsUnique, FFieldNotificationClassDescriptor::bIsUnique);
 }
 
 // 设置选中状态
@@ -42,7 +43,7 @@ void USGCardViewModel::SetSelected(bool bInSelected)
 			bIsSelected ? TEXT("选中") : TEXT("未选中"),
 			bInSelected ? TEXT("选中") : TEXT("未选中"));
 		
-		UE_MVVM_SET_PROPERTY_VALUE(bIsSelected, bInSelected);
+		SetFieldValue(bIsSelected, bInSelected, FFieldNotificationClassDescriptor::bIsSelected);
 		
 		// 广播选中状态改变事件
 		OnSelectionChanged.Broadcast(this, bInSelected);
@@ -52,10 +53,44 @@ void USGCardViewModel::SetSelected(bool bInSelected)
 // 设置可用状态
 void USGCardViewModel::SetPlayable(bool bInPlayable)
 {
-	if (bIsPlayable != bInPlayable)
+	SetFieldValue(bIsPlayable, bInPlayable, FFieldNotificationClassDescriptor::bIsPlayable);
+}
+
+/**
+ * @brief ✨ 新增 - 广播延迟期间修改过的字段
+ * @return 是否有字段发生变化
+ */
+bool USGCardViewModel::FlushFieldNotifications()
+{
+	bDeferFieldNotify = false;
+
+	if (PendingFieldIds.IsEmpty())
+	{
+		return false;
+	}
+
+	// 先交换出来，广播回调中的修改会立即通知
+	TArray<UE::FieldNotification::FFieldId, TInlineAllocator<8>> FieldIds = MoveTemp(PendingFieldIds);
+	PendingFieldIds.Reset();
+
+	for (const UE::FieldNotification::FFieldId& FieldId : FieldIds)
 	{
-		UE_MVVM_SET_PROPERTY_VALUE(bIsPlayable, bInPlayable);
+		BroadcastFieldValueChanged(FieldId);
 	}
+	return true;
+}
+
+/**
+ * @brief ✨ 新增 - 回收到对象池前重置
+ */
+void USGCardViewModel::ResetForPool()
+{
+	OnCardUsedNotification.Clear();
+	OnSelectionChanged.Clear();
+
+	CardData = nullptr;
+	bDeferFieldNotify = false;
+	PendingFieldIds.Reset();
 }
 
 /**
@@ -0,0 +1,241 @@
+// 📄 文件：Source/Sguo/Private/Units/SG_DeathEventHub.cpp
+// ✨ 新增 - 单位死亡事件中心实现
+// ✅ 这是完整文件
+
+#include "Units/SG_DeathEventHub.h"
+#include "Units/SG_UnitsBase.h"
+#include "AI/SG_CombatTargetManager.h"
+#include "AI/SG_TargetingSubsystem.h"
+#include "AI/SG_ReachabilityCache.h"
+#include "Debug/SG_LogCategories.h"
+#include "Engine/World.h"
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_DeathEventHub::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<USG_UnitRegistrySubsystem>();
+
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGUnit, Log, TEXT("✓ 死亡事件中心初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_DeathEventHub::Deinitialize()
+{
+    WatchSlots.Empty();
+    PendingDeaths.Empty();
+
+    Super::Deinitialize();
+}
+
+// ========== 监听接口 ==========
+
+/**
+ * @brief 获取句柄对应的监听者列表
+ */
+USG_DeathEventHub::FSGWatchSlot& USG_DeathEventHub::GetWatchSlot(const FSGUnitHandle& Handle)
+{
+    if (WatchSlots.Num() <= Handle.Index)
+    {
+        WatchSlots.SetNum(Handle.Index + 1);
+    }
+
+    FSGWatchSlot& Slot = WatchSlots[Handle.Index];
+    if (Slot.Generation != Handle.Generation)
+    {
+        // 槽位已被新单位复用，旧的监听者作废
+        Slot.Generation = Handle.Generation;
+        Slot.Watchers.Reset();
+    }
+    return Slot;
+}
+
+/**
+ * @brief 关注某单位的死亡
+ * @param Target 目标单位
+ * @param Owner 监听者
+ * @param Callback 死亡回调
+ * @return 目标有效时返回 true
+ */
+bool USG_DeathEventHub::AddWatcher(ASG_UnitsBase* Target, UObject* Owner, FSGDeathWatchCallback Callback)
+{
+    if (!Target || !Owner || Target->bIsDead)
+    {
+        return false;
+    }
+
+    const USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>();
+    if (!Registry || !Registry->IsHandleValid(Target->RegistryHandle))
+    {
+        return false;
+    }
+
+    FSGWatchSlot& Slot = GetWatchSlot(Target->RegistryHandle);
+
+    for (FSGDeathWatcher& Watcher : Slot.Watchers)
+    {
+        if (Watcher.Owner.Get() == Owner)
+        {
+            Watcher.Callback = MoveTemp(Callback);
+            return true;
+        }
+    }
+
+    // 复用已失效的监听者位置
+    for (FSGDeathWatcher& Watcher : Slot.Watchers)
+    {
+        if (!Watcher.Owner.IsValid())
+        {
+            Watcher.Owner = Owner;
+            Watcher.Callback = MoveTemp(Callback);
+            return true;
+        }
+    }
+
+    FSGDeathWatcher& NewWatcher = Slot.Watchers.AddDefaulted_GetRef();
+    NewWatcher.Owner = Owner;
+    NewWatcher.Callback = MoveTemp(Callback);
+    return true;
+}
+
+/**
+ * @brief 取消关注某单位的死亡
+ * @param Target 目标单位
+ * @param Owner 监听者
+ */
+void USG_DeathEventHub::RemoveWatcher(ASG_UnitsBase* Target, const UObject* Owner)
+{
+    if (!Target || !Owner)
+    {
+        return;
+    }
+
+    const FSGUnitHandle& Handle = Target->RegistryHandle;
+    if (!Handle.IsValid() || !WatchSlots.IsValidIndex(Handle.Index))
+    {
+        return;
+    }
+
+    FSGWatchSlot& Slot = WatchSlots[Handle.Index];
+    if (Slot.Generation != Handle.Generation)
+    {
+        return;
+    }
+
+    Slot.Watchers.RemoveAllSwap([Owner](const FSGDeathWatcher& Watcher)
+    {
+        return Watcher.Owner.Get() == Owner || !Watcher.Owner.IsValid();
+    });
+}
+
+// ========== 死亡上报 ==========
+
+/**
+ * @brief 上报单位死亡
+ * @param DeadUnit 死亡单位
+ */
+void USG_DeathEventHub::NotifyUnitDied(ASG_UnitsBase* DeadUnit)
+{
+    if (!DeadUnit)
+    {
+        return;
+    }
+
+    FSGPendingDeath& PendingDeath = PendingDeaths.AddDefaulted_GetRef();
+    PendingDeath.Unit = DeadUnit;
+
+    // 取出监听者列表（注销后槽位可能被复用）
+    const FSGUnitHandle& Handle = DeadUnit->RegistryHandle;
+    if (Handle.IsValid() && WatchSlots.IsValidIndex(Handle.Index) && WatchSlots[Handle.Index].Generation == Handle.Generation)
+    {
+        PendingDeath.Watchers = MoveTemp(WatchSlots[Handle.Index].Watchers);
+        WatchSlots[Handle.Index].Watchers.Reset();
+    }
+
+    if (USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>())
+    {
+        Registry->UnregisterUnit(DeadUnit->RegistryHandle);
+    }
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧 Tick
+ * @param DeltaTime 帧间隔时间
+ */
+void USG_DeathEventHub::Tick(float DeltaTime)
+{
+    DispatchPendingDeaths();
+}
+
+/**
+ * @brief 统一处理所有待处理的死亡
+ * @details
+ * 详细流程：
+ * 1. 取出本批死亡（回调中产生的新死亡进入下一批）
+ * 2. 攻击槽位、攻击者计数、不可达记录各做一次批量清理
+ * 3. 依次通知仍然有效的监听者
+ */
+void USG_DeathEventHub::DispatchPendingDeaths()
+{
+    TArray<FSGPendingDeath> Batch = MoveTemp(PendingDeaths);
+    PendingDeaths.Reset();
+
+    TArray<ASG_UnitsBase*> DeadUnits;
+    DeadUnits.Reserve(Batch.Num());
+    for (const FSGPendingDeath& PendingDeath : Batch)
+    {
+        if (ASG_UnitsBase* Unit = PendingDeath.Unit.Get())
+        {
+            DeadUnits.Add(Unit);
+        }
+    }
+
+    UWorld* World = GetWorld();
+    if (DeadUnits.Num() > 0 && World)
+    {
+        if (USG_CombatTargetManager* CombatManager = World->GetSubsystem<USG_CombatTargetManager>())
+        {
+            CombatManager->HandleUnitsDied(DeadUnits);
+        }
+
+        if (USG_TargetingSubsystem* TargetingSys = World->GetSubsystem<USG_TargetingSubsystem>())
+        {
+            TargetingSys->HandleUnitsDied(DeadUnits);
+        }
+
+        if (USG_ReachabilityCache* ReachabilityCache = World->GetSubsystem<USG_ReachabilityCache>())
+        {
+            ReachabilityCache->HandleUnitsDied(DeadUnits);
+        }
+    }
+
+    int32 NotifiedCount = 0;
+    for (FSGPendingDeath& PendingDeath : Batch)
+    {
+        ASG_UnitsBase* Unit = PendingDeath.Unit.Get();
+        if (!Unit)
+        {
+            continue;
+        }
+
+        for (FSGDeathWatcher& Watcher : PendingDeath.Watchers)
+        {
+            if (Watcher.Owner.IsValid() && Watcher.Callback.ExecuteIfBound(Unit))
+            {
+                NotifiedCount++;
+            }
+        }
+    }
+
+    UE_LOG(LogSGUnit, Verbose, TEXT("[死亡事件] 本批处理 %d 个死亡，通知 %d 个监听者"), Batch.Num(), NotifiedCount);
+}
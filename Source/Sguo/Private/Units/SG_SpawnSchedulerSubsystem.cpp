@@ -0,0 +1,321 @@
+// 📄 文件：Source/Sguo/Private/Units/SG_SpawnSchedulerSubsystem.cpp
+// ✨ 新增 - 分帧生成调度器实现
+// ✅ 这是完整文件
+
+#include "Units/SG_SpawnSchedulerSubsystem.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Game/SG_HeightfieldSubsystem.h"
+#include "Units/SG_UnitsBase.h"
+#include "Data/SG_CharacterCardData.h"
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_SpawnSchedulerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<USG_UnitPoolSubsystem>();
+
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGUnit, Log, TEXT("✓ 分帧生成调度器初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_SpawnSchedulerSubsystem::Deinitialize()
+{
+    ActiveRequests.Empty();
+    IncomingRequests.Empty();
+
+    Super::Deinitialize();
+}
+
+// ========== 请求接口 ==========
+
+/**
+ * @brief 提交阵型生成请求
+ * @param Request 生成请求
+ * @param OnCompleted 完成回调
+ * @return 请求 ID
+ */
+int32 USG_SpawnSchedulerSubsystem::EnqueueFormation(const FSGFormationSpawnRequest& Request, FSGSpawnRequestCallback OnCompleted)
+{
+    FSGActiveSpawnRequest NewRequest;
+    NewRequest.RequestId = NextRequestId++;
+    NewRequest.Request = Request;
+    NewRequest.Callback = MoveTemp(OnCompleted);
+    NewRequest.SpawnedUnits.Reserve(Request.Slots.Num());
+
+    // 占位 Actor 立即放置，表示该位置已被预定
+    if (PlaceholderClass)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        NewRequest.Placeholders.Reserve(Request.Slots.Num());
+        for (const FSGFormationSpawnSlot& Slot : Request.Slots)
+        {
+            NewRequest.Placeholders.Add(GetWorld()->SpawnActor<AActor>(PlaceholderClass, Slot.Transform, SpawnParams));
+        }
+    }
+
+    UE_LOG(LogSGUnit, Verbose, TEXT("📋 生成请求 #%d：%d 个单位"), NewRequest.RequestId, Request.Slots.Num());
+
+    const int32 RequestId = NewRequest.RequestId;
+    (bProcessingQueue ? IncomingRequests : ActiveRequests).Add(MoveTemp(NewRequest));
+    return RequestId;
+}
+
+/**
+ * @brief 取消生成请求
+ * @param RequestId 请求 ID
+ * @return 是否找到并取消
+ */
+bool USG_SpawnSchedulerSubsystem::CancelRequest(int32 RequestId)
+{
+    for (TArray<FSGActiveSpawnRequest>* Queue : { &ActiveRequests, &IncomingRequests })
+    {
+        const int32 Index = Queue->IndexOfByPredicate([RequestId](const FSGActiveSpawnRequest& Active) { return Active.RequestId == RequestId; });
+        if (Index == INDEX_NONE)
+        {
+            continue;
+        }
+
+        FSGActiveSpawnRequest& Active = (*Queue)[Index];
+        for (const TWeakObjectPtr<AActor>& Placeholder : Active.Placeholders)
+        {
+            if (AActor* PlaceholderActor = Placeholder.Get())
+            {
+                PlaceholderActor->Destroy();
+            }
+        }
+
+        // 处理队列期间只标记为已完成，由 Tick 统一移除
+        if (bProcessingQueue && Queue == &ActiveRequests)
+        {
+            Active.Request.Slots.Reset();
+            Active.NextSlot = 0;
+            Active.bCancelled = true;
+        }
+        else
+        {
+            Queue->RemoveAt(Index);
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 请求是否仍在进行
+ */
+bool USG_SpawnSchedulerSubsystem::IsRequestPending(int32 RequestId) const
+{
+    auto MatchesId = [RequestId](const FSGActiveSpawnRequest& Active) { return Active.RequestId == RequestId; };
+    return ActiveRequests.ContainsByPredicate(MatchesId) || IncomingRequests.ContainsByPredicate(MatchesId);
+}
+
+/**
+ * @brief 获取尚未生成的单位数量
+ */
+int32 USG_SpawnSchedulerSubsystem::GetPendingUnitCount() const
+{
+    int32 Count = 0;
+    for (const TArray<FSGActiveSpawnRequest>* Queue : { &ActiveRequests, &IncomingRequests })
+    {
+        for (const FSGActiveSpawnRequest& Active : *Queue)
+        {
+            Count += Active.Request.Slots.Num() - Active.NextSlot;
+        }
+    }
+    return Count;
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧 Tick
+ * @param DeltaTime 帧间隔时间
+ * @details
+ * 详细流程：
+ * 1. 按提交顺序处理请求，出场间隔未到的请求不阻塞后面的请求
+ * 2. 超出时间预算（且已达到最少生成数量）时停止
+ * 3. 移除已完成的请求并通知调用方（回调中提交的新请求进入下一帧）
+ */
+void USG_SpawnSchedulerSubsystem::Tick(float DeltaTime)
+{
+    SG_SCOPE_CYCLE_COUNTER(SpawnSchedulerTick);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = FrameBudgetMs * 0.001;
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+
+    int32 SpawnedThisFrame = 0;
+    bool bBudgetExhausted = false;
+
+    bProcessingQueue = true;
+
+    for (FSGActiveSpawnRequest& Active : ActiveRequests)
+    {
+        while (!Active.IsFinished())
+        {
+            if (SpawnedThisFrame >= MinUnitsPerFrame && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+            {
+                bBudgetExhausted = true;
+                break;
+            }
+
+            if (Active.Request.StaggerInterval > 0.0f)
+            {
+                if (WorldTime < Active.NextSpawnTime)
+                {
+                    break;
+                }
+                Active.NextSpawnTime = WorldTime + Active.Request.StaggerInterval;
+            }
+
+            SpawnSlot(Active, Active.NextSlot++);
+            SpawnedThisFrame++;
+
+            if (Active.Request.StaggerInterval > 0.0f)
+            {
+                break;
+            }
+        }
+
+        if (bBudgetExhausted)
+        {
+            break;
+        }
+    }
+
+    bProcessingQueue = false;
+
+    // 移除已完成的请求（保持提交顺序），再统一通知
+    TArray<FSGActiveSpawnRequest> Finished;
+    for (int32 Index = 0; Index < ActiveRequests.Num(); )
+    {
+        if (ActiveRequests[Index].IsFinished())
+        {
+            Finished.Add(MoveTemp(ActiveRequests[Index]));
+            ActiveRequests.RemoveAt(Index, EAllowShrinking::No);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    ActiveRequests.Append(MoveTemp(IncomingRequests));
+    IncomingRequests.Reset();
+
+    for (FSGActiveSpawnRequest& Active : Finished)
+    {
+        CompleteRequest(Active);
+    }
+
+    if (SpawnedThisFrame > 0)
+    {
+        UE_LOG(LogSGUnit, Verbose, TEXT("📋 本帧生成 %d 个单位，耗时 %.3f 毫秒，剩余 %d"),
+            SpawnedThisFrame, (FPlatformTime::Seconds() - StartTime) * 1000.0, GetPendingUnitCount());
+    }
+}
+
+/**
+ * @brief 生成请求中的一个单位
+ * @details 地面吸附：找到地面时高度 = 地面 + 偏移，否则保持原高度
+ */
+void USG_SpawnSchedulerSubsystem::SpawnSlot(FSGActiveSpawnRequest& Active, int32 SlotIndex)
+{
+    const FSGFormationSpawnRequest& Request = Active.Request;
+    const FSGFormationSpawnSlot& Slot = Request.Slots[SlotIndex];
+
+    FTransform SpawnTransform = Slot.Transform;
+
+    // 🔧 修改 - 地面高度优先查询高度图缓存
+    USG_HeightfieldSubsystem* Heightfield = GetWorld()->GetSubsystem<USG_HeightfieldSubsystem>();
+    if (Request.bSnapToGround && Heightfield)
+    {
+        const FVector Location = SpawnTransform.GetLocation();
+
+        FVector GroundLocation;
+        if (Heightfield->FindGroundLocation(
+            Location,
+            Request.GroundTraceUp,
+            Request.GroundTraceDown,
+            GroundLocation,
+            ECC_WorldStatic,
+            { Request.SpawnOwner.Get(), Request.SpawnInstigator.Get() }))
+        {
+            SpawnTransform.SetLocation(FVector(Location.X, Location.Y, GroundLocation.Z + Request.GroundZOffset));
+        }
+    }
+
+    // 单位替换占位
+    if (Active.Placeholders.IsValidIndex(SlotIndex))
+    {
+        if (AActor* PlaceholderActor = Active.Placeholders[SlotIndex].Get())
+        {
+            PlaceholderActor->Destroy();
+        }
+    }
+
+    USG_UnitPoolSubsystem* UnitPool = GetWorld()->GetSubsystem<USG_UnitPoolSubsystem>();
+    if (!UnitPool || !Slot.UnitClass)
+    {
+        return;
+    }
+
+    if (ASG_UnitsBase* NewUnit = UnitPool->AcquireUnit(
+        Slot.UnitClass,
+        SpawnTransform,
+        Request.CardData,
+        Request.FactionTag,
+        Request.SpawnOwner,
+        Request.SpawnInstigator))
+    {
+        Active.SpawnedUnits.Add(NewUnit);
+    }
+}
+
+/**
+ * @brief 完成请求：清理占位并通知调用方
+ */
+void USG_SpawnSchedulerSubsystem::CompleteRequest(FSGActiveSpawnRequest& Active)
+{
+    for (const TWeakObjectPtr<AActor>& Placeholder : Active.Placeholders)
+    {
+        if (AActor* PlaceholderActor = Placeholder.Get())
+        {
+            PlaceholderActor->Destroy();
+        }
+    }
+
+    if (Active.bCancelled)
+    {
+        return;
+    }
+
+    TArray<ASG_UnitsBase*> SpawnedUnits;
+    SpawnedUnits.Reserve(Active.SpawnedUnits.Num());
+    for (const TWeakObjectPtr<ASG_UnitsBase>& Unit : Active.SpawnedUnits)
+    {
+        if (ASG_UnitsBase* UnitPtr = Unit.Get())
+        {
+            SpawnedUnits.Add(UnitPtr);
+        }
+    }
+
+    UE_LOG(LogSGUnit, Log, TEXT("📋 生成请求 #%d 完成：%d 个单位"), Active.RequestId, SpawnedUnits.Num());
+
+    Active.Callback.ExecuteIfBound(SpawnedUnits);
+    OnSpawnRequestCompleted.Broadcast(Active.RequestId, SpawnedUnits);
+}
@@ -6,6 +6,7 @@
 #include "AI/SG_StationaryAIController.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_MemoryTracking.h" // ✨ 新增 - LLM 标签
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimMontage.h"
 #include "Actors/SG_Projectile.h"
@@ -60,7 +61,15 @@ void ASG_StationaryUnit::Tick(float DeltaTime)
 
 bool ASG_StationaryUnit::CanBeTargeted() const
 {
-    return bCanBeTargeted;
+    // 🔧 修改 - 池中的单位不可被选为目标
+    return bCanBeTargeted && !IsInPool();
+}
+
+// ✨ 新增 - 从对象池复用时重新应用站桩设置（BeginPlay 不会再次调用）
+void ASG_StationaryUnit::OnActivatedFromPool()
+{
+    Super::OnActivatedFromPool();
+    ApplyStationarySettings();
 }
 
 void ASG_StationaryUnit::ApplyStationarySettings()
@@ -418,6 +427,7 @@ AActor* ASG_StationaryUnit::FireArrow(const FVector& TargetLocation, TSubclassOf
     SpawnParams.Instigator = this;
     SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
+    SG_LLM_SCOPE(Projectiles); // ✨ 新增 - LLM 标签
     AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(
         ProjectileClass,
         SpawnLocation,
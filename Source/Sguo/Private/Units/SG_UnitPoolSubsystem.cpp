@@ -0,0 +1,283 @@
+// 📄 文件：Source/Sguo/Private/Units/SG_UnitPoolSubsystem.cpp
+// ✨ 新增 - 单位对象池实现
+// ✅ 这是完整文件
+
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "Units/SG_UnitsBase.h"
+#include "AI/SG_ReachabilityCache.h"
+#include "Data/SG_CharacterCardData.h"
+#include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Debug/SG_MemoryTracking.h"
+#include "Engine/World.h"
+
+// 预热单位的临时存放位置（远离战场）
+static const FVector PoolParkingLocation(0.0f, 0.0f, -100000.0f);
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_UnitPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGUnit, Log, TEXT("✓ 单位对象池初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_UnitPoolSubsystem::Deinitialize()
+{
+    UE_LOG(LogSGUnit, Log, TEXT("单位对象池统计：新生成 %d，复用 %d，池中峰值 %d"), SpawnedCount, ReusedCount, PooledCount.Peak);
+
+    FreeUnits.Empty();
+    SET_DWORD_STAT(STAT_SGPooledUnits, 0);
+
+    Super::Deinitialize();
+}
+
+// ========== 获取与回收 ==========
+
+/**
+ * @brief 获取单位（优先复用池中的单位）
+ * @details
+ * 详细流程：
+ * 1. 从对应类的空闲列表末尾取出仍然有效的单位
+ * 2. 有可用单位时调用 ActivateFromPool 重置并激活
+ * 3. 否则延迟生成新单位，设置卡牌和阵营后完成生成
+ */
+ASG_UnitsBase* USG_UnitPoolSubsystem::AcquireUnit(
+    TSubclassOf<ASG_UnitsBase> UnitClass,
+    const FTransform& SpawnTransform,
+    USG_CharacterCardData* CardData,
+    FGameplayTag InFactionTag,
+    AActor* SpawnOwner,
+    APawn* SpawnInstigator)
+{
+    SG_SCOPE_CYCLE_COUNTER(UnitPoolAcquire);
+
+    if (!UnitClass)
+    {
+        return nullptr;
+    }
+
+    if (bEnablePooling)
+    {
+        if (TArray<TWeakObjectPtr<ASG_UnitsBase>>* Bucket = FreeUnits.Find(UnitClass))
+        {
+            while (Bucket->Num() > 0)
+            {
+                ASG_UnitsBase* Unit = Bucket->Pop(EAllowShrinking::No).Get();
+                if (!IsValid(Unit))
+                {
+                    continue;
+                }
+
+                Unit->SetOwner(SpawnOwner);
+                Unit->SetInstigator(SpawnInstigator);
+                Unit->ActivateFromPool(SpawnTransform, CardData, InFactionTag);
+                ReusedCount++;
+                SG_INC_COUNTER(UnitsReused);
+                PooledCount.Set(GetTotalPooledCount());
+                SET_DWORD_STAT(STAT_SGPooledUnits, PooledCount.Current);
+
+                UE_LOG(LogSGUnit, Verbose, TEXT("♻️ 复用单位：%s（池中剩余 %d）"), *Unit->GetName(), Bucket->Num());
+                return Unit;
+            }
+        }
+    }
+
+    return SpawnNewUnit(UnitClass, SpawnTransform, CardData, InFactionTag, SpawnOwner, SpawnInstigator);
+}
+
+/**
+ * @brief 生成新单位
+ */
+ASG_UnitsBase* USG_UnitPoolSubsystem::SpawnNewUnit(
+    TSubclassOf<ASG_UnitsBase> UnitClass,
+    const FTransform& SpawnTransform,
+    USG_CharacterCardData* CardData,
+    const FGameplayTag& InFactionTag,
+    AActor* SpawnOwner,
+    APawn* SpawnInstigator)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // ✨ 新增 - 单位 Actor、组件、ASC 和默认控制器都记入 Sguo/Units
+    SG_LLM_SCOPE(Units);
+
+    ASG_UnitsBase* NewUnit = World->SpawnActorDeferred<ASG_UnitsBase>(
+        UnitClass,
+        SpawnTransform,
+        SpawnOwner,
+        SpawnInstigator,
+        ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn
+    );
+
+    if (!NewUnit)
+    {
+        return nullptr;
+    }
+
+    if (CardData)
+    {
+        NewUnit->SetSourceCardData(CardData);
+    }
+    if (InFactionTag.IsValid())
+    {
+        NewUnit->FactionTag = InFactionTag;
+    }
+    NewUnit->bSpawnedFromPool = true;
+    NewUnit->FinishSpawning(SpawnTransform);
+
+    // 未配置自动控制时补一个默认控制器
+    if (!NewUnit->GetController())
+    {
+        NewUnit->SpawnDefaultController();
+    }
+
+    SpawnedCount++;
+    SG_INC_COUNTER(UnitsSpawned);
+    return NewUnit;
+}
+
+/**
+ * @brief 直接以池中状态生成单位
+ * @param UnitClass 单位类
+ */
+ASG_UnitsBase* USG_UnitPoolSubsystem::SpawnPooledUnit(TSubclassOf<ASG_UnitsBase> UnitClass)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    SG_LLM_SCOPE(Units);
+
+    const FTransform ParkingTransform(PoolParkingLocation);
+    ASG_UnitsBase* NewUnit = World->SpawnActorDeferred<ASG_UnitsBase>(
+        UnitClass,
+        ParkingTransform,
+        nullptr,
+        nullptr,
+        ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+    );
+
+    if (!NewUnit)
+    {
+        return nullptr;
+    }
+
+    NewUnit->bSpawnedFromPool = true;
+    NewUnit->PrepareForPooledSpawn();
+    NewUnit->FinishSpawning(ParkingTransform);
+
+    SpawnedCount++;
+    SG_INC_COUNTER(UnitsSpawned);
+    return NewUnit;
+}
+
+/**
+ * @brief 回收单位
+ * @param Unit 单位
+ * @return 是否已放入池中
+ */
+bool USG_UnitPoolSubsystem::ReleaseUnit(ASG_UnitsBase* Unit)
+{
+    if (!bEnablePooling || !IsValid(Unit) || !Unit->bSpawnedFromPool || Unit->IsInPool())
+    {
+        return false;
+    }
+
+    TArray<TWeakObjectPtr<ASG_UnitsBase>>& Bucket = FreeUnits.FindOrAdd(Unit->GetClass());
+    Bucket.RemoveAllSwap([](const TWeakObjectPtr<ASG_UnitsBase>& Ptr) { return !Ptr.IsValid(); });
+
+    if (Bucket.Num() >= MaxPooledPerClass)
+    {
+        return false;
+    }
+
+    Unit->DeactivateForPool();
+    Bucket.Add(Unit);
+
+    // 同一个 Actor 下次出池是新单位，清掉上一次的不可达记录
+    if (USG_ReachabilityCache* ReachabilityCache = GetWorld()->GetSubsystem<USG_ReachabilityCache>())
+    {
+        ReachabilityCache->ClearTarget(Unit);
+    }
+
+    PooledCount.Set(GetTotalPooledCount());
+    SET_DWORD_STAT(STAT_SGPooledUnits, PooledCount.Current);
+
+    UE_LOG(LogSGUnit, Verbose, TEXT("♻️ 回收单位：%s（池中 %d）"), *Unit->GetName(), Bucket.Num());
+    return true;
+}
+
+/**
+ * @brief 预热对象池
+ * @param UnitClass 单位类
+ * @param Count 预热后池中至少保留的数量
+ */
+void USG_UnitPoolSubsystem::Prewarm(TSubclassOf<ASG_UnitsBase> UnitClass, int32 Count)
+{
+    if (!UnitClass || !bEnablePooling)
+    {
+        return;
+    }
+
+    const int32 TargetCount = FMath::Min(Count, MaxPooledPerClass);
+    int32 CreatedCount = 0;
+
+    TArray<TWeakObjectPtr<ASG_UnitsBase>>& Bucket = FreeUnits.FindOrAdd(UnitClass);
+    Bucket.RemoveAllSwap([](const TWeakObjectPtr<ASG_UnitsBase>& Ptr) { return !Ptr.IsValid(); });
+
+    while (Bucket.Num() < TargetCount)
+    {
+        // 以池中状态生成，不经过激活再停用
+        ASG_UnitsBase* Unit = SpawnPooledUnit(UnitClass);
+        if (!Unit)
+        {
+            break;
+        }
+        Bucket.Add(Unit);
+        CreatedCount++;
+    }
+
+    PooledCount.Set(GetTotalPooledCount());
+    SET_DWORD_STAT(STAT_SGPooledUnits, PooledCount.Current);
+
+    UE_LOG(LogSGUnit, Log, TEXT("♻️ 预热对象池：%s +%d（共 %d）"), *UnitClass->GetName(), CreatedCount, GetPooledCount(UnitClass));
+}
+
+// ========== 查询 ==========
+
+/**
+ * @brief 获取池中某类单位的数量
+ */
+int32 USG_UnitPoolSubsystem::GetPooledCount(TSubclassOf<ASG_UnitsBase> UnitClass) const
+{
+    const TArray<TWeakObjectPtr<ASG_UnitsBase>>* Bucket = FreeUnits.Find(UnitClass);
+    return Bucket ? Bucket->Num() : 0;
+}
+
+/**
+ * @brief 获取池中单位总数
+ */
+int32 USG_UnitPoolSubsystem::GetTotalPooledCount() const
+{
+    int32 Total = 0;
+    for (const auto& Pair : FreeUnits)
+    {
+        Total += Pair.Value.Num();
+    }
+    return Total;
+}
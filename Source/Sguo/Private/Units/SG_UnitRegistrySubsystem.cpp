@@ -0,0 +1,277 @@
+// 📄 文件：Source/Sguo/Private/Units/SG_UnitRegistrySubsystem.cpp
+// 🔧 修改 - 新增移动单位的速度历史环形缓冲
+// ✅ 这是完整文件
+
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Units/SG_UnitsBase.h"
+#include "AbilitySystem/SG_AttributeSet.h"
+#include "Debug/SG_LogCategories.h"
+
+// ========== 生命周期 ==========
+
+/**
+ * @brief 子系统初始化
+ * @param Collection 子系统集合
+ */
+void USG_UnitRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UE_LOG(LogSGUnit, Log, TEXT("✓ 单位注册表初始化完成"));
+}
+
+/**
+ * @brief 子系统销毁
+ */
+void USG_UnitRegistrySubsystem::Deinitialize()
+{
+    Units.Empty();
+    Positions.Empty();
+    Healths.Empty();
+    AttackDamages.Empty();
+    FactionIndices.Empty();
+    Generations.Empty();
+    SpeedHistory.Empty();
+    SpeedSampleCounts.Empty();
+    StuckSpeedThresholds.Empty();
+    StuckTimes.Empty();
+    LowSpeedEvaluations.Empty();
+    MovingMask.Empty();
+    ActiveMask.Empty();
+    FreeSlots.Empty();
+    FactionTags.Empty();
+    ActiveCount = FSGHighWaterMark();
+
+    Super::Deinitialize();
+}
+
+// ========== 注册接口 ==========
+
+/**
+ * @brief 注册单位
+ * @param Unit 单位
+ * @return 单位句柄
+ * @details
+ * 功能说明：
+ * - 优先复用空闲槽位，复用时代数加一，使旧句柄失效
+ * - 注册时立即写入一次位置和属性
+ */
+FSGUnitHandle USG_UnitRegistrySubsystem::RegisterUnit(ASG_UnitsBase* Unit)
+{
+    FSGUnitHandle Handle;
+    if (!Unit)
+    {
+        return Handle;
+    }
+
+    int32 SlotIndex;
+    if (FreeSlots.Num() > 0)
+    {
+        SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+        Generations[SlotIndex]++;
+    }
+    else
+    {
+        SlotIndex = Units.AddDefaulted();
+        Positions.AddZeroed();
+        Healths.AddZeroed();
+        AttackDamages.AddZeroed();
+        FactionIndices.AddZeroed();
+        Generations.Add(1);
+        SpeedHistory.AddZeroed(SpeedHistoryLength);
+        SpeedSampleCounts.AddZeroed();
+        StuckSpeedThresholds.AddZeroed();
+        StuckTimes.AddZeroed();
+        LowSpeedEvaluations.AddZeroed();
+        MovingMask.Add(false);
+        ActiveMask.Add(false);
+    }
+
+    Units[SlotIndex] = Unit;
+    FactionIndices[SlotIndex] = GetFactionIndex(Unit->FactionTag);
+    ActiveMask[SlotIndex] = true;
+    ActiveCount.Set(ActiveCount.Current + 1);
+
+    RefreshSlot(SlotIndex, Unit);
+
+    Handle.Index = SlotIndex;
+    Handle.Generation = Generations[SlotIndex];
+
+    UE_LOG(LogSGUnit, Verbose, TEXT("[单位注册表] 注册 %s -> 槽位 %d（代数 %d）"),
+        *Unit->GetName(), Handle.Index, Handle.Generation);
+
+    return Handle;
+}
+
+/**
+ * @brief 注销单位
+ * @param Handle 单位句柄（注销后被重置）
+ */
+void USG_UnitRegistrySubsystem::UnregisterUnit(FSGUnitHandle& Handle)
+{
+    if (!IsHandleValid(Handle))
+    {
+        Handle.Reset();
+        return;
+    }
+
+    const int32 SlotIndex = Handle.Index;
+    Units[SlotIndex] = nullptr;
+    Healths[SlotIndex] = 0.0f;
+    AttackDamages[SlotIndex] = 0.0f;
+    ActiveMask[SlotIndex] = false;
+    MovingMask[SlotIndex] = false;
+    FreeSlots.Add(SlotIndex);
+    ActiveCount.Set(ActiveCount.Current - 1);
+
+    Handle.Reset();
+}
+
+/**
+ * @brief 句柄是否仍然指向有效单位
+ */
+bool USG_UnitRegistrySubsystem::IsHandleValid(const FSGUnitHandle& Handle) const
+{
+    return Handle.IsValid()
+        && ActiveMask.IsValidIndex(Handle.Index)
+        && ActiveMask[Handle.Index]
+        && Generations[Handle.Index] == Handle.Generation;
+}
+
+/**
+ * @brief 把句柄还原为单位指针
+ */
+ASG_UnitsBase* USG_UnitRegistrySubsystem::ResolveUnit(const FSGUnitHandle& Handle) const
+{
+    return IsHandleValid(Handle) ? Units[Handle.Index].Get() : nullptr;
+}
+
+/**
+ * @brief 获取阵营的紧凑索引
+ * @param FactionTag 阵营标签
+ * @return 阵营索引（首次出现时分配）
+ */
+uint8 USG_UnitRegistrySubsystem::GetFactionIndex(const FGameplayTag& FactionTag)
+{
+    int32 Index = FactionTags.IndexOfByKey(FactionTag);
+    if (Index == INDEX_NONE)
+    {
+        if (FactionTags.Num() >= MAX_uint8)
+        {
+            UE_LOG(LogSGUnit, Warning, TEXT("[单位注册表] 阵营数量超出上限，%s 归入索引 0"), *FactionTag.ToString());
+            return 0;
+        }
+        Index = FactionTags.Add(FactionTag);
+    }
+    return static_cast<uint8>(Index);
+}
+
+// ========== 移动追踪 ==========
+
+/**
+ * @brief 设置单位是否处于移动追踪状态
+ * @param Handle 单位句柄
+ * @param bMoving 是否正在向目标移动
+ * @param StuckSpeedThreshold 卡住速度阈值（厘米/秒）
+ * @param StuckTime 低于阈值持续多久判定为卡住（秒）
+ */
+void USG_UnitRegistrySubsystem::SetMoving(const FSGUnitHandle& Handle, bool bMoving, float StuckSpeedThreshold, float StuckTime)
+{
+    if (!IsHandleValid(Handle) || MovingMask[Handle.Index] == bMoving)
+    {
+        return;
+    }
+
+    MovingMask[Handle.Index] = bMoving;
+    StuckSpeedThresholds[Handle.Index] = StuckSpeedThreshold;
+    StuckTimes[Handle.Index] = StuckTime;
+    ResetSpeedHistory(Handle.Index);
+}
+
+/**
+ * @brief 清空某槽位的速度历史
+ */
+void USG_UnitRegistrySubsystem::ResetSpeedHistory(int32 SlotIndex)
+{
+    if (SpeedSampleCounts.IsValidIndex(SlotIndex))
+    {
+        SpeedSampleCounts[SlotIndex] = 0;
+        LowSpeedEvaluations[SlotIndex] = 0;
+        FMemory::Memzero(&SpeedHistory[SlotIndex * SpeedHistoryLength], SpeedHistoryLength * sizeof(float));
+    }
+}
+
+/**
+ * @brief 为所有移动中的槽位写入一次速度采样
+ * @details 只采样水平速度，下落、击飞等竖直运动不算移动
+ */
+void USG_UnitRegistrySubsystem::RecordSpeedSamples()
+{
+    for (TConstSetBitIterator<> It(MovingMask); It; ++It)
+    {
+        const int32 SlotIndex = It.GetIndex();
+        const ASG_UnitsBase* Unit = Units[SlotIndex].Get();
+        if (!Unit)
+        {
+            continue;
+        }
+
+        SpeedHistory[SlotIndex * SpeedHistoryLength + SpeedHistoryHead] = Unit->GetVelocity().Size2D();
+        SpeedSampleCounts[SlotIndex] = FMath::Min<uint8>(SpeedSampleCounts[SlotIndex] + 1, SpeedHistoryLength);
+    }
+
+    SpeedHistoryHead = (SpeedHistoryHead + 1) % SpeedHistoryLength;
+}
+
+// ========== Tick ==========
+
+/**
+ * @brief 每帧 Tick
+ * @param DeltaTime 帧间隔时间
+ * @details
+ * 功能说明：
+ * - 一次遍历刷新所有有效槽位
+ * - 单位被直接销毁（未走注销流程）时在这里回收槽位
+ */
+void USG_UnitRegistrySubsystem::Tick(float DeltaTime)
+{
+    // 遍历过程中不修改掩码，失效槽位先记录下来
+    TArray<int32, TInlineAllocator<8>> StaleSlots;
+
+    for (TConstSetBitIterator<> It(ActiveMask); It; ++It)
+    {
+        const int32 SlotIndex = It.GetIndex();
+        const ASG_UnitsBase* Unit = Units[SlotIndex].Get();
+        if (!Unit)
+        {
+            StaleSlots.Add(SlotIndex);
+            continue;
+        }
+
+        RefreshSlot(SlotIndex, Unit);
+    }
+
+    for (int32 SlotIndex : StaleSlots)
+    {
+        FSGUnitHandle StaleHandle;
+        StaleHandle.Index = SlotIndex;
+        StaleHandle.Generation = Generations[SlotIndex];
+        UnregisterUnit(StaleHandle);
+    }
+}
+
+/**
+ * @brief 刷新单个槽位
+ * @param SlotIndex 槽位索引
+ * @param Unit 单位
+ */
+void USG_UnitRegistrySubsystem::RefreshSlot(int32 SlotIndex, const ASG_UnitsBase* Unit)
+{
+    Positions[SlotIndex] = Unit->GetActorLocation();
+
+    if (Unit->AttributeSet)
+    {
+        Healths[SlotIndex] = Unit->AttributeSet->GetHealth();
+        AttackDamages[SlotIndex] = Unit->AttributeSet->GetAttackDamage();
+    }
+}
@@ -4,6 +4,9 @@
 #include "Units/SG_UnitsBase.h"
 
 #include "Debug/SG_LogCategories.h"
+#include "Debug/SG_Stats.h"
+#include "Debug/SG_Trace.h"
+#include "Debug/SG_DebugSubsystem.h" // ✨ 新增 - 批量调试叠加层
 #include "AbilitySystem/SG_AbilitySystemComponent.h"
 #include "AbilitySystem/SG_AttributeSet.h"
 #include "GameFramework/CharacterMovementComponent.h"  // 必须包含
@@ -20,6 +23,10 @@
 #include "AI/SG_AIControllerBase.h"
 #include "AI/SG_CombatTargetManager.h"
 #include "AI/SG_TargetingSubsystem.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "Units/SG_DeathEventHub.h"
+#include "Units/SG_UnitPoolSubsystem.h"
+#include "TimerManager.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Buildings/SG_MainCityBase.h"
 
@@ -274,7 +281,32 @@ UAbilitySystemComponent* ASG_UnitsBase::GetAbilitySystemComponent() const
 void ASG_UnitsBase::BeginPlay()
 {
 	 Super::BeginPlay();
-    
+
+    // ✨ 新增 - 预热单位直接进入池中，第一次出池时再初始化
+    if (bStartInPool)
+    {
+        bStartInPool = false;
+        bIsDead = true;
+        EnterPoolState();
+        return;
+    }
+
+    // 🔧 修改 - 初始化流程提取到 InitializeUnitState，对象池复用时同样调用
+    InitializeUnitState();
+}
+
+/**
+ * @brief 单位初始化流程
+ * @details
+ * 功能说明：
+ * - 加载数据表属性并应用卡牌倍率
+ * - 加载攻击技能、初始化冷却池、授予通用攻击能力
+ * - 注册到单位注册表
+ * 注意事项：
+ * - 只在属性未初始化（MaxHealth <= 0）时应用属性
+ */
+void ASG_UnitsBase::InitializeUnitState()
+{
     UE_LOG(LogSGGameplay, Log, TEXT("========== 单位生成：%s =========="), *GetName());
     
     // ========== 步骤1：检查是否已初始化 ==========
@@ -418,10 +450,305 @@ void ASG_UnitsBase::BeginPlay()
 	
     // ========== 步骤4：授予通用攻击能力 ==========
     GrantCommonAttackAbility();
+
+    // ✨ 新增 - 步骤5：注册到单位注册表（阵营和属性已确定）
+    if (USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>())
+    {
+        RegistryHandle = Registry->RegisterUnit(this);
+
+        // 控制器可能在注册前就已开始移动，补登记卡住检测
+        if (ASG_AIControllerBase* AICon = Cast<ASG_AIControllerBase>(GetController()))
+        {
+            Registry->SetMoving(RegistryHandle, AICon->GetTargetEngagementState() == ESGTargetEngagementState::Moving);
+        }
+    }
     
     UE_LOG(LogSGGameplay, Log, TEXT("========================================"));
 }
 
+/**
+ * @brief 结束运行
+ * @param EndPlayReason 结束原因
+ * @details 未经过死亡流程直接销毁的单位在这里从注册表注销
+ */
+void ASG_UnitsBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (RegistryHandle.IsValid())
+    {
+        if (USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>())
+        {
+            Registry->UnregisterUnit(RegistryHandle);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+// ========== ✨ 新增 - 对象池 ==========
+
+/**
+ * @brief 延迟移除单位
+ * @param Delay 延迟时间（秒）
+ */
+void ASG_UnitsBase::ScheduleRemoval(float Delay)
+{
+    if (bSpawnedFromPool)
+    {
+        GetWorldTimerManager().SetTimer(PoolReturnTimerHandle, this, &ASG_UnitsBase::ReturnToPoolOrDestroy, FMath::Max(Delay, 0.01f), false);
+    }
+    else
+    {
+        SetLifeSpan(Delay);
+    }
+}
+
+/**
+ * @brief 回收到对象池，池已满时销毁
+ */
+void ASG_UnitsBase::ReturnToPoolOrDestroy()
+{
+    USG_UnitPoolSubsystem* Pool = GetWorld()->GetSubsystem<USG_UnitPoolSubsystem>();
+    if (!Pool || !Pool->ReleaseUnit(this))
+    {
+        Destroy();
+    }
+}
+
+/**
+ * @brief 停用并放入对象池
+ * @details
+ * 详细流程：
+ * 1. 存活单位（预热）先按死亡处理：注销注册表、冻结并解除控制器
+ * 2. 释放能力、效果和标签
+ * 3. 恢复网格体（布娃娃），通知子类和蓝图（ReceiveDeactivatedForPool）
+ * 4. 隐藏并关闭碰撞和 Tick
+ */
+void ASG_UnitsBase::DeactivateForPool()
+{
+    GetWorldTimerManager().ClearAllTimersForObject(this);
+
+    bIsDead = true;
+
+    if (RegistryHandle.IsValid())
+    {
+        if (USG_UnitRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USG_UnitRegistrySubsystem>())
+        {
+            Registry->UnregisterUnit(RegistryHandle);
+        }
+    }
+
+    if (AController* Ctrl = GetController())
+    {
+        if (ASG_AIControllerBase* AICon = Cast<ASG_AIControllerBase>(Ctrl))
+        {
+            AICon->FreezeAI();
+        }
+        Ctrl->UnPossess();
+    }
+
+    ForceStopAllActions();
+    ResetAbilitySystemForReuse();
+    RestoreMeshAfterRagdoll();
+
+    // ✨ 新增 - 通知子类和蓝图停止自身的运行时效果
+    OnDeactivatedForPool();
+    ReceiveDeactivatedForPool();
+
+    EnterPoolState();
+}
+
+/**
+ * @brief 标记为直接以池中状态生成
+ * @details 关闭自动附身 AI，并在 FinishSpawning 之前隐藏、关闭碰撞，避免在停车位置产生任何交互
+ */
+void ASG_UnitsBase::PrepareForPooledSpawn()
+{
+    bStartInPool = true;
+    AutoPossessAI = EAutoPossessAI::Disabled;
+    SetActorHiddenInGame(true);
+    SetActorEnableCollision(false);
+}
+
+/**
+ * @brief 进入池中状态：停止移动，隐藏并关闭碰撞和 Tick
+ */
+void ASG_UnitsBase::EnterPoolState()
+{
+    if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+    {
+        MoveComp->StopMovementImmediately();
+        MoveComp->DisableMovement();
+        MoveComp->SetComponentTickEnabled(false);
+    }
+
+    SetActorHiddenInGame(true);
+    SetActorEnableCollision(false);
+    SetActorTickEnabled(false);
+
+    bIsInPool = true;
+}
+
+/**
+ * @brief 从对象池中激活
+ * @param SpawnTransform 生成变换
+ * @param CardData 源卡牌数据
+ * @param InFactionTag 阵营标签
+ * @details
+ * 详细流程：
+ * 1. 恢复类默认的配置（基础属性、类型、阵营、AI 范围）并清空运行时状态
+ * 2. 恢复碰撞，按 AdjustIfPossibleButAlwaysSpawn 调整到不重叠的位置（与新生成一致），恢复移动和显示
+ * 3. 重置并重新附身控制器（无可用控制器时生成默认控制器）
+ * 4. 按 BeginPlay 相同流程初始化，再通知子类和蓝图（ReceiveActivatedFromPool）
+ */
+void ASG_UnitsBase::ActivateFromPool(const FTransform& SpawnTransform, USG_CharacterCardData* CardData, const FGameplayTag& InFactionTag)
+{
+    const ASG_UnitsBase* CDO = GetClass()->GetDefaultObject<ASG_UnitsBase>();
+
+    // ========== 步骤1：恢复配置和运行时状态 ==========
+    BaseHealth = CDO->BaseHealth;
+    BaseAttackDamage = CDO->BaseAttackDamage;
+    BaseMoveSpeed = CDO->BaseMoveSpeed;
+    BaseAttackSpeed = CDO->BaseAttackSpeed;
+    BaseAttackRange = CDO->BaseAttackRange;
+    VisionRange = CDO->VisionRange;
+    UnitTypeTag = CDO->UnitTypeTag;
+    CachedDetectionRange = CDO->CachedDetectionRange;
+    CachedChaseRange = CDO->CachedChaseRange;
+    FactionTag = InFactionTag.IsValid() ? InFactionTag : CDO->FactionTag;
+    SourceCardData = CardData;
+
+    CachedAttackAbilities.Reset();
+    AbilityCooldowns.Reset();
+    CurrentAttackIndex = 0;
+    bIsAttacking = false;
+    AttackAnimationRemainingTime = 0.0f;
+    AttackLockedTarget = nullptr;
+    CurrentAttackingTarget = nullptr;
+    CurrentTarget = nullptr;
+    RegistryHandle.Reset();
+
+    // 属性归零，InitializeUnitState 会按未初始化单位处理
+    if (AttributeSet)
+    {
+        AttributeSet->SetMaxHealth(0.0f);
+        AttributeSet->SetHealth(0.0f);
+    }
+
+    bIsInPool = false;
+    bIsDead = false;
+
+    // ========== 步骤2：恢复位置、碰撞、移动和显示 ==========
+    if (UCapsuleComponent* Capsule = GetCapsuleComponent())
+    {
+        Capsule->SetCollisionEnabled(CDO->GetCapsuleComponent()->GetCollisionEnabled());
+    }
+    SetActorEnableCollision(true);
+
+    // 与 SpawnActor 的 AdjustIfPossibleButAlwaysSpawn 相同：能找到不重叠的位置就调整，否则按原位置放置
+    FTransform AdjustedTransform = SpawnTransform;
+    FVector AdjustedLocation = SpawnTransform.GetLocation();
+    FRotator AdjustedRotation = SpawnTransform.Rotator();
+    if (GetWorld()->FindTeleportSpot(this, AdjustedLocation, AdjustedRotation))
+    {
+        AdjustedTransform.SetLocation(AdjustedLocation);
+    }
+    SetActorTransform(AdjustedTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+    if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+    {
+        MoveComp->SetComponentTickEnabled(true);
+        MoveComp->SetDefaultMovementMode();
+        MoveComp->Velocity = FVector::ZeroVector;
+    }
+
+    SetActorHiddenInGame(false);
+    SetActorTickEnabled(true);
+
+    // ========== 步骤3：重新附身控制器 ==========
+    AutoPossessAI = CDO->AutoPossessAI;
+    if (AController* Ctrl = LastController.Get())
+    {
+        if (ASG_AIControllerBase* AICon = Cast<ASG_AIControllerBase>(Ctrl))
+        {
+            AICon->ResetForReuse();
+        }
+        Ctrl->Possess(this);
+    }
+    else
+    {
+        SpawnDefaultController();
+    }
+
+    // ========== 步骤4：初始化 ==========
+    InitializeUnitState();
+    OnActivatedFromPool();
+
+    // ✨ 新增 - 蓝图 BeginPlay 不会再次执行，由蓝图事件重新初始化
+    ReceiveActivatedFromPool();
+}
+
+/**
+ * @brief 清空能力系统（能力、效果、标签、属性回调）
+ */
+void ASG_UnitsBase::ResetAbilitySystemForReuse()
+{
+    GrantedCommonAttackHandle = FGameplayAbilitySpecHandle();
+    GrantedSpecificAbilities.Empty();
+
+    if (!AbilitySystemComponent)
+    {
+        return;
+    }
+
+    AbilitySystemComponent->CancelAllAbilities();
+    AbilitySystemComponent->ClearAllAbilities();
+
+    // 移除所有激活的效果
+    FGameplayEffectQuery AllEffectsQuery;
+    AllEffectsQuery.CustomMatchDelegate.BindLambda([](const FActiveGameplayEffect&) { return true; });
+    AbilitySystemComponent->RemoveActiveEffects(AllEffectsQuery);
+
+    // 效果移除后剩下的都是松散标签
+    FGameplayTagContainer OwnedTags;
+    AbilitySystemComponent->GetOwnedGameplayTags(OwnedTags);
+    for (const FGameplayTag& Tag : OwnedTags)
+    {
+        AbilitySystemComponent->SetLooseGameplayTagCount(Tag, 0);
+    }
+
+    // 复用时 InitializeCharacter 会重新绑定
+    if (AttributeSet)
+    {
+        AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AttributeSet->GetHealthAttribute()).RemoveAll(this);
+    }
+}
+
+/**
+ * @brief 恢复网格体（关闭布娃娃并重新附着到胶囊体）
+ */
+void ASG_UnitsBase::RestoreMeshAfterRagdoll()
+{
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    if (!MeshComp)
+    {
+        return;
+    }
+
+    const ACharacter* CDO = GetClass()->GetDefaultObject<ACharacter>();
+
+    MeshComp->SetAllBodiesSimulatePhysics(false);
+    MeshComp->SetSimulatePhysics(false);
+    MeshComp->SetCollisionProfileName(CDO->GetMesh()->GetCollisionProfileName());
+    MeshComp->SetCollisionEnabled(CDO->GetMesh()->GetCollisionEnabled());
+    MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+    MeshComp->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+
+    if (UAnimInstance* AnimInstance = MeshComp->GetAnimInstance())
+    {
+        AnimInstance->StopAllMontages(0.0f);
+    }
+}
+
 
 /**
  * @brief 初始化技能冷却池
@@ -480,6 +807,9 @@ int32 ASG_UnitsBase::GetBestAvailableAbilityIndex() const
 void ASG_UnitsBase::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
+
+	// ✨ 新增 - 记录控制器，对象池复用时重新附身
+	LastController = NewController;
 	
 	// 初始化 ASC（服务器端）
 	if (AbilitySystemComponent)
@@ -652,6 +982,8 @@ void ASG_UnitsBase::OnDeath_Implementation()
     
     // 设置死亡标记
     bIsDead = true;
+
+    SG_TRACE_EVENT(UnitDied, this);
     
     UE_LOG(LogSGGameplay, Log, TEXT("========== %s 执行死亡逻辑 =========="), *GetName());
 	// ✨ 新增 - 死亡时注销攻击者
@@ -659,13 +991,12 @@ void ASG_UnitsBase::OnDeath_Implementation()
 	{
 		OnStopAttackingTarget(CurrentAttackingTarget.Get());
 	}
-	// ✨ 新增 - 释放所有攻击槽位
+	// 🔧 修改 - 上报死亡事件中心：攻击槽位、攻击者计数和监听者通知统一批量处理，并从注册表注销
 	if (UWorld* World = GetWorld())
 	{
-		USG_CombatTargetManager* CombatManager = World->GetSubsystem<USG_CombatTargetManager>();
-		if (CombatManager)
+		if (USG_DeathEventHub* DeathHub = World->GetSubsystem<USG_DeathEventHub>())
 		{
-			CombatManager->ReleaseAllSlots(this);
+			DeathHub->NotifyUnitDied(this);
 		}
 	}
     // 步骤0：立即强制停止所有行为
@@ -757,9 +1088,9 @@ void ASG_UnitsBase::OnDeath_Implementation()
         DeathAnimDuration = 3.0f;
     }
 
-    // 步骤6：延迟销毁
-    SetLifeSpan(DeathAnimDuration);
-    UE_LOG(LogSGGameplay, Log, TEXT("  将在 %.1f 秒后销毁"), DeathAnimDuration);
+    // 🔧 修改 - 步骤6：延迟移除（对象池生成的单位回收，其他单位销毁）
+    ScheduleRemoval(DeathAnimDuration);
+    UE_LOG(LogSGGameplay, Log, TEXT("  将在 %.1f 秒后移除"), DeathAnimDuration);
     UE_LOG(LogSGGameplay, Log, TEXT("========================================"));
 }
 
@@ -1288,6 +1619,8 @@ bool ASG_UnitsBase::IsTargetValid() const
  */
 void ASG_UnitsBase::Tick(float DeltaTime)
 {
+	SG_SCOPE_CYCLE_COUNTER(UnitTick);
+
 	Super::Tick(DeltaTime);
     
     // ✨ 新增 - 更新技能冷却
@@ -1295,6 +1628,12 @@ void ASG_UnitsBase::Tick(float DeltaTime)
     
     // ✨ 新增 - 更新动画僵直状态
     UpdateAttackAnimationState(DeltaTime);
+
+    // ✨ 新增 - 批量调试叠加层启用时，范围圈和冷却文本由叠加层统一绘制（视野裁剪 + 数量上限）
+    if ((bShowAttackRange || bShowAbilityCooldowns || bShowSearchRange) && USG_DebugSubsystem::IsUnitOverlayActive(GetWorld()))
+    {
+        return;
+    }
     
     // 获取角色位置
     FVector ActorLocation = GetActorLocation();
@@ -1749,9 +2088,8 @@ float ASG_UnitsBase::GetAttackRangeForAI() const
  */
 bool ASG_UnitsBase::CanBeTargeted() const
 {
-	// 默认返回 true
-	// 普通单位总是可以被选为目标
-	return true;
+	// 🔧 修改 - 池中的单位不可被选为目标，其他普通单位总是可以
+	return !bIsInPool;
 }
 
 void ASG_UnitsBase::OnStartAttackingTarget(AActor* Target)
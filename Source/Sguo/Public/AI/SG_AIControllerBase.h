@@ -38,6 +38,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI")
     void FreezeAI();
 
+    // ✨ 新增 - 对象池复用
+    /**
+     * @brief 重置控制器状态，供对象池复用的单位重新附身前调用
+     * @details 清空黑板所有键、卡住状态和目标切换计时，恢复 Tick
+     */
+    void ResetForReuse();
+
     // ========== 行为树配置 ==========
     
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "AI", meta = (DisplayName = "默认行为树"))
@@ -132,12 +139,14 @@ public:
 
     /**
      * @brief 标记当前目标为不可达
+     * @details 写入全局可达性缓存，同一导航区域的其他单位共享该结论
      */
     UFUNCTION(BlueprintCallable, Category = "AI|Target", meta = (DisplayName = "标记目标不可达"))
     void MarkCurrentTargetUnreachable();
 
     /**
      * @brief 清除不可达目标列表
+     * @details 只清除当前单位所在导航区域的记录
      */
     UFUNCTION(BlueprintCallable, Category = "AI|Target", meta = (DisplayName = "清除不可达列表"))
     void ClearUnreachableTargets();
@@ -151,21 +160,27 @@ public:
     // ========== 移动状态检测 ==========
     
     /**
-     * @brief 检查是否卡住（移动超时）
+     * @brief 检查是否卡住
+     * @details 绕行后仍然卡住、且未能切换到其他目标时为 true，重置移动计时器后清除
      */
     UFUNCTION(BlueprintPure, Category = "AI|Movement", meta = (DisplayName = "是否卡住"))
     bool IsStuck() const;
 
     /**
      * @brief 重置移动计时器
+     * @details 清除卡住状态，并清空单位在卡住检测中的速度历史
      */
     UFUNCTION(BlueprintCallable, Category = "AI|Movement")
     void ResetMovementTimer();
 
     /**
-     * @brief 更新移动计时器
+     * @brief 卡住检测回调
+     * @details
+     * 由 USG_StuckDetectorSubsystem 调用：
+     * - 第一次卡住：尝试侧面绕行
+     * - 再次卡住：标记目标不可达并切换到其他可达目标
      */
-    void UpdateMovementTimer(float DeltaTime);
+    void OnStuckDetected();
 
     // ========== 主城特殊逻辑 ==========
     
@@ -238,28 +253,19 @@ private:
     UPROPERTY()
     ESGTargetEngagementState TargetEngagementState = ESGTargetEngagementState::Searching;
 
-    // 不可达目标列表
-    UPROPERTY()
-    TSet<TWeakObjectPtr<AActor>> UnreachableTargets;
+    // 是否判定为卡住（绕行无效后设置）
+    bool bStuckDetected = false;
 
-    // 移动计时器（检测卡住）
-    float MovementTimer = 0.0f;
-    FVector LastPosition = FVector::ZeroVector;
-    
-    // 卡住检测参数
+    // 当前目标连续卡住的次数
+    int32 StuckEventCount = 0;
+
+    // 卡住检测参数（开始移动时交给 USG_StuckDetectorSubsystem）
     UPROPERTY(EditDefaultsOnly, Category = "AI|Movement", meta = (DisplayName = "卡住判定时间"))
     float StuckThresholdTime = 1.0f;
     
     UPROPERTY(EditDefaultsOnly, Category = "AI|Movement", meta = (DisplayName = "移动距离阈值"))
     float MinMovementDistance = 50.0f;
 
-    // 不可达列表清理计时器
-    float UnreachableClearTimer = 0.0f;
-
-    //不可达清除间隔
-    UPROPERTY(EditDefaultsOnly, Category = "AI|Target", meta = (DisplayName = "不可达清理间隔"))
-    float UnreachableClearInterval = 5.0f;
-
     // ✨ 新增 - 目标切换检测计时器
     float TargetSwitchCheckTimer = 0.0f;
 };
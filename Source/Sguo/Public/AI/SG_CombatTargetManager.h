@@ -9,6 +9,7 @@
 #include "GameplayTagContainer.h"
 // ✨ 新增 - Tickable 接口，用于每帧绘制调试信息
 #include "Tickable.h"
+#include "Debug/SG_MemoryTracking.h"
 #include "SG_CombatTargetManager.generated.h"
 
 // 前置声明
@@ -235,6 +236,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat", meta = (DisplayName = "释放所有槽位"))
     void ReleaseAllSlots(ASG_UnitsBase* Attacker);
 
+    // ✨ 新增 - 批量死亡处理
+    /**
+     * @brief 批量处理本帧死亡的单位
+     * @param DeadUnits 死亡单位列表
+     * @details
+     * - 由 USG_DeathEventHub 每批调用一次
+     * - 一次遍历同时移除死亡目标的槽位记录、释放死亡攻击者占用的槽位
+     * - 替代每个单位死亡时各自调用 ReleaseAllSlots 的整表遍历
+     */
+    void HandleUnitsDied(const TArray<ASG_UnitsBase*>& DeadUnits);
+
     /**
      * @brief 检查目标是否有可用槽位
      * @param Target 目标 Actor
@@ -405,6 +417,25 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug|Display", meta = (DisplayName = "显示状态图例"))
     bool bShowLegend = true;
 
+    // ========== ✨ 新增 - 内存统计（SG.Mem.Dump） ==========
+
+    /** 当前记录的目标数 */
+    int32 GetTrackedTargetCount() const { return TargetCombatInfoMap.Num(); }
+
+    /** 记录的目标数峰值（高水位线） */
+    int32 GetPeakTrackedTargetCount() const { return TrackedTargetCount.Peak; }
+
+    /** 目标已失效但仍在表中的条目数（应为 0，持续增长说明清理遗漏） */
+    int32 CountStaleTargetEntries() const;
+
+    // ✨ 新增 - 性能面板
+    /**
+     * @brief 统计所有有效目标的攻击槽位
+     * @param OutUsed 输出：非空闲（预约或已到达）的槽位数
+     * @param OutTotal 输出：槽位总数
+     */
+    void GetSlotTotals(int32& OutUsed, int32& OutTotal) const;
+
 protected:
     /**
      * @brief 为目标初始化攻击槽位
@@ -465,4 +496,7 @@ private:
 
     // 清理计时器句柄
     FTimerHandle CleanupTimerHandle;
+
+    // ✨ 新增 - 记录的目标数及其峰值
+    FSGHighWaterMark TrackedTargetCount;
 };
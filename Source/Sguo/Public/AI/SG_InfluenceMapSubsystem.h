@@ -0,0 +1,235 @@
+// 📄 文件：Source/Sguo/Public/AI/SG_InfluenceMapSubsystem.h
+// ✨ 新增 - 阵营势力/威胁图
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "Tickable.h"
+#include "Tasks/Task.h"
+#include "SG_InfluenceMapSubsystem.generated.h"
+
+/**
+ * @brief 势力图采样（单位在某次快照中的贡献）
+ * @details 在游戏线程从单位注册表拷贝，交给工作线程使用
+ */
+struct FSGInfluenceSample
+{
+    // 注册表槽位索引
+    int32 SlotIndex = INDEX_NONE;
+
+    // 槽位代数（用于识别槽位被复用）
+    int32 Generation = 0;
+
+    // 所在格子索引
+    int32 CellIndex = INDEX_NONE;
+
+    // 阵营索引
+    uint8 FactionIndex = 0;
+
+    // 势力值（生命值 × 攻击力）
+    float Strength = 0.0f;
+};
+
+/**
+ * @brief 阵营势力/威胁图（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 把战场划分为低分辨率网格，每个阵营一层，格子值 = 该格内单位的 生命值 × 攻击力 之和
+ * - 数据来源于单位注册表，不遍历场景单位
+ * - 增量更新：只有换格子、属性变化、死亡的单位才会修改格子
+ * - 更新在工作线程执行，完成后在游戏线程发布到只读网格
+ * 使用方式：
+ * - 刷怪器通过 FindWeakestLocationInBox 补强薄弱区域
+ * - 寻敌系统通过 GetNormalizedThreatAt 偏好高威胁区域
+ * - 任何系统都可以通过 GetFactionInfluenceAt / GetThreatAt 查询
+ * 注意事项：
+ * - 查询接口只能在游戏线程调用，读取的是最近一次发布的数据
+ * - 网格范围外的单位不计入
+ */
+UCLASS()
+class SGUO_API USG_InfluenceMapSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // 最多支持的阵营层数
+    static constexpr int32 MaxFactionLayers = 4;
+
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 发布已完成的更新结果，并按间隔启动下一次更新
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_InfluenceMapSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return bEnableInfluenceMap; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 查询接口 ==========
+
+    /**
+     * @brief 获取指定阵营在某位置的势力值
+     * @param FactionTag 阵营标签
+     * @param Location 世界坐标
+     * @return 该格子的势力值（网格外返回 0）
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Influence", meta = (DisplayName = "获取阵营势力"))
+    float GetFactionInfluenceAt(FGameplayTag FactionTag, FVector Location) const;
+
+    /**
+     * @brief 获取某位置对指定阵营的威胁值
+     * @param ForFaction 被威胁的阵营
+     * @param Location 世界坐标
+     * @return 其他所有阵营在该格子的势力之和
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Influence", meta = (DisplayName = "获取威胁值"))
+    float GetThreatAt(FGameplayTag ForFaction, FVector Location) const;
+
+    /**
+     * @brief 获取归一化威胁值
+     * @param ForFaction 被威胁的阵营
+     * @param Location 世界坐标
+     * @return 0~1，相对于当前全图最大威胁
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Influence", meta = (DisplayName = "获取归一化威胁值"))
+    float GetNormalizedThreatAt(FGameplayTag ForFaction, FVector Location) const;
+
+    /**
+     * @brief 在区域内查找指定阵营最薄弱的位置
+     * @param FactionTag 阵营标签
+     * @param Area 查找区域
+     * @param OutLocation 输出：最薄弱格子中心（Z 取区域中心）
+     * @return 区域内有格子时返回 true
+     * @details 薄弱度 = 敌方威胁 - 己方势力，取最大值
+     */
+    UFUNCTION(BlueprintCallable, Category = "AI|Influence", meta = (DisplayName = "查找最薄弱位置"))
+    bool FindWeakestLocationInBox(FGameplayTag FactionTag, const FBox& Area, FVector& OutLocation) const;
+
+    /**
+     * @brief 已发布的数据版本（每次发布加一）
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Influence", meta = (DisplayName = "获取势力图版本"))
+    int32 GetPublishedVersion() const { return PublishedVersion; }
+
+    /**
+     * @brief 世界坐标转格子索引
+     * @return 网格外返回 INDEX_NONE
+     */
+    int32 GetCellIndex(const FVector& Location) const;
+
+    /**
+     * @brief 格子中心的世界坐标（Z 为 0）
+     */
+    FVector GetCellCenter(int32 CellIndex) const;
+
+    // ========== 配置 ==========
+
+    /** 是否启用势力图 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Influence Config", meta = (DisplayName = "启用势力图"))
+    bool bEnableInfluenceMap = true;
+
+    /** 更新间隔（秒） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Influence Config",
+        meta = (DisplayName = "更新间隔", ClampMin = "0.05", UIMin = "0.05", UIMax = "2.0"))
+    float UpdateInterval = 0.25f;
+
+    /** 网格原点（左下角，世界坐标 XY） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Influence Config", meta = (DisplayName = "网格原点"))
+    FVector2D GridOrigin = FVector2D(-25600.0, -25600.0);
+
+    /** 格子尺寸（厘米） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Influence Config",
+        meta = (DisplayName = "格子尺寸", ClampMin = "100.0", UIMin = "100.0"))
+    float CellSize = 800.0f;
+
+    /** 网格宽度（格子数） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Influence Config",
+        meta = (DisplayName = "网格宽度", ClampMin = "1", UIMin = "1", UIMax = "256"))
+    int32 GridWidth = 64;
+
+    /** 网格高度（格子数） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Influence Config",
+        meta = (DisplayName = "网格高度", ClampMin = "1", UIMin = "1", UIMax = "256"))
+    int32 GridHeight = 64;
+
+protected:
+    /**
+     * @brief 从单位注册表拷贝快照，并在工作线程启动增量更新
+     */
+    void LaunchUpdate();
+
+    /**
+     * @brief 工作线程：把快照增量应用到工作网格
+     * @param Samples 本次快照
+     */
+    void ApplySamples(const TArray<FSGInfluenceSample>& Samples);
+
+    /**
+     * @brief 游戏线程：把工作网格发布到只读网格
+     */
+    void PublishWorkingGrid();
+
+    /**
+     * @brief 按当前配置分配网格
+     */
+    void AllocateGrids();
+
+    /**
+     * @brief 读取某阵营层在某格子的值（只读网格）
+     */
+    float GetPublishedValue(int32 FactionLayer, int32 CellIndex) const
+    {
+        return PublishedGrid[FactionLayer * CellCount + CellIndex];
+    }
+
+private:
+    // 格子总数
+    int32 CellCount = 0;
+
+    // 只读网格（游戏线程查询），布局：[阵营层][格子]
+    TArray<float> PublishedGrid;
+
+    // 每个阵营层的最大威胁值（发布时计算）
+    float PublishedMaxThreat[MaxFactionLayers] = {};
+
+    // 已发布的数据版本
+    int32 PublishedVersion = 0;
+
+    // ========== 工作线程独占数据（任务进行中时游戏线程不访问） ==========
+
+    // 工作网格，布局同 PublishedGrid
+    TArray<float> WorkingGrid;
+
+    // 每个槽位上一次的贡献（按注册表槽位索引）
+    TArray<FSGInfluenceSample> PreviousContributions;
+
+    // 本次快照访问过的槽位标记
+    TBitArray<> VisitedSlots;
+
+    // 进行中的更新任务
+    UE::Tasks::FTask PendingTask;
+
+    // 是否有等待发布的结果
+    bool bResultPending = false;
+
+    // 更新计时器
+    float UpdateTimer = 0.0f;
+};
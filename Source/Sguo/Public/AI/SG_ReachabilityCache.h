@@ -0,0 +1,155 @@
+// 📄 文件：Source/Sguo/Public/AI/SG_ReachabilityCache.h
+// ✨ 新增 - 全局可达性缓存
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SG_ReachabilityCache.generated.h"
+
+// 前置声明
+class ANavigationData;
+class ARecastNavMesh;
+class ASG_UnitsBase;
+
+/**
+ * @brief 可达性缓存键
+ * @details 同一导航区域内的单位共享“某目标不可达”的结论
+ */
+USTRUCT()
+struct FSGReachabilityKey
+{
+    GENERATED_BODY()
+
+    // 查询者所在的导航区域（导航网格 Tile 坐标）
+    FIntPoint Region = FIntPoint::ZeroValue;
+
+    // 目标
+    TWeakObjectPtr<AActor> Target;
+
+    bool operator==(const FSGReachabilityKey& Other) const
+    {
+        return Region == Other.Region && Target == Other.Target;
+    }
+
+    friend uint32 GetTypeHash(const FSGReachabilityKey& Key)
+    {
+        return HashCombine(GetTypeHash(Key.Region), GetTypeHash(Key.Target));
+    }
+};
+
+/**
+ * @brief 全局可达性缓存（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 替代每个 AI 控制器各自维护的不可达列表
+ * - 按（查询者所在导航区域，目标）记录不可达结论，并带有过期时间
+ * - 寻路失败、卡住判定时写入；导航网格重建完成后整体失效
+ * - 寻敌系统在评估候选目标前先查询缓存，避免重复发起注定失败的寻路
+ * 注意事项：
+ * - 导航区域使用 Recast 导航网格的 Tile 坐标；没有 Recast 导航网格时按 RegionSize 划分
+ * - 主城不会被记录为不可达
+ */
+UCLASS()
+class SGUO_API USG_ReachabilityCache : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== 查询接口 ==========
+
+    /**
+     * @brief 标记目标从某位置不可达
+     * @param FromLocation 查询者位置
+     * @param Target 目标
+     */
+    void MarkUnreachable(const FVector& FromLocation, AActor* Target);
+
+    /**
+     * @brief 检查目标从某位置是否已知不可达
+     * @param FromLocation 查询者位置
+     * @param Target 目标
+     * @return 有未过期的不可达记录时返回 true
+     */
+    bool IsUnreachable(const FVector& FromLocation, const AActor* Target) const;
+
+    /**
+     * @brief 清除某导航区域内的所有记录
+     * @param FromLocation 区域内任意位置
+     */
+    void ClearRegion(const FVector& FromLocation);
+
+    /**
+     * @brief 清除某目标的所有记录
+     * @details 单位回收进对象池时调用（同一个 Actor 复用后不能继承上一次的不可达记录）
+     */
+    void ClearTarget(const AActor* Target);
+
+    /**
+     * @brief 批量清除本帧死亡单位的记录
+     * @param DeadUnits 死亡单位列表
+     * @details 一次遍历移除所有死亡目标的记录（由 USG_DeathEventHub 调用）
+     */
+    void HandleUnitsDied(const TArray<ASG_UnitsBase*>& DeadUnits);
+
+    /**
+     * @brief 清空缓存
+     */
+    UFUNCTION(BlueprintCallable, Category = "AI|Reachability", meta = (DisplayName = "清空可达性缓存"))
+    void InvalidateAll();
+
+    /**
+     * @brief 获取当前记录数量
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Reachability", meta = (DisplayName = "获取不可达记录数"))
+    int32 GetEntryCount() const { return Entries.Num(); }
+
+    // ========== 配置 ==========
+
+    /** 不可达记录的有效时间（秒） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reachability Config",
+        meta = (DisplayName = "记录有效时间", ClampMin = "0.5", UIMin = "0.5", UIMax = "30.0"))
+    float EntryLifetime = 5.0f;
+
+    /** 没有 Recast 导航网格时的区域尺寸（厘米） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reachability Config",
+        meta = (DisplayName = "区域尺寸", ClampMin = "100.0", UIMin = "100.0"))
+    float RegionSize = 1000.0f;
+
+protected:
+    /**
+     * @brief 位置转导航区域坐标
+     */
+    FIntPoint GetRegion(const FVector& Location) const;
+
+    /**
+     * @brief 清理过期和失效的记录
+     */
+    void CleanupExpiredEntries();
+
+    /**
+     * @brief 导航数据生成完成回调（动态重建后触发）
+     */
+    void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+private:
+    // 键 -> 过期时间（世界时间，秒）
+    TMap<FSGReachabilityKey, double> Entries;
+
+    // 用于计算 Tile 坐标的导航网格
+    TWeakObjectPtr<ARecastNavMesh> CachedNavMesh;
+
+    // 清理计时器
+    FTimerHandle CleanupTimerHandle;
+
+    // 导航重建委托句柄
+    FDelegateHandle NavGenerationFinishedHandle;
+};
@@ -1,5 +1,5 @@
 ﻿// 📄 文件：Source/Sguo/Public/AI/SG_StationaryAIController.h
-// ✨ 新增 - 站桩单位专用 AI 控制器
+// 🔧 修改 - 支持由炮台组管理器统一驱动
 // ✅ 这是完整文件
 
 #pragma once
@@ -21,6 +21,7 @@ class ASG_UnitsBase;
  * - 不使用攻击槽位系统
  * - 只在攻击范围内查找目标
  * - 目标死亡后自动切换下一个
+ * - ✨ 新增 - 默认注册到 USG_StationaryBatterySubsystem，由炮台组统一寻敌和攻击，本控制器不再 Tick
  * 使用场景：
  * - 主城弓手
  * - 箭塔
@@ -122,6 +123,15 @@ public:
         meta = (DisplayName = "AI 启用"))
     bool bAIEnabled = true;
 
+    // ========== ✨ 新增 - 炮台组管理 ==========
+
+    /**
+     * @brief 是否由炮台组管理器驱动
+     * @return 为 true 时本控制器不 Tick，寻敌和攻击由 USG_StationaryBatterySubsystem 统一执行
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Stationary", meta = (DisplayName = "是否由炮台组管理"))
+    bool IsManagedByBattery() const { return bManagedByBattery; }
+
 protected:
     /**
      * @brief 目标死亡回调
@@ -162,4 +172,7 @@ private:
 
     // 目标检测计时器
     float TargetDetectionTimer = 0.0f;
+
+    // ✨ 新增 - 是否由炮台组管理器驱动
+    bool bManagedByBattery = false;
 };
@@ -0,0 +1,161 @@
+// 📄 文件：Source/Sguo/Public/AI/SG_StationaryBatterySubsystem.h
+// ✨ 新增 - 站桩单位炮台组管理器
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "Tickable.h"
+#include "SG_StationaryBatterySubsystem.generated.h"
+
+// 前置声明
+class ASG_StationaryUnit;
+class ASG_StationaryAIController;
+class ASG_UnitsBase;
+
+/**
+ * @brief 炮台组中的单个炮台
+ * @details 记录站桩单位及其控制器，控制器仍负责目标状态与攻击执行
+ */
+USTRUCT()
+struct FSGBatteryTurret
+{
+    GENERATED_BODY()
+
+    // 站桩单位
+    UPROPERTY()
+    TWeakObjectPtr<ASG_StationaryUnit> Unit;
+
+    // 站桩单位的控制器
+    UPROPERTY()
+    TWeakObjectPtr<ASG_StationaryAIController> Controller;
+};
+
+/**
+ * @brief 站桩单位炮台组管理器（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 统一驱动所有站桩单位，替代每个控制器各自 Tick 和球形检测
+ * - 每个检测间隔内，同阵营的站桩单位按空间分簇，每簇只做一次球形检测
+ * - 批量分配目标，按攻击者数量分散火力
+ * - 每帧统一触发攻击
+ * 使用方式：
+ * - 站桩 AI 控制器在 OnPossess 时自动注册，在 OnUnPossess 时自动注销
+ * - 注册后控制器的 Tick 被关闭
+ * 注意事项：
+ * - bEnableBatteryManager 关闭时，站桩控制器回退到原来的逐单位逻辑
+ */
+UCLASS()
+class SGUO_API USG_StationaryBatterySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 按间隔执行批量寻敌，并每帧触发攻击
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_StationaryBatterySubsystem, STATGROUP_Tickables);
+    }
+
+    /**
+     * @brief 是否可以 Tick（没有炮台时不 Tick）
+     */
+    virtual bool IsTickable() const override { return Turrets.Num() > 0; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 注册接口 ==========
+
+    /**
+     * @brief 注册站桩单位
+     * @param Controller 站桩单位的控制器
+     * @return 是否由炮台组接管（接管后控制器不再 Tick）
+     */
+    bool RegisterTurret(ASG_StationaryAIController* Controller);
+
+    /**
+     * @brief 注销站桩单位
+     * @param Controller 站桩单位的控制器
+     */
+    void UnregisterTurret(ASG_StationaryAIController* Controller);
+
+    /**
+     * @brief 请求在下一帧立即执行一次寻敌
+     * @details 目标死亡时调用，同一帧内多次请求只会执行一次检测
+     */
+    void RequestImmediateSweep() { bSweepRequested = true; }
+
+    /**
+     * @brief 获取已注册的炮台数量
+     */
+    UFUNCTION(BlueprintPure, Category = "AI|Battery", meta = (DisplayName = "获取炮台数量"))
+    int32 GetTurretCount() const { return Turrets.Num(); }
+
+    // ========== 配置 ==========
+
+    /** 是否启用炮台组管理（关闭后站桩控制器各自运行） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Battery Config", meta = (DisplayName = "启用炮台组管理"))
+    bool bEnableBatteryManager = true;
+
+    /** 批量寻敌间隔（秒） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Battery Config",
+        meta = (DisplayName = "寻敌间隔", ClampMin = "0.1", UIMin = "0.1", UIMax = "2.0"))
+    float SweepInterval = 0.5f;
+
+    /**
+     * @brief 火力分散系数
+     * @details 目标每多一个攻击者，有效距离放大的比例（0 表示只选最近目标）
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Battery Config",
+        meta = (DisplayName = "火力分散系数", ClampMin = "0.0", UIMin = "0.0", UIMax = "2.0"))
+    float FireSpreadPenalty = 0.35f;
+
+protected:
+    /**
+     * @brief 对所有阵营执行一次批量寻敌
+     */
+    void SweepAllBatteries();
+
+    /**
+     * @brief 对单个阵营的炮台按簇执行球形检测并分配目标
+     * @param FactionTag 阵营标签
+     * @param TurretIndices 该阵营炮台在 Turrets 中的索引
+     */
+    void SweepBattery(const FGameplayTag& FactionTag, const TArray<int32>& TurretIndices);
+
+    /**
+     * @brief 每帧更新炮台：校验目标并触发攻击
+     */
+    void UpdateTurretAttacks();
+
+private:
+    // 所有已注册的炮台
+    UPROPERTY()
+    TArray<FSGBatteryTurret> Turrets;
+
+    // 批量寻敌计时器
+    float SweepTimer = 0.0f;
+
+    // 是否请求立即寻敌
+    bool bSweepRequested = false;
+
+    // 阵营 -> 炮台索引（每次寻敌时复用，避免重复分配）
+    TMap<FGameplayTag, TArray<int32>> FactionBuckets;
+};
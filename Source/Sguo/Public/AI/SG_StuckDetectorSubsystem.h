@@ -0,0 +1,83 @@
+// 📄 文件：Source/Sguo/Public/AI/SG_StuckDetectorSubsystem.h
+// ✨ 新增 - 集中式卡住检测
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SG_StuckDetectorSubsystem.generated.h"
+
+/**
+ * @brief 集中式卡住检测（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 替代每个单位的卡住检测服务和控制器内的移动计时器
+ * - 按固定间隔为所有移动中的单位记录一次水平速度（存放在单位注册表的环形缓冲中）
+ * - 同一次遍历中评估所有单位：窗口内最大速度低于阈值即为低速，连续低速达到判定时间即判定为卡住
+ * - 卡住时通知单位的 AI 控制器（ASG_AIControllerBase::OnStuckDetected）
+ * 注意事项：
+ * - 只有处于 Moving 状态的单位会被追踪（由控制器在切换状态时登记）
+ * - 速度阈值和判定时间来自控制器的 MinMovementDistance / StuckThresholdTime（登记时写入注册表）
+ * - 判定窗口 = 采样间隔 × USG_UnitRegistrySubsystem::SpeedHistoryLength，判定时间短于窗口时按窗口计算
+ */
+UCLASS()
+class SGUO_API USG_StuckDetectorSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 到达采样间隔时记录速度并评估所有移动中的单位
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_StuckDetectorSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return bEnableStuckDetection; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 配置 ==========
+
+    /** 是否启用卡住检测 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stuck Config", meta = (DisplayName = "启用卡住检测"))
+    bool bEnableStuckDetection = true;
+
+    /** 速度采样间隔（秒） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stuck Config",
+        meta = (DisplayName = "采样间隔", ClampMin = "0.05", UIMin = "0.05", UIMax = "0.5"))
+    float SampleInterval = 0.125f;
+
+    /** 控制器未提供阈值时使用的卡住速度阈值（厘米/秒） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stuck Config",
+        meta = (DisplayName = "默认卡住速度阈值", ClampMin = "0.0", UIMin = "0.0", UIMax = "100.0"))
+    float StuckSpeedThreshold = 10.0f;
+
+protected:
+    /**
+     * @brief 评估所有移动中的单位，通知卡住的单位
+     */
+    void EvaluateMovingUnits();
+
+private:
+    // 采样计时器
+    float SampleTimer = 0.0f;
+
+    // 本次评估中卡住的槽位（复用，避免重复分配）
+    TArray<int32> StuckSlots;
+};
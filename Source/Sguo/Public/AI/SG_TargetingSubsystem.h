@@ -236,6 +236,14 @@ public:
     UFUNCTION(BlueprintPure, Category = "Targeting", meta = (DisplayName = "获取攻击者数量"))
     int32 GetAttackerCount(AActor* Target) const;
 
+    // ✨ 新增 - 批量死亡处理
+    /**
+     * @brief 批量处理本帧死亡的单位
+     * @param DeadUnits 死亡单位列表
+     * @details 一次遍历移除死亡目标的记录和死亡攻击者（由 USG_DeathEventHub 调用）
+     */
+    void HandleUnitsDied(const TArray<ASG_UnitsBase*>& DeadUnits);
+
     /**
      * @brief 检查目标是否已满（达到最大攻击者数量）
      * @param Target 目标
@@ -261,6 +269,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting Config", meta = (DisplayName = "距离权重"))
     float DistanceWeight = 1.0f;
 
+    /**
+     * @brief 高威胁区域偏好
+     * @details 目标所在格子的归一化威胁值（来自势力图）对评分的加成比例，0 表示不考虑
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting Config",
+        meta = (DisplayName = "高威胁区域偏好", ClampMin = "0.0", UIMin = "0.0", UIMax = "2.0"))
+    float ThreatPreferenceWeight = 0.0f;
+
     /**
      * @brief 默认最大攻击者数量
      * @details 每个目标最多被多少单位同时攻击
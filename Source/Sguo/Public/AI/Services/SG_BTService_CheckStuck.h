@@ -1,5 +1,5 @@
 ﻿// 📄 文件：Source/Sguo/Public/AI/Services/SG_BTService_CheckStuck.h
-// ✨ 新增 - 检测卡住服务
+// 🔧 修改 - 卡住检测移至 USG_StuckDetectorSubsystem，本服务不再 Tick
 
 #pragma once
 
@@ -8,12 +8,11 @@
 #include "SG_BTService_CheckStuck.generated.h"
 
 /**
- * @brief 检测卡住服务
+ * @brief 检测卡住服务（已废弃）
  * @details
  * 功能说明：
- * - 定期检测单位是否卡住
- * - 卡住时自动切换到可达目标
- * - 只在移动状态下生效
+ * - 卡住检测已由 USG_StuckDetectorSubsystem 对所有移动中的单位统一执行
+ * - 保留此节点只为兼容已有行为树资源，可以安全地从行为树中移除
  */
 UCLASS()
 class SGUO_API USG_BTService_CheckStuck : public UBTService
@@ -25,12 +24,4 @@ public:
 	 * @brief 构造函数
 	 */
 	USG_BTService_CheckStuck();
-
-	/**
-	 * @brief Tick 更新
-	 * @param OwnerComp 行为树组件
-	 * @param NodeMemory 节点内存
-	 * @param DeltaSeconds 时间间隔
-	 */
-	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 };
@@ -111,6 +111,32 @@ protected:
     // 执行召唤逻辑
     void ExecuteSpawn();
 
+    // ✨ 新增 - 召唤单位生成完成
+    /**
+     * @brief 生成调度器完成回调：通知蓝图，动画已结束时结束能力
+     */
+    void OnSummonSpawnCompleted(const TArray<ASG_UnitsBase*>& SpawnedUnits, int32 SpawnSerial);
+
+    /**
+     * @brief 召唤的单位全部生成完成（蓝图子类可在此为召唤物添加效果）
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Summon", meta = (DisplayName = "召唤单位生成完成"))
+    void K2_OnUnitsSummoned(const TArray<ASG_UnitsBase*>& SpawnedUnits);
+
+    /**
+     * @brief 动画结束时结束能力；正常结束且单位仍在分帧生成时，等生成完成后再结束
+     */
+    void FinishSummon(bool bWasCancelled);
+
+    // 是否有尚未生成完的召唤请求
+    bool bSpawnPending = false;
+
+    // 每次提交召唤递增（上一次激活遗留的回调不影响本次）
+    int32 CurrentSpawnSerial = 0;
+
+    // 动画已结束，等待生成完成后结束能力
+    bool bEndAfterSpawn = false;
+
     // 辅助：从 UnitDataTable 获取蒙太奇
     UAnimMontage* FindMontageFromUnitData() const;
 
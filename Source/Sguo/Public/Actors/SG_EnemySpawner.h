@@ -17,6 +17,7 @@
 #include "GameFramework/Actor.h"
 #include "GameplayTagContainer.h"
 #include "CardsAndUnits/SG_CardRuntimeTypes.h" // 复用 FSGCardDrawSlot
+#include "CardsAndUnits/SG_WeightedCardSampler.h"
 #include "SG_EnemySpawner.generated.h"
 
 // 前向声明
@@ -26,6 +27,7 @@ class USG_CardDataBase;
 class ASG_UnitsBase;
 class UBillboardComponent;
 class ASG_MainCityBase;
+struct FStreamableHandle;
 
 /**
  * @brief 生成间隔模式
@@ -162,6 +164,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawner Location", meta = (DisplayName = "生成朝向"))
     FRotator SpawnRotation = FRotator(0.0f, 180.0f, 0.0f);
 
+    /**
+     * @brief 是否优先补强薄弱区域
+     * @details 开启后随机区域模式会查询势力图，在生成区域内己方势力最弱、敌方威胁最高的格子附近生成
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawner Location",
+        meta = (DisplayName = "优先补强薄弱区域", EditCondition = "LocationMode == ESGSpawnLocationMode::RandomInArea", EditConditionHides))
+    bool bReinforceWeakSections = false;
+
     // ========== 控制接口 ==========
 
     /**
@@ -183,6 +193,25 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Spawner Control")
     bool SpawnNextWave();
 
+    // ✨ 新增 - 指定卡牌和位置生成（性能基准、关卡脚本使用）
+    /**
+     * @brief 在指定位置生成一张卡牌的单位
+     * @param CardData 卡牌数据（必须是角色卡）
+     * @param Location 生成中心点（兵团以此为阵型中心）
+     * @return 是否提交了生成
+     * @details 不经过卡池抽卡，走与 SpawnNextWave 相同的兵团排布和分帧生成流程
+     */
+    UFUNCTION(BlueprintCallable, Category = "Spawner Control")
+    bool SpawnCardAt(USG_CardDataBase* CardData, const FVector& Location);
+
+    // ✨ 新增 - 外部指定随机种子（性能基准使用）
+    /**
+     * @brief 用指定种子重置生成器的随机流
+     * @param InSeed 随机种子
+     * @details 需在 BeginPlay 之后调用，否则会被 BeginPlay 中的时间戳种子覆盖
+     */
+    void SetRandomSeed(int32 InSeed) { RandomStream.Initialize(InSeed); }
+
 protected:
     // ========== 内部逻辑 ==========
 
@@ -226,6 +255,16 @@ private:
     UPROPERTY(Transient)
     TArray<FSGCardDrawSlot> SpawnPool;
 
+    // ✨ 新增 - 生成池槽位对应的卡牌数据（与 SpawnPool 一一对应）
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<USG_CardDataBase>> SpawnPoolCards;
+
+    // ✨ 新增 - 生成池的权重采样器
+    FSGWeightedCardSampler SpawnPoolSampler;
+
+    // ✨ 新增 - 生成池卡牌的 Gameplay 资产包加载句柄
+    TSharedPtr<FStreamableHandle> SpawnPoolAssetHandle;
+
     // 已使用的唯一卡牌 ID
     UPROPERTY(Transient)
     TSet<FPrimaryAssetId> ConsumedUniqueCards;
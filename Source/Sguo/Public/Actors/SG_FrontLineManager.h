@@ -290,6 +290,13 @@ public:
     UFUNCTION(BlueprintPure, Category = "Front Line", meta = (WorldContext = "WorldContextObject", DisplayName = "获取前线管理器"))
     static ASG_FrontLineManager* GetFrontLineManager(UObject* WorldContextObject);
 
+    // ✨ 新增 - 外部立即刷新（微基准、调试工具使用）
+    /**
+     * @brief 立即重新扫描最前方单位
+     * @details 不等待 RescanInterval 定时器，结果与定时扫描相同
+     */
+    void ForceRescan() { RescanFrontmostUnits(); }
+
 
     /**
      * @brief 单位死亡回调
@@ -335,7 +342,7 @@ protected:
     /**
      * @brief 绑定单位死亡事件
      * @param Unit 要绑定的单位
-     * @details 将 OnUnitDeath 函数绑定到单位的死亡委托
+     * @details 通过 USG_DeathEventHub 监听单位死亡，回调 OnUnitDeath
      */
     UFUNCTION()
     void BindUnitDeathEvent(ASG_UnitsBase* Unit);
@@ -343,7 +350,7 @@ protected:
     /**
      * @brief 解绑单位死亡事件
      * @param Unit 要解绑的单位
-     * @details 从单位的死亡委托中移除 OnUnitDeath 函数
+     * @details 从 USG_DeathEventHub 取消监听
      */
     UFUNCTION()
     void UnbindUnitDeathEvent(ASG_UnitsBase* Unit);
@@ -49,6 +49,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Placement")
     FRotator GetPreviewRotation() const { return PreviewRotation; }
 
+    // ✨ 新增 - 地面拾取是否使用战场高度图（仅检测静态地面且开启高度图时）
+    bool UsesHeightfieldCache() const { return bOnlyTraceWorldStatic && bUseHeightfieldCache; }
+
     // 是否可以放置
     bool bCanPlace;
 
@@ -74,6 +77,14 @@ protected:
         meta = (DisplayName = "仅检测静态地面(WorldStatic)"))
     bool bOnlyTraceWorldStatic = true;
 
+    /**
+     * @brief ✨ 新增 - 是否使用战场高度图代替射线检测
+     * @details 仅在 bOnlyTraceWorldStatic 开启时生效；高度图范围外退回射线检测
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Detection|Optimization", 
+        meta = (DisplayName = "使用战场高度图", EditCondition = "bOnlyTraceWorldStatic"))
+    bool bUseHeightfieldCache = true;
+
     /**
      * @brief 地面检测通道
      * @details 当 bOnlyTraceWorldStatic 为 false 时使用此通道。
@@ -1057,6 +1057,13 @@ public:
     UFUNCTION(BlueprintPure, Category = "Projectile", meta = (DisplayName = "是否已命中目标"))
     bool HasHitTarget() const { return bHasHitTarget; }
 
+    // ✨ 新增 - 当前存活投射物数量（对局性能遥测使用）
+    /**
+     * @brief 获取当前存活的投射物数量
+     * @details 所有世界合计，只在游戏线程读取
+     */
+    static int32 GetActiveProjectileCount() { return ActiveProjectileCount; }
+
     /**
      * @brief 手动隐藏投射物网格体
      * @details 蓝图可调用，用于自定义隐藏时机
@@ -1071,5 +1078,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Projectile", meta = (DisplayName = "显示网格体"))
     void ShowProjectileMesh();
 
-
+private:
+    // ✨ 新增 - 当前存活的投射物数量（BeginPlay 加一，EndPlay 减一）
+    static int32 ActiveProjectileCount;
 };
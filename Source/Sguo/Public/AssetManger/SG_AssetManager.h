@@ -22,6 +22,63 @@
 #include "CoreMinimal.h"
 #include "Engine/AssetManager.h"
 #include "SG_AssetManager.generated.h"
+
+class USG_CardDataBase;
+
+// ✨ 新增 - 卡牌预加载统计
+/**
+ * @brief 卡牌预加载统计
+ */
+struct FSGCardPreloadStats
+{
+	// 发起的预加载次数
+	int32 PreloadRequests = 0;
+
+	// 使用卡牌时资产已加载完成的次数
+	int32 CacheHits = 0;
+
+	// 使用卡牌时资产仍未加载完成（或没有预加载）的次数
+	int32 CacheMisses = 0;
+
+	// 使用的卡牌没有 Gameplay 资产包（无可预加载的资产），不计入命中率
+	int32 NotPreloadable = 0;
+
+	// 因超出预算或卡牌离开卡池而释放的次数
+	int32 Releases = 0;
+
+	// 当前预加载资产的估算内存（字节）
+	int64 ResidentBytes = 0;
+
+	/** 命中率（0~1） */
+	float GetHitRate() const
+	{
+		const int32 Total = CacheHits + CacheMisses;
+		return Total > 0 ? static_cast<float>(CacheHits) / Total : 0.0f;
+	}
+};
+
+// ✨ 新增 - 同步加载检测
+/**
+ * @brief 禁止同步加载的作用域
+ * @details
+ * 功能说明：
+ * - 作用域内发生任何同步加载（LoadSynchronous、LoadObject 未命中内存等）时触发 ensure
+ * - 用于保护抽卡等游戏过程中的热路径，所需资产应在卡组初始化时异步加载完成
+ * 使用方式：
+ * - FSGScopedNoSyncLoad NoSyncLoad;
+ * - 控制台变量 SG.Asset.FlagSyncLoads 0 可以关闭检测
+ * 注意事项：
+ * - Shipping 版本不检测
+ */
+struct SGUO_API FSGScopedNoSyncLoad
+{
+	FSGScopedNoSyncLoad();
+	~FSGScopedNoSyncLoad();
+
+	/** 当前线程是否处于禁止同步加载的作用域内 */
+	static bool IsActive();
+};
+
 /**
  * @brief 自定义资产管理器类
  * 
@@ -52,6 +109,9 @@ public:
 	// 声明卡组主资产类型，统一 Deck 资产的类型引用
 	static const FPrimaryAssetType DeckAssetType;
 
+	// ✨ 新增 - 卡牌使用时需要的重资产包（卡牌数据中以 meta=(AssetBundles="Gameplay") 标记的软引用）
+	static const FName GameplayBundle;
+
 	/**
 	 * @brief 获取 AssetManager 单例
 	 * @return USGAssetManager* 单例指针
@@ -155,6 +215,8 @@ public:
 
 	/**
 	 * @brief 批量异步加载多个卡牌数据
+	 * @param CardIds 卡牌 ID 列表
+	 * @param Delegate 加载完成回调
 	 * @return TSharedPtr<FStreamableHandle> 加载句柄
 	 */
 	TSharedPtr<FStreamableHandle> LoadCardDataBatch(const TArray<FPrimaryAssetId>& CardIds, FStreamableDelegate Delegate);
@@ -201,10 +263,118 @@ public:
 	// 帮助函数：根据资产名构造卡组资产 ID
 	static FPrimaryAssetId MakeDeckAssetId(const FName& AssetName);
 
+	// ========== ✨ 新增 - 手牌预加载 ==========
+
+	/**
+	 * @brief 异步加载一组卡牌的 Gameplay 资产包
+	 * @param CardIds 卡牌 ID
+	 * @return 加载句柄；卡牌都没有 Gameplay 资产包时为空
+	 * @details 卡牌数据本身需已加载（卡组初始化时完成）；用于敌人生成器等不经过手牌的卡牌来源
+	 */
+	TSharedPtr<FStreamableHandle> LoadCardGameplayBundles(const TArray<FPrimaryAssetId>& CardIds);
+
+	/**
+	 * @brief 根据当前手牌更新预加载
+	 * @param HandCards 手牌中的卡牌数据
+	 * @details
+	 * 功能说明：
+	 * - 新进入手牌的卡牌：异步加载其 Gameplay 资产包（单位类、效果类、投射物类等软引用）
+	 * - 离开手牌的卡牌：保留为可回收，超出内存预算时按最久未使用的顺序释放资产包
+	 * 注意事项：
+	 * - 手牌中的卡牌不会因预算被释放
+	 * - 没有 Gameplay 资产包的卡牌不预加载，使用时计入 NotPreloadable，不影响命中率
+	 */
+	void UpdateHandPreloads(const TArray<USG_CardDataBase*>& HandCards);
+
+	/**
+	 * @brief 释放卡牌的预加载资产（卡牌离开卡池，如唯一卡牌被使用）
+	 * @param CardId 卡牌 ID
+	 */
+	void ReleaseCardPreload(const FPrimaryAssetId& CardId);
+
+	/**
+	 * @brief 使用卡牌时记录预加载命中情况
+	 * @param CardId 卡牌 ID
+	 */
+	void NotifyCardUsed(const FPrimaryAssetId& CardId);
+
+	/**
+	 * @brief 释放所有预加载资产
+	 */
+	void ReleaseAllCardPreloads();
+
+	/**
+	 * @brief 获取预加载统计
+	 */
+	const FSGCardPreloadStats& GetCardPreloadStats() const { return CardPreloadStats; }
+
+	/**
+	 * @brief 预加载内存预算（MB），在 DefaultGame.ini 的 [/Script/Sguo.SG_AssetManager] 中配置
+	 */
+	UPROPERTY(Config)
+	int32 CardPreloadBudgetMB = 256;
+
 protected:
 	virtual void StartInitialLoading() override;
 
 private:
+	// ✨ 新增 - 同步加载回调（检测禁止同步加载的作用域）
+	static void HandleSyncLoadPackage(const FString& PackageName);
+
+	// ✨ 新增 - 单张卡牌的预加载状态
+	struct FSGCardPreloadEntry
+	{
+		// Gameplay 资产包加载句柄（卡牌没有资产包时为空）
+		TSharedPtr<FStreamableHandle> AssetHandle;
+
+		// 估算内存（加载完成后计算一次）
+		int64 EstimatedBytes = 0;
+		bool bSizeMeasured = false;
+
+		// 最近一次在手牌中的时间
+		double LastUsedTime = 0.0;
+
+		// 是否在手牌中
+		bool bInHand = false;
+
+		// 🔧 修改 - 没有句柄表示没有可预加载的资产，不算加载完成
+		bool IsPreloadable() const
+		{
+			return AssetHandle.IsValid();
+		}
+
+		bool HasLoadCompleted() const
+		{
+			return AssetHandle.IsValid() && AssetHandle->HasLoadCompleted();
+		}
+	};
+
+	/**
+	 * @brief 开始预加载一张卡牌
+	 */
+	void PreloadCard(USG_CardDataBase* CardData, FSGCardPreloadEntry& Entry);
+
+	/**
+	 * @brief 释放一张卡牌的预加载资产
+	 */
+	void ReleaseCardPreloadEntry(const FPrimaryAssetId& CardId, FSGCardPreloadEntry& Entry);
+
+	/**
+	 * @brief 计算已加载完成的卡牌的内存，超出预算时释放最久未使用的非手牌卡牌
+	 */
+	void EnforceCardPreloadBudget();
+
+	/**
+	 * @brief 把预加载统计写入 stat Sguo 和 CSV（命中 / 未命中 / 命中率 / 占用内存）
+	 */
+	void PublishCardPreloadStats() const;
+
+	// 卡牌预加载状态
+	TMap<FPrimaryAssetId, FSGCardPreloadEntry> CardPreloads;
+
+	// 预加载统计
+	FSGCardPreloadStats CardPreloadStats;
+
 	// 当前的加载句柄
 	TSharedPtr<FStreamableHandle> CurrentLoadHandle;
 };
@@ -26,6 +26,8 @@
 #include "Components/ActorComponent.h"
 // 引入运行时卡牌类型
 #include "CardsAndUnits/SG_CardRuntimeTypes.h"
+// ✨ 新增 - 权重抽卡采样器
+#include "CardsAndUnits/SG_WeightedCardSampler.h"
 // 引入异步加载管理器
 #include "Engine/StreamableManager.h"
 // 引入卡组组件生成宏
@@ -42,6 +44,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSGCardHandChangedSignature, const T
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSGCardSelectionChangedSignature, const FGuid&, SelectedId);
 // 委托：行动可用状态变化（bCanAct, CooldownRemaining）
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSGCardActionStateSignature, bool, bCanAct, float, CooldownRemaining);
+// ✨ 新增 - 委托：冷却开始（世界时间戳，UI 本地插值倒计时）
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSGCardCooldownSignature, float, CooldownStartTime, float, CooldownEndTime);
 // 委托：卡牌被使用
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSGCardUsedSignature, const FSGCardInstance&, UsedCard);
 // ✨ NEW - 初始化完成委托
@@ -91,17 +95,18 @@ protected:
 		 */
 	virtual void BeginPlay() override;
 
-	/** 
-		 * @brief 每帧更新
-		 * @param DeltaTime 帧间隔时间
-		 * @param TickType Tick 类型
-		 * @param ThisTickFunction Tick 函数指针
-		 * @details
-		 * 功能说明：
-		 * - 更新冷却剩余时间
-		 * - 广播行动状态变化
-		 */
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	/**
+	 * @brief ✨ 新增 - 生命周期结束：释放手牌预加载资产
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * @brief ✨ 新增 - 手牌变化时更新预加载
+	 * @param NewHand 新手牌
+	 * @details 手牌中卡牌的单位类、效果类等重资产提前异步加载，避免第一次使用时卡顿
+	 */
+	UFUNCTION()
+	void HandleHandChangedForPreload(const TArray<FSGCardInstance>& NewHand);
 
 public:
 	/**
@@ -112,13 +117,13 @@ public:
 		 * - 构建抽牌池并抽取初始手牌
 		 * 详细流程：
 		 * 1. 检查是否已初始化或正在加载
-		 * 2. 加载卡组配置资产
+		 * 2. 🔧 修改 - 异步加载卡组配置资产（已在内存中则直接使用）
 		 * 3. 收集需要加载的卡牌资产 ID
-		 * 4. 通过 AssetManager 异步批量加载
+		 * 4. 通过 AssetManager 异步批量加载（包含 Gameplay / UI 资产包）
 		 * 5. 加载完成后调用 HandleCardAssetsLoaded
 		 * 注意事项：
 		 * - 避免重复初始化
-		 * - 异步加载期间不会阻塞主线程
+		 * - 整个初始化流程没有同步加载，加载完成前不会抽卡
 		 */
 	UFUNCTION(BlueprintCallable, Category = "CardDeck")
 	void InitializeDeck();
@@ -208,12 +213,25 @@ public:
 	 * @return 冷却剩余秒数
 	 * @details
 	 * 功能说明：
-	 * - 返回当前冷却剩余时间
+	 * - 🔧 修改 - 根据冷却结束时间戳和当前世界时间计算（不再每帧更新）
 	 * - 用于 UI 显示倒计时
 	 */
 	UFUNCTION(BlueprintCallable, Category = "CardDeck")
 	float GetCooldownRemaining() const;
 
+	/**
+	 * @brief ✨ 新增 - 获取冷却开始时间（世界时间，秒）
+	 */
+	UFUNCTION(BlueprintPure, Category = "CardDeck")
+	float GetCooldownStartTime() const { return CooldownStartTime; }
+
+	/**
+	 * @brief ✨ 新增 - 获取冷却结束时间（世界时间，秒）
+	 * @details UI 用 结束时间 - 当前世界时间 本地插值倒计时，不需要组件每帧广播
+	 */
+	UFUNCTION(BlueprintPure, Category = "CardDeck")
+	float GetCooldownEndTime() const { return CooldownEndTime; }
+
 	
 	/**
 	 * @brief 获取卡组配置
@@ -263,6 +281,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "CardDeck")
 	void ForceSyncState();
 
+	// ========== ✨ 新增 - 离线抽卡模拟（供 USG_DeckSimulationCommandlet 使用） ==========
+
+	/**
+	 * @brief 同步初始化卡组（不依赖世界、计时器和异步加载）
+	 * @param InDeckConfig 卡组配置
+	 * @param Seed 随机种子
+	 * @details 构建抽牌池并抽取初始手牌（包含保证卡牌），流程与 HandleCardAssetsLoaded 相同
+	 */
+	void InitializeForSimulation(USG_DeckConfig* InDeckConfig, int32 Seed);
+
+	/**
+	 * @brief 打出一张手牌（不检查冷却、不广播事件）
+	 * @param HandIndex 手牌索引
+	 * @return 是否成功
+	 */
+	bool PlayCardForSimulation(int32 HandIndex);
+
+	/**
+	 * @brief 抽一张牌加入手牌（不广播事件）
+	 * @return 是否成功
+	 */
+	bool DrawCardForSimulation();
+
+	/**
+	 * @brief 获取最近一次抽卡的概率和保底信息
+	 */
+	const FSGWeightedDrawInfo& GetLastDrawInfo() const { return LastDrawInfo; }
+
 public:
 	// 手牌更新广播
 	// 当手牌发生变化时触发（抽卡、使用卡牌）
@@ -280,6 +326,11 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "CardDeck")
 	FSGCardActionStateSignature OnActionStateChanged;
 
+	// ✨ 新增 - 冷却开始广播
+	// 冷却开始时广播一次开始/结束时间戳
+	UPROPERTY(BlueprintAssignable, Category = "CardDeck")
+	FSGCardCooldownSignature OnCooldownStarted;
+
 	// 卡牌使用广播
 	// 当卡牌被成功使用时触发
 	UPROPERTY(BlueprintAssignable, Category = "CardDeck")
@@ -309,6 +360,7 @@ protected:
 
 	// 当前抽牌池
 	// 存储所有可抽取的卡牌槽位（包括权重信息）
+	// 注意：未抽中槽位的 MissCount 由 DrawSampler 维护，不逐次写回
 	UPROPERTY(BlueprintReadOnly, Category = "CardDeck", meta = (AllowPrivateAccess = "true"))
 	TArray<FSGCardDrawSlot> DrawPile;
 
@@ -329,9 +381,18 @@ protected:
 	FGuid SelectedCardId;
 
 
-	// 当前冷却剩余时间
-	// 每帧更新，用于 UI 显示倒计时
+	// 🔧 修改 - 冷却开始/结束时间（世界时间，秒），替代每帧更新的冷却剩余时间
+	// 冷却开始时设置一次，UI 本地插值倒计时
+	UPROPERTY(BlueprintReadOnly, Category = "CardDeck", meta = (AllowPrivateAccess = "true"))
+	float CooldownStartTime = 0.0f;
+
 	UPROPERTY(BlueprintReadOnly, Category = "CardDeck", meta = (AllowPrivateAccess = "true"))
+	float CooldownEndTime = 0.0f;
+
+	// 🔧 修改 - 冷却剩余时间（已废弃）
+	// 组件不再 Tick，只在冷却开始/结束时更新；读取倒计时请调用 GetCooldownRemaining
+	UPROPERTY(BlueprintReadOnly, Category = "CardDeck",
+		meta = (AllowPrivateAccess = "true", DeprecatedProperty, DeprecationMessage = "只在冷却开始/结束时更新，请改用 GetCooldownRemaining"))
 	float CooldownRemaining = 0.0f;
 
 	// 行动是否可用
@@ -354,6 +415,13 @@ protected:
 	// 用于生成可重现的随机数（基于种子）
 	FRandomStream RandomStream;
 
+	// ✨ 新增 - 抽牌池的权重采样器
+	// 抽牌池构建/重新填充后重建，抽卡 O(log n)
+	FSGWeightedCardSampler DrawSampler;
+
+	// ✨ 新增 - 最近一次抽卡的概率和保底信息
+	FSGWeightedDrawInfo LastDrawInfo;
+
 	// 是否已经初始化
 	// 防止重复初始化
 	bool bInitialized = false;
@@ -367,6 +435,10 @@ protected:
 	// 用于管理异步加载流程
 	TSharedPtr<FStreamableHandle> CurrentLoadHandle;
 
+	// ✨ 新增 - 已加载的卡牌数据（构建抽牌池时缓存，抽卡时只查表不加载）
+	UPROPERTY(Transient)
+	TMap<FPrimaryAssetId, TObjectPtr<USG_CardDataBase>> LoadedCardData;
+
 
 	// 🔧 MODIFIED - 移除 CardCountMap，不再需要统计卡牌数量
 	// UPROPERTY(BlueprintReadOnly, Category = "CardDeck", meta = (AllowPrivateAccess = "true"))
@@ -415,11 +487,9 @@ protected:
 	 * - 使用权重随机系统抽取一张卡牌
 	 * - 支持保底机制，长期来看分布均匀
 	 * 详细流程：
-	 * 1. 收集所有可抽取的槽位（排除已消耗的唯一卡牌）
-	 * 2. 计算每个槽位的实际权重（基础权重 * 保底系数）
-	 * 3. 使用轮盘赌算法随机选择一个槽位
-	 * 4. 更新所有槽位的 MissCount（抽到的重置为 0，未抽到的 +1）
-	 * 5. 解析卡牌数据并构建实例
+	 * 1. 🔧 修改 - 通过 DrawSampler 按实际权重（基础权重 * 保底系数）选择槽位，O(log n)
+	 * 2. 采样器同时更新 MissCount（抽到的重置为 0，未抽到的 +1）和 OccurrenceCount
+	 * 3. 解析卡牌数据并构建实例
 	 * 6. 唯一卡牌加入消耗列表，非唯一卡牌加入弃牌堆
 	 * 注意事项：
 	 * - 实际权重 = DrawWeight * (1.0 + MissCount * 0.1)
@@ -446,6 +516,13 @@ protected:
 	 */
 	void RefillDrawPile();
 
+	/**
+	 * @brief ✨ 新增 - 处理已使用的卡牌
+	 * @param UsedCard 已使用的卡牌
+	 * @details 非唯一卡牌加入弃牌堆，唯一卡牌加入消耗列表
+	 */
+	void DiscardUsedCard(const FSGCardInstance& UsedCard);
+
 	/**
 	 * @brief 启动冷却
 	 * @details
@@ -455,8 +532,8 @@ protected:
 	 * 详细流程：
 	 * 1. 标记行动不可用
 	 * 2. 读取冷却时长（来自卡组配置）
-	 * 3. 启动计时器，到期后调用 CompleteCooldown
-	 * 4. 广播行动状态变化
+	 * 3. 记录开始/结束时间戳，启动计时器，到期后调用 CompleteCooldown
+	 * 4. 广播行动状态变化和冷却时间戳（各一次）
 	 * 注意事项：
 	 * - 如果冷却时长为 0，立即完成冷却
 	 */
@@ -482,6 +559,8 @@ protected:
 	 * 功能说明：
 	 * - 广播当前行动可用状态和冷却剩余时间
 	 * - 供 UI 更新显示
+	 * 注意事项：
+	 * - 🔧 修改 - 只在状态切换时调用（冷却开始/结束、初始化、强制同步），不再每帧广播
 	 */
 	void BroadcastActionState();
 
@@ -492,9 +571,9 @@ protected:
 	 * @details
 	 * 功能说明：
 	 * - 根据资产 ID 获取卡牌数据对象
-	 * - 优先从配置中查找，失败则从 AssetManager 加载
+	 * - 🔧 修改 - 从 LoadedCardData 缓存查找，失败则查询 AssetManager 中已加载的对象
 	 * 注意事项：
-	 * - 如果资产未加载，可能返回 nullptr
+	 * - 不会触发加载，资产未加载时返回 nullptr
 	 */
 	USG_CardDataBase* ResolveCardData(const FPrimaryAssetId& CardId);
 
@@ -517,6 +596,12 @@ protected:
 	 */
 	void HandleCardAssetsLoaded();
 
+	/**
+	 * @brief ✨ 新增 - 卡组配置加载完成回调
+	 * @details 设置随机种子，收集卡牌资产 ID 并开始异步批量加载
+	 */
+	void HandleDeckConfigLoaded();
+
 	/**
 	 * @brief 收集卡牌资产 ID
 	 * @return 需要加载的卡牌资产 ID 数组
@@ -526,6 +611,7 @@ protected:
 	 * - 去重，避免重复加载
 	 * 注意事项：
 	 * - 使用 TSet 去重，确保每个资产只加载一次
+	 * - 🔧 修改 - 通过软引用路径查询资产 ID，不加载卡牌
 	 */
 	TArray<FPrimaryAssetId> GatherCardAssetIds() const;
 
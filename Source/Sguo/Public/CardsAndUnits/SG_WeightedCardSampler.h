@@ -0,0 +1,183 @@
+// 📄 文件：Source/Sguo/Public/CardsAndUnits/SG_WeightedCardSampler.h
+// ✨ 新增 - 权重抽卡采样器（树状数组 + 增量保底权重）
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardsAndUnits/SG_CardRuntimeTypes.h"
+
+/**
+ * @brief 单次抽卡的统计信息
+ */
+struct FSGWeightedDrawInfo
+{
+	// 抽中槽位在本次抽卡中的概率
+	double Probability = 0.0;
+
+	// 抽中前的 MissCount
+	int32 MissCount = 0;
+
+	// 抽中时的保底倍率
+	double PityBonus = 1.0;
+
+	// 保底倍率是否已达上限
+	bool bPityCapped = false;
+};
+
+/**
+ * @brief 权重抽卡采样器
+ * @details
+ * 功能说明：
+ * - 替代"每次抽卡遍历全部槽位 + 线性轮盘赌"，抽卡复杂度 O(log n)
+ * - 实际权重与 FSGCardDrawSlot::GetEffectiveWeight 相同：DrawWeight × Min(1 + MissCount × PityMultiplier, PityMaxMultiplier)
+ * 详细流程：
+ * - 槽位的 MissCount 不再逐个 +1，而是记录"上次抽中时的抽卡序号"，MissCount = 当前序号 - 上次抽中序号
+ * - 保底未封顶时实际权重是抽卡序号 T 的线性函数：A + T × B
+ *   两棵树状数组分别维护 A 和 B，任意前缀和 = SumA + T × SumB
+ * - 每个槽位的封顶时刻可以提前算出，放入小顶堆；到达时把该槽位改为常数权重
+ * - 抽卡：一次随机数 + 树状数组下降查找第一个前缀和 ≥ 随机值的槽位（与原轮盘赌规则一致）
+ * 注意事项：
+ * - 每次抽卡只消耗一次 RandomStream，种子相同则结果完全相同
+ * - 槽位数组结构变化（增删、重新洗牌）后必须重新 Build
+ * - 未抽中槽位的 MissCount 字段不会逐次写回，需要时调用 SyncMissCounts
+ */
+class SGUO_API FSGWeightedCardSampler
+{
+public:
+	/**
+	 * @brief 根据槽位数组构建采样器
+	 * @param InSlots 槽位数组（采样器保存其指针，抽卡时更新被抽中槽位的计数）
+	 * @param ExcludedCards 不参与抽卡的卡牌（已消耗的唯一卡牌）
+	 */
+	void Build(TArray<FSGCardDrawSlot>& InSlots, const TSet<FPrimaryAssetId>& ExcludedCards);
+
+	/**
+	 * @brief 清空采样器
+	 */
+	void Reset();
+
+	/**
+	 * @brief 采样器是否与槽位数组匹配
+	 */
+	bool IsBuiltFor(const TArray<FSGCardDrawSlot>& InSlots) const { return Slots == &InSlots && SlotStates.Num() == InSlots.Num(); }
+
+	/**
+	 * @brief 抽取一个槽位
+	 * @param RandomStream 随机流
+	 * @param OutInfo 可选，本次抽卡的概率和保底信息
+	 * @return 抽中的槽位索引，没有可抽取槽位时返回 INDEX_NONE
+	 * @details 抽中的槽位 MissCount 清零、OccurrenceCount +1，其余可抽取槽位 MissCount +1
+	 */
+	int32 Draw(FRandomStream& RandomStream, FSGWeightedDrawInfo* OutInfo = nullptr);
+
+	/**
+	 * @brief 标记槽位被选中（保证卡牌等不经过随机的抽取）
+	 * @param SlotIndex 槽位索引
+	 * @details MissCount 清零、OccurrenceCount +1，不推进抽卡序号
+	 */
+	void MarkDrawn(int32 SlotIndex);
+
+	/**
+	 * @brief 排除某卡牌的所有槽位（唯一卡牌被消耗）
+	 * @param CardId 卡牌 ID
+	 */
+	void ExcludeCard(const FPrimaryAssetId& CardId);
+
+	/**
+	 * @brief 获取槽位当前的实际权重（不可抽取时为 0）
+	 */
+	double GetEffectiveWeight(int32 SlotIndex) const;
+
+	/**
+	 * @brief 获取所有可抽取槽位的总权重
+	 */
+	double GetTotalWeight() const;
+
+	/**
+	 * @brief 获取可抽取的槽位数量
+	 */
+	int32 GetEligibleCount() const { return EligibleCount; }
+
+	/**
+	 * @brief 获取槽位当前的 MissCount
+	 */
+	int32 GetMissCount(int32 SlotIndex) const;
+
+	/**
+	 * @brief 把所有槽位的 MissCount 写回槽位数组
+	 */
+	void SyncMissCounts() const;
+
+private:
+	// 单个槽位的采样状态
+	struct FSlotState
+	{
+		// 上次抽中时的抽卡序号
+		int64 LastHitDraw = 0;
+
+		// 当前权重：A + DrawCounter × B
+		double WeightA = 0.0;
+		double WeightB = 0.0;
+
+		// 是否可抽取
+		bool bEligible = false;
+	};
+
+	// 保底封顶事件
+	struct FCapEvent
+	{
+		int64 CapDraw = 0;
+		int32 SlotIndex = INDEX_NONE;
+		int64 LastHitDraw = 0;
+
+		bool operator<(const FCapEvent& Other) const { return CapDraw < Other.CapDraw; }
+	};
+
+	/**
+	 * @brief 根据槽位参数和上次抽中序号重新计算权重系数，并登记封顶事件
+	 */
+	void RefreshSlot(int32 SlotIndex);
+
+	/**
+	 * @brief 把槽位设为不可抽取（MissCount 冻结写回槽位）
+	 */
+	void RemoveSlot(int32 SlotIndex);
+
+	/**
+	 * @brief 处理已到达的封顶事件
+	 */
+	void ApplyCapEvents();
+
+	/**
+	 * @brief 修改槽位的权重系数（同步更新树状数组）
+	 */
+	void SetSlotWeight(int32 SlotIndex, double NewA, double NewB);
+
+	/**
+	 * @brief 查找第一个前缀和 ≥ Target 的槽位
+	 */
+	int32 FindSlotByWeight(double Target) const;
+
+	// 绑定的槽位数组
+	TArray<FSGCardDrawSlot>* Slots = nullptr;
+
+	// 槽位状态
+	TArray<FSlotState> SlotStates;
+
+	// 树状数组（下标从 1 开始）
+	TArray<double> TreeA;
+	TArray<double> TreeB;
+
+	// 树状数组下降查找的最高位
+	int32 TreeHighBit = 0;
+
+	// 封顶事件小顶堆
+	TArray<FCapEvent> CapEvents;
+
+	// 抽卡序号（每次 Draw +1）
+	int64 DrawCounter = 0;
+
+	// 可抽取槽位数量
+	int32 EligibleCount = 0;
+};
@@ -21,8 +21,9 @@ class SGUO_API USG_CharacterCardData : public USG_CardDataBase
 	// - TSubclassOf提供类型安全，只能选择AActor的子类
 	// - 在编辑器中有更好的选择器UI
 	// - 支持蓝图类和C++类
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character")
-	TSubclassOf<AActor> CharacterClass;
+	// 🔧 修改 - 改为软引用并归入 Gameplay 资产包：卡牌进入手牌时由 USG_AssetManager 异步加载
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character", meta = (AssetBundles = "Gameplay"))
+	TSoftClassPtr<AActor> CharacterClass;
 	
 	// 是否是兵团卡
 	// True：生成多个单位（兵团）
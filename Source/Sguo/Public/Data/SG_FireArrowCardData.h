@@ -104,9 +104,10 @@ public:
 	 * - 火箭投射物应该有燃烧视觉效果
 	 * - 可以配置落地后的 AOE 伤害
 	 */
+	// 🔧 修改 - 改为软引用并归入 Gameplay 资产包
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Fire Arrow Config", 
-		meta = (DisplayName = "火箭投射物类"))
-	TSubclassOf<AActor> FireArrowProjectileClass;
+		meta = (DisplayName = "火箭投射物类", AssetBundles = "Gameplay"))
+	TSoftClassPtr<AActor> FireArrowProjectileClass;
 
 	/**
 	 * @brief 火箭弧度高度（厘米）
@@ -163,9 +164,10 @@ public:
 	 * - 显示在地面的区域预览材质
 	 * - 建议使用半透明红色材质表示危险区域
 	 */
+	// 🔧 修改 - 改为软引用并归入 Gameplay 资产包
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Fire Arrow Visual", 
-		meta = (DisplayName = "预览区域材质"))
-	TObjectPtr<UMaterialInterface> PreviewAreaMaterial;
+		meta = (DisplayName = "预览区域材质", AssetBundles = "Gameplay"))
+	TSoftObjectPtr<UMaterialInterface> PreviewAreaMaterial;
 
 	/**
 	 * @brief 预览区域颜色
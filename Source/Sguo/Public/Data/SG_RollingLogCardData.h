@@ -132,7 +132,8 @@ public:
      * @brief 滚木 Actor 类
      * @details 要生成的滚木蓝图类
      */
+    // 🔧 修改 - 改为软引用并归入 Gameplay 资产包
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Rolling Log|Class", 
-        meta = (DisplayName = "滚木类"))
-    TSubclassOf<AActor> RollingLogClass;
+        meta = (DisplayName = "滚木类", AssetBundles = "Gameplay"))
+    TSoftClassPtr<AActor> RollingLogClass;
 };
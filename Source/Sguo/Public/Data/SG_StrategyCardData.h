@@ -52,8 +52,9 @@ public:
 	// 为什么用TSubclassOf<AActor>而不是具体类型：
 	// - 提供最大的灵活性，可以使用任何Actor
 	// - 效果Actor可能有不同的基类
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Strategy")
-	TSubclassOf<AActor> EffectActorClass;
+	// 🔧 修改 - 改为软引用并归入 Gameplay 资产包：卡牌进入手牌时由 USG_AssetManager 异步加载
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Strategy", meta = (AssetBundles = "Gameplay"))
+	TSoftClassPtr<AActor> EffectActorClass;
 	
 	// 要应用的GameplayEffect类
 	// 用于应用属性修改或状态效果（如增加伤害、减速等）
@@ -0,0 +1,209 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_BattleBenchmarkSubsystem.h
+// ✨ 新增 - 大规模战斗性能基准
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SG_BattleBenchmarkSubsystem.generated.h"
+
+class ASG_EnemySpawner;
+class USG_CharacterCardData;
+
+/**
+ * @brief 单个计时作用域的基准结果
+ */
+struct FSGBenchmarkScopeResult
+{
+    FString Name;
+    double TotalMs = 0.0;
+    uint64 Calls = 0;
+    double PerFrameMs = 0.0;
+    float BudgetMs = 0.0f;
+    bool bOverBudget = false;
+};
+
+/**
+ * @brief 一次基准的汇总结果
+ * @details ✨ 新增 - 供自动化测试读取，与 JSON 报告内容一致
+ */
+struct FSGBenchmarkSummary
+{
+    // 是否完整跑完采样（生成超时等失败时为 false）
+    bool bCompleted = false;
+    int32 TotalUnits = 0;
+    int32 Frames = 0;
+    float AvgGameThreadMs = 0.0f;
+    float P95GameThreadMs = 0.0f;
+    float MaxGameThreadMs = 0.0f;
+    // 是否找到了对应单位数的帧时间预算
+    bool bHasFrameBudget = false;
+    float AvgBudgetMs = 0.0f;
+    float P95BudgetMs = 0.0f;
+    bool bFramePassed = false;
+    bool bScopesPassed = false;
+    bool bPassed = false;
+    TArray<FSGBenchmarkScopeResult> Scopes;
+};
+
+/**
+ * @brief 大规模战斗性能基准（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 用固定种子生成 N 对 N 的两支军队（近战、远程、立定弓手兵团），让其自行交战 T 秒
+ * - 单位通过 ASG_EnemySpawner::SpawnCardAt 生成，与正式游戏走相同的兵团排布、分帧生成和对象池路径
+ * - 采样每帧帧时间、游戏线程耗时和存活单位数，并汇总 SG_SCOPE_CYCLE_COUNTER 各作用域的耗时
+ * - 与 USG_DebugSettings 中的预算比较，结果写入 Saved/Benchmarks 下的 JSON（汇总）和 CSV（逐帧）
+ * 详细流程：
+ * 1. Spawning：放置双方生成器并提交全部兵团，等待分帧生成调度器清空
+ * 2. Warmup：等待预热时长，排除生成尖峰
+ * 3. Capture：开启 FSGScopeTimer 采集，逐帧记录 T 秒
+ * 4. 输出报告；命令行启动时按是否超预算返回退出码（0 通过，1 超预算，2 配置错误）
+ * 使用方式：
+ * - 无渲染批量运行：UnrealEditor-Cmd.exe Sguo.uproject /Game/Map/Lvl_TestDown -game -nullrhi -nosound -unattended
+ *   -benchmark -fps=30 -SGBenchmark -SGBenchmarkUnits=500 -SGBenchmarkSeconds=30 -SGBenchmarkSeed=1337 [-SGBenchmarkTag=<提交号>] [-SGBenchmarkOut=<目录>]
+ * - 游戏中：控制台 SG.Benchmark.Run <每方单位数> <秒数> <种子>
+ * - 标准档位为每方 100 / 500 / 1000 单位（-SGBenchmarkUnits=100|500|1000），
+ *   对应 Config/DefaultGame.ini 中总单位数 200 / 1000 / 2000 的三档预算
+ * 注意事项：
+ * - 标准地图为 /Game/Map/Lvl_TestDown（项目默认地图）；军队以世界原点为中心、沿 X 轴对阵，
+ *   换用其他地图时只需要原点附近有一块平地（地面吸附检测范围与敌人生成器相同）
+ * - 种子只固定军队组成、站位和双方生成器的随机流，不重置全局 FMath::Rand；
+ *   以下战斗细节仍使用未播种的全局随机，同一种子的两次运行不会逐帧一致：
+ *   - 行为树服务的执行间隔抖动（UpdateTarget / DetectNearbyThreats 的 RandomDeviation，引擎内部使用 FMath）
+ *   - 投射物区域随机落点（ASG_Projectile::GenerateRandomPointInCircle / Rectangle / Sector）
+ *   - 单位避让权重（ASG_UnitsBase::InitializeUnitState 中随机）和站桩单位策略技能的落点偏移
+ *   此外战斗按实际帧间隔推进，帧时间波动本身也会改变交战顺序。
+ *   因此基准只比较统计量（平均、P95），比较提交前后时应各跑多次取中位数，不要比较逐帧 CSV
+ * - 自动化测试 Sguo.Perf.BattleBenchmark 以最小档位驱动本子系统并断言预算（见 SG_BattleBenchmarkTest.cpp）
+ * - Shipping 包不创建该子系统
+ */
+UCLASS()
+class SGUO_API USG_BattleBenchmarkSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_BattleBenchmarkSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return Phase != EPhase::Idle; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 基准接口 ==========
+
+    /**
+     * @brief 开始一次基准
+     * @param UnitsPerSide 每方单位数（兵团按整队生成，实际数量可能略多）
+     * @param DurationSeconds 采样时长（秒）
+     * @param Seed 随机种子
+     * @return 是否成功开始（已在运行或没有可用卡牌时失败）
+     */
+    UFUNCTION(BlueprintCallable, Category = "Debug|Benchmark", meta = (DisplayName = "开始战斗性能基准"))
+    bool StartBenchmark(int32 UnitsPerSide = 500, float DurationSeconds = 30.0f, int32 Seed = 1337);
+
+    /**
+     * @brief 是否正在运行
+     */
+    UFUNCTION(BlueprintPure, Category = "Debug|Benchmark", meta = (DisplayName = "性能基准运行中"))
+    bool IsRunning() const { return Phase != EPhase::Idle; }
+
+    /**
+     * @brief 获取最近一次基准的汇总结果
+     * @details ✨ 新增 - 开始新基准时清空；未跑完时 bCompleted 为 false
+     */
+    const FSGBenchmarkSummary& GetLastSummary() const { return LastSummary; }
+
+private:
+    enum class EPhase : uint8
+    {
+        Idle,
+        Spawning,
+        Warmup,
+        Capture
+    };
+
+    // 逐帧采样
+    struct FFrameSample
+    {
+        float FrameMs = 0.0f;
+        float GameThreadMs = 0.0f;
+        int32 AliveUnits = 0;
+    };
+
+    /**
+     * @brief 放置一方的生成器并提交该方全部兵团
+     * @return 实际提交的单位数
+     */
+    int32 SpawnArmy(int32 SideIndex, const TArray<USG_CharacterCardData*>& Cards, const TArray<float>& CardWeights);
+
+    /**
+     * @brief 开始采样
+     */
+    void BeginCapture();
+
+    /**
+     * @brief 结束采样：汇总、比较预算、输出报告
+     */
+    void FinishBenchmark();
+
+    /**
+     * @brief 写出 JSON 汇总和 CSV 逐帧数据
+     */
+    void WriteReports(const TArray<FSGBenchmarkScopeResult>& ScopeResults, float AvgMs, float P95Ms, float MaxMs,
+        float AvgBudgetMs, float P95BudgetMs, bool bPassed) const;
+
+    /**
+     * @brief 以退出码结束进程（仅命令行启动时）
+     */
+    void ExitIfRequested(int32 ExitCode) const;
+
+    // 当前阶段
+    EPhase Phase = EPhase::Idle;
+
+    // 本次参数
+    int32 UnitsPerSide = 0;
+    float DurationSeconds = 0.0f;
+    int32 Seed = 0;
+    FString RunTag;
+    FString OutputDir;
+
+    // 是否由命令行启动（结束后退出进程）
+    bool bExitWhenDone = false;
+
+    // 固定种子随机流
+    FRandomStream RandomStream;
+
+    // 双方生成器
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<ASG_EnemySpawner>> Spawners;
+
+    // 实际提交的单位数
+    int32 SpawnedUnitCount = 0;
+
+    // 阶段计时
+    double PhaseStartTime = 0.0;
+    double LastFrameTime = 0.0;
+
+    // 逐帧采样
+    TArray<FFrameSample> Samples;
+
+    // 最近一次基准的汇总结果
+    FSGBenchmarkSummary LastSummary;
+};
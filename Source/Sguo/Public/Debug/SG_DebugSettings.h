@@ -26,7 +26,36 @@
 #include "SG_DebugSettings.generated.h"
 
 // 前向声明
+class USG_CharacterCardData;
 
+// ✨ 新增 - 性能基准帧时间预算
+/**
+ * @brief 性能基准的帧时间预算
+ * @details 按总单位数选择：取第一条 UnitCount ≥ 实际总单位数的预算（按 UnitCount 升序配置）
+ */
+USTRUCT(BlueprintType)
+struct FSGBenchmarkBudget
+{
+	GENERATED_BODY()
+
+	FSGBenchmarkBudget() = default;
+	FSGBenchmarkBudget(int32 InUnitCount, float InAvgGameThreadMs, float InP95GameThreadMs)
+		: UnitCount(InUnitCount), AvgGameThreadMs(InAvgGameThreadMs), P95GameThreadMs(InP95GameThreadMs)
+	{
+	}
+
+	// 适用的最大总单位数（双方合计）
+	UPROPERTY(Config, EditAnywhere, Category = "Benchmark", meta = (DisplayName = "总单位数上限", ClampMin = "1"))
+	int32 UnitCount = 200;
+
+	// 游戏线程平均耗时预算（毫秒）
+	UPROPERTY(Config, EditAnywhere, Category = "Benchmark", meta = (DisplayName = "游戏线程平均(ms)", ClampMin = "0.0"))
+	float AvgGameThreadMs = 8.0f;
+
+	// 游戏线程 P95 耗时预算（毫秒）
+	UPROPERTY(Config, EditAnywhere, Category = "Benchmark", meta = (DisplayName = "游戏线程P95(ms)", ClampMin = "0.0"))
+	float P95GameThreadMs = 12.0f;
+};
 
 /**
  * @brief 调试系统配置
@@ -164,6 +193,179 @@ public:
 		meta = (DisplayName = "自动监听新单位"))
 	bool bAutoAddToNewUnits = true;
 
+	// ✨ 新增 - 批量调试叠加层
+
+	/**
+	 * @brief 使用单画布批量叠加层
+	 * @details
+	 * 功能说明：
+	 * - 开启：启用调试显示时不再为每个单位创建 UWidgetComponent，
+	 *   由调试子系统在一次画布绘制中投影所有单位的调试信息（含单位的范围圈和冷却文本）
+	 * - 关闭：沿用逐单位 Widget 的旧方式
+	 * 注意事项：
+	 * - 数百单位时逐单位 Widget 本身就是瓶颈，建议保持开启
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "调试显示", 
+		meta = (DisplayName = "使用批量叠加层"))
+	bool bUseBatchedOverlay = true;
+
+	/**
+	 * @brief 叠加层每帧最多绘制的单位数
+	 * @details
+	 * - 视野内的单位按距离排序，只绘制最近的若干个
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "调试显示", 
+		meta = (DisplayName = "叠加层每帧单位上限", ClampMin = "1", UIMin = "1", UIMax = "1000", EditCondition = "bUseBatchedOverlay"))
+	int32 OverlayMaxUnitsPerFrame = 150;
+
+	/**
+	 * @brief 叠加层详细信息距离
+	 * @details
+	 * - 距离摄像机小于该值：名字、生命值文本、详细属性、冷却
+	 * - 大于该值：只绘制血条
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "调试显示", 
+		meta = (DisplayName = "叠加层详细信息距离", ClampMin = "0.0", UIMin = "0.0", UIMax = "10000.0", EditCondition = "bUseBatchedOverlay"))
+	float OverlayDetailDistance = 2500.0f;
+
+	/**
+	 * @brief 叠加层最大绘制距离（超出不绘制）
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "调试显示", 
+		meta = (DisplayName = "叠加层最大距离", ClampMin = "0.0", UIMin = "0.0", UIMax = "50000.0", EditCondition = "bUseBatchedOverlay"))
+	float OverlayMaxDistance = 12000.0f;
+
+	// ========== ✨ 新增 - 性能基准配置 ==========
+
+	/**
+	 * @brief 基准使用的近战兵团卡
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "近战卡牌"))
+	TSoftObjectPtr<USG_CharacterCardData> BenchmarkMeleeCard;
+
+	/**
+	 * @brief 基准使用的远程兵团卡
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "远程卡牌"))
+	TSoftObjectPtr<USG_CharacterCardData> BenchmarkRangedCard;
+
+	/**
+	 * @brief 基准使用的立定弓手卡
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "立定弓手卡牌"))
+	TSoftObjectPtr<USG_CharacterCardData> BenchmarkStationaryCard;
+
+	/**
+	 * @brief 双方军队的间距（厘米）
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "两军间距", ClampMin = "500.0"))
+	float BenchmarkArmySpacing = 4000.0f;
+
+	/**
+	 * @brief 每支军队的阵型宽度（厘米）
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "军队宽度", ClampMin = "500.0"))
+	float BenchmarkArmyWidth = 6000.0f;
+
+	/**
+	 * @brief 预热时长（秒）
+	 * @details 所有单位生成完毕后再等待该时长才开始采样，排除生成和首次加载的尖峰
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "预热时长", ClampMin = "0.0"))
+	float BenchmarkWarmupSeconds = 3.0f;
+
+	/**
+	 * @brief 帧时间预算（按总单位数升序）
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "帧时间预算"))
+	TArray<FSGBenchmarkBudget> BenchmarkBudgets = {
+		{ 200, 8.0f, 12.0f },
+		{ 1000, 16.0f, 24.0f },
+		{ 2000, 33.0f, 45.0f }
+	};
+
+	/**
+	 * @brief 各计时作用域的每帧平均耗时预算（毫秒）
+	 * @details 键为 SG_SCOPE_CYCLE_COUNTER 的名字（如 UnitTick），未配置的作用域只记录不检查
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能基准", meta = (DisplayName = "作用域预算(ms)"))
+	TMap<FName, float> BenchmarkScopeBudgetsMs;
+
+	// ========== ✨ 新增 - 对局遥测配置 ==========
+
+	/**
+	 * @brief 是否采集对局性能遥测
+	 * @details 开启后每局结束（主城被摧毁）时写出 Saved/Telemetry/SGMatch_*.json；命令行 -SGTelemetry 也可开启
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "对局遥测", meta = (DisplayName = "启用对局遥测"))
+	bool bEnableMatchTelemetry = false;
+
+	/**
+	 * @brief 帧时间预算（毫秒）
+	 * @details 报告中统计超过该值的帧数
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "对局遥测", meta = (DisplayName = "帧时间预算(ms)", ClampMin = "1.0"))
+	float TelemetryFrameBudgetMs = 33.3f;
+
+	/**
+	 * @brief 报告中列出的最慢帧数量
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "对局遥测", meta = (DisplayName = "最慢帧数量", ClampMin = "0", ClampMax = "100"))
+	int32 TelemetrySlowFrameCount = 10;
+
+	// ========== ✨ 新增 - 性能面板 ==========
+
+	/**
+	 * @brief 是否在开局时显示战斗性能面板
+	 * @details
+	 * - 运行时可用控制台 SG.PerfHud [0|1] 切换
+	 * - 编辑器 PIE 中同样生效
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能面板", meta = (DisplayName = "显示性能面板"))
+	bool bShowPerfHud = false;
+
+	/**
+	 * @brief 采样间隔（秒）
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能面板", meta = (DisplayName = "采样间隔", ClampMin = "0.02", ClampMax = "2.0"))
+	float PerfHudSampleInterval = 0.1f;
+
+	/**
+	 * @brief 曲线保留的采样数
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能面板", meta = (DisplayName = "曲线长度", ClampMin = "10", ClampMax = "600"))
+	int32 PerfHudHistoryLength = 120;
+
+	/**
+	 * @brief AI 分档距离：近档上限（到摄像机的距离）
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能面板", meta = (DisplayName = "近档距离", ClampMin = "0.0"))
+	float PerfHudNearDistance = 3000.0f;
+
+	/**
+	 * @brief AI 分档距离：中档上限，超过为远档
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能面板", meta = (DisplayName = "远档距离", ClampMin = "0.0"))
+	float PerfHudFarDistance = 10000.0f;
+
+	/**
+	 * @brief 各曲线的预算线
+	 * @details
+	 * - 键：Units（每方单位）、AI（每档 AI）、TargetQueries（每帧查询）、CandidatesPerQuery、
+	 *   SlotOccupancy（槽位占用百分比）、Projectiles、SpawnQueue
+	 * - 没有配置的曲线不画预算线
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "性能面板", meta = (DisplayName = "预算线"))
+	TMap<FName, float> PerfHudBudgets = {
+		{ FName(TEXT("Units")), 400.0f },
+		{ FName(TEXT("AI")), 300.0f },
+		{ FName(TEXT("TargetQueries")), 200.0f },
+		{ FName(TEXT("CandidatesPerQuery")), 50.0f },
+		{ FName(TEXT("SlotOccupancy")), 90.0f },
+		{ FName(TEXT("Projectiles")), 300.0f },
+		{ FName(TEXT("SpawnQueue")), 100.0f }
+	};
+
 public:
 	// ========== UDeveloperSettings 接口 ==========
 	
@@ -9,6 +9,7 @@
  * - 全局管理所有单位的调试显示
  * - 自动监听单位生成事件
  * - 为新生成的单位自动添加调试 Widget
+ * - ✨ 新增 - 批量叠加层模式：不创建 Widget，一次画布绘制投影所有单位（视野裁剪、按距离分级、每帧数量上限）
  * 详细流程：
  * 1. 从配置类读取设置参数
  * 2. 监听世界中的 Actor 生成事件
@@ -33,6 +34,8 @@
 class USG_UnitDebugWidget;
 class ASG_UnitsBase;
 class UWidgetComponent;
+class UCanvas;
+class APlayerController;
 
 /**
  * @brief 调试子系统
@@ -232,6 +235,18 @@ public:
 		meta = (DisplayName = "是否启用调试显示"))
 	bool IsDebugDisplayEnabled() const { return bDebugDisplayEnabled; }
 
+	// ✨ 新增 - 批量叠加层
+
+	/**
+	 * @brief 批量叠加层是否正在绘制该世界的单位调试信息
+	 * @param World 世界
+	 * @return 叠加层已启用
+	 * @details
+	 * 功能说明：
+	 * - 单位 Tick 据此跳过自身的 DrawDebugCircle / DrawDebugString，改由叠加层统一绘制
+	 */
+	static bool IsUnitOverlayActive(const UWorld* World);
+
 protected:
 	// ========== 生命周期 ==========
 	
@@ -349,6 +364,12 @@ protected:
 	 */
 	FDelegateHandle ActorSpawnedDelegateHandle;
 
+	// ✨ 新增 - 叠加层绘制委托句柄（UDebugDrawService，"Game" 显示标记）
+	FDelegateHandle OverlayDrawHandle;
+
+	// ✨ 新增 - 叠加层候选单位（距离平方, 注册表槽位），跨帧复用避免分配
+	TArray<TPair<float, int32>> OverlayCandidates;
+
 private:
 	// ========== 内部辅助函数 ==========
 	
@@ -442,4 +463,31 @@ private:
 	 * - 避免悬空指针导致崩溃
 	 */
 	void StopListeningForUnitSpawns();
+
+	// ✨ 新增 - 批量叠加层
+
+	/**
+	 * @brief 注册 / 注销叠加层绘制
+	 */
+	void StartUnitOverlay();
+	void StopUnitOverlay();
+
+	/**
+	 * @brief 叠加层绘制（每帧一次，整批单位在同一画布中绘制）
+	 * @param Canvas 画布
+	 * @param PlayerController 玩家控制器（未使用）
+	 * @details
+	 * 详细流程：
+	 * 1. 遍历单位注册表，按最大距离和视锥裁剪
+	 * 2. 按距离排序，只保留最近的 OverlayMaxUnitsPerFrame 个
+	 * 3. 近处单位：名字、血条、生命值、详细属性、冷却、范围圈；远处单位：只画血条
+	 * 4. 左上角输出 绘制数 / 视野内数 / 总数
+	 */
+	void DrawUnitOverlay(UCanvas* Canvas, APlayerController* PlayerController);
+
+	/**
+	 * @brief 在画布上绘制地面圆圈（投影折线）
+	 * @param StartAngle 起始角（弧度），4 段 + 45° 即为正方形
+	 */
+	static void DrawGroundCircle(UCanvas* Canvas, const FVector& Center, float Radius, int32 Segments, const FLinearColor& Color, float StartAngle = 0.0f);
 };
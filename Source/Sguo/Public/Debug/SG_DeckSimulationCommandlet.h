@@ -0,0 +1,80 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_DeckSimulationCommandlet.h
+// ✨ 新增 - 离线抽卡模拟命令行工具
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SG_DeckSimulationCommandlet.generated.h"
+
+class USG_DeckConfig;
+
+/**
+ * @brief 抽卡模拟中单张卡牌的统计
+ */
+struct FSGDeckSimulationCardStats
+{
+    FString DisplayName;
+    double BaseWeight = 0.0;
+
+    // 唯一卡牌或配置了最大出现次数（实际出现率不按权重占比，不参与偏差检查）
+    bool bLimited = false;
+
+    int64 HitCount = 0;
+    int64 PityHitCount = 0;
+    int64 CappedHitCount = 0;
+    int64 LastHitStep = -1;
+    int64 MaxDrought = 0;
+};
+
+/**
+ * @brief 一次抽卡模拟的结果
+ */
+struct FSGDeckSimulationResult
+{
+    // 按卡牌汇总的统计（同一卡牌配置多个槽位时合并）
+    TMap<FPrimaryAssetId, FSGDeckSimulationCardStats> Cards;
+
+    double TotalBaseWeight = 0.0;
+    int64 TotalDraws = 0;
+    double DrawSeconds = 0.0;
+};
+
+/**
+ * @brief 离线抽卡模拟（Commandlet）
+ * @details
+ * 功能说明：
+ * - 不启动游戏世界，直接驱动 USG_CardDeckComponent 的抽卡逻辑模拟大量抽卡
+ * - 统计每张卡牌的实际出现率与配置权重占比、保底触发率、保底封顶率、最长连续未抽中次数
+ * - 输出抽卡吞吐（次/秒），用于验证抽卡算法的性能
+ * 使用方式：
+ * - UnrealEditor-Cmd.exe Sguo.uproject -run=SG_DeckSimulation -Deck=/Game/Data/DA_DeckConfig -Draws=100000 -Seed=1337 -Runs=1 -Tolerance=5
+ * - 不受限卡牌的实际出现率与其权重占比相差超过 Tolerance 个百分点时返回 2（可用于 CI）
+ * 注意事项：
+ * - 唯一卡牌和配置了最大出现次数的卡牌不参与偏差检查
+ * - 保底机制会把出现率拉向均匀分布，权重差距大的卡组需要放宽 Tolerance
+ * - 每一步随机打出一张手牌再抽一张（与游戏中"使用一张、抽一张"的节奏一致）
+ * - 模拟期间 LogSGCard 降为 Error，避免日志拖慢模拟
+ * - 种子相同则结果完全相同
+ */
+UCLASS()
+class SGUO_API USG_DeckSimulationCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USG_DeckSimulationCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+    /**
+     * @brief 运行抽卡模拟（命令行工具与自动化测试共用）
+     * @param DeckConfig 卡组配置（卡牌数据需已加载）
+     * @param NumDraws 每轮抽卡次数
+     * @param Seed 随机种子（第 N 轮使用 Seed + N）
+     * @param NumRuns 轮数
+     * @return 模拟结果
+     */
+    static FSGDeckSimulationResult RunSimulation(USG_DeckConfig* DeckConfig, int32 NumDraws, int32 Seed, int32 NumRuns);
+};
@@ -13,14 +13,27 @@
  * - 配置文件设置：DefaultEngine.ini -> [Core.Log]
  * 注意事项：
  * - 所有模块都应使用对应的日志类别，避免使用 LogTemp
+ * - LogSGGameplay / LogSGUnit / LogSGCard 的编译期级别由 SG_LOG_COMPILE_VERBOSITY 决定，
+ *   低于该级别的 UE_LOG 和 SG_LOG_EVENT 文本输出在编译期移除（参数不会求值）
+ * - 热点路径使用 SG_LOG_EVENT（见 SG_StructuredLog.h），事件同时进入环形缓冲区
  */
 #pragma once
 
 #include "CoreMinimal.h"
 
+// ✨ 新增 - 游戏日志的编译期级别
+// Test / Shipping 默认只保留 Display 及以上（Log / Verbose 移除）；可在 Build.cs 中通过 PublicDefinitions 覆盖，如 SG_LOG_COMPILE_VERBOSITY=Log
+#ifndef SG_LOG_COMPILE_VERBOSITY
+	#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+		#define SG_LOG_COMPILE_VERBOSITY Display
+	#else
+		#define SG_LOG_COMPILE_VERBOSITY All
+	#endif
+#endif
+
 // ✨ NEW - 卡牌系统日志类别
 // 用于卡牌抽取、使用、选中等相关日志
-DECLARE_LOG_CATEGORY_EXTERN(LogSGCard, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogSGCard, Log, SG_LOG_COMPILE_VERBOSITY);
 
 // ✨ NEW - 资产管理日志类别
 // 用于资产加载、缓存、卸载等相关日志
@@ -32,9 +45,9 @@ DECLARE_LOG_CATEGORY_EXTERN(LogSGUI, Log, All);
 
 // ✨ NEW - 游戏玩法日志类别
 // 用于单位生成、战斗、技能等相关日志
-DECLARE_LOG_CATEGORY_EXTERN(LogSGGameplay, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogSGGameplay, Log, SG_LOG_COMPILE_VERBOSITY);
 
 
 // ✨ 新增 - 单位系统日志类别
 // 用于单位初始化、移动、攻击等相关日志
-DECLARE_LOG_CATEGORY_EXTERN(LogSGUnit, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogSGUnit, Log, SG_LOG_COMPILE_VERBOSITY);
\ No newline at end of file
@@ -0,0 +1,196 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_MatchTelemetrySubsystem.h
+// ✨ 新增 - 对局性能遥测
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Async/Future.h"
+#include "AssetManger/SG_AssetManager.h"
+#include "CardsAndUnits/SG_CardRuntimeTypes.h"
+#include "SG_MatchTelemetrySubsystem.generated.h"
+
+class FSGScopeTimer;
+class USG_CardDeckComponent;
+
+/**
+ * @brief 单帧采样
+ */
+struct FSGTelemetryFrameSample
+{
+    float FrameMs = 0.0f;
+    float GameThreadMs = 0.0f;
+    int32 Units = 0;
+    int32 Projectiles = 0;
+};
+
+/**
+ * @brief 慢帧记录
+ */
+struct FSGTelemetrySlowFrame
+{
+    int32 FrameIndex = 0;
+    float FrameMs = 0.0f;
+    int32 Units = 0;
+
+    // 本帧耗时最多的作用域（名字、毫秒）
+    TArray<TPair<FString, double>> TopScopes;
+};
+
+/**
+ * @brief 移交给线程池的完整报告
+ */
+struct FSGMatchTelemetryReport
+{
+    FString FilePath;
+    FString MapName;
+    FString Result;
+    FString DeckName;
+    double DurationSeconds = 0.0;
+    float FrameBudgetMs = 0.0f;
+
+    TArray<FSGTelemetryFrameSample> Samples;
+    TArray<FSGTelemetrySlowFrame> SlowFrames;
+
+    // 作用域：名字 → （总毫秒，调用次数）
+    TMap<FString, TPair<double, uint64>> Scopes;
+
+    // 卡牌 ID → 使用次数
+    TMap<FString, int32> CardUses;
+
+    int32 PeakUnits = 0;
+    int32 PeakProjectiles = 0;
+    int32 PeakPendingSpawns = 0;
+    int32 PeakPooledUnits = 0;
+    int32 UnitsSpawned = 0;
+    int32 UnitsReused = 0;
+
+    uint64 TargetQueries = 0;
+
+    // 本局卡牌预加载命中 / 未命中 / 无可预加载资产的使用次数，结束时的预加载占用内存
+    int32 CardPreloadHits = 0;
+    int32 CardPreloadMisses = 0;
+    int32 CardPreloadNotPreloadable = 0;
+    int64 CardPreloadResidentBytes = 0;
+
+    int32 GCCount = 0;
+    double GCTotalMs = 0.0;
+    double GCMaxMs = 0.0;
+};
+
+/**
+ * @brief 对局性能遥测（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 整局逐帧采样帧时间、游戏线程耗时、存活单位数、投射物数、生成队列长度
+ * - 统计 GC 暂停（次数、总时长、最长）、对象池生成 / 复用、目标查询次数（每秒）
+ * - 记录最慢的若干帧，以及这些帧中耗时最多的 SG_SCOPE_CYCLE_COUNTER 作用域
+ * - 记录玩家卡组和每张卡的使用次数，便于按卡组构成比较帧时间
+ * - 记录本局卡牌预加载的命中 / 未命中次数和结束时的预加载占用内存
+ * 详细流程：
+ * 1. 世界开始时按配置（USG_DebugSettings::bEnableMatchTelemetry）或命令行 -SGTelemetry 开始采集
+ * 2. 每帧采样并按作用域计时器的增量更新最慢帧列表
+ * 3. 主城被摧毁时（ASG_MainCityBase::OnMainCityDestroyed）调用 FinishMatch
+ * 4. 采样数据移交线程池：计算分位数、拼接 JSON、写入 Saved/Telemetry/SGMatch_<地图>_<时间>.json，不阻塞游戏线程
+ * 注意事项：
+ * - 采集期间开启 FSGScopeTimer（每个作用域多一次读时钟）
+ * - 与性能基准同时运行时，基准会重置作用域计时器，本局的作用域数据不可信
+ * - Shipping 包不创建该子系统
+ */
+UCLASS()
+class SGUO_API USG_MatchTelemetrySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_MatchTelemetrySubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return bCapturing; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 遥测接口 ==========
+
+    /**
+     * @brief 开始采集（已在采集时忽略）
+     */
+    void StartCapture();
+
+    /**
+     * @brief 对局结束：停止采集并异步写出报告
+     * @param Result 对局结果（Victory / Defeat）
+     */
+    void FinishMatch(const FString& Result);
+
+    bool IsCapturing() const { return bCapturing; }
+
+private:
+    /**
+     * @brief 按作用域计时器的增量更新最慢帧列表
+     */
+    void UpdateScopeDeltas(const FSGTelemetryFrameSample& Sample, int32 FrameIndex);
+
+    /**
+     * @brief 绑定玩家卡组的出牌事件（玩家控制器在世界开始后才生成）
+     */
+    void TryBindPlayerDeck();
+
+    UFUNCTION()
+    void HandleCardUsed(const FSGCardInstance& UsedCard);
+
+    void HandlePreGarbageCollect();
+    void HandlePostGarbageCollect();
+
+    /**
+     * @brief 停止采集并解除所有绑定
+     */
+    void StopCapture();
+
+    // 是否正在采集
+    bool bCapturing = false;
+
+    // 采集开始前作用域计时器是否已开启（结束时恢复）
+    bool bScopeCaptureWasEnabled = false;
+
+    // 采集开始时间 / 上一帧时间
+    double StartTime = 0.0;
+    double LastFrameTime = 0.0;
+
+    // 正在写入的报告
+    FSGMatchTelemetryReport Report;
+
+    // 各作用域计时器上一帧 / 采集开始时的累计周期和调用次数
+    TMap<const FSGScopeTimer*, uint64> LastCycles;
+    TMap<const FSGScopeTimer*, TPair<uint64, uint64>> StartTotals;
+
+    // 采集开始时的卡牌预加载统计（只统计本局的增量）
+    FSGCardPreloadStats StartPreloadStats;
+
+    // 绑定的玩家卡组
+    TWeakObjectPtr<USG_CardDeckComponent> BoundDeck;
+
+    // GC 开始时间（0 表示不在 GC 中）
+    double GCStartTime = 0.0;
+
+    FDelegateHandle PreGCHandle;
+    FDelegateHandle PostGCHandle;
+
+    // 正在写入的报告任务（世界销毁前等待完成）
+    TFuture<void> PendingWrite;
+};
@@ -0,0 +1,58 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_MemoryTracking.h
+// ✨ 新增 - 分系统内存追踪（LLM 标签）
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ * @brief Sguo 的 LLM（Low-Level Memory Tracker）标签
+ * @details
+ * 功能说明：
+ * - 父标签 Sguo，子标签：
+ *   Sguo/Units：单位生成与初始化（含 ASC、属性集、技能授予）
+ *   Sguo/Projectiles：投射物生成
+ *   Sguo/AI：AI 控制器、目标查询、攻击槽位、影响力图
+ *   Sguo/CardsUI：卡组、卡牌视图模型、手牌 Widget
+ *   Sguo/Strategies：计谋效果与滚木
+ * 使用方式：
+ * - 在分配发生的作用域写 SG_LLM_SCOPE(Units)
+ * - 运行时加 -llm 启动，用 stat LLM / stat LLMFULL 或控制台 SG.Mem.Dump 查看
+ * 注意事项：
+ * - Actor 的内存在 SpawnActor 内分配，作用域必须放在生成调用处，而不是构造函数里
+ * - 未开启 LLM 的版本中 SG_LLM_SCOPE 为空
+ */
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+LLM_DECLARE_TAG_API(Sguo, SGUO_API);
+LLM_DECLARE_TAG_API(Sguo_Units, SGUO_API);
+LLM_DECLARE_TAG_API(Sguo_Projectiles, SGUO_API);
+LLM_DECLARE_TAG_API(Sguo_AI, SGUO_API);
+LLM_DECLARE_TAG_API(Sguo_CardsUI, SGUO_API);
+LLM_DECLARE_TAG_API(Sguo_Strategies, SGUO_API);
+
+#define SG_LLM_SCOPE(Name) LLM_SCOPE_BYTAG(Sguo_##Name)
+
+#else
+
+#define SG_LLM_SCOPE(Name)
+
+#endif
+
+/**
+ * @brief 数量的当前值与峰值（高水位线）
+ * @details 数量变化时调用 Set；单位对象池、单位注册表、战斗目标管理器和手牌 ViewModel 池用它记录峰值，SG.Mem.Dump 输出
+ */
+struct FSGHighWaterMark
+{
+	int32 Current = 0;
+	int32 Peak = 0;
+
+	void Set(int32 InValue)
+	{
+		Current = InValue;
+		Peak = FMath::Max(Peak, InValue);
+	}
+};
@@ -0,0 +1,67 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_MicroBenchmarkCommandlet.h
+// ✨ 新增 - 目标查询 / 攻击槽位 / 前线 / 抽卡微基准命令行工具
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SG_MicroBenchmarkCommandlet.generated.h"
+
+class UWorld;
+class ASG_UnitsBase;
+
+/**
+ * @brief 微基准（Commandlet）
+ * @details
+ * 功能说明：
+ * - 在最小世界中放置合成单位布局（均匀、聚团、分路），单独测量热点逻辑，排除整场战斗的噪声
+ * - 套件：
+ *   Targeting：USG_TargetingSubsystem::FindBestTarget / FindEnemyUnitsOnly
+ *   Slots：USG_CombatTargetManager::FindBestTargetWithSlot + 预约 / 释放攻击槽位
+ *   FrontLine：ASG_FrontLineManager 重新扫描最前方单位 + 区域判断
+ *   Draw：USG_CardDeckComponent 在不同卡池大小下的抽卡
+ * - 每项输出 ns/次 和 游戏线程分配次数/次，按单位数（卡池大小）形成扩展曲线
+ * 使用方式：
+ * - UnrealEditor-Cmd.exe Sguo.uproject -run=SG_MicroBenchmark [-Suites=Targeting,Slots,FrontLine,Draw]
+ *   [-Counts=100,500,1000,2000] [-Layouts=Uniform,Clumped,Lane] [-Iterations=5] [-Radius=1500] [-Seed=1337] [-Out=<CSV 路径>]
+ * 注意事项：
+ * - 单位不生成 AI 控制器，只测查询本身
+ * - 分配次数在计时之外单独跑一轮统计：只在该轮用转发分配器临时替换 GMalloc，只计游戏线程
+ * - 运行期间 LogSGGameplay / LogSGUnit / LogSGCard 降为 Error
+ * - 种子相同则布局完全相同
+ */
+UCLASS()
+class SGUO_API USG_MicroBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USG_MicroBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /**
+     * @brief 把单位摆成指定布局（前一半为玩家阵营，后一半为敌方阵营）
+     * @param Layout 布局名（Uniform / Clumped / Lane）
+     */
+    void ArrangeUnits(const TArray<ASG_UnitsBase*>& Units, const FString& Layout, FRandomStream& RandomStream) const;
+
+    /**
+     * @brief 合成卡池下的抽卡基准
+     */
+    void RunDrawSuite(const TArray<int32>& PoolSizes, int32 Iterations, int32 Seed);
+
+    /**
+     * @brief 测量一项操作：先预热一轮，再计时一轮，最后统计一轮的游戏线程分配次数
+     * @param Operations Body 执行一次包含的操作次数
+     */
+    void Measure(const TCHAR* Suite, const FString& Layout, int32 Count, int64 Operations, TFunctionRef<void()> Body);
+
+    // 日志表格行（日志恢复后统一输出）
+    TArray<FString> ReportLines;
+
+    // CSV 内容
+    FString CsvReport;
+};
@@ -0,0 +1,121 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_PerfHudSubsystem.h
+// ✨ 新增 - 战斗性能面板（游戏内实时曲线）
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SG_PerfHudSubsystem.generated.h"
+
+class UCanvas;
+class APlayerController;
+
+/**
+ * @brief 性能面板的一次采样
+ */
+struct FSGPerfHudSample
+{
+    enum EValue : uint8
+    {
+        PlayerUnits,
+        EnemyUnits,
+        AINear,
+        AIMid,
+        AIFar,
+        QueriesPerFrame,
+        CandidatesPerQuery,
+        SlotOccupancy,
+        Projectiles,
+        PooledUnits,
+        SpawnQueue,
+
+        NumValues
+    };
+
+    float Values[NumValues] = {};
+};
+
+/**
+ * @brief 战斗性能面板（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 在游戏视口左侧绘制一组小曲线，持续显示战斗子系统的负载：
+ *   每方单位数、按到摄像机距离分档的 AI 数、每帧目标查询数、每次查询的平均候选数、
+ *   攻击槽位占用率、存活投射物 / 池中单位、生成队列长度
+ * - 每条曲线可在 USG_DebugSettings::PerfHudBudgets 中配置预算线，超出预算时数值标红
+ * 详细流程：
+ * 1. 开启后向 UDebugDrawService 注册 "Game" 绘制回调（不创建任何控件）
+ * 2. 绘制回调中按采样间隔采样一次，写入环形缓冲区
+ * 3. 背景一次平铺，曲线和预算线直接写入画布的批量线段
+ * 使用方式：
+ * - 项目设置 → 调试系统 → 性能面板 → 显示性能面板（开局即显示，PIE 同样生效）
+ * - 控制台：SG.PerfHud [0|1]，不带参数时切换
+ * 注意事项：
+ * - 目标查询数来自 FSGCounter（SG_INC_COUNTER_BY），按两次采样间的帧数取平均
+ * - 项目没有 AI LOD，AI 按单位到摄像机的距离分为近 / 中 / 远三档
+ * - 投射物没有对象池，池中数量显示的是单位对象池
+ * - Shipping 包不创建该子系统
+ */
+UCLASS()
+class SGUO_API USG_PerfHudSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // ========== 面板接口 ==========
+
+    /**
+     * @brief 显示面板（已显示时忽略）
+     */
+    void Show();
+
+    /**
+     * @brief 隐藏面板并清空曲线
+     */
+    void Hide();
+
+    bool IsVisible() const { return DrawHandle.IsValid(); }
+
+private:
+    /**
+     * @brief 绘制回调：到采样时间时采样，然后绘制全部曲线
+     */
+    void DrawPerfHud(UCanvas* Canvas, APlayerController* PlayerController);
+
+    /**
+     * @brief 采样一次并写入环形缓冲区
+     * @param ViewLocation 当前视口的摄像机位置（AI 距离分档）
+     */
+    void TakeSample(const FVector& ViewLocation);
+
+    /**
+     * @brief 按从旧到新的顺序读取历史采样
+     */
+    const FSGPerfHudSample& GetHistorySample(int32 Index) const
+    {
+        return History[(HistoryHead + History.Num() - HistoryCount + Index) % History.Num()];
+    }
+
+    // 绘制回调句柄（有效表示面板显示中）
+    FDelegateHandle DrawHandle;
+
+    // 采样历史（环形缓冲区）
+    TArray<FSGPerfHudSample> History;
+    int32 HistoryHead = 0;
+    int32 HistoryCount = 0;
+
+    // 上一次采样的时间（真实时间）和帧号
+    double LastSampleTime = 0.0;
+    uint64 LastSampleFrame = 0;
+
+    // 上一次采样时的计数器读数
+    uint64 LastQueries = 0;
+    uint64 LastCandidates = 0;
+};
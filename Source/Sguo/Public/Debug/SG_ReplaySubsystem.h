@@ -0,0 +1,215 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_ReplaySubsystem.h
+// ✨ 新增 - 确定性对局录像（性能问题复现）
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SG_ReplaySubsystem.generated.h"
+
+class ASG_EnemySpawner;
+class USG_CardDataBase;
+
+/**
+ * @brief 录像事件类型
+ */
+enum class ESGReplayEventType : uint8
+{
+    CardUse,        // 玩家使用卡牌
+    Skip,           // 玩家跳过行动
+    SpawnerWave     // 敌人生成器生成一波
+};
+
+/**
+ * @brief 一条录像事件（文件中每条 25 字节）
+ */
+struct FSGReplayEvent
+{
+    // 相对录像开始的帧数
+    uint32 Frame = 0;
+
+    // 相对录像开始的世界时间（秒）
+    float Time = 0.0f;
+
+    ESGReplayEventType Type = ESGReplayEventType::CardUse;
+
+    // 字符串表索引：卡牌 ID（Skip 不使用）
+    uint16 CardIndex = 0;
+
+    // CardUse：手牌位置；SpawnerWave：生成器名字的字符串表索引
+    uint16 SourceIndex = 0;
+
+    // 放置 / 生成位置
+    FVector3f Location = FVector3f::ZeroVector;
+};
+
+/**
+ * @brief 确定性对局录像（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 录制：对局种子、玩家每次出牌（手牌位置、卡牌 ID、位置、时间）、跳过行动、敌人生成器每一波（卡牌、位置）
+ * - 回放：用相同种子初始化卡组和生成器的随机流，按时间把出牌喂回 ASG_PlayerController，把生成波次喂回生成器
+ * - 录像为紧凑二进制文件（Saved/Replays/*.sgreplay），用于把玩家报告的卡顿对局原样复现给性能分析工具
+ * 详细流程：
+ * 1. 世界开始时按命令行进入录制或回放模式，设置对局种子（同时初始化 FMath::Rand / SRand）
+ * 2. 卡组和生成器初始化随机流时调用 ResolveStreamSeed，从对局种子派生各自的种子
+ * 3. 录制：玩家控制器、卡组、生成器在操作成功后调用 Record*，世界结束或 SG.Replay.Save 时写入文件
+ * 4. 回放：生成器不自行计时生成；每帧派发到期的事件，手牌与录像不一致时记为分歧
+ * 使用方式：
+ * - 录制：-SGReplayRecord[=<文件路径>] [-SGReplaySeed=<种子>]
+ * - 回放：-SGReplayPlay=<文件路径>（建议配合 -benchmark -fps=30 固定步长，事件按帧派发）
+ * - 控制台：SG.Replay.Save 立即写入当前录像
+ * 注意事项：
+ * - 非固定步长时事件按世界时间派发，只能近似复现；固定步长下按帧派发
+ * - AI 的随机行为只通过固定 FMath::Rand 种子复现，单位生成顺序变化时可能产生偏差
+ * - 事件在录制帧的末尾派发（Tickable 在 Actor 之后更新）
+ * - Shipping 包不创建该子系统
+ */
+UCLASS()
+class SGUO_API USG_ReplaySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_ReplaySubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return Mode == EMode::Playback && NextEventIndex < Events.Num(); }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 模式 ==========
+
+    /**
+     * @brief 开始录制
+     * @param InMatchSeed 对局种子
+     * @param InFilePath 输出文件（为空时写入 Saved/Replays/<地图>_<时间>.sgreplay）
+     */
+    void StartRecording(int32 InMatchSeed, const FString& InFilePath);
+
+    /**
+     * @brief 加载录像并开始回放
+     * @return 文件是否有效
+     */
+    bool StartPlayback(const FString& InFilePath);
+
+    /**
+     * @brief 把当前录像写入文件
+     * @return 是否写入成功
+     */
+    bool SaveRecording();
+
+    bool IsRecording() const { return Mode == EMode::Recording; }
+    bool IsPlaying() const { return Mode == EMode::Playback; }
+
+    /**
+     * @brief 获取某个随机流的种子
+     * @param StreamName 随机流名字（卡组使用 "Deck"，生成器使用自身 Actor 名字）
+     * @param InOutSeed 录制或回放时替换为从对局种子派生的种子，否则保持不变
+     * @return 是否替换了种子
+     */
+    bool ResolveStreamSeed(FName StreamName, int32& InOutSeed) const;
+
+    // ========== 录制 ==========
+
+    /**
+     * @brief 记录玩家出牌
+     * @param HandIndex 卡牌使用前在手牌中的位置
+     */
+    void RecordCardUse(int32 HandIndex, const FPrimaryAssetId& CardId, const FVector& Location);
+
+    /**
+     * @brief 记录玩家跳过行动
+     */
+    void RecordSkip();
+
+    /**
+     * @brief 记录生成器生成一波
+     */
+    void RecordSpawnerWave(const ASG_EnemySpawner* Spawner, const FPrimaryAssetId& CardId, const FVector& Location);
+
+private:
+    enum class EMode : uint8
+    {
+        None,
+        Recording,
+        Playback
+    };
+
+    /**
+     * @brief 添加当前帧和时间的事件
+     */
+    FSGReplayEvent& AddEvent(ESGReplayEventType Type);
+
+    /**
+     * @brief 获取字符串在字符串表中的索引（不存在时添加）
+     */
+    uint16 FindOrAddName(const FString& Name);
+
+    /**
+     * @brief 派发一条回放事件
+     * @return false 表示暂时无法派发（卡组冷却中），下一帧重试
+     */
+    bool DispatchEvent(const FSGReplayEvent& Event);
+
+    bool DispatchCardUse(const FSGReplayEvent& Event);
+    bool DispatchSkip();
+    void DispatchSpawnerWave(const FSGReplayEvent& Event);
+
+    /**
+     * @brief 回放结束时输出统计
+     */
+    void ReportPlayback() const;
+
+    // 当前模式
+    EMode Mode = EMode::None;
+
+    // 对局种子
+    int32 MatchSeed = 0;
+
+    // 录像文件路径
+    FString FilePath;
+
+    // 录制时的地图名（回放时用于提示地图不一致）
+    FString MapName;
+
+    // 字符串表（卡牌 ID、生成器名字）
+    TArray<FString> NameTable;
+    TMap<FString, uint16> NameLookup;
+
+    // 事件（按时间顺序）
+    TArray<FSGReplayEvent> Events;
+
+    // 回放：下一条待派发的事件
+    int32 NextEventIndex = 0;
+
+    // 录像开始时的帧号和世界时间
+    uint64 StartFrame = 0;
+    double StartTime = 0.0;
+
+    // 回放：字符串表中卡牌 ID 对应的卡牌数据（非卡牌条目为空）
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<USG_CardDataBase>> PlaybackCards;
+
+    // 回放：按名字缓存的生成器
+    TMap<uint16, TWeakObjectPtr<ASG_EnemySpawner>> PlaybackSpawners;
+
+    // 回放统计
+    int32 DivergenceCount = 0;
+    int32 DeferredFrames = 0;
+};
@@ -0,0 +1,211 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_Stats.h
+// ✨ 新增 - 性能统计分组与 CSV 分类
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include <atomic>
+
+/**
+ * @brief Sguo 性能统计
+ * @details
+ * 功能说明：
+ * - STATGROUP_Sguo：战斗热点路径的耗时（Cycle）和每帧计数（Counter）
+ * - CSV 分类 Sguo：与上面同名的计时和计数，供夜间性能测试绘制曲线
+ * 使用方式：
+ * - 运行时查看：stat Sguo
+ * - CSV 采集：csvprofile start / csvprofile stop（或命令行 -csvCaptureFrames=N）
+ * - 代码中：SG_SCOPE_CYCLE_COUNTER(FindBestTarget)、SG_INC_COUNTER_BY(TargetCandidates, Num)
+ * 注意事项：
+ * - 宏参数是统计名去掉 STAT_SG 前缀，同时作为 CSV 统计名
+ * - Counter 每帧清零，Accumulator 不清零（当前存活数量）
+ * - SG_SCOPE_CYCLE_COUNTER 同时累加 FSGScopeTimer，供性能基准在 Test 包中读取（Stat 系统在 Test 包不可用）
+ * - SG_INC_COUNTER_BY 同时累加 FSGCounter（非 Shipping 始终开启），供性能面板读取
+ */
+
+DECLARE_STATS_GROUP(TEXT("Sguo"), STATGROUP_Sguo, STATCAT_Advanced);
+
+// ========== 耗时 ==========
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindBestTarget"), STAT_SGFindBestTarget, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindEnemyUnitsOnly"), STAT_SGFindEnemyUnitsOnly, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindBestTargetWithSlot"), STAT_SGFindBestTargetWithSlot, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ReserveAttackSlot"), STAT_SGReserveAttackSlot, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ReleaseAttackSlot"), STAT_SGReleaseAttackSlot, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AIController Tick"), STAT_SGAIControllerTick, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Unit Tick"), STAT_SGUnitTick, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Tick"), STAT_SGProjectileTick, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Melee Detection"), STAT_SGMeleeDetection, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EnemySpawner SpawnUnit"), STAT_SGEnemySpawnUnit, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SpawnScheduler Tick"), STAT_SGSpawnSchedulerTick, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UnitPool Acquire"), STAT_SGUnitPoolAcquire, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Card Draw"), STAT_SGCardDraw, STATGROUP_Sguo, SGUO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FrontLine Update"), STAT_SGFrontLineUpdate, STATGROUP_Sguo, SGUO_API);
+
+// ========== 每帧计数 ==========
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Target Queries"), STAT_SGTargetQueries, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Target Candidates"), STAT_SGTargetCandidates, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Slot Reservations"), STAT_SGSlotReservations, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Ticks"), STAT_SGProjectileTicks, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Melee Sweep Hits"), STAT_SGMeleeSweepHits, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Units Spawned (New)"), STAT_SGUnitsSpawned, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Units Reused (Pool)"), STAT_SGUnitsReused, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cards Drawn"), STAT_SGCardsDrawn, STATGROUP_Sguo, SGUO_API);
+
+// ========== 当前数量 ==========
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Projectiles"), STAT_SGActiveProjectiles, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Units"), STAT_SGPooledUnits, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Card Preload Hits"), STAT_SGCardPreloadHits, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Card Preload Misses"), STAT_SGCardPreloadMisses, STATGROUP_Sguo, SGUO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Card Preload Hit Rate (%)"), STAT_SGCardPreloadHitRate, STATGROUP_Sguo, SGUO_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Card Preload Resident"), STAT_SGCardPreloadResident, STATGROUP_Sguo, SGUO_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(SGUO_API, Sguo);
+
+// ✨ 新增 - 基准采集用的作用域计时器
+/**
+ * @brief 作用域累计计时器
+ * @details
+ * 功能说明：
+ * - 每个 SG_SCOPE_CYCLE_COUNTER 调用点一个静态实例，首次执行时挂到全局链表
+ * - 只有开启采集（SetCaptureEnabled）时才读时钟和累加，平时只多一次原子读
+ * - 性能基准按名字汇总所有实例，得到各子系统的总耗时和调用次数
+ * 注意事项：
+ * - 累加使用原子操作，可在任意线程使用
+ * - 同名的多个调用点各自独立计数，汇总由读取方完成
+ */
+class SGUO_API FSGScopeTimer
+{
+public:
+	explicit FSGScopeTimer(const TCHAR* InName);
+
+	const TCHAR* GetName() const { return Name; }
+	uint64 GetCycles() const { return Cycles.load(std::memory_order_relaxed); }
+	uint64 GetCalls() const { return Calls.load(std::memory_order_relaxed); }
+	const FSGScopeTimer* GetNext() const { return Next; }
+
+	void Accumulate(uint64 InCycles)
+	{
+		Cycles.fetch_add(InCycles, std::memory_order_relaxed);
+		Calls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/** @brief 是否正在采集 */
+	static bool IsCaptureEnabled() { return bCaptureEnabled.load(std::memory_order_relaxed); }
+
+	/** @brief 开启或关闭采集 */
+	static void SetCaptureEnabled(bool bEnabled) { bCaptureEnabled.store(bEnabled, std::memory_order_relaxed); }
+
+	/** @brief 清零所有计时器 */
+	static void ResetAll();
+
+	/** @brief 链表头（遍历所有已注册的计时器） */
+	static const FSGScopeTimer* GetFirst() { return Head.load(std::memory_order_acquire); }
+
+private:
+	const TCHAR* Name;
+	std::atomic<uint64> Cycles{ 0 };
+	std::atomic<uint64> Calls{ 0 };
+	FSGScopeTimer* Next = nullptr;
+
+	static std::atomic<FSGScopeTimer*> Head;
+	static std::atomic<bool> bCaptureEnabled;
+};
+
+/**
+ * @brief FSGScopeTimer 的作用域对象
+ */
+class FSGScopeTimerScope
+{
+public:
+	explicit FSGScopeTimerScope(FSGScopeTimer& InTimer)
+		: Timer(FSGScopeTimer::IsCaptureEnabled() ? &InTimer : nullptr)
+		, StartCycles(Timer ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FSGScopeTimerScope()
+	{
+		if (Timer)
+		{
+			Timer->Accumulate(FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	FSGScopeTimer* Timer;
+	uint64 StartCycles;
+};
+
+// ✨ 新增 - 性能面板读取的累计计数器
+/**
+ * @brief 累计计数器
+ * @details
+ * 功能说明：
+ * - 每个 SG_INC_COUNTER_BY 调用点一个静态实例，首次执行时挂到全局链表
+ * - 只增不减，读取方按名字求和并与上一次读数相减得到增量
+ * 注意事项：
+ * - 累加使用 relaxed 原子操作，可在任意线程使用
+ * - Shipping 包不累加
+ */
+class SGUO_API FSGCounter
+{
+public:
+	explicit FSGCounter(const TCHAR* InName);
+
+	const TCHAR* GetName() const { return Name; }
+	uint64 GetValue() const { return Value.load(std::memory_order_relaxed); }
+
+	void Add(uint64 Amount)
+	{
+		Value.fetch_add(Amount, std::memory_order_relaxed);
+	}
+
+	/** @brief 同名计数器的总和 */
+	static uint64 Sum(const TCHAR* InName);
+
+private:
+	const TCHAR* Name;
+	std::atomic<uint64> Value{ 0 };
+	FSGCounter* Next = nullptr;
+
+	static std::atomic<FSGCounter*> Head;
+};
+
+#if UE_BUILD_SHIPPING
+	#define SG_COUNTER_ACCUMULATE(Name, Amount)
+#else
+	#define SG_COUNTER_ACCUMULATE(Name, Amount) \
+		static FSGCounter SGCounter_##Name(TEXT(#Name)); \
+		SGCounter_##Name.Add(static_cast<uint64>(Amount))
+#endif
+
+/**
+ * @brief 同时记录 Stat 耗时和 CSV 耗时
+ * @param Name 统计名（不带 STAT_SG 前缀）
+ */
+#define SG_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_SG##Name); \
+	CSV_SCOPED_TIMING_STAT(Sguo, Name); \
+	static FSGScopeTimer SGScopeTimer_##Name(TEXT(#Name)); \
+	FSGScopeTimerScope SGScopeTimerScope_##Name(SGScopeTimer_##Name)
+
+/**
+ * @brief 同时累加 Stat 计数和 CSV 计数
+ * @param Name 统计名（不带 STAT_SG 前缀）
+ * @param Amount 增量
+ */
+#define SG_INC_COUNTER_BY(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_SG##Name, Amount); \
+		CSV_CUSTOM_STAT(Sguo, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+		SG_COUNTER_ACCUMULATE(Name, Amount); \
+	} while (0)
+
+#define SG_INC_COUNTER(Name) SG_INC_COUNTER_BY(Name, 1)
@@ -0,0 +1,165 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_StructuredLog.h
+// ✨ 新增 - 结构化游戏日志（编译期裁剪 + 每线程无锁环形缓冲区）
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformTime.h"
+#include "Debug/SG_LogCategories.h"
+#include <type_traits>
+
+/**
+ * @brief 结构化游戏日志
+ * @details
+ * 功能说明：
+ * - SG_LOG_EVENT 记录一条二进制事件：事件类型、帧号、时间戳、最多 2 个对象名（FName）、最多 4 个数值
+ * - 事件写入当前线程的环形缓冲区（无锁，只在线程首次记录时注册一次），不做任何字符串格式化
+ * - 只有日志类别的编译期和运行期级别都允许时，才按事件格式拼出文本写入日志
+ * - 缓冲区可随时转储：控制台 SG.Log.DumpRing [每线程条数]；崩溃时自动转储到日志
+ * 使用方式：
+ * - SG_LOG_EVENT(LogSGGameplay, Log, TargetSelected, Querier, Target, Distance, AttackerCount, Score)
+ * - 参数顺序无关紧要：UObject 指针和 FName 依次进入名字槽，算术类型依次进入数值槽
+ * 注意事项：
+ * - 新增事件需要同时在 ESGLogEvent 和 SG_StructuredLog.cpp 的事件表中登记
+ * - 对象只记录 FName，转储时对象可能已销毁，但名字仍可读
+ * - SG_LOG_RING_ENABLED 默认在非 Shipping 版本开启；关闭且文本也被裁剪时，宏整体编译为空
+ */
+
+#ifndef SG_LOG_RING_ENABLED
+	#define SG_LOG_RING_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * @brief 结构化日志事件类型
+ */
+enum class ESGLogEvent : uint16
+{
+	TargetSelected,         // 名字：查询者、目标；数值：距离、攻击者数、评分
+	TargetSearchCity,       // 名字：查询者
+	TargetFallbackCity,     // 名字：查询者、主城；数值：距离、攻击者数
+	TargetNone,             // 名字：查询者
+	AttackUnitFound,        // 名字：施放者、目标
+	AttackCityHit,          // 名字：施放者、主城；数值：表面距离、攻击范围
+	AttackCityOutOfRange,   // 名字：施放者、主城；数值：表面距离、攻击范围
+	DamageComputed,         // 名字：攻击者、目标；数值：攻击力、倍率、最终伤害
+
+	Count
+};
+
+/**
+ * @brief 一条结构化日志
+ */
+struct FSGLogRecord
+{
+	static constexpr uint8 MaxNames = 2;
+	static constexpr uint8 MaxValues = 4;
+
+	uint64 Cycles = 0;
+	uint32 FrameNumber = 0;
+	ESGLogEvent Event = ESGLogEvent::Count;
+	ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+	uint8 NumNames = 0;
+	uint8 NumValues = 0;
+	FName Category;
+	FName Names[MaxNames];
+	float Values[MaxValues] = {};
+};
+
+namespace SGLog
+{
+	/** @brief 写入当前线程的环形缓冲区 */
+	SGUO_API void Record(const FSGLogRecord& InRecord);
+
+	/** @brief 按事件格式生成文本 */
+	SGUO_API FString FormatRecord(const FSGLogRecord& InRecord);
+
+	/** @brief 以文本写入日志 */
+	SGUO_API void EmitText(const FSGLogRecord& InRecord);
+
+	/**
+	 * @brief 把所有线程缓冲区中的事件按时间顺序输出
+	 * @param Ar 输出设备
+	 * @param MaxRecordsPerThread 每个线程最多输出的条数（最近的）
+	 */
+	SGUO_API void DumpRings(FOutputDevice& Ar, int32 MaxRecordsPerThread);
+
+	inline void AddArg(FSGLogRecord& InRecord, const UObject* Object)
+	{
+		if (InRecord.NumNames < FSGLogRecord::MaxNames)
+		{
+			InRecord.Names[InRecord.NumNames++] = Object ? Object->GetFName() : NAME_None;
+		}
+	}
+
+	inline void AddArg(FSGLogRecord& InRecord, FName Name)
+	{
+		if (InRecord.NumNames < FSGLogRecord::MaxNames)
+		{
+			InRecord.Names[InRecord.NumNames++] = Name;
+		}
+	}
+
+	template <typename T>
+	std::enable_if_t<std::is_arithmetic_v<T>> AddArg(FSGLogRecord& InRecord, T Value)
+	{
+		if (InRecord.NumValues < FSGLogRecord::MaxValues)
+		{
+			InRecord.Values[InRecord.NumValues++] = static_cast<float>(Value);
+		}
+	}
+
+	template <typename... ArgTypes>
+	FSGLogRecord MakeRecord(FName Category, ELogVerbosity::Type Verbosity, ESGLogEvent Event, const ArgTypes&... Args)
+	{
+		FSGLogRecord NewRecord;
+		NewRecord.Cycles = FPlatformTime::Cycles64();
+		NewRecord.FrameNumber = static_cast<uint32>(GFrameCounter);
+		NewRecord.Event = Event;
+		NewRecord.Verbosity = Verbosity;
+		NewRecord.Category = Category;
+		(AddArg(NewRecord, Args), ...);
+		return NewRecord;
+	}
+}
+
+// 文本输出：低于编译期级别时整段移除
+#if NO_LOGGING
+	#define SG_LOG_EVENT_TEXT(CategoryName, Verbosity, RecordExpr)
+#else
+	#define SG_LOG_EVENT_TEXT(CategoryName, Verbosity, RecordExpr) \
+		if constexpr ((ELogVerbosity::Verbosity & ELogVerbosity::VerbosityMask) <= ELogVerbosity::COMPILED_IN_MINIMUM_VERBOSITY \
+			&& (ELogVerbosity::Verbosity & ELogVerbosity::VerbosityMask) <= FLogCategory##CategoryName::CompileTimeVerbosity) \
+		{ \
+			if (!CategoryName.IsSuppressed(ELogVerbosity::Verbosity)) \
+			{ \
+				SGLog::EmitText(RecordExpr); \
+			} \
+		}
+#endif
+
+#if SG_LOG_RING_ENABLED
+
+/**
+ * @brief 记录结构化事件（写入环形缓冲区，级别允许时同时输出文本）
+ */
+#define SG_LOG_EVENT(CategoryName, Verbosity, EventName, ...) \
+	do \
+	{ \
+		static const FName SGLogCategoryName(TEXT(#CategoryName)); \
+		const FSGLogRecord SGLogRecord = SGLog::MakeRecord(SGLogCategoryName, ELogVerbosity::Verbosity, ESGLogEvent::EventName, ##__VA_ARGS__); \
+		SGLog::Record(SGLogRecord); \
+		SG_LOG_EVENT_TEXT(CategoryName, Verbosity, SGLogRecord) \
+	} while (0)
+
+#else
+
+#define SG_LOG_EVENT(CategoryName, Verbosity, EventName, ...) \
+	do \
+	{ \
+		SG_LOG_EVENT_TEXT(CategoryName, Verbosity, \
+			SGLog::MakeRecord(FName(TEXT(#CategoryName)), ELogVerbosity::Verbosity, ESGLogEvent::EventName, ##__VA_ARGS__)) \
+	} while (0)
+
+#endif
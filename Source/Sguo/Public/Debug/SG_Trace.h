@@ -0,0 +1,71 @@
+// 📄 文件：Source/Sguo/Public/Debug/SG_Trace.h
+// ✨ 新增 - Unreal Insights 自定义追踪通道（AI 决策与战斗事件）
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+/**
+ * @brief Sguo 追踪通道
+ * @details
+ * 功能说明：
+ * - SguoChannel 记录目标切换、攻击槽位预约/释放、伤害结算、单位死亡、卡牌使用
+ * - 每个事件写入一条结构化 Trace 事件（Sguo.TargetChanged 等），带时间戳和 Actor ID
+ * - Actor ID 第一次出现时写入一条 Sguo.ActorName 事件（ID → 名称），ID 不随 GC 复用
+ * - 同时在当前线程的 CPU 时间线上放一个零时长标记（每种事件一个固定名称，如 "SG.TargetChanged"），
+ *   Timing Insights 中无需额外分析器即可与 CPU 耗时逐帧对照
+ * 使用方式：
+ * - 启动参数：-trace=default,Sguo
+ * - 运行时：Trace.Enable Sguo / Trace.Disable Sguo
+ * - 代码中：SG_TRACE_EVENT(TargetChanged, Unit, OldTarget, NewTarget)
+ * 注意事项：
+ * - 通道关闭时 SG_TRACE_EVENT 只有一次通道检查，不会计算参数
+ * - 时间线标记名称固定，参与方和数值只在结构化事件中
+ * - Shipping 版本整体编译为空
+ */
+
+#define SG_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+class AActor;
+
+#if SG_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(SguoChannel, SGUO_API);
+
+namespace SGTrace
+{
+	/** @brief 单位切换目标 */
+	SGUO_API void TargetChanged(const AActor* Unit, const AActor* OldTarget, const AActor* NewTarget);
+
+	/** @brief 攻击槽位预约（SlotIndex 为 INDEX_NONE 表示失败） */
+	SGUO_API void SlotReserved(const AActor* Attacker, const AActor* Target, int32 SlotIndex);
+
+	/** @brief 攻击槽位释放 */
+	SGUO_API void SlotReleased(const AActor* Attacker, const AActor* Target);
+
+	/** @brief 伤害结算 */
+	SGUO_API void Damage(const AActor* Source, const AActor* Target, float Amount);
+
+	/** @brief 单位死亡 */
+	SGUO_API void UnitDied(const AActor* Unit);
+
+	/** @brief 卡牌使用 */
+	SGUO_API void CardUsed(const AActor* Owner, const FText& CardName, const FGuid& InstanceId);
+}
+
+#define SG_TRACE_EVENT(EventName, ...) \
+	do \
+	{ \
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(SguoChannel)) \
+		{ \
+			SGTrace::EventName(__VA_ARGS__); \
+		} \
+	} while (0)
+
+#else
+
+#define SG_TRACE_EVENT(EventName, ...) do {} while (0)
+
+#endif
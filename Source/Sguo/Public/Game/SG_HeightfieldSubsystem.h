@@ -0,0 +1,273 @@
+// 📄 文件：Source/Sguo/Public/Game/SG_HeightfieldSubsystem.h
+// ✨ 新增 - 战场高度图缓存
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SG_HeightfieldSubsystem.generated.h"
+
+/**
+ * @brief 战场高度图缓存（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 关卡开始时对战场网格的每个顶点做一次向下射线检测，缓存地面高度
+ * - 网格范围取导航网格范围（没有导航网格时取关卡包围盒），采样按每帧时间预算分帧进行
+ * - 查询时对所在格子的四个顶点做双线性插值，不再逐次射线检测
+ * - 运行时生成/销毁的静态阻挡物会使所在区域失效，失效顶点在下次查询时重新采样
+ * 使用方式：
+ * - 地面吸附：FindGroundLocation（高度图没有结果时自动退回射线检测）
+ * - 鼠标拾取地面：RaycastHeightfield
+ * - 其他系统移动了地形/建筑时手动调用 InvalidateRegion
+ * 注意事项：
+ * - 采样完成前 IsHeightfieldReady 为 false，所有查询退回射线检测
+ * - 每个顶点只记录最高的静态地面（桥下、洞穴内的位置需要退回射线检测）
+ * - 任一顶点没有地面（悬崖外、空洞）时查询失败
+ * - 查询接口只能在游戏线程调用
+ */
+UCLASS()
+class SGUO_API USG_HeightfieldSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    /**
+     * @brief 关卡开始：采样高度图并开始监听阻挡物的生成/销毁
+     */
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 采样进行中时，在时间预算内继续采样顶点
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_HeightfieldSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return bBuilding; }
+    virtual bool IsTickableWhenPaused() const override { return true; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 查询 ==========
+
+    /**
+     * @brief 获取某水平位置的地面高度
+     * @param Location 查询位置（只使用 X、Y）
+     * @param OutHeight 地面高度
+     * @return 位置在高度图内且四个顶点都有地面时返回 true
+     */
+    UFUNCTION(BlueprintCallable, Category = "Heightfield", meta = (DisplayName = "获取地面高度"))
+    bool GetGroundHeight(const FVector& Location, float& OutHeight);
+
+    /**
+     * @brief 获取某水平位置的地面法线（由相邻顶点高度差计算）
+     * @param Location 查询位置（只使用 X、Y）
+     * @param OutNormal 地面法线
+     * @return 是否成功
+     */
+    UFUNCTION(BlueprintCallable, Category = "Heightfield", meta = (DisplayName = "获取地面法线"))
+    bool GetGroundNormal(const FVector& Location, FVector& OutNormal);
+
+    /**
+     * @brief 查找地面位置（替代向下的射线检测）
+     * @param Location 查询位置
+     * @param TraceUp 检测起点高度（相对查询位置）
+     * @param TraceDown 检测深度（相对查询位置）
+     * @param OutGroundLocation 地面位置
+     * @param TraceChannel 检测通道（与 SampleChannel 不同时不使用高度图，直接射线检测）
+     * @param IgnoredActors 退回射线检测时忽略的 Actor
+     * @return 是否找到地面
+     * @details 高度图结果不在 [Z - TraceDown, Z + TraceUp] 范围内时退回射线检测，保持与原射线检测一致的结果
+     */
+    bool FindGroundLocation(
+        const FVector& Location,
+        float TraceUp,
+        float TraceDown,
+        FVector& OutGroundLocation,
+        ECollisionChannel TraceChannel,
+        TArrayView<const AActor* const> IgnoredActors = TArrayView<const AActor* const>()
+    );
+
+    /**
+     * @brief 射线与高度图求交（替代鼠标拾取地面的射线检测）
+     * @param Start 射线起点
+     * @param Direction 射线方向（需归一化）
+     * @param MaxDistance 最大距离
+     * @param OutHitLocation 交点
+     * @return 是否相交
+     */
+    bool RaycastHeightfield(const FVector& Start, const FVector& Direction, float MaxDistance, FVector& OutHitLocation);
+
+    /**
+     * @brief 高度图是否已采样
+     */
+    UFUNCTION(BlueprintPure, Category = "Heightfield", meta = (DisplayName = "高度图是否可用"))
+    bool IsHeightfieldReady() const { return bHeightfieldReady; }
+
+    // ========== 失效 ==========
+
+    /**
+     * @brief 使某区域失效（区域内的顶点在下次查询时重新采样）
+     * @param Bounds 区域
+     */
+    UFUNCTION(BlueprintCallable, Category = "Heightfield", meta = (DisplayName = "使区域失效"))
+    void InvalidateRegion(const FBox& Bounds);
+
+    /**
+     * @brief 重新采样整个高度图
+     * @details 重新计算网格范围并开始分帧采样；采样完成前查询退回射线检测
+     */
+    UFUNCTION(BlueprintCallable, Category = "Heightfield", meta = (DisplayName = "重建高度图"))
+    void BuildHeightfield();
+
+    /**
+     * @brief 是否正在采样
+     */
+    UFUNCTION(BlueprintPure, Category = "Heightfield", meta = (DisplayName = "高度图是否正在采样"))
+    bool IsBuilding() const { return bBuilding; }
+
+    // ========== 统计 ==========
+
+    /** 缓存命中次数 */
+    int32 GetCacheHitCount() const { return CacheHitCount; }
+
+    /** 退回射线检测的次数 */
+    int32 GetFallbackTraceCount() const { return FallbackTraceCount; }
+
+    // ========== 配置 ==========
+
+    /** 是否启用高度图 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config", meta = (DisplayName = "启用高度图"))
+    bool bEnableHeightfield = true;
+
+    /**
+     * @brief 是否按关卡自动确定网格范围
+     * @details 优先使用导航网格范围，其次使用关卡包围盒；都没有时使用下面的手动网格
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config", meta = (DisplayName = "自动适配关卡范围"))
+    bool bFitToLevelBounds = true;
+
+    /** 网格原点（左下角，自动适配时由关卡范围覆盖） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config", meta = (DisplayName = "网格原点"))
+    FVector2D GridOrigin = FVector2D(-25600.0, -25600.0);
+
+    /** 格子大小（厘米，自动适配时范围过大会在运行时放大格子以满足网格尺寸上限，不修改此配置） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config",
+        meta = (DisplayName = "格子大小", ClampMin = "25.0", UIMin = "25.0", UIMax = "1000.0"))
+    float CellSize = 200.0f;
+
+    /** 网格宽度（格子数，自动适配时由关卡范围覆盖） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config",
+        meta = (DisplayName = "网格宽度", ClampMin = "1", UIMin = "1", UIMax = "1024"))
+    int32 GridWidth = 256;
+
+    /** 网格高度（格子数，自动适配时由关卡范围覆盖） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config",
+        meta = (DisplayName = "网格高度", ClampMin = "1", UIMin = "1", UIMax = "1024"))
+    int32 GridHeight = 256;
+
+    /** 采样射线起点高度（自动适配时为关卡范围顶部） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config", meta = (DisplayName = "采样起点高度"))
+    float SampleTopZ = 20000.0f;
+
+    /** 采样射线终点高度（自动适配时为关卡范围底部） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config", meta = (DisplayName = "采样终点高度"))
+    float SampleBottomZ = -20000.0f;
+
+    /** 每帧采样的时间预算（毫秒，<= 0 时一次采样完成） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config",
+        meta = (DisplayName = "每帧采样预算(ms)", UIMin = "0.0", UIMax = "10.0"))
+    float BuildBudgetMs = 2.0f;
+
+    /** 采样使用的检测通道 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightfield Config", meta = (DisplayName = "采样通道"))
+    TEnumAsByte<ECollisionChannel> SampleChannel = ECC_WorldStatic;
+
+protected:
+    /**
+     * @brief 按导航网格或关卡包围盒确定网格范围
+     * @return 是否找到关卡范围
+     */
+    bool FitGridToLevelBounds();
+
+    /**
+     * @brief 在时间预算内继续采样
+     */
+    void ContinueBuild(double BudgetSeconds);
+
+    /**
+     * @brief 采样一个顶点
+     * @return 是否检测到地面
+     */
+    bool SampleVertex(int32 VertexX, int32 VertexY);
+
+    /**
+     * @brief 获取顶点高度（失效顶点先重新采样）
+     * @return 顶点有地面时返回 true
+     */
+    bool GetVertexHeight(int32 VertexX, int32 VertexY, float& OutHeight);
+
+    /**
+     * @brief 生成 Actor 回调：可移动的静态阻挡物使所在区域失效
+     */
+    void HandleActorSpawned(AActor* Actor);
+
+    /**
+     * @brief 销毁 Actor 回调
+     */
+    void HandleActorDestroyed(AActor* Actor);
+
+    /**
+     * @brief Actor 是否会影响高度图
+     */
+    bool AffectsHeightfield(const AActor* Actor) const;
+
+private:
+    int32 GetVertexIndex(int32 VertexX, int32 VertexY) const { return VertexY * (GridWidth + 1) + VertexX; }
+
+    // 顶点高度（(GridWidth + 1) × (GridHeight + 1)）
+    TArray<float> VertexHeights;
+
+    // 顶点是否有地面
+    TBitArray<> VertexValid;
+
+    // 顶点是否需要重新采样
+    TBitArray<> VertexDirty;
+
+    // ✨ 新增 - 实际使用的格子大小（CellSize 或自动适配放大后的值）
+    float ActiveCellSize = 200.0f;
+
+    // 所有有效顶点的高度范围（用于裁剪射线）
+    float MinHeight = 0.0f;
+    float MaxHeight = 0.0f;
+
+    bool bHeightfieldReady = false;
+
+    // 分帧采样状态
+    bool bBuilding = false;
+    int32 BuildCursor = 0;
+    int32 BuildValidCount = 0;
+    double BuildSeconds = 0.0;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+
+    // 统计
+    int32 CacheHitCount = 0;
+    int32 FallbackTraceCount = 0;
+};
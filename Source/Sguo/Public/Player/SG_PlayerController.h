@@ -16,6 +16,11 @@ class USG_CardDataBase;
 class USG_StrategyCardData;
 // ✨ 新增 - 计谋效果基类前向声明
 class ASG_StrategyEffectBase;
+class USG_CharacterCardData;
+class ASG_UnitsBase;
+
+// ✨ 新增 - 角色卡单位全部生成完成事件（单位经分帧调度器生成，晚于卡牌使用）
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSGOnCardUnitsSpawnedSignature, USG_CharacterCardData*, CardData, const TArray<ASG_UnitsBase*>&, SpawnedUnits);
 
 // ✨ 新增 - 放置模式枚举
 /**
@@ -173,6 +178,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Placement")
 	bool DoesCardRequirePreview(USG_CardDataBase* CardData) const;
 
+	// ✨ 新增 - 在指定位置直接使用手牌（对局回放）
+	/**
+	 * @brief 在指定位置使用手牌，不经过放置预览和鼠标输入
+	 * @param CardInstanceId 卡牌实例 ID
+	 * @param Location 放置位置（角色卡）或目标位置（计谋卡）
+	 * @return 是否使用成功
+	 * @details
+	 * 功能说明：
+	 * - 角色卡：生成单位并使用卡牌，与 ConfirmPlacement 相同
+	 * - 全局计谋卡：UseStrategyCardDirectly
+	 * - 需要目标的计谋卡：开始目标选择 → 更新目标位置 → 确认目标
+	 * 注意事项：
+	 * - 会取消当前的放置 / 目标选择
+	 */
+	bool PlayCardAt(const FGuid& CardInstanceId, const FVector& Location);
+
+	// ✨ 新增 - 角色卡单位生成完成
+	/**
+	 * @brief 角色卡的单位全部生成完成时广播
+	 * @details
+	 * - 单位由 USG_SpawnSchedulerSubsystem 分帧生成，卡牌使用时单位尚未出现
+	 * - 需要对本次出牌的单位做后续处理（加效果、引导提示等）时绑定此事件
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Card", meta = (DisplayName = "卡牌单位生成完成"))
+	FSGOnCardUnitsSpawnedSignature OnCardUnitsSpawned;
+
 private:
 	void BindPawnInputEvents();
 	
@@ -184,6 +215,15 @@ private:
 
 	void SpawnUnitFromCard(USG_CardDataBase* CardData, const FVector& UnitSpawnLocation, const FRotator& UnitSpawnRotation);
 
+	// ✨ 新增 - 生成调度器完成回调
+	void HandleCardUnitsSpawned(const TArray<ASG_UnitsBase*>& SpawnedUnits, TWeakObjectPtr<USG_CharacterCardData> CardData);
+
+	// ✨ 新增 - 使用卡牌并写入对局录像
+	/**
+	 * @brief 使用卡牌，成功时记录手牌位置、卡牌 ID 和位置
+	 */
+	bool UseCardAndRecord(const FGuid& CardInstanceId, const FVector& Location);
+
 	UFUNCTION()
 	void OnCardSelectionChanged(const FGuid& SelectedId);
 
@@ -227,6 +227,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Strategy Effect", meta = (DisplayName = "是否执行中"))
 	bool IsExecuting() const { return CurrentState == ESGStrategyEffectState::Executing; }
 
+	// ✨ 新增 - 获取目标位置（对局录像记录计谋释放位置）
+	/**
+	 * @brief 获取当前目标位置
+	 */
+	UFUNCTION(BlueprintPure, Category = "Strategy Effect", meta = (DisplayName = "获取目标位置"))
+	FVector GetEffectTargetLocation() const { return TargetLocation; }
+
 public:
 	// ========== 委托 ==========
 	
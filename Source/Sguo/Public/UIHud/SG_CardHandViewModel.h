@@ -19,6 +19,8 @@
 // 引入卡牌运行时类型
 #include "SG_CardViewModel.h"
 #include "CardsAndUnits/SG_CardRuntimeTypes.h"
+#include "Debug/SG_MemoryTracking.h"
+#include "Engine/TimerHandle.h"
 // 引入头文件生成宏
 #include "SG_CardHandViewModel.generated.h"
 
@@ -47,6 +49,63 @@ public:
 	/** @brief 获取卡牌 ViewModel 列表 */
 	UFUNCTION(BlueprintCallable, Category = "Card")
 	TArray<USGCardViewModel*> GetCardViewModels() const; 
+
+	/**
+	 * @brief ✨ 新增 - 根据冷却时间戳本地计算剩余冷却时间
+	 * @param WorldTime 当前世界时间（Get Game Time in Seconds）
+	 * @return 剩余秒数
+	 * @details 卡组组件只在冷却开始/结束时通知；进度条等连续显示应在 Widget 中每帧调用本函数本地插值
+	 */
+	UFUNCTION(BlueprintPure, Category = "Card")
+	float GetCooldownRemainingAt(float WorldTime) const;
+
+	/**
+	 * @brief ✨ 新增 - 根据冷却时间戳本地计算冷却进度
+	 * @param WorldTime 当前世界时间
+	 * @return 0（刚开始）~ 1（已结束）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Card")
+	float GetCooldownProgressAt(float WorldTime) const;
+
+	/**
+	 * @brief 🔧 修改 - 冷却剩余时间（Cooldown 字段的 Getter）
+	 * @return 根据冷却结束时间和当前世界时间计算的剩余秒数
+	 */
+	float GetCooldown() const;
+
+	// ========== ✨ 新增 - 批量更新 ==========
+
+	/**
+	 * @brief 开始一次批量更新（可嵌套）
+	 * @details
+	 * 功能说明：
+	 * - 批量更新期间字段值立即修改，FieldNotify 只记录不广播
+	 * - 最外层 EndUpdate 后在下一次 Tick 统一广播：每个发生变化的字段一次，未变化的卡牌不通知
+	 * 注意事项：
+	 * - 优先使用 FSGCardHandUpdateScope，保证 Begin/End 成对
+	 */
+	void BeginUpdate();
+
+	/** @brief 结束批量更新 */
+	void EndUpdate();
+
+	/**
+	 * @brief 立即广播所有待发送的字段通知
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Card")
+	void FlushPendingNotifications();
+
+	/**
+	 * @brief 归还已离开手牌的卡牌 ViewModel
+	 * @param ViewModel 卡牌 ViewModel（卡牌 Widget 移除动画结束后调用）
+	 * @details 归还后 ViewModel 的事件绑定被清空，之后可能被新抽到的卡牌复用
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Card")
+	void ReleaseCardViewModel(USGCardViewModel* ViewModel);
+
+	// ✨ 新增 - 对象池数量与高水位线（SG.Mem.Dump）
+	int32 GetPooledCardViewModelCount() const { return CardViewModelPool.Num(); }
+	int32 GetPeakPooledCardViewModelCount() const { return PooledCardViewModels.Peak; }
 protected:
 	// 处理手牌更新
 	UFUNCTION()
@@ -74,12 +133,109 @@ protected:
 	bool bCanAct = true;
 
 	// 冷却剩余时间
-	UPROPERTY(BlueprintReadWrite, FieldNotify, Category = "Card")
+	// 🔧 修改 - 通过 GetCooldown 按冷却结束时间实时计算；冷却期间只在整秒变化时通知绑定
+	UPROPERTY(BlueprintReadWrite, FieldNotify, Getter, Category = "Card")
 	float Cooldown = 0.0f;
 
+	// ✨ 新增 - 冷却开始/结束时间（世界时间，秒）
+	UPROPERTY(BlueprintReadWrite, FieldNotify, Category = "Card")
+	float CooldownStartTime = 0.0f;
+
+	UPROPERTY(BlueprintReadWrite, FieldNotify, Category = "Card")
+	float CooldownEndTime = 0.0f;
+
 protected:
 	// 被观察的卡组组件
 	UPROPERTY(Transient)
 	TObjectPtr<USG_CardDeckComponent> ObservedDeck;
+
+private:
+	/**
+	 * @brief ✨ 新增 - 从对象池取出卡牌 ViewModel（池为空时新建）
+	 */
+	USGCardViewModel* AcquireCardViewModel();
+
+	/**
+	 * @brief ✨ 新增 - 卡牌 ViewModel 加入本次批量更新
+	 */
+	void TrackCardViewModel(USGCardViewModel* ViewModel);
+
+	/**
+	 * @brief 🔧 修改 - 刷新 Cooldown 并通知绑定，冷却未结束时在下一个整秒边界继续刷新
+	 */
+	void RefreshCooldown();
+
+	/**
+	 * @brief ✨ 新增 - 修改字段（批量更新期间只记录字段 ID）
+	 */
+	template<typename T, typename U>
+	void SetFieldValue(T& Value, const U& NewValue, UE::FieldNotification::FFieldId FieldId)
+	{
+		if (SGViewModel::AreFieldValuesEqual<T>(Value, NewValue))
+		{
+			return;
+		}
+
+		Value = NewValue;
+
+		if (UpdateDepth > 0)
+		{
+			PendingFieldIds.AddUnique(FieldId);
+		}
+		else
+		{
+			BroadcastFieldValueChanged(FieldId);
+		}
+	}
+
+	// ✨ 新增 - 批量更新嵌套深度
+	int32 UpdateDepth = 0;
+
+	// ✨ 新增 - 是否已安排下一次 Tick 广播
+	bool bFlushScheduled = false;
+
+	// 🔧 修改 - 冷却倒计时刷新定时器（按整秒触发，不再每帧触发）
+	FTimerHandle CooldownRefreshTimer;
+
+	// ✨ 新增 - 待广播的手牌字段
+	TArray<UE::FieldNotification::FFieldId, TInlineAllocator<8>> PendingFieldIds;
+
+	// ✨ 新增 - 本次批量更新涉及的卡牌 ViewModel
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USGCardViewModel>> PendingCardViewModels;
+
+	// ✨ 新增 - 已离开手牌、等待 Widget 归还的卡牌 ViewModel
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USGCardViewModel>> RetiredCardViewModels;
+
+	// ✨ 新增 - 可复用的卡牌 ViewModel
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USGCardViewModel>> CardViewModelPool;
+
+	// ✨ 新增 - 对象池高水位线
+	FSGHighWaterMark PooledCardViewModels;
+};
+
+/**
+ * @brief ✨ 新增 - 手牌批量更新作用域
+ * @details 构造时 BeginUpdate，析构时 EndUpdate
+ */
+struct FSGCardHandUpdateScope
+{
+	explicit FSGCardHandUpdateScope(USGCardHandViewModel* InViewModel)
+		: ViewModel(InViewModel)
+	{
+		ViewModel->BeginUpdate();
+	}
+
+	~FSGCardHandUpdateScope()
+	{
+		ViewModel->EndUpdate();
+	}
+
+	UE_NONCOPYABLE(FSGCardHandUpdateScope);
+
+private:
+	USGCardHandViewModel* ViewModel;
 };
 
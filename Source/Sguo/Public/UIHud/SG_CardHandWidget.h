@@ -23,6 +23,7 @@ class USG_CardEntryWidget;
 class USGCardViewModel;
 class UCanvasPanel;
 class UCanvasPanelSlot;
+class UInvalidationBox;
 
 // 卡牌布局信息结构体
 USTRUCT(BlueprintType)
@@ -149,6 +150,17 @@ protected:
 	UPROPERTY(BlueprintReadWrite, Category = "Card", meta = (BindWidget))
 	TObjectPtr<UCanvasPanel> CardsArea;
 
+	/**
+	 * @brief ✨ 新增 - 包裹 CardsArea 的失效缓存面板（可选）
+	 * @details
+	 * 功能说明：
+	 * - 在 UMG 中用 Invalidation Box 包裹 CardsArea 并命名为 CardsInvalidationBox
+	 * - 手牌静止时开启缓存，Slate 直接复用上次的绘制结果
+	 * - 有卡牌在动画中时关闭缓存，避免每帧重建缓存
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Card", meta = (BindWidgetOptional))
+	TObjectPtr<UInvalidationBox> CardsInvalidationBox;
+
 	/**
 	 * @brief Card Entry Widget 类
 	 */
@@ -354,6 +366,49 @@ private:
 	void UpdateCardPositions(float DeltaTime);
 	void ApplyCardPosition(FSGCardLayoutInfo& LayoutInfo);
 
+	// ========== ✨ 新增 - 保留式布局 ==========
+
+	/**
+	 * @brief 标记布局需要重新计算（下一次 Tick 统一计算一次）
+	 */
+	void MarkLayoutDirty();
+
+	/**
+	 * @brief 布局已标记时重新计算目标位置，并唤醒目标发生变化的卡牌
+	 */
+	void FlushLayoutIfDirty();
+
+	/**
+	 * @brief 把卡牌加入活跃动画列表
+	 * @param CardIndex 卡牌在 CardLayouts 中的索引
+	 */
+	void WakeCard(int32 CardIndex);
+
+	/**
+	 * @brief 唤醒所有卡牌（选中状态变化时重新应用 Z 层级）
+	 */
+	void WakeAllCards();
+
+	/**
+	 * @brief 把所有未到达目标的卡牌加入活跃动画列表
+	 */
+	void WakeUnsettledCards();
+
+	/**
+	 * @brief 卡牌是否已静止（没有动画且已到达目标）
+	 */
+	bool IsCardSettled(const FSGCardLayoutInfo& LayoutInfo) const;
+
+	/**
+	 * @brief 手牌是否完全空闲（没有待刷新、待布局、开局动画和活跃动画）
+	 */
+	bool IsHandIdle() const;
+
+	/**
+	 * @brief 根据是否空闲开关失效缓存
+	 */
+	void UpdateInvalidationCaching();
+
 	UFUNCTION()
 	void OnCardUsed(USGCardViewModel* UsedCard);
 
@@ -410,6 +465,12 @@ private:
 	UPROPERTY(Transient)
 	TArray<FSGCardLayoutInfo> CardLayouts;
 
+	// ✨ 新增 - 布局是否需要重新计算（仅手牌变化时标记）
+	bool bLayoutDirty = false;
+
+	// ✨ 新增 - 正在动画的卡牌索引（为空时 Tick 直接返回）
+	TArray<int32> AnimatingCardIndices;
+
 	// ========== 开局展开动画状态 ==========
 
 	// 是否正在播放开局展开动画
@@ -22,6 +22,23 @@
 // 引入生成宏
 #include "SG_CardViewModel.generated.h"
 
+// ✨ 新增 - 批量通知使用的字段比较
+namespace SGViewModel
+{
+	template<typename T>
+	bool AreFieldValuesEqual(const T& A, const T& B)
+	{
+		if constexpr (std::is_same_v<T, FText>)
+		{
+			return A.IdenticalTo(B);
+		}
+		else
+		{
+			return A == B;
+		}
+	}
+}
+
 
 // 选中状态改变委托
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSGCardViewModelSelectionChangedSignature, USGCardViewModel*, ViewModel, bool, bIsSelected);
@@ -81,6 +98,26 @@ public:
 	/** @brief 检查是否为同一张卡牌 */
 	bool IsSameCard(const FGuid& OtherInstanceId) const { return InstanceId == OtherInstanceId; }
 
+	// ========== ✨ 新增 - 批量通知 ==========
+
+	/**
+	 * @brief 开始延迟字段通知
+	 * @details 之后的字段修改只记录字段 ID，直到 FlushFieldNotifications 统一广播
+	 */
+	void BeginDeferredNotify() { bDeferFieldNotify = true; }
+
+	/**
+	 * @brief 广播期间修改过的字段（每个字段一次）并结束延迟
+	 * @return 是否有字段发生变化
+	 */
+	bool FlushFieldNotifications();
+
+	/**
+	 * @brief 回收到对象池前重置
+	 * @details 清空所有事件绑定和卡牌数据，不广播任何通知
+	 */
+	void ResetForPool();
+
 	// 选中状态改变事件
 	UPROPERTY(BlueprintAssignable, Category = "Card")
 	FSGCardViewModelSelectionChangedSignature OnSelectionChanged;
@@ -118,5 +155,37 @@ protected:
 	// 卡牌数据引用
 	UPROPERTY(Transient)
 	TObjectPtr<USG_CardDataBase> CardData = nullptr;
+
+private:
+	/**
+	 * @brief ✨ 新增 - 修改字段（延迟期间只记录字段 ID）
+	 * @return 值是否发生变化
+	 */
+	template<typename T, typename U>
+	bool SetFieldValue(T& Value, const U& NewValue, UE::FieldNotification::FFieldId FieldId)
+	{
+		if (SGViewModel::AreFieldValuesEqual<T>(Value, NewValue))
+		{
+			return false;
+		}
+
+		Value = NewValue;
+
+		if (bDeferFieldNotify)
+		{
+			PendingFieldIds.AddUnique(FieldId);
+		}
+		else
+		{
+			BroadcastFieldValueChanged(FieldId);
+		}
+		return true;
+	}
+
+	// ✨ 新增 - 是否延迟字段通知
+	bool bDeferFieldNotify = false;
+
+	// ✨ 新增 - 延迟期间修改过的字段
+	TArray<UE::FieldNotification::FFieldId, TInlineAllocator<8>> PendingFieldIds;
 };
 
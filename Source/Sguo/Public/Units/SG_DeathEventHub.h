@@ -0,0 +1,159 @@
+// 📄 文件：Source/Sguo/Public/Units/SG_DeathEventHub.h
+// ✨ 新增 - 单位死亡事件中心
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
+#include "SG_DeathEventHub.generated.h"
+
+// 前置声明
+class ASG_UnitsBase;
+
+// 死亡通知回调（原生委托，绑定开销远小于动态委托）
+DECLARE_DELEGATE_OneParam(FSGDeathWatchCallback, ASG_UnitsBase* /*DeadUnit*/);
+
+/**
+ * @brief 单个监听者
+ */
+struct FSGDeathWatcher
+{
+    // 监听者（失效后自动跳过）
+    TWeakObjectPtr<UObject> Owner;
+
+    // 回调
+    FSGDeathWatchCallback Callback;
+};
+
+// 每个目标的监听者通常只有几个，内联存储避免堆分配
+using FSGDeathWatcherList = TArray<FSGDeathWatcher, TInlineAllocator<4>>;
+
+/**
+ * @brief 单位死亡事件中心（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 替代攻击者、前线管理器各自向目标绑定的死亡委托
+ * - 监听者列表按单位注册表句柄的槽位存放，注册/注销只是数组操作
+ * - 一帧内的所有死亡先入队，在子系统 Tick 中统一处理：
+ *   1. 一次遍历释放死亡单位相关的攻击槽位（USG_CombatTargetManager）
+ *   2. 一次遍历清理攻击者计数（USG_TargetingSubsystem）
+ *   3. 一次遍历清理以死亡单位为目标的不可达记录（USG_ReachabilityCache）
+ *   4. 依次通知监听者
+ * 使用方式：
+ * - 单位死亡时调用 NotifyUnitDied（ASG_UnitsBase::OnDeath、主城爆炸）
+ * - 监听者通过 AddWatcher / RemoveWatcher 关注目标
+ * 注意事项：
+ * - 监听者在死亡后的下一次 Tick 收到通知（同一帧或下一帧）
+ * - 单位的 OnUnitDeathEvent 仍会立即广播，供蓝图使用
+ */
+UCLASS()
+class SGUO_API USG_DeathEventHub : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 统一处理本帧入队的死亡事件
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_DeathEventHub, STATGROUP_Tickables);
+    }
+
+    /**
+     * @brief 是否可以 Tick（没有待处理的死亡时不 Tick）
+     */
+    virtual bool IsTickable() const override { return PendingDeaths.Num() > 0; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 监听接口 ==========
+
+    /**
+     * @brief 关注某单位的死亡
+     * @param Target 目标单位
+     * @param Owner 监听者（同一监听者重复关注时替换回调）
+     * @param Callback 死亡回调
+     * @return 目标有效时返回 true
+     */
+    bool AddWatcher(ASG_UnitsBase* Target, UObject* Owner, FSGDeathWatchCallback Callback);
+
+    /**
+     * @brief 取消关注某单位的死亡
+     * @param Target 目标单位
+     * @param Owner 监听者
+     */
+    void RemoveWatcher(ASG_UnitsBase* Target, const UObject* Owner);
+
+    // ========== 死亡上报 ==========
+
+    /**
+     * @brief 上报单位死亡
+     * @param DeadUnit 死亡单位
+     * @details
+     * - 取出该单位的监听者列表并入队，下一次 Tick 统一派发
+     * - 立即从单位注册表注销（槽位随后可被复用）
+     */
+    void NotifyUnitDied(ASG_UnitsBase* DeadUnit);
+
+    /**
+     * @brief 获取待处理的死亡数量
+     */
+    UFUNCTION(BlueprintPure, Category = "Unit Events", meta = (DisplayName = "获取待处理死亡数量"))
+    int32 GetPendingDeathCount() const { return PendingDeaths.Num(); }
+
+protected:
+    /**
+     * @brief 统一处理所有待处理的死亡
+     */
+    void DispatchPendingDeaths();
+
+private:
+    /**
+     * @brief 某槽位的监听者列表
+     */
+    struct FSGWatchSlot
+    {
+        // 列表对应的槽位代数（与句柄不一致时视为空列表）
+        int32 Generation = 0;
+
+        FSGDeathWatcherList Watchers;
+    };
+
+    /**
+     * @brief 待处理的死亡
+     */
+    struct FSGPendingDeath
+    {
+        TWeakObjectPtr<ASG_UnitsBase> Unit;
+
+        FSGDeathWatcherList Watchers;
+    };
+
+    /**
+     * @brief 获取句柄对应的监听者列表（代数不一致时重置）
+     */
+    FSGWatchSlot& GetWatchSlot(const FSGUnitHandle& Handle);
+
+    // 按注册表槽位索引存放的监听者列表
+    TArray<FSGWatchSlot> WatchSlots;
+
+    // 本帧待处理的死亡
+    TArray<FSGPendingDeath> PendingDeaths;
+};
@@ -0,0 +1,253 @@
+// 📄 文件：Source/Sguo/Public/Units/SG_SpawnSchedulerSubsystem.h
+// ✨ 新增 - 分帧生成调度器
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GameplayTagContainer.h"
+#include "SG_SpawnSchedulerSubsystem.generated.h"
+
+// 前置声明
+class ASG_UnitsBase;
+class USG_CharacterCardData;
+
+// 生成请求完成回调（原生，供 C++ 调用方使用）
+DECLARE_DELEGATE_OneParam(FSGSpawnRequestCallback, const TArray<ASG_UnitsBase*>& /*SpawnedUnits*/);
+
+// 生成请求完成事件（蓝图）
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSGSpawnRequestCompletedSignature, int32, RequestId, const TArray<ASG_UnitsBase*>&, SpawnedUnits);
+
+/**
+ * @brief 阵型中的一个生成位置
+ */
+USTRUCT(BlueprintType)
+struct FSGFormationSpawnSlot
+{
+    GENERATED_BODY()
+
+    // 单位类
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "单位类"))
+    TSubclassOf<ASG_UnitsBase> UnitClass;
+
+    // 生成变换（开启地面吸附时只使用水平位置，未检测到地面时保持原高度）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "生成变换"))
+    FTransform Transform;
+};
+
+/**
+ * @brief 阵型生成请求
+ */
+USTRUCT(BlueprintType)
+struct FSGFormationSpawnRequest
+{
+    GENERATED_BODY()
+
+    // 生成位置列表（按顺序生成）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "生成位置"))
+    TArray<FSGFormationSpawnSlot> Slots;
+
+    // 源卡牌数据
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "源卡牌数据"))
+    TObjectPtr<USG_CharacterCardData> CardData;
+
+    // 阵营标签（无效时使用单位类默认阵营）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "阵营标签"))
+    FGameplayTag FactionTag;
+
+    // 所有者（同时在地面检测中被忽略）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "所有者"))
+    TObjectPtr<AActor> SpawnOwner;
+
+    // 发起者（同时在地面检测中被忽略）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "发起者"))
+    TObjectPtr<APawn> SpawnInstigator;
+
+    // 是否在生成时吸附地面
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "吸附地面"))
+    bool bSnapToGround = true;
+
+    // 地面检测起点高度（相对生成位置）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "检测起点高度", EditCondition = "bSnapToGround"))
+    float GroundTraceUp = 500.0f;
+
+    // 地面检测深度（相对生成位置）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "检测深度", EditCondition = "bSnapToGround"))
+    float GroundTraceDown = 1000.0f;
+
+    // 吸附后的高度偏移（通常为胶囊体半高）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "地面高度偏移", EditCondition = "bSnapToGround"))
+    float GroundZOffset = 0.0f;
+
+    // 同一请求中相邻单位的出场间隔（秒，0 表示尽快生成）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (DisplayName = "出场间隔", ClampMin = "0.0"))
+    float StaggerInterval = 0.0f;
+};
+
+/**
+ * @brief 进行中的生成请求（内部使用）
+ */
+USTRUCT()
+struct FSGActiveSpawnRequest
+{
+    GENERATED_BODY()
+
+    int32 RequestId = 0;
+
+    UPROPERTY()
+    FSGFormationSpawnRequest Request;
+
+    // 下一个要生成的位置
+    int32 NextSlot = 0;
+
+    // 出场间隔：下一个单位最早的生成时间
+    double NextSpawnTime = 0.0;
+
+    // 每个位置的占位 Actor
+    TArray<TWeakObjectPtr<AActor>> Placeholders;
+
+    // 已生成的单位
+    TArray<TWeakObjectPtr<ASG_UnitsBase>> SpawnedUnits;
+
+    // 完成回调
+    FSGSpawnRequestCallback Callback;
+
+    // 是否已取消（取消的请求不再通知）
+    bool bCancelled = false;
+
+    bool IsFinished() const { return NextSlot >= Request.Slots.Num(); }
+};
+
+/**
+ * @brief 分帧生成调度器（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 接收阵型生成请求，在多帧内按时间预算逐个生成单位
+ * - 地面吸附在真正生成该单位时进行（优先查询 USG_HeightfieldSubsystem）
+ * - 可选：为尚未生成的位置放置占位 Actor；为同一请求设置出场间隔
+ * - 请求完成时调用请求回调并广播 OnSpawnRequestCompleted
+ * 使用方式：
+ * - 卡牌使用、敌人生成器、召唤能力调用 EnqueueFormation
+ * 注意事项：
+ * - 每帧至少生成 MinUnitsPerFrame 个单位，保证请求总能推进
+ * - 单位通过 USG_UnitPoolSubsystem 获取
+ */
+UCLASS()
+class SGUO_API USG_SpawnSchedulerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 在时间预算内处理生成队列
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_SpawnSchedulerSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return ActiveRequests.Num() > 0 || IncomingRequests.Num() > 0; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 请求接口 ==========
+
+    /**
+     * @brief 提交阵型生成请求
+     * @param Request 生成请求
+     * @param OnCompleted 完成回调（全部单位生成后调用）
+     * @return 请求 ID
+     */
+    int32 EnqueueFormation(const FSGFormationSpawnRequest& Request, FSGSpawnRequestCallback OnCompleted = FSGSpawnRequestCallback());
+
+    /**
+     * @brief 提交阵型生成请求（蓝图）
+     * @param Request 生成请求
+     * @return 请求 ID（完成时通过 OnSpawnRequestCompleted 广播）
+     */
+    UFUNCTION(BlueprintCallable, Category = "Spawn Scheduler", meta = (DisplayName = "提交阵型生成请求"))
+    int32 SubmitFormation(const FSGFormationSpawnRequest& Request) { return EnqueueFormation(Request); }
+
+    /**
+     * @brief 取消生成请求（已生成的单位保留，剩余位置不再生成）
+     * @param RequestId 请求 ID
+     * @return 是否找到并取消
+     */
+    UFUNCTION(BlueprintCallable, Category = "Spawn Scheduler", meta = (DisplayName = "取消生成请求"))
+    bool CancelRequest(int32 RequestId);
+
+    /**
+     * @brief 请求是否仍在进行
+     */
+    UFUNCTION(BlueprintPure, Category = "Spawn Scheduler", meta = (DisplayName = "请求是否进行中"))
+    bool IsRequestPending(int32 RequestId) const;
+
+    /**
+     * @brief 获取尚未生成的单位数量
+     */
+    UFUNCTION(BlueprintPure, Category = "Spawn Scheduler", meta = (DisplayName = "获取待生成单位数量"))
+    int32 GetPendingUnitCount() const;
+
+    // ========== 事件 ==========
+
+    /** 生成请求完成事件 */
+    UPROPERTY(BlueprintAssignable, Category = "Spawn Scheduler")
+    FSGSpawnRequestCompletedSignature OnSpawnRequestCompleted;
+
+    // ========== 配置 ==========
+
+    /** 每帧生成预算（毫秒） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Scheduler Config",
+        meta = (DisplayName = "每帧预算(毫秒)", ClampMin = "0.1", UIMin = "0.1", UIMax = "8.0"))
+    float FrameBudgetMs = 1.0f;
+
+    /** 每帧最少生成数量（不受预算限制） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Scheduler Config",
+        meta = (DisplayName = "每帧最少生成数量", ClampMin = "1", UIMin = "1", UIMax = "10"))
+    int32 MinUnitsPerFrame = 1;
+
+    /** 占位 Actor 类（为空则不放置占位） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Scheduler Config", meta = (DisplayName = "占位 Actor 类"))
+    TSubclassOf<AActor> PlaceholderClass;
+
+protected:
+    /**
+     * @brief 生成请求中的一个单位
+     */
+    void SpawnSlot(FSGActiveSpawnRequest& Active, int32 SlotIndex);
+
+    /**
+     * @brief 完成请求：清理占位并通知调用方
+     */
+    void CompleteRequest(FSGActiveSpawnRequest& Active);
+
+private:
+    // 进行中的请求（先进先出）
+    UPROPERTY()
+    TArray<FSGActiveSpawnRequest> ActiveRequests;
+
+    // Tick 期间提交的请求（Tick 结束后并入）
+    UPROPERTY()
+    TArray<FSGActiveSpawnRequest> IncomingRequests;
+
+    // 是否正在处理队列
+    bool bProcessingQueue = false;
+
+    // 下一个请求 ID
+    int32 NextRequestId = 1;
+};
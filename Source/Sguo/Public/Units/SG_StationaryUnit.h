@@ -48,6 +48,9 @@ protected:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
 
+    // ✨ 新增 - 对象池复用时重新应用站桩设置
+    virtual void OnActivatedFromPool() override;
+
 public:
     // ========== 站桩配置 ==========
     
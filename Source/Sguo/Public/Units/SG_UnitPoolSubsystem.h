@@ -0,0 +1,145 @@
+// 📄 文件：Source/Sguo/Public/Units/SG_UnitPoolSubsystem.h
+// ✨ 新增 - 单位对象池
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "Debug/SG_MemoryTracking.h"
+#include "SG_UnitPoolSubsystem.generated.h"
+
+// 前置声明
+class ASG_UnitsBase;
+class USG_CharacterCardData;
+
+/**
+ * @brief 单位对象池（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 按单位类缓存死亡后回收的单位（连同 AI 控制器和 ASC）
+ * - 生成单位时优先复用池中的单位，没有可用单位时才真正生成 Actor
+ * - 复用时完整重置属性、能力、标签和黑板（见 ASG_UnitsBase::ActivateFromPool）
+ * 使用方式：
+ * - 生成：AcquireUnit（替代 SpawnActorDeferred + FinishSpawning）
+ * - 回收：单位死亡表现结束后自动调用 ReleaseUnit，池已满时照常销毁
+ * 注意事项：
+ * - 只有通过 AcquireUnit 生成的单位才会回收到池中
+ * - 池中的单位处于隐藏、无碰撞、无 Tick 状态，bIsDead 保持为 true
+ */
+UCLASS()
+class SGUO_API USG_UnitPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== 获取与回收 ==========
+
+    /**
+     * @brief 获取单位（优先复用池中的单位）
+     * @param UnitClass 单位类
+     * @param SpawnTransform 生成变换
+     * @param CardData 源卡牌数据（可为空）
+     * @param InFactionTag 阵营标签（无效时使用类默认阵营）
+     * @param SpawnOwner 所有者
+     * @param SpawnInstigator 发起者
+     * @return 已完成初始化的单位，失败返回 nullptr
+     */
+    UFUNCTION(BlueprintCallable, Category = "Unit Pool", meta = (DisplayName = "获取单位"))
+    ASG_UnitsBase* AcquireUnit(
+        TSubclassOf<ASG_UnitsBase> UnitClass,
+        const FTransform& SpawnTransform,
+        USG_CharacterCardData* CardData,
+        FGameplayTag InFactionTag,
+        AActor* SpawnOwner = nullptr,
+        APawn* SpawnInstigator = nullptr
+    );
+
+    /**
+     * @brief 回收单位
+     * @param Unit 单位
+     * @return 是否已放入池中（false 表示调用方应销毁单位）
+     */
+    bool ReleaseUnit(ASG_UnitsBase* Unit);
+
+    /**
+     * @brief 预热对象池
+     * @param UnitClass 单位类
+     * @param Count 预热后池中至少保留的数量
+     * @details 在对局开始或卡组确定后调用，把生成开销前移；预热单位直接以池中状态生成，不运行 AI、不注册
+     */
+    UFUNCTION(BlueprintCallable, Category = "Unit Pool", meta = (DisplayName = "预热对象池"))
+    void Prewarm(TSubclassOf<ASG_UnitsBase> UnitClass, int32 Count);
+
+    // ========== 查询 ==========
+
+    /**
+     * @brief 获取池中某类单位的数量
+     */
+    UFUNCTION(BlueprintPure, Category = "Unit Pool", meta = (DisplayName = "获取池中单位数量"))
+    int32 GetPooledCount(TSubclassOf<ASG_UnitsBase> UnitClass) const;
+
+    /**
+     * @brief 获取池中单位总数
+     */
+    UFUNCTION(BlueprintPure, Category = "Unit Pool", meta = (DisplayName = "获取池中单位总数"))
+    int32 GetTotalPooledCount() const;
+
+    /** 新生成的单位数量 */
+    int32 GetSpawnedCount() const { return SpawnedCount; }
+
+    /** 复用的单位数量 */
+    int32 GetReusedCount() const { return ReusedCount; }
+
+    /**
+     * @brief ✨ 新增 - 池中单位总数峰值（高水位线），用于确定 MaxPooledPerClass
+     */
+    int32 GetPeakPooledCount() const { return PooledCount.Peak; }
+
+    // ========== 配置 ==========
+
+    /** 是否启用对象池 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Pool Config", meta = (DisplayName = "启用对象池"))
+    bool bEnablePooling = true;
+
+    /** 每个单位类最多缓存的数量 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Pool Config",
+        meta = (DisplayName = "每类最大缓存数量", ClampMin = "0", UIMin = "0", UIMax = "200"))
+    int32 MaxPooledPerClass = 60;
+
+private:
+    /**
+     * @brief 生成新单位
+     */
+    ASG_UnitsBase* SpawnNewUnit(
+        TSubclassOf<ASG_UnitsBase> UnitClass,
+        const FTransform& SpawnTransform,
+        USG_CharacterCardData* CardData,
+        const FGameplayTag& InFactionTag,
+        AActor* SpawnOwner,
+        APawn* SpawnInstigator
+    );
+
+    /**
+     * @brief 直接以池中状态生成单位（预热）
+     * @details 延迟生成并在 FinishSpawning 前标记，BeginPlay 不附身、不注册
+     */
+    ASG_UnitsBase* SpawnPooledUnit(TSubclassOf<ASG_UnitsBase> UnitClass);
+
+    // 单位类 -> 空闲单位（单位可能随关卡卸载而失效）
+    TMap<TSubclassOf<ASG_UnitsBase>, TArray<TWeakObjectPtr<ASG_UnitsBase>>> FreeUnits;
+
+    // 统计
+    int32 SpawnedCount = 0;
+    int32 ReusedCount = 0;
+
+    // ✨ 新增 - 池中单位总数及其峰值
+    FSGHighWaterMark PooledCount;
+};
@@ -0,0 +1,243 @@
+// 📄 文件：Source/Sguo/Public/Units/SG_UnitRegistrySubsystem.h
+// 🔧 修改 - 新增移动单位的速度历史环形缓冲
+// ✅ 这是完整文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "Tickable.h"
+#include "Debug/SG_MemoryTracking.h"
+#include "SG_UnitRegistrySubsystem.generated.h"
+
+// 前置声明
+class ASG_UnitsBase;
+
+/**
+ * @brief 单位句柄
+ * @details
+ * 功能说明：
+ * - 由槽位索引和代数组成，槽位被复用后旧句柄自动失效
+ * - 可以安全地保存在其他系统中，不持有单位引用
+ */
+USTRUCT(BlueprintType)
+struct FSGUnitHandle
+{
+    GENERATED_BODY()
+
+    // 槽位索引
+    UPROPERTY(BlueprintReadOnly, Category = "Unit Registry")
+    int32 Index = INDEX_NONE;
+
+    // 槽位代数（每次复用槽位时递增）
+    UPROPERTY(BlueprintReadOnly, Category = "Unit Registry")
+    int32 Generation = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Reset() { Index = INDEX_NONE; Generation = 0; }
+
+    bool operator==(const FSGUnitHandle& Other) const
+    {
+        return Index == Other.Index && Generation == Other.Generation;
+    }
+    bool operator!=(const FSGUnitHandle& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const FSGUnitHandle& Handle)
+    {
+        return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+    }
+};
+
+/**
+ * @brief 单位注册表（World Subsystem）
+ * @details
+ * 功能说明：
+ * - 所有存活单位在 BeginPlay 时注册，死亡或销毁时注销
+ * - 位置、生命值、攻击力、阵营按槽位存放在连续数组中（结构化数组）
+ * - 每帧统一刷新一次位置和属性，其他系统直接读取数组，不再遍历场景单位
+ * 使用方式：
+ * - 通过 GetActiveMask() 遍历有效槽位，按索引读取各数组
+ * - 通过 ResolveUnit() 把句柄还原为单位指针
+ * 注意事项：
+ * - 只能在游戏线程访问；需要在工作线程使用的数据应先拷贝快照
+ */
+UCLASS()
+class SGUO_API USG_UnitRegistrySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    // 每个槽位保存的速度采样数量
+    static constexpr int32 SpeedHistoryLength = 8;
+
+    // ========== 生命周期 ==========
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
+
+    // ========== FTickableGameObject 接口实现 ==========
+
+    /**
+     * @brief 每帧 Tick
+     * @param DeltaTime 帧间隔时间
+     * @details 刷新所有有效槽位的位置和属性
+     */
+    virtual void Tick(float DeltaTime) override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(USG_UnitRegistrySubsystem, STATGROUP_Tickables);
+    }
+
+    virtual bool IsTickable() const override { return ActiveCount.Current > 0; }
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+    // ========== 注册接口 ==========
+
+    /**
+     * @brief 注册单位
+     * @param Unit 单位
+     * @return 单位句柄
+     */
+    FSGUnitHandle RegisterUnit(ASG_UnitsBase* Unit);
+
+    /**
+     * @brief 注销单位
+     * @param Handle 单位句柄（注销后被重置）
+     */
+    void UnregisterUnit(FSGUnitHandle& Handle);
+
+    /**
+     * @brief 句柄是否仍然指向有效单位
+     */
+    bool IsHandleValid(const FSGUnitHandle& Handle) const;
+
+    /**
+     * @brief 把句柄还原为单位指针
+     * @return 句柄失效时返回 nullptr
+     */
+    ASG_UnitsBase* ResolveUnit(const FSGUnitHandle& Handle) const;
+
+    /**
+     * @brief 获取阵营的紧凑索引
+     * @param FactionTag 阵营标签
+     * @return 阵营索引（首次出现时分配）
+     */
+    uint8 GetFactionIndex(const FGameplayTag& FactionTag);
+
+    /**
+     * @brief 查找阵营的紧凑索引（不分配）
+     * @return 未注册过的阵营返回 INDEX_NONE
+     */
+    int32 FindFactionIndex(const FGameplayTag& FactionTag) const { return FactionTags.IndexOfByKey(FactionTag); }
+
+    // ========== 数据访问（按槽位索引） ==========
+
+    /** 槽位总数（包括空闲槽位） */
+    int32 GetSlotCount() const { return Units.Num(); }
+
+    /** 有效单位数量 */
+    UFUNCTION(BlueprintPure, Category = "Unit Registry", meta = (DisplayName = "获取注册单位数量"))
+    int32 GetActiveCount() const { return ActiveCount.Current; }
+
+    /** ✨ 新增 - 有效单位数量峰值（高水位线） */
+    int32 GetPeakActiveCount() const { return ActiveCount.Peak; }
+
+    /** 有效槽位掩码 */
+    const TBitArray<>& GetActiveMask() const { return ActiveMask; }
+
+    const TArray<FVector>& GetPositions() const { return Positions; }
+    const TArray<float>& GetHealths() const { return Healths; }
+    const TArray<float>& GetAttackDamages() const { return AttackDamages; }
+    const TArray<uint8>& GetFactionIndices() const { return FactionIndices; }
+    const TArray<int32>& GetGenerations() const { return Generations; }
+
+    /** 槽位对应的单位（可能已失效） */
+    ASG_UnitsBase* GetUnitAt(int32 SlotIndex) const { return Units.IsValidIndex(SlotIndex) ? Units[SlotIndex].Get() : nullptr; }
+
+    /** 阵营索引对应的标签 */
+    const TArray<FGameplayTag>& GetFactionTags() const { return FactionTags; }
+
+    // ========== 移动追踪（卡住检测） ==========
+
+    /**
+     * @brief 设置单位是否处于移动追踪状态
+     * @param Handle 单位句柄
+     * @param bMoving 是否正在向目标移动
+     * @param StuckSpeedThreshold 卡住速度阈值（厘米/秒）
+     * @param StuckTime 低于阈值持续多久判定为卡住（秒）
+     * @details 开始追踪时清空该槽位的速度历史
+     */
+    void SetMoving(const FSGUnitHandle& Handle, bool bMoving, float StuckSpeedThreshold = 0.0f, float StuckTime = 0.0f);
+
+    /**
+     * @brief 清空某槽位的速度历史（重新开始计时）
+     */
+    void ResetSpeedHistory(int32 SlotIndex);
+
+    /**
+     * @brief 为所有移动中的槽位写入一次速度采样
+     * @details 所有槽位共用同一个写入位置，一次调用对应一个采样时刻
+     */
+    void RecordSpeedSamples();
+
+    /** 移动中槽位掩码 */
+    const TBitArray<>& GetMovingMask() const { return MovingMask; }
+
+    /** 速度历史，布局：[槽位][SpeedHistoryLength] */
+    const TArray<float>& GetSpeedHistory() const { return SpeedHistory; }
+
+    /** 每个槽位已有的有效采样数（最多 SpeedHistoryLength） */
+    const TArray<uint8>& GetSpeedSampleCounts() const { return SpeedSampleCounts; }
+
+    /** 每个槽位的卡住速度阈值和判定时间（由 AI 控制器在开始移动时提供） */
+    const TArray<float>& GetStuckSpeedThresholds() const { return StuckSpeedThresholds; }
+    const TArray<float>& GetStuckTimes() const { return StuckTimes; }
+
+    /** 每个槽位连续判定为低速的次数（卡住检测读写） */
+    TArray<uint16>& GetLowSpeedEvaluations() { return LowSpeedEvaluations; }
+
+private:
+    // 刷新单个槽位
+    void RefreshSlot(int32 SlotIndex, const ASG_UnitsBase* Unit);
+
+    // ========== 结构化数组（按槽位索引对齐） ==========
+
+    TArray<TWeakObjectPtr<ASG_UnitsBase>> Units;
+    TArray<FVector> Positions;
+    TArray<float> Healths;
+    TArray<float> AttackDamages;
+    TArray<uint8> FactionIndices;
+    TArray<int32> Generations;
+
+    // 速度历史环形缓冲（每个槽位 SpeedHistoryLength 个）
+    TArray<float> SpeedHistory;
+    TArray<uint8> SpeedSampleCounts;
+
+    // 卡住检测参数和连续低速次数
+    TArray<float> StuckSpeedThresholds;
+    TArray<float> StuckTimes;
+    TArray<uint16> LowSpeedEvaluations;
+
+    // 移动中槽位掩码
+    TBitArray<> MovingMask;
+
+    // 环形缓冲的写入位置（所有槽位共用）
+    int32 SpeedHistoryHead = 0;
+
+    // 有效槽位掩码
+    TBitArray<> ActiveMask;
+
+    // 空闲槽位
+    TArray<int32> FreeSlots;
+
+    // 🔧 修改 - 有效单位数量及其峰值
+    FSGHighWaterMark ActiveCount;
+
+    // 阵营索引 -> 阵营标签
+    TArray<FGameplayTag> FactionTags;
+};
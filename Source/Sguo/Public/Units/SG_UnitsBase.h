@@ -8,6 +8,7 @@
 #include "AbilitySystemInterface.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "Units/SG_UnitRegistrySubsystem.h"
 #include "SG_UnitsBase.generated.h"
 
 // 前置声明
@@ -292,13 +293,90 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat")
     bool IsTargetValid() const;
 
+    // ========== ✨ 新增 - 对象池 ==========
+
+    /**
+     * @brief 是否由 USG_UnitPoolSubsystem 生成（死亡后回收而不是销毁）
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Unit Pool", meta = (DisplayName = "由对象池生成"))
+    bool bSpawnedFromPool = false;
+
+    /**
+     * @brief 是否正在池中（隐藏待复用）
+     */
+    UFUNCTION(BlueprintPure, Category = "Unit Pool", meta = (DisplayName = "是否在对象池中"))
+    bool IsInPool() const { return bIsInPool; }
+
+    /**
+     * @brief 从对象池中激活
+     * @param SpawnTransform 生成变换
+     * @param CardData 源卡牌数据
+     * @param InFactionTag 阵营标签（无效时使用类默认阵营）
+     * @details
+     * 功能说明：
+     * - 恢复类默认的基础属性，清空能力、效果和标签
+     * - 重新附身原控制器（黑板已清空），按 BeginPlay 相同流程初始化
+     */
+    void ActivateFromPool(const FTransform& SpawnTransform, USG_CharacterCardData* CardData, const FGameplayTag& InFactionTag);
+
+    /**
+     * @brief 停用并放入对象池
+     * @details 隐藏、关闭碰撞和 Tick，释放能力和效果，控制器解除附身但保留
+     */
+    void DeactivateForPool();
+
+    /**
+     * @brief 标记为直接以池中状态生成（对象池预热）
+     * @details
+     * - 必须在 SpawnActorDeferred 之后、FinishSpawning 之前调用
+     * - BeginPlay 不再初始化单位：不附身控制器、不启动行为树、不注册到注册表
+     * - 第一次出池时由 ActivateFromPool 完成全部初始化
+     */
+    void PrepareForPooledSpawn();
+
+    /**
+     * @brief 延迟移除单位
+     * @param Delay 延迟时间（秒）
+     * @details 对象池生成的单位到时回收，其他单位照常 SetLifeSpan
+     */
+    void ScheduleRemoval(float Delay);
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void PossessedBy(AController* NewController) override;
 
     void InitializeAttributes(float HealthMult, float DamageMult, float SpeedMult);
     void BindAttributeDelegates();
 
+    // ✨ 新增 - 单位初始化流程（BeginPlay 和对象池复用共用）
+    void InitializeUnitState();
+
+    // ✨ 新增 - 从对象池激活后调用，子类在此恢复自身的运行时设置
+    virtual void OnActivatedFromPool() {}
+
+    // ✨ 新增 - 放入对象池前调用（已停止动作、清空能力，尚未隐藏），子类在此停止自身的运行时效果
+    virtual void OnDeactivatedForPool() {}
+
+    /**
+     * @brief 从对象池激活（蓝图事件）
+     * @details
+     * 功能说明：
+     * - 复用的单位不会再次执行蓝图 BeginPlay，蓝图侧的初始化（特效、时间轴、事件绑定）在此重新执行
+     * 注意事项：
+     * - 在 C++ 初始化（InitializeUnitState、OnActivatedFromPool）之后调用
+     * - 预热生成的单位第一次出池时也会调用；新生成的单位只执行 BeginPlay，不调用此事件
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Unit Pool", meta = (DisplayName = "从对象池激活"))
+    void ReceiveActivatedFromPool();
+
+    /**
+     * @brief 放入对象池（蓝图事件）
+     * @details 在隐藏之前调用，蓝图在此停止特效、时间轴并解绑事件
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Unit Pool", meta = (DisplayName = "放入对象池"))
+    void ReceiveDeactivatedForPool();
+
     void OnHealthChanged(const FOnAttributeChangeData& Data);
     
     UFUNCTION(BlueprintNativeEvent, Category = "Character")
@@ -313,6 +391,10 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Character", meta = (DisplayName = "是否已死亡"))
     bool bIsDead = false;
 
+    // ✨ 新增 - 单位注册表句柄（存活期间有效）
+    UPROPERTY(BlueprintReadOnly, Category = "Character", meta = (DisplayName = "注册表句柄"))
+    FSGUnitHandle RegistryHandle;
+
     // ========== 调试可视化 ==========
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization", meta = (DisplayName = "显示攻击范围"))
@@ -415,4 +497,22 @@ private:
     UPROPERTY()
     TWeakObjectPtr<AActor> CurrentAttackingTarget;
 
+    // ✨ 新增 - 对象池内部函数
+    void ResetAbilitySystemForReuse();
+    void RestoreMeshAfterRagdoll();
+    void EnterPoolState();
+    void ReturnToPoolOrDestroy();
+
+    // ✨ 新增 - 是否正在池中
+    bool bIsInPool = false;
+
+    // 是否以池中状态生成（预热单位跳过 BeginPlay 初始化）
+    bool bStartInPool = false;
+
+    // ✨ 新增 - 最近一次附身的控制器（死亡时解除附身，复用时重新附身）
+    TWeakObjectPtr<AController> LastController;
+
+    // ✨ 新增 - 回收计时器
+    FTimerHandle PoolReturnTimerHandle;
+
 };
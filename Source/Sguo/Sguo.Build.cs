@@ -32,7 +32,9 @@ public class Sguo : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
-			"NetCore"
+			"NetCore",
+			// 性能基准读取 GGameThreadTime
+			"RenderCore"
 		});
 
 		PublicIncludePaths.AddRange(new string[] {